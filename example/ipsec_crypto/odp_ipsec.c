@@ -1426,6 +1426,7 @@ main(int argc, char *argv[])
 	shm = odp_shm_lookup("shm_ipsec_cache");
 	if (odp_shm_free(shm) != 0)
 		ODPH_ERR("Error: shm free shm_ipsec_cache failed\n");
+	term_fwd_db();
 	shm = odp_shm_lookup("shm_fwd_db");
 	if (odp_shm_free(shm) != 0)
 		ODPH_ERR("Error: shm free shm_fwd_db failed\n");
@@ -22,6 +22,7 @@ fwd_db_t *fwd_db;
 
 void init_fwd_db(void)
 {
+	odph_lpm_param_t param;
 	odp_shm_t shm;
 
 	shm = odp_shm_reserve("shm_fwd_db",
@@ -41,6 +42,23 @@ void init_fwd_db(void)
 		exit(EXIT_FAILURE);
 	}
 	memset(fwd_db, 0, sizeof(*fwd_db));
+
+	odph_lpm_param_init(&param);
+	param.max_routes = MAX_DB;
+	param.num_groups = MAX_DB;
+
+	fwd_db->lpm = odph_lpm_create("fwd_db_lpm", &param);
+
+	if (fwd_db->lpm == ODPH_LPM_INVALID) {
+		ODPH_ERR("Error: route table create failed.\n");
+		exit(EXIT_FAILURE);
+	}
+}
+
+void term_fwd_db(void)
+{
+	if (odph_lpm_destroy(fwd_db->lpm))
+		ODPH_ERR("Error: route table destroy failed.\n");
 }
 
 int create_fwd_db_entry(char *input, char **if_names, int if_count)
@@ -113,6 +131,16 @@ int create_fwd_db_entry(char *input, char **if_names, int if_count)
 		return -1;
 	}
 
+	/* Add route to the lookup table, a later route replaces an earlier one
+	 * of the same subnet */
+	if (odph_lpm_ipv4_add(fwd_db->lpm, entry->subnet.addr,
+			      __builtin_popcount(entry->subnet.mask),
+			      fwd_db->index)) {
+		printf("ERROR: \"%s\" route add failed\n", input);
+		free(local);
+		return -1;
+	}
+
 	/* Add route to the list */
 	fwd_db->index++;
 	entry->next = fwd_db->list;
@@ -163,10 +191,10 @@ void dump_fwd_db(void)
 
 fwd_db_entry_t *find_fwd_db_entry(uint32_t dst_ip)
 {
-	fwd_db_entry_t *entry;
+	uint32_t idx;
 
-	for (entry = fwd_db->list; NULL != entry; entry = entry->next)
-		if (entry->subnet.addr == (dst_ip & entry->subnet.mask))
-			break;
-	return entry;
+	if (odph_lpm_ipv4_find(fwd_db->lpm, dst_ip, &idx))
+		return NULL;
+
+	return &fwd_db->array[idx];
 }
@@ -12,6 +12,7 @@ extern "C" {
 #endif
 
 #include <odp_api.h>
+#include <odp/helper/odph_api.h>
 #include <odp_ipsec_misc.h>
 
 #define OIF_LEN 32
@@ -35,6 +36,7 @@ typedef struct fwd_db_entry_s {
 typedef struct fwd_db_s {
 	uint32_t          index;          /**< Next available entry */
 	fwd_db_entry_t   *list;           /**< List of active routes */
+	odph_lpm_t        lpm;            /**< Route lookup table */
 	fwd_db_entry_t    array[MAX_DB];  /**< Entry storage */
 } fwd_db_t;
 
@@ -44,6 +46,9 @@ extern fwd_db_t *fwd_db;
 /** Initialize FWD DB */
 void init_fwd_db(void);
 
+/** Free FWD DB route lookup table */
+void term_fwd_db(void);
+
 /**
  * Create a forwarding database entry
  *
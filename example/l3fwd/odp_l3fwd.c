@@ -21,7 +21,6 @@
 #include <odp/helper/odph_api.h>
 
 #include "odp_l3fwd_db.h"
-#include "odp_l3fwd_lpm.h"
 
 #define POOL_NUM_PKT	8192
 #define POOL_SEG_LEN	1856
@@ -97,8 +96,11 @@ typedef struct {
 	/** Break workers loop if set to 1 */
 	odp_atomic_u32_t exit_threads;
 
-	/* forward func, hash or lpm */
-	int (*fwd_func)(odp_packet_t pkt, int sif);
+	/** LPM table */
+	odph_lpm_t lpm;
+
+	/* forward func, hash or lpm. Writes output port of each packet into dif[]. */
+	void (*fwd_func)(odp_packet_t pkt_tbl[], int num, int sif, int dif[]);
 } global_data_t;
 
 static global_data_t *global;
@@ -158,16 +160,30 @@ static void setup_fwd_db(void)
 	app_args_t *args;
 
 	args = &global->cmd_args;
-	if (args->hash_mode)
+	if (args->hash_mode) {
 		init_fwd_hash_cache();
-	else
-		fib_tbl_init();
+	} else {
+		odph_lpm_param_t lpm_param;
+
+		odph_lpm_param_init(&lpm_param);
+		lpm_param.max_routes = MAX_NB_ROUTE;
+		lpm_param.num_groups = MAX_NB_ROUTE;
+
+		global->lpm = odph_lpm_create("l3fwd_lpm", &lpm_param);
+		if (global->lpm == ODPH_LPM_INVALID) {
+			ODPH_ERR("Error: LPM table create failed.\n");
+			exit(EXIT_FAILURE);
+		}
+	}
 
 	for (entry = fwd_db->list; NULL != entry; entry = entry->next) {
 		if_idx = entry->oif_id;
-		if (!args->hash_mode)
-			fib_tbl_insert(entry->subnet.addr, if_idx,
-				       entry->subnet.depth);
+		if (!args->hash_mode &&
+		    odph_lpm_ipv4_add(global->lpm, entry->subnet.addr,
+				      entry->subnet.depth, if_idx)) {
+			ODPH_ERR("Error: LPM route add failed.\n");
+			exit(EXIT_FAILURE);
+		}
 		if (args->dest_mac_changed[if_idx])
 			global->eth_dest_mac[if_idx] = entry->dst_mac;
 		else
@@ -191,68 +207,69 @@ static inline void ipv4_dec_ttl_csum_update(odph_ipv4hdr_t *ip)
 		ip->chksum += odp_cpu_to_be_16(1 << 8);
 }
 
-static inline int l3fwd_pkt_hash(odp_packet_t pkt, int sif)
+static void l3fwd_pkt_hash_multi(odp_packet_t pkt_tbl[], int num, int sif,
+				 int dif[])
 {
-	fwd_db_entry_t *entry;
-	ipv4_tuple5_t key;
+	fwd_db_entry_t *entry[num];
+	odph_ipv4hdr_t *ip[num];
 	odph_ethhdr_t *eth;
-	odph_udphdr_t  *udp;
-	odph_ipv4hdr_t *ip;
-	int dif;
-
-	ip = odp_packet_l3_ptr(pkt, NULL);
-	key.dst_ip = odp_be_to_cpu_32(ip->dst_addr);
-	key.src_ip = odp_be_to_cpu_32(ip->src_addr);
-	key.proto = ip->proto;
-
-	if (odp_packet_has_udp(pkt) ||
-	    odp_packet_has_tcp(pkt)) {
-		/* UDP or TCP*/
-		void *ptr = odp_packet_l4_ptr(pkt, NULL);
-
-		udp = (odph_udphdr_t *)ptr;
-		key.src_port = odp_be_to_cpu_16(udp->src_port);
-		key.dst_port = odp_be_to_cpu_16(udp->dst_port);
-	} else {
-		key.src_port = 0;
-		key.dst_port = 0;
-	}
-	entry = find_fwd_db_entry(&key);
-	ipv4_dec_ttl_csum_update(ip);
-	eth = odp_packet_l2_ptr(pkt, NULL);
-	if (entry) {
-		eth->src = entry->src_mac;
-		eth->dst = entry->dst_mac;
-		dif = entry->oif_id;
-	} else {
-		/* no route, send by src port */
-		eth->dst = eth->src;
-		dif = sif;
+	uint32_t dst_ip[num];
+	int i;
+
+	for (i = 0; i < num; i++) {
+		ip[i] = odp_packet_l3_ptr(pkt_tbl[i], NULL);
+		dst_ip[i] = odp_be_to_cpu_32(ip[i]->dst_addr);
 	}
 
-	return dif;
+	/* Look up the whole burst at once */
+	find_fwd_db_entry_multi(dst_ip, entry, num);
+
+	for (i = 0; i < num; i++) {
+		ipv4_dec_ttl_csum_update(ip[i]);
+		eth = odp_packet_l2_ptr(pkt_tbl[i], NULL);
+
+		if (entry[i]) {
+			eth->src = entry[i]->src_mac;
+			eth->dst = entry[i]->dst_mac;
+			dif[i] = entry[i]->oif_id;
+		} else {
+			/* no route, send by src port */
+			eth->dst = eth->src;
+			dif[i] = sif;
+		}
+	}
 }
 
-static inline int l3fwd_pkt_lpm(odp_packet_t pkt, int sif)
+static void l3fwd_pkt_lpm_multi(odp_packet_t pkt_tbl[], int num, int sif,
+				int dif[])
 {
-	odph_ipv4hdr_t *ip;
+	odph_ipv4hdr_t *ip[num];
 	odph_ethhdr_t *eth;
-	int dif;
-	int ret;
-
-	ip = odp_packet_l3_ptr(pkt, NULL);
-	ipv4_dec_ttl_csum_update(ip);
-	eth = odp_packet_l2_ptr(pkt, NULL);
+	uint32_t dst_ip[num];
+	uint32_t next_hop[num];
+	int i;
 
 	/* network byte order maybe different from host */
-	ret = fib_tbl_lookup(odp_be_to_cpu_32(ip->dst_addr), &dif);
-	if (ret)
-		dif = sif;
+	for (i = 0; i < num; i++) {
+		ip[i] = odp_packet_l3_ptr(pkt_tbl[i], NULL);
+		dst_ip[i] = odp_be_to_cpu_32(ip[i]->dst_addr);
+	}
 
-	eth->dst = global->eth_dest_mac[dif];
-	eth->src = global->l3fwd_pktios[dif].mac_addr;
+	/* Look up the whole burst at once */
+	odph_lpm_ipv4_find_multi(global->lpm, dst_ip, next_hop, num);
 
-	return dif;
+	for (i = 0; i < num; i++) {
+		ipv4_dec_ttl_csum_update(ip[i]);
+		eth = odp_packet_l2_ptr(pkt_tbl[i], NULL);
+
+		if (next_hop[i] == ODPH_LPM_NEXT_HOP_INVALID)
+			dif[i] = sif;
+		else
+			dif[i] = next_hop[i];
+
+		eth->dst = global->eth_dest_mac[dif[i]];
+		eth->src = global->l3fwd_pktios[dif[i]].mac_addr;
+	}
 }
 
 /**
@@ -300,9 +317,11 @@ static int run_worker(void *arg)
 	odp_pktin_queue_t input_queues[thr_arg->nb_pktio];
 	odp_pktout_queue_t output_queues[global->cmd_args.if_count];
 	odp_packet_t pkt_tbl[MAX_PKT_BURST];
+	int dif_tbl[MAX_PKT_BURST];
 	odp_packet_t *tbl;
+	int *dif;
 	int pkts, drop, sent;
-	int dst_port, dif;
+	int dst_port;
 	int i, j;
 	int pktio = 0;
 	int num_pktio = 0;
@@ -352,13 +371,13 @@ static int run_worker(void *arg)
 		if (odp_unlikely(pkts < 1))
 			continue;
 
-		dif = global->fwd_func(pkt_tbl[0], if_idx);
+		global->fwd_func(pkt_tbl, pkts, if_idx, dif_tbl);
 		tbl = &pkt_tbl[0];
+		dif = &dif_tbl[0];
 		while (pkts) {
-			dst_port = dif;
+			dst_port = dif[0];
 			for (i = 1; i < pkts; i++) {
-				dif = global->fwd_func(tbl[i], if_idx);
-				if (dif != dst_port)
+				if (dif[i] != dst_port)
 					break;
 			}
 			sent = odp_pktout_send(output_queues[dst_port], tbl, i);
@@ -368,8 +387,10 @@ static int run_worker(void *arg)
 				thr_arg->tx_drops += i - sent;
 			}
 
-			if (i < pkts)
+			if (i < pkts) {
 				tbl += i;
+				dif += i;
+			}
 
 			pkts -= i;
 		}
@@ -983,6 +1004,7 @@ int main(int argc, char **argv)
 	memset(global, 0, sizeof(global_data_t));
 	odp_atomic_init_u32(&global->exit_threads, 0);
 	global->shm = shm;
+	global->lpm = ODPH_LPM_INVALID;
 
 	/* Initialize the dest mac as 2:0:0:0:0:x */
 	mac[0] = 2;
@@ -1076,9 +1098,9 @@ int main(int argc, char **argv)
 
 	/* Decide ip lookup method */
 	if (args->hash_mode)
-		global->fwd_func = l3fwd_pkt_hash;
+		global->fwd_func = l3fwd_pkt_hash_multi;
 	else
-		global->fwd_func = l3fwd_pkt_lpm;
+		global->fwd_func = l3fwd_pkt_lpm_multi;
 
 	/* Start all the available ports */
 	for (i = 0; i < args->if_count; i++) {
@@ -1142,19 +1164,15 @@ int main(int argc, char **argv)
 	for (i = 0; i < MAX_NB_ROUTE; i++)
 		free(args->route_str[i]);
 
-	shm = odp_shm_lookup("flow_table");
-	if (shm != ODP_SHM_INVALID && odp_shm_free(shm) != 0) {
-		printf("Error: shm free flow_table\n");
-		exit(EXIT_FAILURE);
-	}
+	if (args->hash_mode)
+		term_fwd_hash_cache();
 	shm = odp_shm_lookup("shm_fwd_db");
 	if (shm != ODP_SHM_INVALID && odp_shm_free(shm) != 0) {
 		printf("Error: shm free shm_fwd_db\n");
 		exit(EXIT_FAILURE);
 	}
-	shm = odp_shm_lookup("fib_lpm_sub");
-	if (shm != ODP_SHM_INVALID && odp_shm_free(shm) != 0) {
-		printf("Error: shm free fib_lpm_sub\n");
+	if (global->lpm != ODPH_LPM_INVALID && odph_lpm_destroy(global->lpm)) {
+		printf("Error: LPM table destroy\n");
 		exit(EXIT_FAILURE);
 	}
 
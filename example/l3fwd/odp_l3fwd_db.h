@@ -23,11 +23,6 @@ extern "C" {
  */
 #define FWD_MAX_FLOW_COUNT	(1 << 22)
 
-/**
- * Default hash entries in a bucket
- */
-#define FWD_DEF_BUCKET_ENTRIES	4
-
 /**
  * IP address range (subnet)
  */
@@ -36,27 +31,6 @@ typedef struct ip_addr_range_s {
 	uint32_t  depth;    /**< subnet bit width */
 } ip_addr_range_t;
 
-/**
- * TCP/UDP flow
- */
-typedef struct ODP_ALIGNED_CACHE ipv4_tuple5_s {
-	union {
-		struct {
-			int32_t src_ip;
-			int32_t dst_ip;
-			int16_t src_port;
-			int16_t dst_port;
-			int8_t  proto;
-			int8_t  pad1;
-			int16_t pad2;
-		};
-		struct {
-			int64_t hi64;
-			int64_t lo64;
-		};
-	};
-} ipv4_tuple5_t;
-
 /**
  * Forwarding data base entry
  */
@@ -75,6 +49,7 @@ typedef struct fwd_db_entry_s {
 typedef struct fwd_db_s {
 	uint32_t          index;          /**< Next available entry */
 	fwd_db_entry_t   *list;           /**< List of active routes */
+	odph_flow_table_t flow_tbl;       /**< Destination lookup cache */
 	fwd_db_entry_t    array[MAX_DB];  /**< Entry storage */
 } fwd_db_t;
 
@@ -91,6 +66,11 @@ void init_fwd_db(void);
  */
 void init_fwd_hash_cache(void);
 
+/**
+ * Free forward lookup cache
+ */
+void term_fwd_hash_cache(void);
+
 /**
  * Create a forwarding database entry
  *
@@ -126,13 +106,16 @@ void dump_fwd_db_entry(fwd_db_entry_t *entry);
 void dump_fwd_db(void);
 
 /**
- * Find a matching forwarding database entry
+ * Find matching forwarding database entries
  *
- * @param key  ipv4 tuple
+ * Destinations that are not yet in the lookup cache are added to it.
  *
- * @return pointer to forwarding DB entry else NULL
+ * @param dst_ip  Destination IPv4 addresses, host endianness
+ * @param entry   Pointer to forwarding DB entry of each address, or NULL
+ * @param num     Number of addresses
  */
-fwd_db_entry_t *find_fwd_db_entry(ipv4_tuple5_t *key);
+void find_fwd_db_entry_multi(const uint32_t dst_ip[], fwd_db_entry_t *entry[],
+			     int num);
 
 #ifdef __cplusplus
 }
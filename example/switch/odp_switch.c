@@ -39,27 +39,16 @@
 /** Maximum number of pktio interfaces. Must be <= UINT8_MAX. */
 #define MAX_PKTIOS             8
 
-/** Number of MAC table entries. Must match to hash length. */
+/** Number of MAC table entries */
 #define MAC_TBL_SIZE           UINT16_MAX
 
-/** Aging time for MAC table entries in minutes. Must be <= UINT8_MAX. */
+/** Aging time for MAC table entries in minutes */
 #define AGING_TIME 5
 
 /** Get rid of path in filename - only for unix-type paths using '/' */
 #define NO_PATH(file_name) (strrchr((file_name), '/') ? \
 			    strrchr((file_name), '/') + 1 : (file_name))
 
-/** Local copy of MAC forwarding table entry */
-typedef union {
-	struct {
-		odph_ethaddr_t mac; /**< Ethernet MAC address */
-		uint8_t port;	    /**< Port index */
-		uint8_t tick;	    /**< Tick of the latest received packet */
-	} s;
-
-	uint64_t u64;
-} mac_tbl_entry_t;
-
 /**
  * Parsed command line application arguments
  */
@@ -150,7 +139,7 @@ typedef struct {
 		int next_tx_queue;
 	} pktios[MAX_PKTIOS];
 
-	odp_atomic_u64_t mac_tbl[MAC_TBL_SIZE]; /**< MAC forwarding table */
+	odph_flow_table_t mac_tbl; /**< MAC forwarding table */
 } args_t;
 
 /** Global pointer to args */
@@ -164,86 +153,22 @@ static void sig_handler(int signo ODP_UNUSED)
 }
 
 /**
- * Calculate MAC table index using Ethernet address hash
- *
- * @param mac        Pointer to Ethernet address
- *
- * @retval MAC table index
- */
-static inline uint16_t calc_mac_tbl_idx(odph_ethaddr_t *mac)
-{
-	uint32_t hash;
-
-	hash = odp_hash_crc32c(mac->addr, ODPH_ETHADDR_LEN, 0);
-
-	return (uint16_t)(hash & 0xFFFF);
-}
-
-/**
- * Calculate diff between ticks and take care of value wrap
- */
-static inline uint8_t diff_ticks(uint8_t t2, uint8_t t1)
-{
-	if (t1 < t2)
-		return t2 - t1;
-	else if (t1 > t2)
-		return UINT8_MAX + t2 - t1;
-	return 0;
-}
-
-/**
- * Get Ethernet address port index from MAC table
+ * Put Ethernet address port index to MAC table
  *
  * @param mac        Pointer to Ethernet address
- * @param port[out]  Pointer to port index for output
- * @param cur_tick   Current tick
- *
- * @retval 1 on entry found
- * @retval 0 on entry not found or expired
+ * @param port       Port index
  */
-static inline int mac_table_get(odph_ethaddr_t *mac, uint8_t *port,
-				uint8_t cur_tick)
+static inline void mac_table_update(odph_ethaddr_t *mac, uint8_t port)
 {
-	mac_tbl_entry_t entry;
-	uint16_t idx;
-
-	idx = calc_mac_tbl_idx(mac);
-
-	entry.u64 = odp_atomic_load_u64(&gbl_args->mac_tbl[idx]);
-
-	if (memcmp(mac->addr, entry.s.mac.addr, ODPH_ETHADDR_LEN))
-		return 0;
+	uint64_t cur_port;
 
-	if (odp_unlikely(diff_ticks(cur_tick, entry.s.tick) > AGING_TIME))
-		return 0;
-
-	*port = entry.s.port;
-	return 1;
-}
+	/* Source address lookup refreshes the entry age */
+	if (odp_likely(!odph_flow_table_find_refresh(gbl_args->mac_tbl, mac->addr, &cur_port) &&
+		       cur_port == port))
+		return;
 
-/**
- * Put Ethernet address port index to MAC table
- *
- * @param mac        Pointer to Ethernet address
- * @param port       Pointer to port index
- * @param cur_tick   Current tick
- */
-static inline void mac_table_update(odph_ethaddr_t *mac, uint8_t port,
-				    uint8_t cur_tick)
-{
-	mac_tbl_entry_t entry;
-	uint16_t idx;
-
-	idx = calc_mac_tbl_idx(mac);
-	entry.u64 = odp_atomic_load_u64(&gbl_args->mac_tbl[idx]);
-
-	if (memcmp(entry.s.mac.addr, mac->addr, ODPH_ETHADDR_LEN) ||
-	    entry.s.port != port || entry.s.tick != cur_tick) {
-		entry.s.mac = *mac;
-		entry.s.port = port;
-		entry.s.tick = cur_tick;
-		odp_atomic_store_u64(&gbl_args->mac_tbl[idx], entry.u64);
-	}
+	/* Frames to the address are broadcasted, if the table is full */
+	(void)odph_flow_table_add(gbl_args->mac_tbl, mac->addr, port);
 }
 
 /**
@@ -397,6 +322,9 @@ static int print_speed_stats(int num_workers, stats_t (*thr_stats)[MAX_PKTIOS],
 		sleep(timeout);
 		elapsed += timeout;
 
+		/* Remove MAC table entries of stations that have been silent */
+		odph_flow_table_age(gbl_args->mac_tbl);
+
 		for (i = 0; i < num_workers; i++) {
 			for (j = 0; j < num_ifaces; j++) {
 				rx_pkts[j] += thr_stats[i][j].s.rx_packets;
@@ -558,18 +486,20 @@ static frame_type_t check_frame(odph_ethhdr_t *eth)
  * @param num        Number of packets in the array
  * @param thr_arg    Thread arguments
  * @param port_in    Input port index
- * @param cur_tick   Current tick
  */
 static inline void forward_packets(odp_packet_t pkt_tbl[], unsigned int num,
-				   thread_args_t *thr_arg, uint8_t port_in,
-				   uint8_t cur_tick)
+				   thread_args_t *thr_arg, uint8_t port_in)
 {
 	odp_packet_t pkt;
 	odph_ethhdr_t *eth;
 	unsigned int i;
 	unsigned int buf_id;
-	uint8_t port_out = 0;
+	uint8_t port_out;
 	int frame_type;
+	odp_packet_t pkt_uc[num];
+	const void *dst_mac[num];
+	uint64_t port[num];
+	unsigned int num_uc = 0;
 
 	for (i = 0; i < num; i++) {
 		pkt = pkt_tbl[i];
@@ -591,14 +521,30 @@ static inline void forward_packets(odp_packet_t pkt_tbl[], unsigned int num,
 		}
 
 		/* Update source address MAC table entry */
-		mac_table_update(&eth->src, port_in, cur_tick);
+		mac_table_update(&eth->src, port_in);
+
+		if (frame_type == FRAME_BROADCAST) {
+			broadcast_packet(pkt, thr_arg, port_in);
+			continue;
+		}
+
+		dst_mac[num_uc] = eth->dst.addr;
+		pkt_uc[num_uc++] = pkt;
+	}
+
+	/* Look up destination ports of all unicast frames at once */
+	odph_flow_table_find_multi(gbl_args->mac_tbl, dst_mac, port, num_uc);
 
-		/* Broadcast frame is necessary */
-		if (frame_type == FRAME_BROADCAST ||
-		    !mac_table_get(&eth->dst, &port_out, cur_tick)) {
+	for (i = 0; i < num_uc; i++) {
+		pkt = pkt_uc[i];
+
+		/* Broadcast frame if destination is unknown */
+		if (port[i] == ODPH_FLOW_TABLE_VALUE_INVALID) {
 			broadcast_packet(pkt, thr_arg, port_in);
 			continue;
 		}
+
+		port_out = port[i];
 		buf_id = thr_arg->tx_pktio[port_out].buf.len;
 
 		thr_arg->tx_pktio[port_out].buf.pkt[buf_id] = pkt;
@@ -673,9 +619,6 @@ static int run_worker(void *arg)
 	odp_packet_t pkt_tbl[MAX_PKT_BURST];
 	odp_pktin_queue_t pktin;
 	odp_pktout_queue_t pktout;
-	odp_time_t time_prev;
-	odp_time_t minute;
-	uint8_t cur_tick;
 	unsigned int num_pktio;
 	unsigned int pktio = 0;
 	uint8_t port_in;
@@ -688,13 +631,7 @@ static int run_worker(void *arg)
 
 	odp_barrier_wait(&gbl_args->barrier);
 
-	minute = odp_time_local_from_ns(ODP_TIME_MIN_IN_NS);
-	time_prev = odp_time_local();
-	cur_tick = (odp_time_to_ns(time_prev) / ODP_TIME_MIN_IN_NS) % UINT8_MAX;
-
 	while (!odp_atomic_load_u32(&gbl_args->exit_threads)) {
-		odp_time_t time_cur;
-		odp_time_t time_diff;
 		int sent;
 		unsigned int drops;
 
@@ -710,20 +647,10 @@ static int run_worker(void *arg)
 		if (odp_unlikely(pkts <= 0))
 			continue;
 
-		time_cur = odp_time_local();
-		time_diff = odp_time_diff(time_cur, time_prev);
-
-		if (odp_unlikely(odp_time_cmp(time_diff, minute))) {
-			/* Tick stored as 8 bit value */
-			cur_tick = (odp_time_to_ns(time_cur) /
-					ODP_TIME_MIN_IN_NS) % UINT8_MAX;
-			time_prev = time_cur;
-		}
-
 		thr_args->stats[port_in]->s.rx_packets += pkts;
 
 		/* Sort packets to thread local tx buffers */
-		forward_packets(pkt_tbl, pkts, thr_args, port_in, cur_tick);
+		forward_packets(pkt_tbl, pkts, thr_args, port_in);
 
 		/* Empty all thread local tx buffers */
 		for (port_out = 0; port_out < gbl_args->appl.if_count;
@@ -982,6 +909,7 @@ int main(int argc, char **argv)
 	int i, j;
 	int num_workers;
 	odp_shm_t shm;
+	odph_flow_table_param_t mac_tbl_param;
 	odp_cpumask_t cpumask;
 	char cpumaskstr[ODP_CPUMASK_STR_SIZE];
 	odp_pool_param_t params;
@@ -1032,8 +960,16 @@ int main(int argc, char **argv)
 	}
 	gbl_args_init(gbl_args);
 
-	for (i = 0; (unsigned int)i < MAC_TBL_SIZE; i++)
-		odp_atomic_init_u64(&gbl_args->mac_tbl[i], 0);
+	odph_flow_table_param_init(&mac_tbl_param);
+	mac_tbl_param.key_size = ODPH_ETHADDR_LEN;
+	mac_tbl_param.num_entries = MAC_TBL_SIZE;
+	mac_tbl_param.aging_ns = AGING_TIME * ODP_TIME_MIN_IN_NS;
+
+	gbl_args->mac_tbl = odph_flow_table_create("mac_table", &mac_tbl_param);
+	if (gbl_args->mac_tbl == ODPH_FLOW_TABLE_INVALID) {
+		printf("Error: MAC table create failed.\n");
+		exit(EXIT_FAILURE);
+	}
 
 	/* Parse and store the application arguments */
 	parse_args(argc, argv, &gbl_args->appl);
@@ -1159,6 +1095,11 @@ int main(int argc, char **argv)
 		exit(EXIT_FAILURE);
 	}
 
+	if (odph_flow_table_destroy(gbl_args->mac_tbl)) {
+		printf("Error: MAC table destroy\n");
+		exit(EXIT_FAILURE);
+	}
+
 	if (odp_shm_free(shm)) {
 		printf("Error: shm free\n");
 		exit(EXIT_FAILURE);
@@ -0,0 +1,732 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+#include <odp_api.h>
+#include <odp/helper/debug.h>
+#include <odp/helper/flow_table.h>
+#include <odp/helper/macros.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#define BUCKET_SIZE   8
+
+/* Index of an empty bucket slot. Entry indexes start from one. */
+#define EMPTY         0
+
+/* Maximum number of buckets visited when searching space for a new key */
+#define MOVE_QUEUE    256
+
+/* Number of keys looked up per round in find_multi */
+#define FIND_BURST    32
+
+/* Entries are aged in milliseconds */
+#define TIME_UNIT_NS  ODP_TIME_MSEC_IN_NS
+
+typedef struct ODP_ALIGNED_CACHE {
+	uint16_t sig[BUCKET_SIZE];
+	odp_atomic_u32_t idx[BUCKET_SIZE];
+
+} bucket_t;
+
+typedef struct {
+	odp_atomic_u64_t value;
+	odp_atomic_u32_t time;
+
+	/* Odd while the entry is free. Incremented when the entry is released
+	 * and when it is allocated again. */
+	odp_atomic_u32_t gen;
+
+	uint8_t key[];
+
+} flow_entry_t;
+
+/* Bucket of a key during the search for a free slot. The key in 'slot' of the
+ * parent bucket moves into this bucket. */
+typedef struct {
+	uint32_t bkt;
+	int32_t parent;
+	uint32_t slot;
+
+} move_node_t;
+
+typedef struct odph_flow_table_s {
+	odp_shm_t shm;
+
+	/* Serializes updates, unless single writer */
+	odp_spinlock_t lock;
+
+	/* Incremented before a key is removed from its old bucket on a move */
+	odp_atomic_u32_t change_cnt ODP_ALIGNED_CACHE;
+
+	/* Current table time */
+	odp_atomic_u32_t time;
+
+	char name[ODPH_FLOW_TABLE_NAME_LEN];
+	odp_bool_t single_writer;
+	uint32_t key_size;
+	uint32_t num_entries;
+	uint32_t num_used;
+	uint32_t bucket_mask;
+	uint32_t entry_size;
+	uint32_t aging_time;
+
+	/* Free entries are allocated from the head and returned to the tail of
+	 * a FIFO, so that a released entry is reused as late as possible. */
+	uint32_t free_head;
+	uint32_t free_tail;
+
+	/* Offsets from the table start, which are valid in all processes */
+	uint64_t entry_offset;
+	uint64_t free_offset;
+	uint64_t size;
+
+	bucket_t bucket[];
+
+} flow_table_t;
+
+static inline bucket_t *bucket_ptr(flow_table_t *tbl, uint32_t bkt)
+{
+	return &tbl->bucket[bkt];
+}
+
+static inline flow_entry_t *entry_ptr(flow_table_t *tbl, uint32_t idx)
+{
+	uint8_t *base = (uint8_t *)tbl + tbl->entry_offset;
+
+	return (flow_entry_t *)(void *)(base + (uint64_t)(idx - 1) * tbl->entry_size);
+}
+
+static inline uint32_t *free_fifo(flow_table_t *tbl)
+{
+	return (uint32_t *)(void *)((uint8_t *)tbl + tbl->free_offset);
+}
+
+static inline uint32_t table_time(void)
+{
+	return odp_time_global_ns() / TIME_UNIT_NS;
+}
+
+/* Alternative bucket of a key. Applying the same function to the alternative
+ * bucket results the original bucket. */
+static inline uint32_t alt_bucket(flow_table_t *tbl, uint32_t bkt, uint16_t sig)
+{
+	return (bkt ^ sig) & tbl->bucket_mask;
+}
+
+static inline void key_hash(flow_table_t *tbl, const void *key, uint32_t *bkt, uint16_t *sig)
+{
+	uint32_t hash = odp_hash_crc32c(key, tbl->key_size, 0);
+
+	*bkt = hash & tbl->bucket_mask;
+	*sig = hash >> 16;
+}
+
+/* Bit mask of bucket slots with a matching signature */
+static inline uint32_t sig_match(const bucket_t *b, uint16_t sig)
+{
+#if defined(__SSE2__)
+	__m128i sigs = _mm_load_si128((const __m128i *)(const void *)b->sig);
+	__m128i eq = _mm_cmpeq_epi16(sigs, _mm_set1_epi16(sig));
+
+	return _mm_movemask_epi8(_mm_packs_epi16(eq, _mm_setzero_si128()));
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+	static const uint8_t bit[BUCKET_SIZE] = {1, 2, 4, 8, 16, 32, 64, 128};
+	uint16x8_t eq = vceqq_u16(vld1q_u16(b->sig), vdupq_n_u16(sig));
+
+	return vaddv_u8(vand_u8(vmovn_u16(eq), vld1_u8(bit)));
+#else
+	uint32_t match = 0;
+
+	for (int i = 0; i < BUCKET_SIZE; i++)
+		match |= (uint32_t)(b->sig[i] == sig) << i;
+
+	return match;
+#endif
+}
+
+static inline void entry_refresh(flow_table_t *tbl, flow_entry_t *e)
+{
+	uint32_t now;
+
+	if (tbl->aging_time == 0)
+		return;
+
+	/* Avoid writing the entry cache line on every lookup */
+	now = odp_atomic_load_u32(&tbl->time);
+
+	if (odp_unlikely(odp_atomic_load_u32(&e->time) != now))
+		odp_atomic_store_u32(&e->time, now);
+}
+
+/* Search a key from a bucket on updates. Returns the entry index or EMPTY. */
+static inline uint32_t bucket_search(flow_table_t *tbl, bucket_t *b, uint16_t sig,
+				     const void *key, uint32_t *slot)
+{
+	uint32_t match = sig_match(b, sig);
+
+	while (match) {
+		int i = __builtin_ctz(match);
+		uint32_t idx = odp_atomic_load_acq_u32(&b->idx[i]);
+
+		match &= match - 1;
+
+		if (idx != EMPTY && !memcmp(entry_ptr(tbl, idx)->key, key, tbl->key_size)) {
+			*slot = i;
+			return idx;
+		}
+	}
+
+	return EMPTY;
+}
+
+/* Search a key from a bucket concurrently with updates. Returns the entry and
+ * its value, or NULL. */
+static inline flow_entry_t *bucket_find(flow_table_t *tbl, bucket_t *b, uint16_t sig,
+					const void *key, uint64_t *value)
+{
+	uint32_t match = sig_match(b, sig);
+
+	while (match) {
+		int i = __builtin_ctz(match);
+		uint32_t idx = odp_atomic_load_acq_u32(&b->idx[i]);
+		flow_entry_t *e;
+		uint64_t val;
+		uint32_t gen;
+
+		match &= match - 1;
+
+		if (idx == EMPTY)
+			continue;
+
+		e = entry_ptr(tbl, idx);
+		gen = odp_atomic_load_acq_u32(&e->gen);
+
+		/* Entry has been released */
+		if (gen & 1)
+			continue;
+
+		if (memcmp(e->key, key, tbl->key_size))
+			continue;
+
+		val = odp_atomic_load_u64(&e->value);
+
+		/* Key and value may belong to another key, if the entry was
+		 * released and reused meanwhile */
+		odp_mb_acquire();
+
+		if (odp_unlikely(odp_atomic_load_u32(&e->gen) != gen))
+			continue;
+
+		*value = val;
+		return e;
+	}
+
+	return NULL;
+}
+
+static inline int bucket_free_slot(bucket_t *b)
+{
+	for (int i = 0; i < BUCKET_SIZE; i++)
+		if (odp_atomic_load_u32(&b->idx[i]) == EMPTY)
+			return i;
+
+	return -1;
+}
+
+static inline void slot_set(bucket_t *b, uint32_t slot, uint16_t sig, uint32_t idx)
+{
+	/* Signature is written first, readers compare full keys anyway */
+	b->sig[slot] = sig;
+	odp_atomic_store_rel_u32(&b->idx[slot], idx);
+}
+
+static inline void lock(flow_table_t *tbl)
+{
+	if (!tbl->single_writer)
+		odp_spinlock_lock(&tbl->lock);
+}
+
+static inline void unlock(flow_table_t *tbl)
+{
+	if (!tbl->single_writer)
+		odp_spinlock_unlock(&tbl->lock);
+}
+
+static uint32_t entry_alloc(flow_table_t *tbl)
+{
+	uint32_t idx = free_fifo(tbl)[tbl->free_head % tbl->num_entries];
+
+	tbl->free_head++;
+	tbl->num_used++;
+
+	return idx;
+}
+
+static void entry_free(flow_table_t *tbl, uint32_t idx)
+{
+	odp_atomic_u32_t *gen = &entry_ptr(tbl, idx)->gen;
+
+	/* Lookups that read the entry see the change before it is reused */
+	odp_atomic_store_u32(gen, odp_atomic_load_u32(gen) + 1);
+	odp_mb_release();
+
+	free_fifo(tbl)[tbl->free_tail % tbl->num_entries] = idx;
+	tbl->free_tail++;
+	tbl->num_used--;
+}
+
+/* Move a key into a free slot of its alternative bucket */
+static void slot_move(flow_table_t *tbl, uint32_t src_bkt, uint32_t src_slot, uint32_t dst_bkt,
+		      uint32_t dst_slot)
+{
+	bucket_t *src = bucket_ptr(tbl, src_bkt);
+
+	slot_set(bucket_ptr(tbl, dst_bkt), dst_slot, src->sig[src_slot],
+		 odp_atomic_load_u32(&src->idx[src_slot]));
+
+	/* The key is now in both buckets. Readers that missed the new copy and
+	 * may miss the old copy see the counter change and search again. */
+	odp_atomic_store_u32(&tbl->change_cnt, odp_atomic_load_u32(&tbl->change_cnt) + 1);
+	odp_mb_release();
+
+	odp_atomic_store_u32(&src->idx[src_slot], EMPTY);
+}
+
+/* Free a slot in one of the two buckets by moving keys to their alternative
+ * buckets. Breadth first search finds the shortest path of moves. */
+static int make_space(flow_table_t *tbl, uint32_t bkt_1, uint32_t bkt_2, uint32_t *bkt,
+		      uint32_t *slot)
+{
+	move_node_t node[MOVE_QUEUE];
+	int head = 0, tail = 0;
+
+	node[tail++] = (move_node_t){ .bkt = bkt_1, .parent = -1 };
+	node[tail++] = (move_node_t){ .bkt = bkt_2, .parent = -1 };
+
+	for (; head < tail; head++) {
+		bucket_t *b = bucket_ptr(tbl, node[head].bkt);
+
+		for (uint32_t i = 0; i < BUCKET_SIZE; i++) {
+			uint32_t alt = alt_bucket(tbl, node[head].bkt, b->sig[i]);
+			uint32_t free_bkt, free_slot;
+			int n, s;
+
+			if (alt == node[head].bkt)
+				continue;
+
+			s = bucket_free_slot(bucket_ptr(tbl, alt));
+
+			if (s < 0) {
+				if (tail < MOVE_QUEUE)
+					node[tail++] = (move_node_t){ .bkt = alt, .parent = head,
+								      .slot = i };
+				continue;
+			}
+
+			/* Move keys along the path, starting from the last one */
+			slot_move(tbl, node[head].bkt, i, alt, s);
+			free_bkt = node[head].bkt;
+			free_slot = i;
+
+			for (n = head; node[n].parent >= 0; n = node[n].parent) {
+				move_node_t *parent = &node[node[n].parent];
+				bucket_t *pb = bucket_ptr(tbl, parent->bkt);
+
+				/* A bucket may appear twice on the path. Stop if
+				 * the key to be moved has already moved. */
+				if (odp_atomic_load_u32(&pb->idx[node[n].slot]) == EMPTY ||
+				    alt_bucket(tbl, parent->bkt, pb->sig[node[n].slot]) != free_bkt)
+					return -1;
+
+				slot_move(tbl, parent->bkt, node[n].slot, free_bkt, free_slot);
+				free_bkt = parent->bkt;
+				free_slot = node[n].slot;
+			}
+
+			*bkt = free_bkt;
+			*slot = free_slot;
+			return 0;
+		}
+	}
+
+	return -1;
+}
+
+static inline int table_find(flow_table_t *tbl, const void *key, uint32_t bkt_1, uint16_t sig,
+			     uint64_t *value, int refresh)
+{
+	uint32_t bkt_2 = alt_bucket(tbl, bkt_1, sig);
+	flow_entry_t *e;
+	uint32_t cnt;
+
+	do {
+		cnt = odp_atomic_load_acq_u32(&tbl->change_cnt);
+
+		e = bucket_find(tbl, bucket_ptr(tbl, bkt_1), sig, key, value);
+
+		if (e == NULL)
+			e = bucket_find(tbl, bucket_ptr(tbl, bkt_2), sig, key, value);
+
+		if (e != NULL) {
+			if (refresh)
+				entry_refresh(tbl, e);
+			return 0;
+		}
+
+		odp_mb_acquire();
+
+	} while (cnt != odp_atomic_load_u32(&tbl->change_cnt));
+
+	return -1;
+}
+
+void odph_flow_table_param_init(odph_flow_table_param_t *param)
+{
+	memset(param, 0, sizeof(odph_flow_table_param_t));
+
+	param->key_size = 16;
+	param->num_entries = 1024;
+}
+
+odph_flow_table_t odph_flow_table_create(const char *name, const odph_flow_table_param_t *param)
+{
+	odp_shm_t shm;
+	flow_table_t *tbl;
+	uint64_t size, entry_offset, free_offset, num_buckets, min_buckets;
+	uint32_t entry_size;
+
+	if (name == NULL || strlen(name) >= ODPH_FLOW_TABLE_NAME_LEN) {
+		ODPH_ERR("Bad flow table name\n");
+		return ODPH_FLOW_TABLE_INVALID;
+	}
+
+	if (param->key_size == 0 || param->key_size > ODPH_FLOW_TABLE_MAX_KEY_SIZE) {
+		ODPH_ERR("Bad key size: %" PRIu32 "\n", param->key_size);
+		return ODPH_FLOW_TABLE_INVALID;
+	}
+
+	if (param->num_entries == 0 || param->num_entries > UINT32_MAX / 2) {
+		ODPH_ERR("Bad number of entries: %" PRIu32 "\n", param->num_entries);
+		return ODPH_FLOW_TABLE_INVALID;
+	}
+
+	/* Buckets are at most 90% full, when all entries are used */
+	min_buckets = ((uint64_t)param->num_entries * 10 + 9 * BUCKET_SIZE - 1) /
+		      (9 * BUCKET_SIZE);
+	num_buckets = 2;
+
+	while (num_buckets < min_buckets)
+		num_buckets *= 2;
+
+	entry_size = ODPH_ROUNDUP_MULTIPLE(sizeof(flow_entry_t) + param->key_size, 8);
+	entry_offset = sizeof(flow_table_t) + num_buckets * sizeof(bucket_t);
+	free_offset = entry_offset + (uint64_t)param->num_entries * entry_size;
+	size = free_offset + (uint64_t)param->num_entries * sizeof(uint32_t);
+
+	shm = odp_shm_reserve(name, size, ODP_CACHE_LINE_SIZE, 0);
+
+	if (shm == ODP_SHM_INVALID) {
+		ODPH_ERR("Shm reserve failed: %s (%" PRIu64 " bytes)\n", name, size);
+		return ODPH_FLOW_TABLE_INVALID;
+	}
+
+	tbl = odp_shm_addr(shm);
+	memset(tbl, 0, size);
+
+	tbl->shm = shm;
+	odp_spinlock_init(&tbl->lock);
+	odp_atomic_init_u32(&tbl->change_cnt, 0);
+	odp_atomic_init_u32(&tbl->time, table_time());
+	strcpy(tbl->name, name);
+	tbl->single_writer = param->single_writer;
+	tbl->key_size = param->key_size;
+	tbl->num_entries = param->num_entries;
+	tbl->bucket_mask = num_buckets - 1;
+	tbl->entry_size = entry_size;
+	tbl->aging_time = (param->aging_ns + TIME_UNIT_NS - 1) / TIME_UNIT_NS;
+	tbl->entry_offset = entry_offset;
+	tbl->free_offset = free_offset;
+	tbl->size = size;
+
+	for (uint64_t i = 0; i < num_buckets; i++)
+		for (int j = 0; j < BUCKET_SIZE; j++)
+			odp_atomic_init_u32(&tbl->bucket[i].idx[j], EMPTY);
+
+	for (uint32_t i = 0; i < param->num_entries; i++) {
+		odp_atomic_init_u32(&entry_ptr(tbl, i + 1)->gen, 1);
+		free_fifo(tbl)[i] = i + 1;
+	}
+
+	tbl->free_head = 0;
+	tbl->free_tail = param->num_entries;
+
+	return tbl;
+}
+
+odph_flow_table_t odph_flow_table_lookup(const char *name)
+{
+	odp_shm_t shm = odp_shm_lookup(name);
+
+	if (shm == ODP_SHM_INVALID)
+		return ODPH_FLOW_TABLE_INVALID;
+
+	return odp_shm_addr(shm);
+}
+
+int odph_flow_table_destroy(odph_flow_table_t tbl)
+{
+	if (odp_shm_free(tbl->shm)) {
+		ODPH_ERR("Shm free failed: %s\n", tbl->name);
+		return -1;
+	}
+
+	return 0;
+}
+
+int odph_flow_table_add(odph_flow_table_t tbl, const void *key, uint64_t value)
+{
+	flow_entry_t *e;
+	uint32_t bkt_1, bkt_2, bkt, idx, slot;
+	uint16_t sig;
+	int s;
+
+	if (odp_unlikely(value == ODPH_FLOW_TABLE_VALUE_INVALID)) {
+		ODPH_ERR("Bad value\n");
+		return -1;
+	}
+
+	key_hash(tbl, key, &bkt_1, &sig);
+	bkt_2 = alt_bucket(tbl, bkt_1, sig);
+
+	lock(tbl);
+
+	idx = bucket_search(tbl, bucket_ptr(tbl, bkt_1), sig, key, &slot);
+
+	if (idx == EMPTY)
+		idx = bucket_search(tbl, bucket_ptr(tbl, bkt_2), sig, key, &slot);
+
+	if (idx != EMPTY) {
+		e = entry_ptr(tbl, idx);
+		odp_atomic_store_u64(&e->value, value);
+		odp_atomic_store_u32(&e->time, odp_atomic_load_u32(&tbl->time));
+		unlock(tbl);
+		return 0;
+	}
+
+	if (tbl->num_used == tbl->num_entries) {
+		unlock(tbl);
+		return -1;
+	}
+
+	bkt = bkt_1;
+	s = bucket_free_slot(bucket_ptr(tbl, bkt_1));
+
+	if (s < 0) {
+		bkt = bkt_2;
+		s = bucket_free_slot(bucket_ptr(tbl, bkt_2));
+	}
+
+	if (s >= 0) {
+		slot = s;
+	} else if (make_space(tbl, bkt_1, bkt_2, &bkt, &slot)) {
+		unlock(tbl);
+		return -1;
+	}
+
+	/* Entry is fully written before it is linked into the bucket */
+	idx = entry_alloc(tbl);
+	e = entry_ptr(tbl, idx);
+	memcpy(e->key, key, tbl->key_size);
+	odp_atomic_init_u64(&e->value, value);
+	odp_atomic_init_u32(&e->time, odp_atomic_load_u32(&tbl->time));
+	odp_atomic_store_rel_u32(&e->gen, odp_atomic_load_u32(&e->gen) + 1);
+	slot_set(bucket_ptr(tbl, bkt), slot, sig, idx);
+
+	unlock(tbl);
+
+	return 0;
+}
+
+int odph_flow_table_del(odph_flow_table_t tbl, const void *key)
+{
+	uint32_t bkt, idx, slot;
+	uint16_t sig;
+
+	key_hash(tbl, key, &bkt, &sig);
+
+	lock(tbl);
+
+	idx = bucket_search(tbl, bucket_ptr(tbl, bkt), sig, key, &slot);
+
+	if (idx == EMPTY) {
+		bkt = alt_bucket(tbl, bkt, sig);
+		idx = bucket_search(tbl, bucket_ptr(tbl, bkt), sig, key, &slot);
+	}
+
+	if (idx == EMPTY) {
+		unlock(tbl);
+		return -1;
+	}
+
+	odp_atomic_store_rel_u32(&bucket_ptr(tbl, bkt)->idx[slot], EMPTY);
+	entry_free(tbl, idx);
+
+	unlock(tbl);
+
+	return 0;
+}
+
+int odph_flow_table_find(odph_flow_table_t tbl, const void *key, uint64_t *value)
+{
+	uint32_t bkt;
+	uint16_t sig;
+
+	key_hash(tbl, key, &bkt, &sig);
+
+	return table_find(tbl, key, bkt, sig, value, 0);
+}
+
+int odph_flow_table_find_refresh(odph_flow_table_t tbl, const void *key, uint64_t *value)
+{
+	uint32_t bkt;
+	uint16_t sig;
+
+	key_hash(tbl, key, &bkt, &sig);
+
+	return table_find(tbl, key, bkt, sig, value, 1);
+}
+
+int odph_flow_table_find_multi(odph_flow_table_t tbl, const void *const key[], uint64_t value[],
+			       int num)
+{
+	uint32_t bkt[FIND_BURST];
+	uint16_t sig[FIND_BURST];
+	uint32_t cnt, idx, match_1, match_2;
+	int n, found = 0;
+
+	for (int i = 0; i < num; i += n) {
+		const void *const *k = &key[i];
+		uint64_t *v = &value[i];
+		int miss = 0;
+
+		n = ODPH_MIN(num - i, FIND_BURST);
+
+		for (int j = 0; j < n; j++) {
+			key_hash(tbl, k[j], &bkt[j], &sig[j]);
+			odp_prefetch(bucket_ptr(tbl, bkt[j]));
+			odp_prefetch(bucket_ptr(tbl, alt_bucket(tbl, bkt[j], sig[j])));
+		}
+
+		cnt = odp_atomic_load_acq_u32(&tbl->change_cnt);
+
+		/* Compare signatures and prefetch the first candidate entry */
+		for (int j = 0; j < n; j++) {
+			bucket_t *b_1 = bucket_ptr(tbl, bkt[j]);
+			bucket_t *b_2 = bucket_ptr(tbl, alt_bucket(tbl, bkt[j], sig[j]));
+
+			match_1 = sig_match(b_1, sig[j]);
+			match_2 = sig_match(b_2, sig[j]);
+
+			if (match_1)
+				idx = odp_atomic_load_u32(&b_1->idx[__builtin_ctz(match_1)]);
+			else if (match_2)
+				idx = odp_atomic_load_u32(&b_2->idx[__builtin_ctz(match_2)]);
+			else
+				continue;
+
+			if (idx != EMPTY)
+				odp_prefetch(entry_ptr(tbl, idx));
+		}
+
+		for (int j = 0; j < n; j++) {
+			flow_entry_t *e;
+
+			e = bucket_find(tbl, bucket_ptr(tbl, bkt[j]), sig[j], k[j], &v[j]);
+
+			if (e == NULL)
+				e = bucket_find(tbl, bucket_ptr(tbl, alt_bucket(tbl, bkt[j], sig[j])),
+						sig[j], k[j], &v[j]);
+
+			if (odp_likely(e != NULL)) {
+				found++;
+			} else {
+				v[j] = ODPH_FLOW_TABLE_VALUE_INVALID;
+				miss = 1;
+			}
+		}
+
+		if (odp_likely(!miss))
+			continue;
+
+		/* Search again keys that were missed during a move */
+		odp_mb_acquire();
+
+		if (odp_likely(cnt == odp_atomic_load_u32(&tbl->change_cnt)))
+			continue;
+
+		for (int j = 0; j < n; j++) {
+			if (v[j] == ODPH_FLOW_TABLE_VALUE_INVALID &&
+			    table_find(tbl, k[j], bkt[j], sig[j], &v[j], 0) == 0)
+				found++;
+		}
+	}
+
+	return found;
+}
+
+int odph_flow_table_age(odph_flow_table_t tbl)
+{
+	uint32_t now = table_time();
+	int removed = 0;
+
+	odp_atomic_store_u32(&tbl->time, now);
+
+	if (tbl->aging_time == 0)
+		return 0;
+
+	lock(tbl);
+
+	for (uint64_t i = 0; i <= tbl->bucket_mask; i++) {
+		bucket_t *b = bucket_ptr(tbl, i);
+
+		for (int j = 0; j < BUCKET_SIZE; j++) {
+			uint32_t idx = odp_atomic_load_u32(&b->idx[j]);
+
+			if (idx == EMPTY ||
+			    now - odp_atomic_load_u32(&entry_ptr(tbl, idx)->time) <= tbl->aging_time)
+				continue;
+
+			odp_atomic_store_rel_u32(&b->idx[j], EMPTY);
+			entry_free(tbl, idx);
+			removed++;
+		}
+	}
+
+	unlock(tbl);
+
+	return removed;
+}
+
+void odph_flow_table_print(odph_flow_table_t tbl)
+{
+	printf("\nFlow table info\n");
+	printf("---------------\n");
+	printf("  name         %s\n", tbl->name);
+	printf("  key size     %" PRIu32 "\n", tbl->key_size);
+	printf("  entries      %" PRIu32 "/%" PRIu32 "\n", tbl->num_used, tbl->num_entries);
+	printf("  buckets      %" PRIu32 "\n", tbl->bucket_mask + 1);
+	printf("  aging        %" PRIu32 " ms\n", tbl->aging_time);
+	printf("  writers      %s\n", tbl->single_writer ? "single" : "multiple");
+	printf("  memory       %" PRIu64 " kB\n", tbl->size / 1024);
+	printf("\n");
+}
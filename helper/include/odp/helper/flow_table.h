@@ -0,0 +1,253 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+/**
+ * @file
+ *
+ * ODP helper flow tables
+ */
+
+#ifndef ODPH_FLOW_TABLE_H_
+#define ODPH_FLOW_TABLE_H_
+
+#include <odp_api.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup odph_flow_table ODPH FLOW TABLE
+ * Concurrent exact match tables for per-flow state
+ *
+ * @details
+ * A flow table maps fixed size keys (e.g. packet 5-tuples or MAC addresses)
+ * to 64-bit values. Keys are hashed with odp_hash_crc32c() into two candidate
+ * buckets of eight entries (bucketized cuckoo hashing). A bucket stores a
+ * 16-bit signature of each key, so that a lookup compares full keys only for
+ * the entries with a matching signature.
+ *
+ * Tables are stored in shared memory, which is reserved by
+ * odph_flow_table_create(). All ODP threads, including those of other
+ * processes forked after table creation, may use the same table.
+ *
+ * Lookups do not take locks and run concurrently with updates. An update may
+ * move other keys to their alternative buckets. A lookup that overlaps with a
+ * move repeats the search, so it never misses a key that is in the table. By
+ * default, updates are serialized by a table lock. When only one thread
+ * updates the table, the lock can be disabled with
+ * odph_flow_table_param_t::single_writer. An entry released by a delete is
+ * reused only after all other free entries. A lookup that reads an entry,
+ * which is released and reused meanwhile, ignores the entry.
+ *
+ * Optionally, entries that have not been refreshed or added within the
+ * aging time are removed by odph_flow_table_age(). Only
+ * odph_flow_table_find_refresh() refreshes entries, other lookups do not.
+ * For example, a switch refreshes the source address of a frame, but not
+ * the destination address. Applications typically call
+ * odph_flow_table_age() periodically, for example on ODP timer timeouts.
+ *
+ * @{
+ */
+
+/** Flow table handle */
+typedef struct odph_flow_table_s *odph_flow_table_t;
+
+/** Invalid flow table handle */
+#define ODPH_FLOW_TABLE_INVALID NULL
+
+/** Maximum length of flow table name including the null character */
+#define ODPH_FLOW_TABLE_NAME_LEN 32
+
+/** Maximum key size in bytes */
+#define ODPH_FLOW_TABLE_MAX_KEY_SIZE 64
+
+/** Value of keys that are not found */
+#define ODPH_FLOW_TABLE_VALUE_INVALID UINT64_MAX
+
+/** Flow table parameters */
+typedef struct {
+	/** Key size in bytes (1 ... ODPH_FLOW_TABLE_MAX_KEY_SIZE). Default is 16. */
+	uint32_t key_size;
+
+	/**
+	 * Maximum number of entries
+	 *
+	 * The table may fail to add a key before it is full, when both buckets
+	 * of the key and the alternative buckets of their keys are full. This
+	 * happens rarely below 90% load. Default is 1024.
+	 */
+	uint32_t num_entries;
+
+	/**
+	 * Only one thread at a time updates the table
+	 *
+	 * When true, the application guarantees that add, delete and aging
+	 * calls are not made concurrently, and the table does not take a lock
+	 * on updates. Lookups may still run concurrently with the updates.
+	 * Default is false.
+	 */
+	odp_bool_t single_writer;
+
+	/**
+	 * Aging time in nanoseconds
+	 *
+	 * When non-zero, odph_flow_table_age() removes entries that have not
+	 * been refreshed or added within the aging time. The value is rounded
+	 * to milliseconds. Default is 0 (aging disabled).
+	 */
+	uint64_t aging_ns;
+
+} odph_flow_table_param_t;
+
+/**
+ * Initialize flow table parameters
+ *
+ * Initialize an odph_flow_table_param_t to its default values for all fields.
+ *
+ * @param[out] param   Pointer to parameter structure
+ */
+void odph_flow_table_param_init(odph_flow_table_param_t *param);
+
+/**
+ * Create a flow table
+ *
+ * Reserves a shared memory block with the table name and initializes an
+ * empty table into it.
+ *
+ * @param name    Table name, and name of the shared memory block
+ * @param param   Table parameters
+ *
+ * @return Flow table handle
+ * @retval ODPH_FLOW_TABLE_INVALID on failure
+ */
+odph_flow_table_t odph_flow_table_create(const char *name, const odph_flow_table_param_t *param);
+
+/**
+ * Find a flow table by name
+ *
+ * @param name    Table name
+ *
+ * @return Flow table handle
+ * @retval ODPH_FLOW_TABLE_INVALID if table was not found
+ */
+odph_flow_table_t odph_flow_table_lookup(const char *name);
+
+/**
+ * Destroy a flow table
+ *
+ * Frees the shared memory of the table. No other thread may use the table
+ * during or after the call.
+ *
+ * @param tbl     Flow table handle
+ *
+ * @retval 0 on success
+ * @retval <0 on failure
+ */
+int odph_flow_table_destroy(odph_flow_table_t tbl);
+
+/**
+ * Add a key
+ *
+ * Adds a key with a value into the table. If the key is already in the table,
+ * its value is replaced.
+ *
+ * @param tbl     Flow table handle
+ * @param key     Pointer to key of 'key_size' bytes
+ * @param value   Value of the key. Must not be ODPH_FLOW_TABLE_VALUE_INVALID.
+ *
+ * @retval 0 on success
+ * @retval <0 on failure. Table is full.
+ */
+int odph_flow_table_add(odph_flow_table_t tbl, const void *key, uint64_t value);
+
+/**
+ * Delete a key
+ *
+ * @param tbl     Flow table handle
+ * @param key     Pointer to key of 'key_size' bytes
+ *
+ * @retval 0 on success
+ * @retval <0 on failure. Key was not found.
+ */
+int odph_flow_table_del(odph_flow_table_t tbl, const void *key);
+
+/**
+ * Find the value of a key
+ *
+ * Does not refresh the entry age.
+ *
+ * @param      tbl     Flow table handle
+ * @param      key     Pointer to key of 'key_size' bytes
+ * @param[out] value   Value of the key
+ *
+ * @retval 0 on success
+ * @retval <0 if the key was not found. 'value' is not modified.
+ */
+int odph_flow_table_find(odph_flow_table_t tbl, const void *key, uint64_t *value);
+
+/**
+ * Find the value of a key and refresh its age
+ *
+ * Like odph_flow_table_find(), but also refreshes the entry, so that
+ * odph_flow_table_age() does not remove it within the aging time.
+ *
+ * @param      tbl     Flow table handle
+ * @param      key     Pointer to key of 'key_size' bytes
+ * @param[out] value   Value of the key
+ *
+ * @retval 0 on success
+ * @retval <0 if the key was not found. 'value' is not modified.
+ */
+int odph_flow_table_find_refresh(odph_flow_table_t tbl, const void *key, uint64_t *value);
+
+/**
+ * Find the values of multiple keys
+ *
+ * Looks up all keys in one pass. Buckets of all keys are prefetched before
+ * the first one is read, and entries with a matching signature are prefetched
+ * before keys are compared. This hides memory latency better than multiple
+ * odph_flow_table_find() calls. Does not refresh the entry ages.
+ *
+ * @param      tbl     Flow table handle
+ * @param      key     Pointers to keys of 'key_size' bytes
+ * @param[out] value   Value of each key, or ODPH_FLOW_TABLE_VALUE_INVALID
+ *                     when the key was not found
+ * @param      num     Number of keys
+ *
+ * @return Number of keys found
+ */
+int odph_flow_table_find_multi(odph_flow_table_t tbl, const void *const key[], uint64_t value[],
+			       int num);
+
+/**
+ * Remove aged entries
+ *
+ * Advances the table time to the current ODP global time and removes all
+ * entries that have not been refreshed or added within the aging time. Time
+ * of an entry is updated to the table time, so the aging resolution is the
+ * interval between calls. The call scans the entire table.
+ *
+ * @param tbl     Flow table handle
+ *
+ * @return Number of removed entries
+ */
+int odph_flow_table_age(odph_flow_table_t tbl);
+
+/**
+ * Print flow table information
+ *
+ * @param tbl     Flow table handle
+ */
+void odph_flow_table_print(odph_flow_table_t tbl);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,281 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+/**
+ * @file
+ *
+ * ODP helper longest prefix match tables
+ */
+
+#ifndef ODPH_LPM_H_
+#define ODPH_LPM_H_
+
+#include <odp_api.h>
+#include <odp/helper/ip.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup odph_lpm ODPH LPM
+ * Longest prefix match tables for IPv4 and IPv6 routing
+ *
+ * @details
+ * An LPM table maps IP address prefixes (routes) to 32-bit next hop values.
+ * The first 24 address bits index a table with one entry per /24 prefix.
+ * Longer prefixes are resolved through groups of 256 entries, one address
+ * byte at a time (DIR-24-8). An IPv4 lookup reads at most two entries and an
+ * IPv6 lookup at most 14 entries.
+ *
+ * Tables are stored in shared memory, which is reserved by odph_lpm_create().
+ * All ODP threads, including those of other processes forked after table
+ * creation, may do lookups in the same table.
+ *
+ * Routes are added and deleted under a table lock, so only one thread updates
+ * a table at a time. Lookups do not take the lock and run concurrently with
+ * updates. A concurrent lookup returns either the old or the new next hop of
+ * the addresses that an update changes. A group of 256 entries that becomes
+ * unused is reused only after all other free groups. A lookup that reads a
+ * group retries, if any group was allocated during the lookup, so it never
+ * returns a next hop from a group that was released and reused meanwhile.
+ *
+ * @{
+ */
+
+/** LPM table handle */
+typedef struct odph_lpm_s *odph_lpm_t;
+
+/** Invalid LPM table handle */
+#define ODPH_LPM_INVALID NULL
+
+/** Maximum length of LPM table name including the null character */
+#define ODPH_LPM_NAME_LEN 32
+
+/** Maximum next hop value */
+#define ODPH_LPM_MAX_NEXT_HOP 0x3fffff
+
+/** Next hop value of addresses without a matching route */
+#define ODPH_LPM_NEXT_HOP_INVALID UINT32_MAX
+
+/** LPM table address type */
+typedef enum {
+	/** IPv4 addresses, prefix length 0 ... 32 */
+	ODPH_LPM_IPV4 = 0,
+
+	/** IPv6 addresses, prefix length 0 ... 128 */
+	ODPH_LPM_IPV6
+
+} odph_lpm_type_t;
+
+/** LPM table parameters */
+typedef struct {
+	/** Address type. Default is ODPH_LPM_IPV4. */
+	odph_lpm_type_t type;
+
+	/** Maximum number of routes. Default is 1024. */
+	uint32_t max_routes;
+
+	/**
+	 * Number of 256 entry groups for prefixes longer than 24 bits
+	 *
+	 * An IPv4 route longer than /24 needs one group, unless it shares the
+	 * group with other routes of the same /24 prefix. An IPv6 route needs
+	 * up to (prefix length - 17) / 8 groups. Each group uses 1 kB of
+	 * memory. Default is 256.
+	 */
+	uint32_t num_groups;
+
+} odph_lpm_param_t;
+
+/**
+ * Initialize LPM table parameters
+ *
+ * Initialize an odph_lpm_param_t to its default values for all fields.
+ *
+ * @param[out] param   Pointer to parameter structure
+ */
+void odph_lpm_param_init(odph_lpm_param_t *param);
+
+/**
+ * Create an LPM table
+ *
+ * Reserves a shared memory block with the table name and initializes an
+ * empty table into it. The table has a fixed part of 64 MB for the first
+ * 24 address bits, and parts which size depends on 'max_routes' and
+ * 'num_groups'.
+ *
+ * @param name    Table name, and name of the shared memory block
+ * @param param   Table parameters
+ *
+ * @return LPM table handle
+ * @retval ODPH_LPM_INVALID on failure
+ */
+odph_lpm_t odph_lpm_create(const char *name, const odph_lpm_param_t *param);
+
+/**
+ * Find an LPM table by name
+ *
+ * @param name    Table name
+ *
+ * @return LPM table handle
+ * @retval ODPH_LPM_INVALID if table was not found
+ */
+odph_lpm_t odph_lpm_lookup(const char *name);
+
+/**
+ * Destroy an LPM table
+ *
+ * Frees the shared memory of the table. No other thread may use the table
+ * during or after the call.
+ *
+ * @param lpm     LPM table handle
+ *
+ * @retval 0 on success
+ * @retval <0 on failure
+ */
+int odph_lpm_destroy(odph_lpm_t lpm);
+
+/**
+ * Add an IPv4 route
+ *
+ * Adds a route to an IPv4 table. Address bits after the prefix length are
+ * ignored. If the table has a route with the same prefix, its next hop is
+ * replaced.
+ *
+ * @param lpm       LPM table handle
+ * @param ip        IPv4 address in CPU byte order
+ * @param depth     Prefix length (0 ... 32)
+ * @param next_hop  Next hop value (0 ... ODPH_LPM_MAX_NEXT_HOP)
+ *
+ * @retval 0 on success
+ * @retval <0 on failure. Table is full or out of groups, or invalid
+ *            parameters.
+ */
+int odph_lpm_ipv4_add(odph_lpm_t lpm, uint32_t ip, uint8_t depth, uint32_t next_hop);
+
+/**
+ * Delete an IPv4 route
+ *
+ * Deletes the route of the prefix. Addresses of the prefix are routed
+ * according to the next longest matching route in the table.
+ *
+ * @param lpm       LPM table handle
+ * @param ip        IPv4 address in CPU byte order
+ * @param depth     Prefix length (0 ... 32)
+ *
+ * @retval 0 on success
+ * @retval <0 on failure. Route was not found.
+ */
+int odph_lpm_ipv4_del(odph_lpm_t lpm, uint32_t ip, uint8_t depth);
+
+/**
+ * Find the next hop of an IPv4 address
+ *
+ * @param      lpm       LPM table handle
+ * @param      ip        IPv4 address in CPU byte order
+ * @param[out] next_hop  Next hop of the longest matching route
+ *
+ * @retval 0 on success
+ * @retval <0 if no route matches the address. 'next_hop' is not modified.
+ */
+int odph_lpm_ipv4_find(odph_lpm_t lpm, uint32_t ip, uint32_t *next_hop);
+
+/**
+ * Find the next hops of multiple IPv4 addresses
+ *
+ * Looks up all addresses in one pass. Table entries of all addresses are
+ * prefetched before the first one is read, which hides memory latency better
+ * than multiple odph_lpm_ipv4_find() calls.
+ *
+ * @param      lpm       LPM table handle
+ * @param      ip        IPv4 addresses in CPU byte order
+ * @param[out] next_hop  Next hop of each address, or
+ *                       ODPH_LPM_NEXT_HOP_INVALID when no route matches
+ * @param      num       Number of addresses
+ *
+ * @return Number of addresses with a matching route
+ */
+int odph_lpm_ipv4_find_multi(odph_lpm_t lpm, const uint32_t ip[], uint32_t next_hop[], int num);
+
+/**
+ * Add an IPv6 route
+ *
+ * Adds a route to an IPv6 table. Address bits after the prefix length are
+ * ignored. If the table has a route with the same prefix, its next hop is
+ * replaced.
+ *
+ * @param lpm       LPM table handle
+ * @param ip        IPv6 address in network byte order
+ * @param depth     Prefix length (0 ... 128)
+ * @param next_hop  Next hop value (0 ... ODPH_LPM_MAX_NEXT_HOP)
+ *
+ * @retval 0 on success
+ * @retval <0 on failure. Table is full or out of groups, or invalid
+ *            parameters.
+ */
+int odph_lpm_ipv6_add(odph_lpm_t lpm, const uint8_t ip[ODPH_IPV6ADDR_LEN], uint8_t depth,
+		      uint32_t next_hop);
+
+/**
+ * Delete an IPv6 route
+ *
+ * Deletes the route of the prefix. Addresses of the prefix are routed
+ * according to the next longest matching route in the table.
+ *
+ * @param lpm       LPM table handle
+ * @param ip        IPv6 address in network byte order
+ * @param depth     Prefix length (0 ... 128)
+ *
+ * @retval 0 on success
+ * @retval <0 on failure. Route was not found.
+ */
+int odph_lpm_ipv6_del(odph_lpm_t lpm, const uint8_t ip[ODPH_IPV6ADDR_LEN], uint8_t depth);
+
+/**
+ * Find the next hop of an IPv6 address
+ *
+ * @param      lpm       LPM table handle
+ * @param      ip        IPv6 address in network byte order
+ * @param[out] next_hop  Next hop of the longest matching route
+ *
+ * @retval 0 on success
+ * @retval <0 if no route matches the address. 'next_hop' is not modified.
+ */
+int odph_lpm_ipv6_find(odph_lpm_t lpm, const uint8_t ip[ODPH_IPV6ADDR_LEN],
+		       uint32_t *next_hop);
+
+/**
+ * Find the next hops of multiple IPv6 addresses
+ *
+ * Looks up all addresses in one pass, one address byte at a time, and
+ * prefetches the next table entry of each address before reading it.
+ *
+ * @param      lpm       LPM table handle
+ * @param      ip        IPv6 addresses in network byte order
+ * @param[out] next_hop  Next hop of each address, or
+ *                       ODPH_LPM_NEXT_HOP_INVALID when no route matches
+ * @param      num       Number of addresses
+ *
+ * @return Number of addresses with a matching route
+ */
+int odph_lpm_ipv6_find_multi(odph_lpm_t lpm, const uint8_t ip[][ODPH_IPV6ADDR_LEN],
+			     uint32_t next_hop[], int num);
+
+/**
+ * Print LPM table information
+ *
+ * @param lpm     LPM table handle
+ */
+void odph_lpm_print(odph_lpm_t lpm);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
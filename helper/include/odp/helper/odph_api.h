@@ -20,11 +20,13 @@
 #include <odp/helper/chksum.h>
 #include <odp/helper/debug.h>
 #include <odp/helper/eth.h>
+#include <odp/helper/flow_table.h>
 #include <odp/helper/gtp.h>
 #include <odp/helper/icmp.h>
 #include <odp/helper/igmp.h>
 #include <odp/helper/ip.h>
 #include <odp/helper/ipsec.h>
+#include <odp/helper/lpm.h>
 #include <odp/helper/macros.h>
 #include <odp/helper/stress.h>
 #include <odp/helper/sctp.h>
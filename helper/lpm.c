@@ -0,0 +1,775 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+#include <odp_api.h>
+#include <odp/helper/debug.h>
+#include <odp/helper/lpm.h>
+#include <odp/helper/macros.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Table entry bits. An entry either contains a route (depth and next hop), or
+ * the index of the group that resolves the next address byte. */
+#define ENTRY_VALID       0x80000000u
+#define ENTRY_EXT         0x40000000u
+#define ENTRY_DEPTH_SHIFT 22
+#define ENTRY_DEPTH_MASK  0xffu
+#define ENTRY_VALUE_MASK  0x3fffffu
+
+#define TBL24_BITS   24
+#define TBL24_SIZE   (1u << TBL24_BITS)
+#define GROUP_BITS   8
+#define GROUP_SIZE   (1u << GROUP_BITS)
+
+#define MAX_ADDR_LEN ODPH_IPV6ADDR_LEN
+#define MAX_LEVELS   (1 + (MAX_ADDR_LEN * 8 - TBL24_BITS) / GROUP_BITS)
+
+/* Number of addresses looked up per round in find_multi functions */
+#define FIND_BURST   32
+
+typedef struct {
+	uint8_t  addr[MAX_ADDR_LEN];
+	uint32_t next_hop;
+	uint8_t  depth;
+	uint8_t  used;
+
+} lpm_route_t;
+
+typedef struct odph_lpm_s {
+	odp_shm_t shm;
+
+	/* Serializes route add and delete */
+	odp_spinlock_t lock;
+
+	char name[ODPH_LPM_NAME_LEN];
+	odph_lpm_type_t type;
+	uint32_t addr_len;
+	uint32_t max_depth;
+	uint32_t max_routes;
+	uint32_t num_routes;
+	uint32_t route_mask;
+	uint32_t num_groups;
+
+	/* Free groups are allocated from the head and returned to the tail of
+	 * a FIFO, so that a released group is reused as late as possible. */
+	uint32_t free_head;
+	uint32_t free_tail;
+
+	/* Incremented before a group is allocated. A lookup that reads groups
+	 * retries, if the counter changed during the lookup, since a group it
+	 * read may have been released and reused for another prefix. */
+	odp_atomic_u32_t group_gen;
+
+	/* Offsets from the table start, which are valid in all processes */
+	uint64_t group_offset;
+	uint64_t free_offset;
+	uint64_t route_offset;
+	uint64_t size;
+
+	odp_atomic_u32_t tbl24[] ODP_ALIGNED_CACHE;
+
+} lpm_t;
+
+static inline odp_atomic_u32_t *group_ptr(lpm_t *lpm, uint32_t group)
+{
+	odp_atomic_u32_t *tbl8 = (odp_atomic_u32_t *)((uint8_t *)lpm + lpm->group_offset);
+
+	return &tbl8[(uint64_t)group * GROUP_SIZE];
+}
+
+static inline uint32_t *free_fifo(lpm_t *lpm)
+{
+	return (uint32_t *)((uint8_t *)lpm + lpm->free_offset);
+}
+
+static inline lpm_route_t *route_tbl(lpm_t *lpm)
+{
+	return (lpm_route_t *)((uint8_t *)lpm + lpm->route_offset);
+}
+
+static inline uint32_t entry_route(uint32_t depth, uint32_t next_hop)
+{
+	return ENTRY_VALID | (depth << ENTRY_DEPTH_SHIFT) | next_hop;
+}
+
+static inline uint32_t entry_depth(uint32_t entry)
+{
+	return (entry >> ENTRY_DEPTH_SHIFT) & ENTRY_DEPTH_MASK;
+}
+
+/* Table index of an address on a level. Level 0 is indexed with the first
+ * three address bytes and the following levels with one byte each. */
+static inline uint32_t addr_index(const uint8_t addr[], uint32_t level)
+{
+	if (level == 0)
+		return ((uint32_t)addr[0] << 16) | ((uint32_t)addr[1] << 8) | addr[2];
+
+	return addr[2 + level];
+}
+
+static void addr_mask(uint8_t dst[], const uint8_t src[], uint32_t len, uint32_t depth)
+{
+	memset(dst, 0, MAX_ADDR_LEN);
+
+	for (uint32_t i = 0; i < len && depth; i++) {
+		if (depth >= 8) {
+			dst[i] = src[i];
+			depth -= 8;
+		} else {
+			dst[i] = src[i] & (uint8_t)(0xff << (8 - depth));
+			depth = 0;
+		}
+	}
+}
+
+static void ipv4_to_addr(uint8_t addr[], uint32_t ip)
+{
+	addr[0] = ip >> 24;
+	addr[1] = ip >> 16;
+	addr[2] = ip >> 8;
+	addr[3] = ip;
+}
+
+static inline uint32_t route_hash(lpm_t *lpm, const uint8_t addr[], uint32_t depth)
+{
+	return odp_hash_crc32c(addr, lpm->addr_len, depth) & lpm->route_mask;
+}
+
+static lpm_route_t *route_find(lpm_t *lpm, const uint8_t addr[], uint32_t depth)
+{
+	lpm_route_t *route = route_tbl(lpm);
+	uint32_t i = route_hash(lpm, addr, depth);
+
+	while (route[i].used) {
+		if (route[i].depth == depth && memcmp(route[i].addr, addr, lpm->addr_len) == 0)
+			return &route[i];
+
+		i = (i + 1) & lpm->route_mask;
+	}
+
+	return NULL;
+}
+
+static lpm_route_t *route_insert(lpm_t *lpm, const uint8_t addr[], uint32_t depth)
+{
+	lpm_route_t *route = route_tbl(lpm);
+	uint32_t i = route_hash(lpm, addr, depth);
+
+	while (route[i].used)
+		i = (i + 1) & lpm->route_mask;
+
+	memcpy(route[i].addr, addr, MAX_ADDR_LEN);
+	route[i].depth = depth;
+	route[i].used = 1;
+	lpm->num_routes++;
+
+	return &route[i];
+}
+
+/* Remove a route and shift following routes of the probe sequence backwards,
+ * so that lookups do not need deletion markers. */
+static void route_remove(lpm_t *lpm, lpm_route_t *removed)
+{
+	lpm_route_t *route = route_tbl(lpm);
+	uint32_t mask = lpm->route_mask;
+	uint32_t i = removed - route;
+	uint32_t j = i;
+	uint32_t home;
+
+	while (1) {
+		j = (j + 1) & mask;
+
+		if (!route[j].used)
+			break;
+
+		home = route_hash(lpm, route[j].addr, route[j].depth);
+
+		/* Route stays if its home slot is cyclically in (i, j] */
+		if (((j - home) & mask) < ((j - i) & mask))
+			continue;
+
+		route[i] = route[j];
+		i = j;
+	}
+
+	route[i].used = 0;
+	lpm->num_routes--;
+}
+
+static inline uint32_t groups_free(lpm_t *lpm)
+{
+	return lpm->free_tail - lpm->free_head;
+}
+
+static uint32_t group_alloc(lpm_t *lpm)
+{
+	uint32_t group = free_fifo(lpm)[lpm->free_head % lpm->num_groups];
+
+	lpm->free_head++;
+
+	/* Counter update is visible to lookups before the new group content */
+	odp_atomic_inc_u32(&lpm->group_gen);
+	odp_mb_release();
+
+	return group;
+}
+
+static void group_free(lpm_t *lpm, uint32_t group)
+{
+	free_fifo(lpm)[lpm->free_tail % lpm->num_groups] = group;
+	lpm->free_tail++;
+}
+
+/* Number of new groups needed for a route */
+static uint32_t groups_needed(lpm_t *lpm, const uint8_t addr[], uint32_t depth)
+{
+	uint32_t end_bit = TBL24_BITS;
+	uint32_t level = 0;
+	uint32_t e = odp_atomic_load_u32(&lpm->tbl24[addr_index(addr, 0)]);
+
+	while (depth > end_bit) {
+		if (!(e & ENTRY_EXT))
+			return ODPH_DIV_ROUNDUP(depth - end_bit, GROUP_BITS);
+
+		level++;
+		e = odp_atomic_load_u32(&group_ptr(lpm, e & ENTRY_VALUE_MASK)[addr_index(addr,
+											level)]);
+		end_bit += GROUP_BITS;
+	}
+
+	return 0;
+}
+
+/* Set route into an entry, unless the entry has a longer route already */
+static void entry_set(lpm_t *lpm, odp_atomic_u32_t *entry, uint32_t depth, uint32_t new)
+{
+	uint32_t e = odp_atomic_load_u32(entry);
+
+	if (e & ENTRY_EXT) {
+		odp_atomic_u32_t *group = group_ptr(lpm, e & ENTRY_VALUE_MASK);
+
+		for (uint32_t i = 0; i < GROUP_SIZE; i++)
+			entry_set(lpm, &group[i], depth, new);
+
+		return;
+	}
+
+	if (!(e & ENTRY_VALID) || entry_depth(e) <= depth)
+		odp_atomic_store_rel_u32(entry, new);
+}
+
+static void route_install(lpm_t *lpm, const uint8_t addr[], uint32_t depth, uint32_t next_hop)
+{
+	odp_atomic_u32_t *tbl = lpm->tbl24;
+	odp_atomic_u32_t *entry;
+	uint32_t level = 0;
+	uint32_t end_bit = TBL24_BITS;
+	uint32_t new = entry_route(depth, next_hop);
+	uint32_t e, first, num;
+
+	while (depth > end_bit) {
+		entry = &tbl[addr_index(addr, level)];
+		e = odp_atomic_load_u32(entry);
+
+		if (!(e & ENTRY_EXT)) {
+			uint32_t group = group_alloc(lpm);
+			odp_atomic_u32_t *group_tbl = group_ptr(lpm, group);
+
+			for (uint32_t i = 0; i < GROUP_SIZE; i++)
+				odp_atomic_store_u32(&group_tbl[i], e);
+
+			/* Group content is written before it is linked into the table */
+			e = ENTRY_EXT | group;
+			odp_atomic_store_rel_u32(entry, e);
+		}
+
+		tbl = group_ptr(lpm, e & ENTRY_VALUE_MASK);
+		level++;
+		end_bit += GROUP_BITS;
+	}
+
+	first = addr_index(addr, level);
+	num = 1u << (end_bit - depth);
+
+	for (uint32_t i = 0; i < num; i++)
+		entry_set(lpm, &tbl[first + i], depth, new);
+}
+
+/* Link group content directly into the parent entry, when all group entries
+ * contain the same route that covers the whole group (or no route). */
+static void group_collapse(lpm_t *lpm, odp_atomic_u32_t *entry, uint32_t end_bit)
+{
+	uint32_t e = odp_atomic_load_u32(entry);
+	uint32_t group = e & ENTRY_VALUE_MASK;
+	odp_atomic_u32_t *group_tbl = group_ptr(lpm, group);
+	uint32_t first = odp_atomic_load_u32(&group_tbl[0]);
+
+	if (first & ENTRY_EXT)
+		return;
+
+	if ((first & ENTRY_VALID) && entry_depth(first) > end_bit)
+		return;
+
+	for (uint32_t i = 1; i < GROUP_SIZE; i++)
+		if (odp_atomic_load_u32(&group_tbl[i]) != first)
+			return;
+
+	odp_atomic_store_rel_u32(entry, first);
+	group_free(lpm, group);
+}
+
+/* Replace route of 'depth' in an entry */
+static void entry_replace(lpm_t *lpm, odp_atomic_u32_t *entry, uint32_t depth, uint32_t new,
+			  uint32_t end_bit)
+{
+	uint32_t e = odp_atomic_load_u32(entry);
+
+	if (e & ENTRY_EXT) {
+		odp_atomic_u32_t *group = group_ptr(lpm, e & ENTRY_VALUE_MASK);
+
+		for (uint32_t i = 0; i < GROUP_SIZE; i++)
+			entry_replace(lpm, &group[i], depth, new, end_bit + GROUP_BITS);
+
+		group_collapse(lpm, entry, end_bit);
+		return;
+	}
+
+	if ((e & ENTRY_VALID) && entry_depth(e) == depth)
+		odp_atomic_store_rel_u32(entry, new);
+}
+
+static void route_uninstall(lpm_t *lpm, const uint8_t addr[], uint32_t depth, uint32_t new)
+{
+	odp_atomic_u32_t *path[MAX_LEVELS];
+	uint32_t path_bit[MAX_LEVELS];
+	odp_atomic_u32_t *tbl = lpm->tbl24;
+	uint32_t level = 0;
+	uint32_t end_bit = TBL24_BITS;
+	uint32_t e, first, num;
+
+	while (depth > end_bit) {
+		path[level] = &tbl[addr_index(addr, level)];
+		path_bit[level] = end_bit;
+		e = odp_atomic_load_u32(path[level]);
+
+		/* Groups on the path of a route are not collapsed */
+		if (odp_unlikely(!(e & ENTRY_EXT))) {
+			ODPH_ERR("LPM table %s: route group missing\n", lpm->name);
+			return;
+		}
+
+		tbl = group_ptr(lpm, e & ENTRY_VALUE_MASK);
+		level++;
+		end_bit += GROUP_BITS;
+	}
+
+	first = addr_index(addr, level);
+	num = 1u << (end_bit - depth);
+
+	for (uint32_t i = 0; i < num; i++)
+		entry_replace(lpm, &tbl[first + i], depth, new, end_bit);
+
+	while (level--)
+		group_collapse(lpm, path[level], path_bit[level]);
+}
+
+static int lpm_add(lpm_t *lpm, const uint8_t ip[], uint32_t depth, uint32_t next_hop)
+{
+	uint8_t addr[MAX_ADDR_LEN];
+	lpm_route_t *route;
+
+	if (depth > lpm->max_depth || next_hop > ODPH_LPM_MAX_NEXT_HOP) {
+		ODPH_ERR("LPM table %s: bad route (depth %" PRIu32 ", next hop %" PRIu32 ")\n",
+			 lpm->name, depth, next_hop);
+		return -1;
+	}
+
+	addr_mask(addr, ip, lpm->addr_len, depth);
+
+	odp_spinlock_lock(&lpm->lock);
+
+	route = route_find(lpm, addr, depth);
+
+	if (route == NULL) {
+		if (lpm->num_routes == lpm->max_routes ||
+		    groups_needed(lpm, addr, depth) > groups_free(lpm)) {
+			odp_spinlock_unlock(&lpm->lock);
+			return -1;
+		}
+
+		route = route_insert(lpm, addr, depth);
+	} else if (route->next_hop == next_hop) {
+		odp_spinlock_unlock(&lpm->lock);
+		return 0;
+	}
+
+	route->next_hop = next_hop;
+	route_install(lpm, addr, depth, next_hop);
+
+	odp_spinlock_unlock(&lpm->lock);
+
+	return 0;
+}
+
+static int lpm_del(lpm_t *lpm, const uint8_t ip[], uint32_t depth)
+{
+	uint8_t addr[MAX_ADDR_LEN];
+	uint8_t parent[MAX_ADDR_LEN];
+	lpm_route_t *route;
+	uint32_t new = 0;
+
+	if (depth > lpm->max_depth)
+		return -1;
+
+	addr_mask(addr, ip, lpm->addr_len, depth);
+
+	odp_spinlock_lock(&lpm->lock);
+
+	route = route_find(lpm, addr, depth);
+
+	if (route == NULL) {
+		odp_spinlock_unlock(&lpm->lock);
+		return -1;
+	}
+
+	route_remove(lpm, route);
+
+	/* Addresses of the prefix fall back to the next longest matching route */
+	for (uint32_t d = depth; d-- > 0;) {
+		addr_mask(parent, addr, lpm->addr_len, d);
+		route = route_find(lpm, parent, d);
+
+		if (route) {
+			new = entry_route(d, route->next_hop);
+			break;
+		}
+	}
+
+	route_uninstall(lpm, addr, depth, new);
+
+	odp_spinlock_unlock(&lpm->lock);
+
+	return 0;
+}
+
+void odph_lpm_param_init(odph_lpm_param_t *param)
+{
+	memset(param, 0, sizeof(odph_lpm_param_t));
+
+	param->type = ODPH_LPM_IPV4;
+	param->max_routes = 1024;
+	param->num_groups = 256;
+}
+
+odph_lpm_t odph_lpm_create(const char *name, const odph_lpm_param_t *param)
+{
+	odp_shm_t shm;
+	lpm_t *lpm;
+	uint64_t size, group_offset, free_offset, route_offset;
+	uint32_t route_size = 2;
+
+	if (name == NULL || strlen(name) >= ODPH_LPM_NAME_LEN) {
+		ODPH_ERR("Bad LPM table name\n");
+		return ODPH_LPM_INVALID;
+	}
+
+	if (param->type != ODPH_LPM_IPV4 && param->type != ODPH_LPM_IPV6) {
+		ODPH_ERR("Bad LPM table type: %i\n", param->type);
+		return ODPH_LPM_INVALID;
+	}
+
+	if (param->max_routes == 0 || param->max_routes > UINT32_MAX / 4) {
+		ODPH_ERR("Bad number of routes: %" PRIu32 "\n", param->max_routes);
+		return ODPH_LPM_INVALID;
+	}
+
+	if (param->num_groups > ENTRY_VALUE_MASK + 1) {
+		ODPH_ERR("Too many groups: %" PRIu32 " (max %u)\n", param->num_groups,
+			 ENTRY_VALUE_MASK + 1);
+		return ODPH_LPM_INVALID;
+	}
+
+	/* Route hash table is at most half full */
+	while (route_size < 2 * param->max_routes)
+		route_size *= 2;
+
+	group_offset = ODPH_ROUNDUP_MULTIPLE(sizeof(lpm_t) +
+					     (uint64_t)TBL24_SIZE * sizeof(odp_atomic_u32_t),
+					     ODP_CACHE_LINE_SIZE);
+	free_offset = group_offset +
+		      (uint64_t)param->num_groups * GROUP_SIZE * sizeof(odp_atomic_u32_t);
+	route_offset = ODPH_ROUNDUP_MULTIPLE(free_offset + param->num_groups * sizeof(uint32_t),
+					     ODP_CACHE_LINE_SIZE);
+	size = route_offset + (uint64_t)route_size * sizeof(lpm_route_t);
+
+	shm = odp_shm_reserve(name, size, ODP_CACHE_LINE_SIZE, 0);
+
+	if (shm == ODP_SHM_INVALID) {
+		ODPH_ERR("Shm reserve failed: %s (%" PRIu64 " bytes)\n", name, size);
+		return ODPH_LPM_INVALID;
+	}
+
+	lpm = odp_shm_addr(shm);
+	memset(lpm, 0, size);
+
+	lpm->shm = shm;
+	odp_spinlock_init(&lpm->lock);
+	strcpy(lpm->name, name);
+	lpm->type = param->type;
+	lpm->addr_len = param->type == ODPH_LPM_IPV4 ? ODPH_IPV4ADDR_LEN : ODPH_IPV6ADDR_LEN;
+	lpm->max_depth = lpm->addr_len * 8;
+	lpm->max_routes = param->max_routes;
+	lpm->route_mask = route_size - 1;
+	lpm->num_groups = param->num_groups;
+	lpm->group_offset = group_offset;
+	lpm->free_offset = free_offset;
+	lpm->route_offset = route_offset;
+	lpm->size = size;
+
+	for (uint32_t i = 0; i < param->num_groups; i++)
+		free_fifo(lpm)[i] = i;
+
+	lpm->free_head = 0;
+	lpm->free_tail = param->num_groups;
+	odp_atomic_init_u32(&lpm->group_gen, 0);
+
+	return lpm;
+}
+
+odph_lpm_t odph_lpm_lookup(const char *name)
+{
+	odp_shm_t shm = odp_shm_lookup(name);
+
+	if (shm == ODP_SHM_INVALID)
+		return ODPH_LPM_INVALID;
+
+	return odp_shm_addr(shm);
+}
+
+int odph_lpm_destroy(odph_lpm_t lpm)
+{
+	if (odp_shm_free(lpm->shm)) {
+		ODPH_ERR("Shm free failed: %s\n", lpm->name);
+		return -1;
+	}
+
+	return 0;
+}
+
+int odph_lpm_ipv4_add(odph_lpm_t lpm, uint32_t ip, uint8_t depth, uint32_t next_hop)
+{
+	uint8_t addr[ODPH_IPV4ADDR_LEN];
+
+	ipv4_to_addr(addr, ip);
+
+	return lpm_add(lpm, addr, depth, next_hop);
+}
+
+int odph_lpm_ipv4_del(odph_lpm_t lpm, uint32_t ip, uint8_t depth)
+{
+	uint8_t addr[ODPH_IPV4ADDR_LEN];
+
+	ipv4_to_addr(addr, ip);
+
+	return lpm_del(lpm, addr, depth);
+}
+
+/* Check if a group was allocated after reading 'gen'. Called after all table
+ * entries of a lookup have been read with acquire loads. */
+static inline int group_gen_changed(lpm_t *lpm, uint32_t gen)
+{
+	return odp_atomic_load_u32(&lpm->group_gen) != gen;
+}
+
+int odph_lpm_ipv4_find(odph_lpm_t lpm, uint32_t ip, uint32_t *next_hop)
+{
+	uint32_t gen, e;
+
+	do {
+		gen = odp_atomic_load_acq_u32(&lpm->group_gen);
+		e = odp_atomic_load_acq_u32(&lpm->tbl24[ip >> 8]);
+
+		if (odp_likely(!(e & ENTRY_EXT)))
+			break;
+
+		e = odp_atomic_load_acq_u32(&group_ptr(lpm, e & ENTRY_VALUE_MASK)[ip & 0xff]);
+	} while (odp_unlikely(group_gen_changed(lpm, gen)));
+
+	if (odp_unlikely(!(e & ENTRY_VALID)))
+		return -1;
+
+	*next_hop = e & ENTRY_VALUE_MASK;
+	return 0;
+}
+
+int odph_lpm_ipv4_find_multi(odph_lpm_t lpm, const uint32_t ip[], uint32_t next_hop[], int num)
+{
+	uint32_t entry[FIND_BURST];
+	uint32_t e, gen;
+	int n, ext, num_found, found = 0;
+
+	for (int i = 0; i < num; i += n) {
+		const uint32_t *addr = &ip[i];
+
+		n = ODPH_MIN(num - i, FIND_BURST);
+		ext = 0;
+		num_found = 0;
+		gen = odp_atomic_load_acq_u32(&lpm->group_gen);
+
+		for (int j = 0; j < n; j++)
+			odp_prefetch(&lpm->tbl24[addr[j] >> 8]);
+
+		for (int j = 0; j < n; j++) {
+			e = odp_atomic_load_acq_u32(&lpm->tbl24[addr[j] >> 8]);
+
+			if (odp_unlikely(e & ENTRY_EXT)) {
+				odp_prefetch(&group_ptr(lpm, e & ENTRY_VALUE_MASK)[addr[j] & 0xff]);
+				ext = 1;
+			}
+
+			entry[j] = e;
+		}
+
+		for (int j = 0; j < n; j++) {
+			e = entry[j];
+
+			if (odp_unlikely(e & ENTRY_EXT))
+				e = odp_atomic_load_acq_u32(&group_ptr(lpm, e & ENTRY_VALUE_MASK)
+							    [addr[j] & 0xff]);
+
+			if (odp_likely(e & ENTRY_VALID)) {
+				next_hop[i + j] = e & ENTRY_VALUE_MASK;
+				num_found++;
+			} else {
+				next_hop[i + j] = ODPH_LPM_NEXT_HOP_INVALID;
+			}
+		}
+
+		/* Repeat the burst */
+		if (odp_unlikely(ext && group_gen_changed(lpm, gen))) {
+			n = 0;
+			continue;
+		}
+
+		found += num_found;
+	}
+
+	return found;
+}
+
+int odph_lpm_ipv6_add(odph_lpm_t lpm, const uint8_t ip[ODPH_IPV6ADDR_LEN], uint8_t depth,
+		      uint32_t next_hop)
+{
+	return lpm_add(lpm, ip, depth, next_hop);
+}
+
+int odph_lpm_ipv6_del(odph_lpm_t lpm, const uint8_t ip[ODPH_IPV6ADDR_LEN], uint8_t depth)
+{
+	return lpm_del(lpm, ip, depth);
+}
+
+int odph_lpm_ipv6_find(odph_lpm_t lpm, const uint8_t ip[ODPH_IPV6ADDR_LEN], uint32_t *next_hop)
+{
+	uint32_t gen, e, byte;
+
+	do {
+		gen = odp_atomic_load_acq_u32(&lpm->group_gen);
+		e = odp_atomic_load_acq_u32(&lpm->tbl24[addr_index(ip, 0)]);
+
+		if (odp_likely(!(e & ENTRY_EXT)))
+			break;
+
+		byte = 3;
+		while (e & ENTRY_EXT)
+			e = odp_atomic_load_acq_u32(&group_ptr(lpm, e & ENTRY_VALUE_MASK)
+						    [ip[byte++]]);
+	} while (odp_unlikely(group_gen_changed(lpm, gen)));
+
+	if (odp_unlikely(!(e & ENTRY_VALID)))
+		return -1;
+
+	*next_hop = e & ENTRY_VALUE_MASK;
+	return 0;
+}
+
+int odph_lpm_ipv6_find_multi(odph_lpm_t lpm, const uint8_t ip[][ODPH_IPV6ADDR_LEN],
+			     uint32_t next_hop[], int num)
+{
+	uint32_t entry[FIND_BURST];
+	uint32_t gen;
+	int n, ext, num_found, found = 0;
+
+	for (int i = 0; i < num; i += n) {
+		const uint8_t (*addr)[ODPH_IPV6ADDR_LEN] = &ip[i];
+		uint32_t byte;
+
+		n = ODPH_MIN(num - i, FIND_BURST);
+		num_found = 0;
+		gen = odp_atomic_load_acq_u32(&lpm->group_gen);
+
+		for (int j = 0; j < n; j++)
+			odp_prefetch(&lpm->tbl24[addr_index(addr[j], 0)]);
+
+		for (int j = 0; j < n; j++)
+			entry[j] = odp_atomic_load_acq_u32(&lpm->tbl24[addr_index(addr[j], 0)]);
+
+		/* Resolve one address byte of all addresses at a time */
+		for (byte = 3; byte < ODPH_IPV6ADDR_LEN; byte++) {
+			ext = 0;
+
+			for (int j = 0; j < n; j++) {
+				if (entry[j] & ENTRY_EXT) {
+					odp_prefetch(&group_ptr(lpm, entry[j] & ENTRY_VALUE_MASK)
+						     [addr[j][byte]]);
+					ext = 1;
+				}
+			}
+
+			if (odp_likely(!ext))
+				break;
+
+			for (int j = 0; j < n; j++) {
+				if (entry[j] & ENTRY_EXT)
+					entry[j] = odp_atomic_load_acq_u32(&group_ptr(lpm, entry[j] &
+										      ENTRY_VALUE_MASK)
+									   [addr[j][byte]]);
+			}
+		}
+
+		for (int j = 0; j < n; j++) {
+			if (odp_likely(entry[j] & ENTRY_VALID)) {
+				next_hop[i + j] = entry[j] & ENTRY_VALUE_MASK;
+				num_found++;
+			} else {
+				next_hop[i + j] = ODPH_LPM_NEXT_HOP_INVALID;
+			}
+		}
+
+		/* Repeat the burst, if groups were read */
+		if (odp_unlikely(byte > 3 && group_gen_changed(lpm, gen))) {
+			n = 0;
+			continue;
+		}
+
+		found += num_found;
+	}
+
+	return found;
+}
+
+void odph_lpm_print(odph_lpm_t lpm)
+{
+	printf("\nLPM table info\n");
+	printf("--------------\n");
+	printf("  name         %s\n", lpm->name);
+	printf("  type         %s\n", lpm->type == ODPH_LPM_IPV4 ? "IPv4" : "IPv6");
+	printf("  routes       %" PRIu32 "/%" PRIu32 "\n", lpm->num_routes, lpm->max_routes);
+	printf("  groups       %" PRIu32 "/%" PRIu32 "\n", lpm->num_groups - groups_free(lpm),
+	       lpm->num_groups);
+	printf("  memory       %" PRIu64 " kB\n", lpm->size / 1024);
+	printf("\n");
+}
@@ -0,0 +1,251 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+#include <odp_api.h>
+#include <odp/helper/odph_api.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM_KEYS 1000
+#define BURST    64
+
+typedef struct {
+	uint32_t src_ip;
+	uint32_t dst_ip;
+	uint16_t src_port;
+	uint16_t dst_port;
+	uint8_t  proto;
+	uint8_t  pad[3];
+} tuple_t;
+
+static tuple_t make_key(uint32_t i)
+{
+	tuple_t key;
+
+	memset(&key, 0, sizeof(key));
+	key.src_ip = 0x0a000000 + i;
+	key.dst_ip = 0xc0a80000 + (i % 7);
+	key.src_port = i;
+	key.dst_port = 80;
+	key.proto = 6;
+
+	return key;
+}
+
+static odph_flow_table_t create_table(uint32_t num_entries, uint64_t aging_ns)
+{
+	odph_flow_table_param_t param;
+	odph_flow_table_t tbl;
+
+	odph_flow_table_param_init(&param);
+	param.key_size = sizeof(tuple_t);
+	param.num_entries = num_entries;
+	param.aging_ns = aging_ns;
+
+	tbl = odph_flow_table_create("odph_flow_table_test", &param);
+
+	if (tbl == ODPH_FLOW_TABLE_INVALID)
+		ODPH_ERR("Flow table create failed\n");
+	else if (odph_flow_table_lookup("odph_flow_table_test") != tbl)
+		ODPH_ERR("Flow table lookup failed\n");
+
+	return tbl;
+}
+
+static int test_add_del(void)
+{
+	odph_flow_table_t tbl;
+	tuple_t key;
+	uint64_t value;
+	int ret = 0;
+
+	printf("  add and delete ... ");
+
+	tbl = create_table(NUM_KEYS, 0);
+	if (tbl == ODPH_FLOW_TABLE_INVALID)
+		return 1;
+
+	for (uint32_t i = 0; i < NUM_KEYS; i++) {
+		key = make_key(i);
+		ret += odph_flow_table_add(tbl, &key, i) != 0;
+	}
+
+	/* Table is full */
+	key = make_key(NUM_KEYS);
+	ret += odph_flow_table_add(tbl, &key, NUM_KEYS) == 0;
+	ret += odph_flow_table_find(tbl, &key, &value) == 0;
+
+	for (uint32_t i = 0; i < NUM_KEYS; i++) {
+		key = make_key(i);
+		ret += odph_flow_table_find(tbl, &key, &value) != 0 || value != i;
+	}
+
+	/* Replace values of existing keys */
+	for (uint32_t i = 0; i < NUM_KEYS; i += 2) {
+		key = make_key(i);
+		ret += odph_flow_table_add(tbl, &key, i + NUM_KEYS) != 0;
+	}
+
+	for (uint32_t i = 0; i < NUM_KEYS; i++) {
+		key = make_key(i);
+		ret += odph_flow_table_find(tbl, &key, &value) != 0 ||
+		       value != (i % 2 ? i : i + NUM_KEYS);
+	}
+
+	for (uint32_t i = 0; i < NUM_KEYS; i += 2) {
+		key = make_key(i);
+		ret += odph_flow_table_del(tbl, &key) != 0;
+		ret += odph_flow_table_del(tbl, &key) == 0;
+	}
+
+	for (uint32_t i = 0; i < NUM_KEYS; i++) {
+		key = make_key(i);
+		ret += (odph_flow_table_find(tbl, &key, &value) == 0) != (i % 2);
+	}
+
+	ret += odph_flow_table_add(tbl, &key, ODPH_FLOW_TABLE_VALUE_INVALID) == 0;
+
+	if (odph_flow_table_destroy(tbl))
+		ret++;
+
+	if (ret)
+		printf("%i tests failed\n", ret);
+	else
+		printf("passed\n");
+
+	return ret;
+}
+
+static int test_find_multi(void)
+{
+	odph_flow_table_t tbl;
+	tuple_t key[BURST];
+	const void *key_ptr[BURST];
+	uint64_t value[BURST];
+	int found = 0;
+	int ret = 0;
+
+	printf("  find multi ... ");
+
+	tbl = create_table(NUM_KEYS, 0);
+	if (tbl == ODPH_FLOW_TABLE_INVALID)
+		return 1;
+
+	for (uint32_t i = 0; i < BURST; i++) {
+		key[i] = make_key(i);
+		key_ptr[i] = &key[i];
+
+		if (i % 3) {
+			ret += odph_flow_table_add(tbl, &key[i], i) != 0;
+			found++;
+		}
+	}
+
+	ret += odph_flow_table_find_multi(tbl, key_ptr, value, BURST) != found;
+
+	for (uint32_t i = 0; i < BURST; i++)
+		ret += value[i] != (i % 3 ? i : ODPH_FLOW_TABLE_VALUE_INVALID);
+
+	if (odph_flow_table_destroy(tbl))
+		ret++;
+
+	if (ret)
+		printf("%i tests failed\n", ret);
+	else
+		printf("passed\n");
+
+	return ret;
+}
+
+static int test_aging(void)
+{
+	const uint64_t aging_ns = 100 * ODP_TIME_MSEC_IN_NS;
+	odph_flow_table_t tbl;
+	tuple_t key;
+	uint64_t value;
+	int removed = 0;
+	int ret = 0;
+
+	printf("  aging ... ");
+
+	tbl = create_table(NUM_KEYS, aging_ns);
+	if (tbl == ODPH_FLOW_TABLE_INVALID)
+		return 1;
+
+	for (uint32_t i = 0; i < 10; i++) {
+		key = make_key(i);
+		ret += odph_flow_table_add(tbl, &key, i) != 0;
+	}
+
+	/* Keep half of the keys in use, until the others have aged. Lookups
+	 * without refresh do not keep keys in use. */
+	for (int round = 0; round < 6; round++) {
+		odp_time_wait_ns(aging_ns / 4);
+		removed += odph_flow_table_age(tbl);
+
+		for (uint32_t i = 0; i < 10; i++) {
+			key = make_key(i);
+
+			if (i % 2 == 0)
+				ret += odph_flow_table_find_refresh(tbl, &key, &value) != 0;
+			else
+				(void)odph_flow_table_find(tbl, &key, &value);
+		}
+	}
+
+	ret += removed != 5;
+
+	for (uint32_t i = 0; i < 10; i++) {
+		key = make_key(i);
+		ret += (odph_flow_table_find(tbl, &key, &value) == 0) != !(i % 2);
+	}
+
+	if (odph_flow_table_destroy(tbl))
+		ret++;
+
+	if (ret)
+		printf("%i tests failed\n", ret);
+	else
+		printf("passed\n");
+
+	return ret;
+}
+
+int main(int argc ODP_UNUSED, char *argv[] ODP_UNUSED)
+{
+	odp_instance_t instance;
+	int ret = 0;
+
+	if (odp_init_global(&instance, NULL, NULL)) {
+		ODPH_ERR("Global init failed\n");
+		return EXIT_FAILURE;
+	}
+
+	if (odp_init_local(instance, ODP_THREAD_CONTROL)) {
+		ODPH_ERR("Local init failed\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("Running helper flow table tests:\n");
+
+	ret += test_add_del();
+	ret += test_find_multi();
+	ret += test_aging();
+
+	printf("\n");
+
+	if (odp_term_local()) {
+		ODPH_ERR("Local term failed\n");
+		return EXIT_FAILURE;
+	}
+
+	if (odp_term_global(instance)) {
+		ODPH_ERR("Global term failed\n");
+		return EXIT_FAILURE;
+	}
+
+	return ret ? EXIT_FAILURE : EXIT_SUCCESS;
+}
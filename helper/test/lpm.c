@@ -0,0 +1,294 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+#include <odp_api.h>
+#include <odp/helper/odph_api.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define IPV4(a, b, c, d) (((uint32_t)(a) << 24) | ((b) << 16) | ((c) << 8) | (d))
+
+typedef struct {
+	uint32_t ip;
+	uint32_t next_hop;
+} ipv4_check_t;
+
+typedef struct {
+	uint8_t ip[ODPH_IPV6ADDR_LEN];
+	uint32_t next_hop;
+} ipv6_check_t;
+
+static odph_lpm_t create_table(odph_lpm_type_t type, uint32_t num_groups)
+{
+	odph_lpm_param_t param;
+	odph_lpm_t lpm;
+
+	odph_lpm_param_init(&param);
+	param.type = type;
+	param.max_routes = 64;
+	param.num_groups = num_groups;
+
+	lpm = odph_lpm_create("odph_lpm_test", &param);
+
+	if (lpm == ODPH_LPM_INVALID)
+		ODPH_ERR("LPM table create failed\n");
+	else if (odph_lpm_lookup("odph_lpm_test") != lpm)
+		ODPH_ERR("LPM table lookup failed\n");
+
+	return lpm;
+}
+
+static int check_ipv4(odph_lpm_t lpm, const ipv4_check_t check[], int num)
+{
+	uint32_t ip[num];
+	uint32_t next_hop[num];
+	uint32_t nh;
+	int found = 0;
+	int ret = 0;
+
+	for (int i = 0; i < num; i++) {
+		ip[i] = check[i].ip;
+
+		if (check[i].next_hop != ODPH_LPM_NEXT_HOP_INVALID)
+			found++;
+
+		if (odph_lpm_ipv4_find(lpm, check[i].ip, &nh))
+			nh = ODPH_LPM_NEXT_HOP_INVALID;
+
+		if (nh != check[i].next_hop)
+			ret++;
+	}
+
+	if (odph_lpm_ipv4_find_multi(lpm, ip, next_hop, num) != found)
+		ret++;
+
+	for (int i = 0; i < num; i++)
+		if (next_hop[i] != check[i].next_hop)
+			ret++;
+
+	return ret;
+}
+
+static int check_ipv6(odph_lpm_t lpm, const ipv6_check_t check[], int num)
+{
+	uint8_t ip[num][ODPH_IPV6ADDR_LEN];
+	uint32_t next_hop[num];
+	uint32_t nh;
+	int found = 0;
+	int ret = 0;
+
+	for (int i = 0; i < num; i++) {
+		memcpy(ip[i], check[i].ip, ODPH_IPV6ADDR_LEN);
+
+		if (check[i].next_hop != ODPH_LPM_NEXT_HOP_INVALID)
+			found++;
+
+		if (odph_lpm_ipv6_find(lpm, check[i].ip, &nh))
+			nh = ODPH_LPM_NEXT_HOP_INVALID;
+
+		if (nh != check[i].next_hop)
+			ret++;
+	}
+
+	if (odph_lpm_ipv6_find_multi(lpm, (const uint8_t (*)[ODPH_IPV6ADDR_LEN])ip, next_hop,
+				     num) != found)
+		ret++;
+
+	for (int i = 0; i < num; i++)
+		if (next_hop[i] != check[i].next_hop)
+			ret++;
+
+	return ret;
+}
+
+static int test_ipv4(void)
+{
+	odph_lpm_t lpm;
+	int ret = 0;
+
+	printf("  IPv4 routes ... ");
+
+	lpm = create_table(ODPH_LPM_IPV4, 4);
+	if (lpm == ODPH_LPM_INVALID)
+		return 1;
+
+	ret += odph_lpm_ipv4_add(lpm, IPV4(10, 0, 0, 0), 8, 1) != 0;
+	ret += odph_lpm_ipv4_add(lpm, IPV4(10, 1, 0, 0), 16, 2) != 0;
+	ret += odph_lpm_ipv4_add(lpm, IPV4(10, 1, 1, 0), 24, 3) != 0;
+	ret += odph_lpm_ipv4_add(lpm, IPV4(10, 1, 1, 128), 25, 4) != 0;
+	ret += odph_lpm_ipv4_add(lpm, IPV4(10, 1, 1, 200), 32, 5) != 0;
+	/* Host bits are ignored */
+	ret += odph_lpm_ipv4_add(lpm, IPV4(192, 168, 1, 77), 24, 6) != 0;
+
+	const ipv4_check_t check_1[] = {
+		{IPV4(10, 2, 3, 4), 1},
+		{IPV4(10, 1, 2, 3), 2},
+		{IPV4(10, 1, 1, 1), 3},
+		{IPV4(10, 1, 1, 129), 4},
+		{IPV4(10, 1, 1, 200), 5},
+		{IPV4(10, 1, 1, 201), 4},
+		{IPV4(192, 168, 1, 1), 6},
+		{IPV4(192, 168, 2, 1), ODPH_LPM_NEXT_HOP_INVALID},
+		{IPV4(11, 0, 0, 0), ODPH_LPM_NEXT_HOP_INVALID},
+	};
+
+	ret += check_ipv4(lpm, check_1, ODPH_ARRAY_SIZE(check_1));
+
+	/* Replace next hop, delete routes and add a default route */
+	ret += odph_lpm_ipv4_add(lpm, IPV4(10, 1, 1, 128), 25, 7) != 0;
+	ret += odph_lpm_ipv4_del(lpm, IPV4(10, 1, 1, 0), 24) != 0;
+	ret += odph_lpm_ipv4_del(lpm, IPV4(10, 1, 1, 200), 32) != 0;
+	ret += odph_lpm_ipv4_del(lpm, IPV4(10, 1, 1, 200), 32) == 0;
+	ret += odph_lpm_ipv4_add(lpm, 0, 0, 8) != 0;
+
+	const ipv4_check_t check_2[] = {
+		{IPV4(10, 1, 1, 1), 2},
+		{IPV4(10, 1, 1, 129), 7},
+		{IPV4(10, 1, 1, 200), 7},
+		{IPV4(192, 168, 2, 1), 8},
+		{IPV4(11, 0, 0, 0), 8},
+	};
+
+	ret += check_ipv4(lpm, check_2, ODPH_ARRAY_SIZE(check_2));
+
+	if (odph_lpm_destroy(lpm))
+		ret++;
+
+	if (ret)
+		printf("%i tests failed\n", ret);
+	else
+		printf("passed\n");
+
+	return ret;
+}
+
+static int test_ipv6(void)
+{
+	odph_lpm_t lpm;
+	int ret = 0;
+	const uint8_t prefix_32[ODPH_IPV6ADDR_LEN] = {0x20, 0x01, 0x0d, 0xb8};
+	const uint8_t prefix_64[ODPH_IPV6ADDR_LEN] = {0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 1};
+	const uint8_t host[ODPH_IPV6ADDR_LEN] = {0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 1,
+						 0, 0, 0, 0, 0, 0, 0, 0x10};
+	const uint8_t any[ODPH_IPV6ADDR_LEN] = {0};
+
+	printf("  IPv6 routes ... ");
+
+	lpm = create_table(ODPH_LPM_IPV6, 32);
+	if (lpm == ODPH_LPM_INVALID)
+		return 1;
+
+	ret += odph_lpm_ipv6_add(lpm, prefix_32, 32, 1) != 0;
+	ret += odph_lpm_ipv6_add(lpm, prefix_64, 64, 2) != 0;
+	ret += odph_lpm_ipv6_add(lpm, host, 128, 3) != 0;
+
+	const ipv6_check_t check_1[] = {
+		{{0x20, 0x01, 0x0d, 0xb8, 0xff}, 1},
+		{{0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 1, 0xff}, 2},
+		{{0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0x10}, 3},
+		{{0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0x11}, 2},
+		{{0x20, 0x01, 0x0d, 0xb9}, ODPH_LPM_NEXT_HOP_INVALID},
+	};
+
+	ret += check_ipv6(lpm, check_1, ODPH_ARRAY_SIZE(check_1));
+
+	ret += odph_lpm_ipv6_del(lpm, prefix_64, 64) != 0;
+	ret += odph_lpm_ipv6_add(lpm, any, 0, 4) != 0;
+
+	const ipv6_check_t check_2[] = {
+		{{0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 1, 0xff}, 1},
+		{{0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0x10}, 3},
+		{{0x20, 0x01, 0x0d, 0xb9}, 4},
+	};
+
+	ret += check_ipv6(lpm, check_2, ODPH_ARRAY_SIZE(check_2));
+
+	if (odph_lpm_destroy(lpm))
+		ret++;
+
+	if (ret)
+		printf("%i tests failed\n", ret);
+	else
+		printf("passed\n");
+
+	return ret;
+}
+
+/* Deleted routes must release their groups */
+static int test_groups(void)
+{
+	uint8_t ip[ODPH_IPV6ADDR_LEN] = {0x20, 0x01};
+	odph_lpm_t lpm;
+	uint32_t nh;
+	int ret = 0;
+
+	printf("  group reuse ... ");
+
+	/* One /128 route needs 13 groups */
+	lpm = create_table(ODPH_LPM_IPV6, 13);
+	if (lpm == ODPH_LPM_INVALID)
+		return 1;
+
+	for (int i = 0; i < 100; i++) {
+		ip[15] = i;
+
+		ret += odph_lpm_ipv6_add(lpm, ip, 128, i) != 0;
+		ret += odph_lpm_ipv6_find(lpm, ip, &nh) != 0 || nh != (uint32_t)i;
+		ret += odph_lpm_ipv6_del(lpm, ip, 128) != 0;
+		ret += odph_lpm_ipv6_find(lpm, ip, &nh) == 0;
+	}
+
+	/* Second /128 route of another /64 prefix does not fit */
+	ret += odph_lpm_ipv6_add(lpm, ip, 128, 1) != 0;
+	ip[8] = 1;
+	ret += odph_lpm_ipv6_add(lpm, ip, 128, 2) == 0;
+
+	if (odph_lpm_destroy(lpm))
+		ret++;
+
+	if (ret)
+		printf("%i tests failed\n", ret);
+	else
+		printf("passed\n");
+
+	return ret;
+}
+
+int main(int argc ODP_UNUSED, char *argv[] ODP_UNUSED)
+{
+	odp_instance_t instance;
+	int ret = 0;
+
+	if (odp_init_global(&instance, NULL, NULL)) {
+		ODPH_ERR("Global init failed\n");
+		return EXIT_FAILURE;
+	}
+
+	if (odp_init_local(instance, ODP_THREAD_CONTROL)) {
+		ODPH_ERR("Local init failed\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("Running helper LPM tests:\n");
+
+	ret += test_ipv4();
+	ret += test_ipv6();
+	ret += test_groups();
+
+	printf("\n");
+
+	if (odp_term_local()) {
+		ODPH_ERR("Local term failed\n");
+		return EXIT_FAILURE;
+	}
+
+	if (odp_term_global(instance)) {
+		ODPH_ERR("Global term failed\n");
+		return EXIT_FAILURE;
+	}
+
+	return ret ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -213,6 +213,27 @@ int odp_pool_stats_selected(odp_pool_t pool, odp_pool_stats_selected_t *stats,
  */
 int odp_pool_stats_reset(odp_pool_t pool);
 
+/**
+ * Trim thread local pool caches
+ *
+ * Requests all threads to return events from their local caches of the pool back to the pool,
+ * so that those become available to other threads. Events in the calling thread's cache are
+ * returned before the call returns. Other threads return their cached events asynchronously
+ * after the call, while they call ODP functions that allocate, free or schedule events.
+ * Application may use this function e.g. when some threads become idle, to avoid events being
+ * stranded in caches of those threads. Statistics counters cache_available, cache_flush_reqs and
+ * cache_flushed (see odp_pool_stats_t) can be used to monitor the caches.
+ *
+ * Pool cache trim does not affect pool functionality. Threads may store events in their caches
+ * again after the call.
+ *
+ * @param pool    Pool handle
+ *
+ * @retval  0 on success
+ * @retval <0 on failure
+ */
+int odp_pool_cache_trim(odp_pool_t pool);
+
 /**
  * Query capabilities of an external memory pool type
  *
@@ -81,6 +81,12 @@ typedef union odp_pool_stats_opt_t {
 
 		/** See odp_pool_stats_t::thread::cache_available */
 		uint64_t thread_cache_available : 1;
+
+		/** See odp_pool_stats_t::cache_flush_reqs */
+		uint64_t cache_flush_reqs   : 1;
+
+		/** See odp_pool_stats_t::cache_flushed */
+		uint64_t cache_flushed      : 1;
 	} bit;
 
 	/** All bits of the bit field structure
@@ -126,6 +132,16 @@ typedef struct odp_pool_stats_t {
 	/** The number of free operations, which stored events to pool caches. */
 	uint64_t cache_free_ops;
 
+	/** The number of requests to flush a thread local cache
+	 *
+	 *  Threads are requested to return events from their local caches to the pool e.g. when
+	 *  the pool is running out of events, or when application calls odp_pool_cache_trim(). */
+	uint64_t cache_flush_reqs;
+
+	/** The number of events returned from thread local caches to the pool due to flush
+	 *  requests */
+	uint64_t cache_flushed;
+
 	/** Per thread counters */
 	struct {
 		/** First thread identifier to read counters from. Ignored when
@@ -176,6 +192,12 @@ typedef struct odp_pool_stats_selected_t {
 	/** See odp_pool_stats_t::cache_free_ops */
 	uint64_t cache_free_ops;
 
+	/** See odp_pool_stats_t::cache_flush_reqs */
+	uint64_t cache_flush_reqs;
+
+	/** See odp_pool_stats_t::cache_flushed */
+	uint64_t cache_flushed;
+
 } odp_pool_stats_selected_t;
 
 /**
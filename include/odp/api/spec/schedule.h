@@ -583,6 +583,46 @@ void odp_schedule_order_wait(void);
  */
 void odp_schedule_print(void);
 
+/**
+ * Read scheduler statistics
+ *
+ * Read scheduler statistics of a thread, or combined statistics of all threads. Statistics are
+ * collected per thread by the thread itself, and combined on demand when this function is
+ * called. Depending on the implementation, there may be some delay until the latest scheduling
+ * operations of other threads are visible in the statistics.
+ *
+ * Statistics support is indicated by odp_schedule_capability_t::stats.
+ *
+ * @param      thr    Thread identifier (see odp_thread_id()) to read statistics from. When
+ *                    negative, statistics of all threads are combined.
+ * @param[out] stats  Output buffer for statistics
+ *
+ * @retval  0 on success
+ * @retval <0 on failure
+ */
+int odp_schedule_stats(int thr, odp_schedule_stats_t *stats);
+
+/**
+ * Reset scheduler statistics
+ *
+ * Reset statistics of all threads to zero. Scheduling operations that other threads perform
+ * concurrently with the reset may or may not be included in the statistics.
+ *
+ * @retval  0 on success
+ * @retval <0 on failure
+ */
+int odp_schedule_stats_reset(void);
+
+/**
+ * Print scheduler statistics
+ *
+ * Print implementation defined scheduler statistics to the ODP log. Prints per thread
+ * statistics of all threads that have performed scheduling operations, followed by combined
+ * statistics of all threads. The information is intended to be used for debugging and
+ * monitoring.
+ */
+void odp_schedule_stats_print(void);
+
 /**
  * @}
  */
@@ -246,8 +246,78 @@ typedef struct odp_schedule_capability_t {
 	/** Event aggregator capabilities for scheduled queues */
 	odp_event_aggr_capability_t aggr;
 
+	/** Scheduler statistics support
+	 *
+	 *  When supported, per thread scheduler statistics are collected and can be read with
+	 *  odp_schedule_stats(). If not supported, odp_schedule_stats() and
+	 *  odp_schedule_stats_reset() return failure. */
+	odp_support_t stats;
+
 } odp_schedule_capability_t;
 
+/** Number of bins in a scheduler statistics histogram */
+#define ODP_SCHED_STATS_HIST_BINS 64
+
+/**
+ * Scheduler statistics histogram
+ *
+ * Histogram bins have logarithmic widths. Bin 0 counts samples of value zero and bin N (N > 0)
+ * counts samples in the value range [2^(N-1), 2^N - 1]. The last bin counts also all samples
+ * larger than that.
+ */
+typedef struct odp_schedule_stats_hist_t {
+	/** Number of samples */
+	uint64_t num;
+
+	/** Sum of all sample values */
+	uint64_t sum;
+
+	/** Minimum sample value. Zero when there are no samples. */
+	uint64_t min;
+
+	/** Maximum sample value */
+	uint64_t max;
+
+	/** Number of samples per bin */
+	uint64_t bin[ODP_SCHED_STATS_HIST_BINS];
+
+} odp_schedule_stats_hist_t;
+
+/**
+ * Scheduler statistics
+ *
+ * A scheduling round is one scan of the scheduling queues. A single odp_schedule() or
+ * odp_schedule_multi() call may perform multiple rounds while waiting for events.
+ */
+typedef struct odp_schedule_stats_t {
+	/** Number of scheduling rounds */
+	uint64_t rounds;
+
+	/** Number of scheduling rounds that did not return any events (empty polls) */
+	uint64_t empty_rounds;
+
+	/** Number of events returned by the scheduler */
+	uint64_t events;
+
+	/** Scheduling round latency in nanoseconds
+	 *
+	 *  One sample per scheduling round that returned events. */
+	odp_schedule_stats_hist_t latency;
+
+	/** Event queueing delay in nanoseconds
+	 *
+	 *  Time from an event enqueue into a scheduled queue until the scheduler dequeued
+	 *  the event from the queue. One sample per event. Events that the scheduler receives
+	 *  directly from a packet input queue are not included. */
+	odp_schedule_stats_hist_t queue_delay;
+
+	/** Number of events per scheduling round
+	 *
+	 *  One sample per scheduling round that returned events. */
+	odp_schedule_stats_hist_t burst;
+
+} odp_schedule_stats_t;
+
 /**
  * Region specific cache stashing configuration
  *
@@ -120,7 +120,12 @@ typedef union {
 	uint32_t all_flags;
 
 	struct {
-		uint32_t reserved1:      4;
+		uint32_t reserved1:      2;
+
+	/*
+	 * Packet input flags
+	 */
+		uint32_t reass:          2; /* Reassembly status */
 
 	/*
 	 * Init flags
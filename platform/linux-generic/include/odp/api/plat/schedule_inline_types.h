@@ -51,6 +51,9 @@ typedef struct {
 	void (*schedule_order_lock_wait)(uint32_t lock_index);
 	void (*schedule_order_wait)(void);
 	void (*schedule_print)(void);
+	int (*schedule_stats)(int thr, odp_schedule_stats_t *stats);
+	int (*schedule_stats_reset)(void);
+	void (*schedule_stats_print)(void);
 
 } _odp_schedule_api_fn_t;
 
@@ -0,0 +1,58 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+#ifndef ODP_BG_THREAD_INTERNAL_H_
+#define ODP_BG_THREAD_INTERNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <odp/api/atomic.h>
+
+#include <pthread.h>
+#include <stdint.h>
+
+/* Maximum number of threads in a background thread group */
+#define _ODP_BG_THREAD_MAX 64
+
+/* Background thread work function. Called repeatedly until the threads are
+ * stopped. Returns the number of processed work items. Threads back off when
+ * there is no work. */
+typedef uint32_t (*_odp_bg_thread_fn_t)(void *arg, int thr_idx);
+
+typedef struct _odp_bg_thread_grp_t _odp_bg_thread_grp_t;
+
+typedef struct {
+	_odp_bg_thread_grp_t *grp;
+	pthread_t thread;
+	int idx;
+} _odp_bg_thread_t;
+
+/* Group of internal worker threads (e.g. DMA copy threads). Each thread is an
+ * ODP control thread, and reserves one ODP thread while running. */
+struct _odp_bg_thread_grp_t {
+	_odp_bg_thread_fn_t fn;
+	void *arg;
+	const char *name;
+	uint32_t num;
+	odp_atomic_u32_t exit;
+	odp_atomic_u32_t started;
+	odp_atomic_u32_t failed;
+	_odp_bg_thread_t thr[_ODP_BG_THREAD_MAX];
+};
+
+/* Start 'num' threads that call 'fn' until stopped. Returns 0 when all threads
+ * have joined ODP, or -1 on failure (e.g. no free ODP threads left). */
+int _odp_bg_thread_grp_start(_odp_bg_thread_grp_t *grp, uint32_t num, const char *name,
+			     _odp_bg_thread_fn_t fn, void *arg);
+
+/* Stop and join all threads of the group */
+void _odp_bg_thread_grp_stop(_odp_bg_thread_grp_t *grp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
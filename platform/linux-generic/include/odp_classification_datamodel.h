@@ -27,6 +27,7 @@ extern "C" {
 #include <odp_queue_if.h>
 
 #include <protocols/ip.h>
+#include <protocols/thash.h>
 
 /* Maximum Class Of Service Entry */
 #define CLS_COS_MAX_ENTRY		64
@@ -196,6 +197,15 @@ typedef struct cls_global_t {
 	_cls_queue_grp_tbl_t queue_grp_tbl;
 	odp_shm_t shm;
 
+	/* Match L3 and L4 PMR terms against inner headers of tunneled packets */
+	uint8_t inner_pmr;
+
+	/* Order flow tuple source and destination before RSS hashing */
+	uint8_t rss_sym;
+
+	/* Toeplitz hash lookup tables of the RSS key */
+	thash_tbl_t rss_tbl ODP_ALIGNED_CACHE;
+
 } cls_global_t;
 
 #ifdef __cplusplus
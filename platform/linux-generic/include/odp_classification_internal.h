@@ -40,6 +40,27 @@ static inline cos_t *_odp_cos_entry_from_idx(uint32_t ndx)
 	return &_odp_cls_global->cos_tbl.cos_entry[ndx];
 }
 
+/*
+ * Software RSS hash of flow tuples
+ *
+ * Tuples are in network byte order: source and destination addresses
+ * followed by source and destination ports (see thash_tuple_sym()). The
+ * configured RSS key is used. Packet input drivers spreading packets into
+ * multiple input queues use this same hash as the classifier.
+ */
+static inline void _odp_cls_rss_hash_multi(const uint8_t *tuple[], const uint32_t len[],
+					   uint32_t hash[], int num)
+{
+	thash_hash_multi(&_odp_cls_global->rss_tbl, tuple, len, hash, num);
+}
+
+/* Order flow tuple source and destination when symmetric RSS is configured */
+static inline void _odp_cls_rss_tuple_sym(uint8_t *tuple, uint32_t addr_len, int ports)
+{
+	if (_odp_cls_global->rss_sym)
+		thash_tuple_sym(tuple, addr_len, ports);
+}
+
 static inline int _odp_cos_queue_idx(const cos_t *cos, odp_queue_t queue)
 {
 	uint32_t i, tbl_idx;
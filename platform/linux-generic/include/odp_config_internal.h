@@ -138,11 +138,11 @@ extern "C" {
 /*
  * Number of shared memory blocks reserved for implementation internal use.
  *
- * Each pool requires three blocks (buffers, ring, user area), 20 blocks
- * are reserved for per ODP module global data and one block per packet I/O is
- * reserved for TX completion usage.
+ * Each pool requires four blocks (buffers, ring, magazine depot, user area), 20 blocks
+ * are reserved for per ODP module global data and two blocks per packet I/O are
+ * reserved for TX completion and IP reassembly usage.
  */
-#define CONFIG_INTERNAL_SHM_BLOCKS ((CONFIG_POOLS * 3) + 20 + CONFIG_PKTIO_ENTRIES)
+#define CONFIG_INTERNAL_SHM_BLOCKS ((CONFIG_POOLS * 4) + 20 + (2 * CONFIG_PKTIO_ENTRIES))
 
 /*
  * Maximum number of shared memory blocks.
@@ -180,6 +180,18 @@ extern "C" {
 /* Enable pool statistics collection */
 #define CONFIG_POOL_STATISTICS 1
 
+/*
+ * Enable scheduler statistics collection
+ *
+ * When enabled, the basic scheduler collects per thread histograms of scheduling round latency,
+ * event queueing delay and burst size (see odp_schedule_stats()). Every enqueue into a scheduled
+ * queue stores a timestamp into the event header, which adds some overhead to the fast path.
+ * Can be enabled at build time with CPPFLAGS=-DCONFIG_SCHED_STATISTICS=1.
+ */
+#ifndef CONFIG_SCHED_STATISTICS
+#define CONFIG_SCHED_STATISTICS 0
+#endif
+
 /*
  * Maximum number of IPsec SAs. The actual maximum number can be further
  * limited by the number of sessions supported by the crypto subsystem and
@@ -187,6 +199,18 @@ extern "C" {
  */
 #define CONFIG_IPSEC_MAX_NUM_SA 4000
 
+/*
+ * Maximum number of IP datagrams under reassembly per packet input interface.
+ * Must be a power of two.
+ */
+#define CONFIG_IP_REASS_MAX_FLOWS 1024
+
+/* Maximum number of fragments per reassembled IP datagram */
+#define CONFIG_IP_REASS_MAX_FRAGS 16
+
+/* Maximum time in nanoseconds that fragments wait for reassembly */
+#define CONFIG_IP_REASS_MAX_WAIT_NS (10 * 1000000000ULL)
+
 /*
  * Use 128-bit atomics for timer implementation (if available)
  *
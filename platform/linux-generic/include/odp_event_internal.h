@@ -17,6 +17,7 @@ extern "C" {
 
 #include <odp/api/debug.h>
 #include <odp/api/event.h>
+#include <odp/api/hints.h>
 #include <odp/api/pool_types.h>
 #include <odp/api/std_types.h>
 
@@ -69,6 +70,11 @@ typedef struct _odp_event_hdr_t {
 	/* Event flow id */
 	uint8_t   flow_id;
 
+#if CONFIG_SCHED_STATISTICS
+	/* Scheduled queue enqueue timestamp in nanoseconds */
+	uint64_t  enq_ts;
+#endif
+
 } _odp_event_hdr_t;
 
 static inline odp_event_t _odp_event_from_hdr(_odp_event_hdr_t *hdr)
@@ -96,6 +102,24 @@ static inline odp_pool_t _odp_event_pool(odp_event_t event)
 	return _odp_event_hdr(event)->pool;
 }
 
+static inline void _odp_event_enq_ts_set(_odp_event_hdr_t *event_hdr[] ODP_UNUSED,
+					 int num ODP_UNUSED, uint64_t ts ODP_UNUSED)
+{
+#if CONFIG_SCHED_STATISTICS
+	for (int i = 0; i < num; i++)
+		event_hdr[i]->enq_ts = ts;
+#endif
+}
+
+static inline uint64_t _odp_event_enq_ts(const _odp_event_hdr_t *event_hdr ODP_UNUSED)
+{
+#if CONFIG_SCHED_STATISTICS
+	return event_hdr->enq_ts;
+#else
+	return 0;
+#endif
+}
+
 #ifdef __cplusplus
 }
 #endif
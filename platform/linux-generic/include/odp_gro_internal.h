@@ -0,0 +1,49 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+/**
+ * @file
+ *
+ * ODP software generic receive offload (GRO)
+ */
+
+#ifndef ODP_GRO_INTERNAL_H_
+#define ODP_GRO_INTERNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <odp/api/packet.h>
+
+#include <stdint.h>
+
+/* GRO configuration */
+typedef struct {
+	/* Enable GRO on packet input queues */
+	uint8_t enable;
+	/* Maximum IP datagram length of a coalesced packet */
+	uint32_t max_len;
+	/* Maximum number of TCP segments coalesced into a packet */
+	uint32_t max_segs;
+
+} _odp_gro_config_t;
+
+/*
+ * Coalesce TCP segments of a received packet burst
+ *
+ * In-order TCP segments of the same flow are concatenated into the first
+ * segment of the flow, which is updated to look like a single large TCP
+ * segment. Packets must have been parsed up to layer 4. The relative order of
+ * packets within a flow is maintained.
+ *
+ * Returns the number of packets remaining in 'pkt'.
+ */
+int _odp_gro_burst(const _odp_gro_config_t *config, odp_packet_t pkt[], int num);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
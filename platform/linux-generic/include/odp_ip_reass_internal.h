@@ -0,0 +1,70 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+/**
+ * @file
+ *
+ * ODP inline IP reassembly
+ */
+
+#ifndef ODP_IP_REASS_INTERNAL_H_
+#define ODP_IP_REASS_INTERNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <odp/api/packet.h>
+#include <odp/api/packet_io.h>
+#include <odp/api/pool.h>
+#include <odp/api/reassembly.h>
+
+#include <stdint.h>
+
+/* Reassembly context of a packet input interface */
+typedef struct ip_reass_t ip_reass_t;
+
+/* Fill in reassembly capability */
+void _odp_ip_reass_capability(odp_reass_capability_t *capa);
+
+/* Create a reassembly context. Incomplete reassembly results are allocated
+ * from the pool. Returns NULL on failure. */
+ip_reass_t *_odp_ip_reass_create(odp_pktio_t pktio, odp_pool_t pool,
+				 const odp_reass_config_t *config);
+
+/* Destroy a reassembly context and free all stored fragments */
+void _odp_ip_reass_destroy(ip_reass_t *reass);
+
+/*
+ * Offer a received packet to reassembly
+ *
+ * Returns the packet that the caller continues to process: the input packet
+ * itself when it is not a fragment of an enabled IP version, a completely
+ * reassembled packet, or a packet with ODP_PACKET_REASS_INCOMPLETE status.
+ * Returns ODP_PACKET_INVALID when the fragment was stored (or dropped).
+ *
+ * 'now_ns' is the current ODP global time in nanoseconds.
+ */
+odp_packet_t _odp_ip_reass_recv(ip_reass_t *reass, odp_packet_t pkt, uint64_t now_ns);
+
+/*
+ * Output reassembly attempts that have timed out
+ *
+ * Outputs up to 'num' packets with ODP_PACKET_REASS_INCOMPLETE status. The
+ * table is scanned only when its sweep interval has passed, so most calls
+ * return immediately.
+ *
+ * Returns the number of packets written into 'pkt'.
+ */
+int _odp_ip_reass_expire(ip_reass_t *reass, odp_packet_t pkt[], int num, uint64_t now_ns);
+
+/* Get fragments of an incomplete reassembly result. Consumes the packet. */
+int _odp_ip_reass_partial_state(odp_packet_t pkt, odp_packet_t frags[],
+				odp_packet_reass_partial_state_t *res);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -96,8 +96,15 @@ int _odp_ipsec_status_send(odp_queue_t queue,
 /* The maximum supported AR window size */
 #define IPSEC_AR_WIN_SIZE_MAX	4096
 
-/* For a 64-bit bucket size */
-#define IPSEC_AR_WIN_BUCKET_BITS	6
+/*
+ * Each 64-bit bucket holds a 32-bit window bitmap in the lower half and the
+ * 32 lower bits of the bucket sequence number (seq >> BUCKET_BITS) in the
+ * upper half. The tag lets buckets be reused lazily, without a separate clear
+ * step when the window top advances. The tag is truncated, so it is only
+ * compared for equality. Whether a bucket with another tag is older or newer is
+ * decided by the window top.
+ */
+#define IPSEC_AR_WIN_BUCKET_BITS	5
 #define IPSEC_AR_WIN_BUCKET_SIZE	(1 << IPSEC_AR_WIN_BUCKET_BITS)
 #define IPSEC_AR_WIN_BITLOC_MASK	(IPSEC_AR_WIN_BUCKET_SIZE - 1)
 
@@ -126,14 +133,11 @@ struct ipsec_sa_s {
 
 		union {
 			struct {
-				/* AR window lock */
-				odp_spinlock_t lock;
-
 				/* AR window top sequence number */
 				odp_atomic_u64_t wintop_seq;
 
-				/* AR window bucket array */
-				uint64_t bucket_arr[IPSEC_AR_WIN_BUCKET_MAX];
+				/* AR window bucket array (tag | bitmap) */
+				odp_atomic_u64_t bucket_arr[IPSEC_AR_WIN_BUCKET_MAX];
 			} in;
 
 			struct {
@@ -221,6 +225,9 @@ struct ipsec_sa_s {
 			odp_ipsec_frag_mode_t frag_mode;
 			odp_atomic_u32_t mtu;
 
+			/* Number of sequence numbers reserved by a thread at a time, or 0 */
+			uint32_t seq_block;
+
 			union {
 			struct {
 				odp_ipsec_ipv4_param_t param;
@@ -325,6 +332,9 @@ uint32_t _odp_ipsec_auth_digest_len(odp_auth_alg_t auth);
 /* Return the maximum number of SAs supported by the implementation */
 uint32_t _odp_ipsec_max_num_sa(void);
 
+/* Print SA table information */
+void _odp_ipsec_sad_print(void);
+
 /*
  * Get SA entry from handle without obtaining a reference
  */
@@ -381,12 +391,34 @@ int _odp_ipsec_sa_replay_update(ipsec_sa_t *ipsec_sa, uint64_t seq,
 uint16_t _odp_ipsec_sa_alloc_ipv4_id(ipsec_sa_t *ipsec_sa);
 
 /**
- * Try inline IPsec processing of provided packet.
+  * Allocate a sequence number for an outgoing packet from the block of
+  * sequence numbers reserved by the calling thread. Used when
+  * ipsec_sa_t::out::seq_block is non-zero.
+  */
+uint64_t _odp_ipsec_sa_alloc_seq_no(ipsec_sa_t *ipsec_sa);
+
+/**
+  * Set the next outbound sequence number of the SA. Drops the sequence
+  * number blocks of all threads.
+  */
+void _odp_ipsec_sa_seq_no_set(ipsec_sa_t *ipsec_sa, uint64_t seq);
+
+/**
+ * Try inline IPsec processing of a burst of received packets.
+ *
+ * Packets are processed together through the same burst pipeline as
+ * odp_ipsec_in_enq(). A processed packet has its IPsec result and SA
+ * destination queue (packet header dst_queue) set, and the caller enqueues
+ * it. Packets for which no SA was found are not processed and continue
+ * normal packet input processing.
+ *
+ * @param[in,out] pkt        Packets
+ * @param[out]    processed  Processing status of each packet
+ * @param         num        Number of packets
  *
- * @retval 0 if packet was processed and will be queue using IPsec inline
- *           processing
+ * @return Number of processed packets
  */
-int _odp_ipsec_try_inline(odp_packet_t *pkt);
+int _odp_ipsec_try_inline_multi(odp_packet_t pkt[], odp_bool_t processed[], int num);
 
 /**
  * Populate number of packets and bytes of data successfully processed by the SA
@@ -49,6 +49,34 @@ ODP_STATIC_ASSERT(sizeof(_odp_packet_flags_t) == sizeof(uint32_t),
 
 ODP_STATIC_ASSERT(PKT_MAX_SEGS < UINT16_MAX, "PACKET_MAX_SEGS_ERROR");
 
+/* Tunnel types recognized by the parser */
+typedef enum {
+	_ODP_TUNNEL_NONE = 0,
+	_ODP_TUNNEL_IPIP,
+	_ODP_TUNNEL_GRE,
+	_ODP_TUNNEL_VXLAN,
+	_ODP_TUNNEL_GENEVE,
+	_ODP_TUNNEL_GTPU,
+	_ODP_TUNNEL_MPLS
+
+} _odp_tunnel_type_t;
+
+/* Tunnel type and inner header flags. Inner L3 offset is valid when type is
+ * not _ODP_TUNNEL_NONE, and inner L4 offset when one of the L4 flags is set. */
+typedef union {
+	uint16_t all;
+
+	struct {
+		uint16_t type : 3;
+		uint16_t ipv4 : 1;
+		uint16_t ipv6 : 1;
+		uint16_t tcp  : 1;
+		uint16_t udp  : 1;
+		uint16_t sctp : 1;
+	};
+
+} _odp_packet_tunnel_t;
+
 /**
  * Packet parser metadata
  */
@@ -67,6 +95,15 @@ typedef struct {
 
 	/* offset to L4 hdr (TCP, UDP, SCTP, also ICMP) */
 	uint16_t l4_offset;
+
+	/* Tunnel type and inner header flags */
+	_odp_packet_tunnel_t tunnel;
+
+	/* offset to inner L3 hdr of a tunneled packet */
+	uint16_t inner_l3_offset;
+
+	/* offset to inner L4 hdr of a tunneled packet */
+	uint16_t inner_l4_offset;
 } packet_parser_t;
 
 /**
@@ -151,6 +188,9 @@ typedef struct ODP_ALIGNED_CACHE odp_packet_hdr_t {
 	/* Pktio where packet is used as a memory source */
 	uint8_t ms_pktio_idx;
 
+	/* Number of fragments of a reassembled packet */
+	uint8_t reass_num_frags;
+
 	union {
 		/* Result for crypto packet op */
 		odp_crypto_packet_result_t crypto_op_result;
@@ -228,6 +268,7 @@ static inline void _odp_packet_reset_md(odp_packet_hdr_t *pkt_hdr)
 	pkt_hdr->p.l2_offset = 0;
 	pkt_hdr->p.l3_offset = ODP_PACKET_OFFSET_INVALID;
 	pkt_hdr->p.l4_offset = ODP_PACKET_OFFSET_INVALID;
+	pkt_hdr->p.tunnel.all = 0;
 
 	if (odp_unlikely(pkt_hdr->event_hdr.subtype != ODP_EVENT_PACKET_BASIC))
 		pkt_hdr->event_hdr.subtype = ODP_EVENT_PACKET_BASIC;
@@ -341,6 +382,9 @@ static inline void _odp_packet_copy_md(odp_packet_hdr_t *dst_hdr,
 	if (src_hdr->p.flags.payload_off)
 		dst_hdr->payload_offset = src_hdr->payload_offset;
 
+	if (src_hdr->p.flags.reass == ODP_PACKET_REASS_COMPLETE)
+		dst_hdr->reass_num_frags = src_hdr->reass_num_frags;
+
 	dst_hdr->p = src_hdr->p;
 
 	if (src_hdr->uarea_addr) {
@@ -436,6 +480,7 @@ static inline void packet_parse_reset(odp_packet_hdr_t *pkt_hdr, int all)
 	pkt_hdr->p.l2_offset        = ODP_PACKET_OFFSET_INVALID;
 	pkt_hdr->p.l3_offset        = ODP_PACKET_OFFSET_INVALID;
 	pkt_hdr->p.l4_offset        = ODP_PACKET_OFFSET_INVALID;
+	pkt_hdr->p.tunnel.all       = 0;
 
 	if (all)
 		pkt_hdr->p.flags.all_flags = 0;
@@ -29,6 +29,7 @@ extern "C" {
 #include <odp_classification_datamodel.h>
 #include <odp_config_internal.h>
 #include <odp_debug_internal.h>
+#include <odp_gro_internal.h>
 #include <odp_macros_internal.h>
 #include <odp_packet_io_stats_common.h>
 #include <odp_queue_if.h>
@@ -155,6 +156,8 @@ typedef struct ODP_ALIGNED_CACHE {
 		odp_queue_t        queue;
 		odp_pktin_queue_t  pktin;
 		odp_pktin_vector_config_t vector;
+		/* Software GRO enabled */
+		uint8_t gro;
 	} in_queue[ODP_PKTIN_MAX_QUEUES];
 
 	struct {
@@ -181,6 +184,8 @@ typedef struct {
 		uint16_t pktin_frame_offset;
 		/* Pool size for potential completion events */
 		uint32_t tx_compl_pool_size;
+		/* Software GRO */
+		_odp_gro_config_t gro;
 	} config;
 
 	pktio_entry_t entries[CONFIG_PKTIO_ENTRIES];
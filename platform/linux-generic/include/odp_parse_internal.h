@@ -49,6 +49,13 @@ extern "C" {
 /* _odp_packet_parse_common() requires up to this many bytes. */
 #define PARSE_BYTES (PARSE_ETH_BYTES + PARSE_L3_L4_BYTES)
 
+/*
+ * Inner headers of tunneled packets are parsed (with ODP_PROTO_LAYER_ALL)
+ * only when they end within this many bytes from the packet start, and within
+ * the contiguous data passed to the parser.
+ */
+#define PARSE_TUNNEL_BYTES 256U
+
 uint16_t _odp_parse_eth(packet_parser_t *prs, const uint8_t **parseptr,
 			uint32_t *offset, uint32_t frame_len);
 
@@ -56,7 +63,8 @@ uint16_t _odp_parse_eth(packet_parser_t *prs, const uint8_t **parseptr,
  * Parse common L3 and L4 packet headers up to given layer
  *
  * See _odp_packet_parse_common(). Requires up to PARSE_L3_L4_BYTES bytes of
- * contiguous packet data.
+ * contiguous packet data. With ODP_PROTO_LAYER_ALL, inner headers of
+ * tunneled packets are parsed from the data available before seg_end.
  *
  * - offset is the offset of the first byte of the data pointed to by parseptr
  * - seg_end is the maximum offset that can be accessed plus one
@@ -111,6 +119,26 @@ static inline int _odp_packet_parse_common(odp_packet_hdr_t *pkt_hdr,
 	return r;
 }
 
+/* Number of packets _odp_packet_parse_multi() processes at a time */
+#define PARSE_MULTI_BURST 16
+
+/**
+ * Parse common packet headers of multiple packets up to given layer
+ *
+ * Results are the same as from calling _odp_packet_parse_common() for each
+ * packet, with frame length and segment length both set to len[i]. Data of
+ * each packet must be contiguous. Common Ethernet / IPv4 and IPv6 TCP and UDP
+ * packets are recognized in groups of PARSE_MULTI_BURST packets and parsed
+ * without protocol dispatch, other packets are parsed one by one. Parse
+ * metadata must be already initialized.
+ *
+ * Writes the result of each packet into ret[]: 0 on success, 1 on packet
+ * errors, and -1 if the packet should be dropped.
+ */
+void _odp_packet_parse_multi(odp_packet_hdr_t *pkt_hdr[], const uint8_t *data[],
+			     const uint32_t len[], int num, int layer,
+			     odp_pktin_config_opt_t opt, int ret[]);
+
 #ifdef __cplusplus
 }
 #endif
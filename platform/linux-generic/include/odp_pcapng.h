@@ -19,6 +19,7 @@ int _odp_pcapng_start(pktio_entry_t *entry);
 void _odp_pcapng_stop(pktio_entry_t *entry);
 int _odp_pcapng_dump_pkts(pktio_entry_t *entry, int qidx,
 			  const odp_packet_t packets[], int num);
+void _odp_pcapng_print(pktio_entry_t *entry);
 
 #ifdef __cplusplus
 }
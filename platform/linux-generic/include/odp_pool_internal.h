@@ -20,6 +20,7 @@ extern "C" {
 #include <odp/api/shared_memory.h>
 #include <odp/api/ticketlock.h>
 #include <odp/api/align.h>
+#include <odp/api/hints.h>
 
 #include <odp_event_internal.h>
 #include <odp_config_internal.h>
@@ -28,14 +29,42 @@ extern "C" {
 
 #define _ODP_POOL_MEM_SRC_DATA_SIZE 128
 
+/* Magazine of cached buffers. Magazines are moved as a whole between thread
+ * local caches and the pool depot. */
+typedef struct pool_mag_t {
+	/* Number of buffers in magazine */
+	uint32_t num;
+	/* Cached buffers */
+	_odp_event_hdr_t *event_hdr[CONFIG_POOL_CACHE_MAX_SIZE / 2];
+
+} pool_mag_t;
+
 typedef struct ODP_ALIGNED_CACHE pool_cache_t {
 	/* Number of buffers in cache */
 	odp_atomic_u32_t cache_num;
-	/* Cached buffers */
-	_odp_event_hdr_t *event_hdr[CONFIG_POOL_CACHE_MAX_SIZE];
+	/* Flush request from another thread */
+	odp_atomic_u32_t flush_req;
+	/* Magazine in use. Previous magazine is either full or empty. */
+	pool_mag_t *loaded;
+	pool_mag_t *prev;
+	/* Magazine misses since the last cache size adaptation */
+	uint16_t alloc_miss;
+	uint16_t free_miss;
+	/* Cache is limited to the loaded magazine */
+	uint8_t one_mag;
+	/* Initial magazines of the thread */
+	pool_mag_t mag[2];
 
 } pool_cache_t;
 
+/* Pool depot: rings of full and empty magazines */
+typedef struct pool_depot_t {
+	ring_ptr_t *full;
+	ring_ptr_t *empty;
+	uint32_t    mask;
+
+} pool_depot_t;
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wpedantic"
 /* Event header ring */
@@ -85,6 +114,10 @@ typedef struct pool_t {
 	uint8_t         *max_addr;
 	uint32_t         ext_head_offset;
 	uint32_t         skipped_blocks;
+	uint32_t         mag_size;
+	pool_depot_t     depot;
+	/* Number of posted local cache flush requests not yet handled */
+	odp_atomic_u32_t flush_pending;
 	odp_pool_param_t params;
 	odp_pool_ext_param_t ext_param;
 
@@ -98,6 +131,8 @@ typedef struct pool_t {
 		odp_atomic_u64_t free_ops;
 		odp_atomic_u64_t cache_alloc_ops;
 		odp_atomic_u64_t cache_free_ops;
+		odp_atomic_u64_t cache_flush_reqs;
+		odp_atomic_u64_t cache_flushed;
 	} stats;
 
 	pool_cache_t     local_cache[ODP_THREAD_COUNT_MAX];
@@ -107,6 +142,7 @@ typedef struct pool_t {
 	odp_shm_t        shm;
 	uint64_t         shm_size;
 	odp_shm_t        ring_shm;
+	odp_shm_t        depot_shm;
 	odp_shm_t        uarea_shm;
 	uint64_t         uarea_shm_size;
 	uint8_t         *uarea_base_addr;
@@ -122,6 +158,9 @@ typedef struct pool_global_t {
 	pool_t    pool[CONFIG_POOLS];
 	odp_shm_t shm;
 
+	/* Per thread flags for pending cache flush requests */
+	odp_atomic_u32_t flush_req[ODP_THREAD_COUNT_MAX] ODP_ALIGNED_CACHE;
+
 	struct {
 		uint32_t pkt_max_len;
 		uint32_t pkt_max_num;
@@ -129,6 +168,8 @@ typedef struct pool_global_t {
 		uint32_t burst_size;
 		uint32_t pkt_base_align;
 		uint32_t buf_min_align;
+		uint8_t  huge_pages;
+		uint8_t  prefault;
 	} config;
 
 } pool_global_t;
@@ -154,6 +195,22 @@ typedef struct _odp_pool_mem_src_ops_t {
 
 extern pool_global_t *_odp_pool_glb;
 
+/* Flush local caches that other threads have requested to be flushed */
+void _odp_pool_cache_flush_req_handle(void);
+
+/* Flush the local cache of the calling thread into the global pool. Used by internal
+ * threads that free events on behalf of other threads. */
+void _odp_pool_cache_flush_local(pool_t *pool);
+
+/* Check cache flush requests of the calling thread. Threads that may be idle
+ * for a long time (e.g. in the scheduler) call this periodically, so that
+ * events in their local caches become available to other threads. */
+static inline void _odp_pool_cache_flush_check(int thr)
+{
+	if (odp_unlikely(odp_atomic_load_u32(&_odp_pool_glb->flush_req[thr])))
+		_odp_pool_cache_flush_req_handle();
+}
+
 static inline pool_t *_odp_pool_entry_from_idx(uint32_t pool_idx)
 {
 	return &_odp_pool_glb->pool[pool_idx];
@@ -23,6 +23,7 @@ extern "C" {
 #include <odp_config_internal.h>
 #include <odp_macros_internal.h>
 #include <odp_ring_mpmc_u32_internal.h>
+#include <odp_ring_mpmc_seq_internal.h>
 #include <odp_ring_st_internal.h>
 #include <odp_ring_spsc_internal.h>
 #include <odp_queue_lf.h>
@@ -33,6 +34,10 @@ extern "C" {
 #define QUEUE_STATUS_NOTSCHED     3
 #define QUEUE_STATUS_SCHED        4
 
+/* Plain queue ring types */
+#define QUEUE_RING_MPMC           0
+#define QUEUE_RING_MPMC_SEQ       1
+
 typedef struct ODP_ALIGNED_CACHE queue_entry_s {
 	/* The first cache line is read only */
 	queue_enq_fn_t       enqueue ODP_ALIGNED_CACHE;
@@ -46,7 +51,10 @@ typedef struct ODP_ALIGNED_CACHE queue_entry_s {
 	odp_queue_type_t     type;
 
 	/* MPMC ring (2 cache lines). */
-	ring_mpmc_u32_t      ring_mpmc;
+	union {
+		ring_mpmc_u32_t      ring_mpmc;
+		ring_mpmc_seq_u32_t  ring_mpmc_seq;
+	};
 
 	odp_ticketlock_t     lock;
 	union {
@@ -69,6 +77,8 @@ typedef struct ODP_ALIGNED_CACHE queue_entry_s {
 typedef struct queue_global_t {
 	queue_entry_t   queue[CONFIG_MAX_QUEUES];
 	uint32_t        *ring_data;
+	/* Ring data space per queue in uint32_t units */
+	uint32_t        ring_data_num;
 	uint32_t        queue_lf_num;
 	uint32_t        queue_lf_size;
 	queue_lf_func_t queue_lf_func;
@@ -78,6 +88,7 @@ typedef struct queue_global_t {
 	struct {
 		uint32_t max_queue_size;
 		uint32_t default_queue_size;
+		uint32_t plain_ring_type;
 	} config;
 
 } queue_global_t;
@@ -108,12 +119,26 @@ static inline queue_entry_t *qentry_from_handle(odp_queue_t handle)
 
 void _odp_queue_spsc_init(queue_entry_t *queue, uint32_t queue_size);
 
+static inline uint32_t *queue_ring_data(queue_entry_t *queue)
+{
+	return &_odp_queue_glb->ring_data[queue->index * (uint64_t)_odp_queue_glb->ring_data_num];
+}
+
 /* Functions for schedulers */
 void _odp_sched_queue_set_status(uint32_t queue_index, int status);
 int _odp_sched_queue_deq(uint32_t queue_index, odp_event_t ev[], int num,
 			 int update_status);
 int _odp_sched_queue_empty(uint32_t queue_index);
 
+/* Number of events in a scheduled queue. Queue is not locked, so the value is
+ * an estimate and may be out of range while other threads modify the queue. */
+static inline uint32_t _odp_sched_queue_len(uint32_t queue_index)
+{
+	queue_entry_t *queue = qentry_from_index(queue_index);
+
+	return ring_st_length(&queue->ring_st);
+}
+
 /* Functions by schedulers */
 int _odp_sched_basic_get_spread(uint32_t queue_index);
 
@@ -0,0 +1,190 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+#ifndef ODP_RING_MPMC_SEQ_INTERNAL_H_
+#define ODP_RING_MPMC_SEQ_INTERNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <odp/api/align.h>
+#include <odp/api/atomic.h>
+#include <odp/api/hints.h>
+
+#include <odp/api/plat/atomic_inlines.h>
+
+#include <stdint.h>
+
+/* Ring of uint32_t data with per slot sequence numbers
+ *
+ * Each ring slot is a 64-bit word, which stores a sequence number in the upper
+ * 32 bits and data in the lower 32 bits. Writers and readers own a range of
+ * slots after a successful CAS on the head counter, and publish each slot
+ * individually by updating its sequence number. There are no tail counters.
+ *
+ * Ring head/tail rings (e.g. ring_mpmc) wait until other threads have
+ * completed their operations before updating a tail counter. If a thread is
+ * preempted between its head and tail updates, all other writers (or readers)
+ * of the ring spin until the thread is scheduled again. This ring never waits
+ * for other threads: a slot that is being written is seen empty by readers and
+ * a slot that is being read is seen full by writers, and the operation returns
+ * less data (or space) than there would otherwise be. Data order is maintained.
+ *
+ * Sequence numbers of a slot at position 'pos':
+ *   pos           Slot is free, the writer of 'pos' may write it
+ *   pos + 1       Slot contains data, the reader of 'pos' may read it
+ *   pos + size    Slot is free for the writer of the next round
+ *
+ * Ring size must be a power of two. Unlike ring_mpmc, all slots are used for
+ * data.
+ */
+
+typedef struct ODP_ALIGNED_CACHE {
+	odp_atomic_u32_t r_head ODP_ALIGNED_CACHE;
+	odp_atomic_u32_t w_head ODP_ALIGNED_CACHE;
+} ring_mpmc_seq_u32_t;
+
+static inline uint64_t _ring_mpmc_seq_slot(uint32_t seq, uint32_t data)
+{
+	return ((uint64_t)seq << 32) | data;
+}
+
+static inline uint32_t _ring_mpmc_seq_of(uint64_t slot)
+{
+	return (uint32_t)(slot >> 32);
+}
+
+/* Initialize ring */
+static inline void ring_mpmc_seq_u32_init(ring_mpmc_seq_u32_t *ring, odp_atomic_u64_t *ring_slot,
+					  uint32_t ring_mask)
+{
+	odp_atomic_init_u32(&ring->r_head, 0);
+	odp_atomic_init_u32(&ring->w_head, 0);
+
+	for (uint32_t i = 0; i <= ring_mask; i++)
+		odp_atomic_init_u64(&ring_slot[i], _ring_mpmc_seq_slot(i, 0));
+}
+
+/* Dequeue data from the ring head */
+static inline uint32_t ring_mpmc_seq_u32_deq_multi(ring_mpmc_seq_u32_t *ring,
+						   odp_atomic_u64_t *ring_slot,
+						   uint32_t ring_mask, uint32_t data[],
+						   uint32_t num)
+{
+	uint32_t head, n, i;
+	uint32_t size = ring_mask + 1;
+	uint64_t slot = 0;
+
+	if (odp_unlikely(num == 0))
+		return 0;
+
+	head = odp_atomic_load_u32(&ring->r_head);
+
+	while (1) {
+		/* Count slots with data. Data is read here, and it remains valid when
+		 * the CAS succeeds, since then no other reader has passed the slots. */
+		for (n = 0; n < num; n++) {
+			slot = odp_atomic_load_acq_u64(&ring_slot[(head + n) & ring_mask]);
+
+			if (_ring_mpmc_seq_of(slot) != head + n + 1)
+				break;
+
+			data[n] = (uint32_t)slot;
+		}
+
+		if (odp_unlikely(n == 0)) {
+			/* Ring is empty or the first slot is being written */
+			if ((int32_t)(_ring_mpmc_seq_of(slot) - (head + 1)) < 0)
+				return 0;
+
+			/* Another reader has consumed the slot */
+			head = odp_atomic_load_u32(&ring->r_head);
+			continue;
+		}
+
+		if (odp_likely(__atomic_compare_exchange_n(&ring->r_head.v, &head, head + n,
+							   0, __ATOMIC_RELAXED,
+							   __ATOMIC_RELAXED)))
+			break;
+	}
+
+	/* Release the slots to writers of the next round */
+	for (i = 0; i < n; i++)
+		odp_atomic_store_rel_u64(&ring_slot[(head + i) & ring_mask],
+					 _ring_mpmc_seq_slot(head + i + size, 0));
+
+	return n;
+}
+
+/* Enqueue multiple data into the ring tail */
+static inline uint32_t ring_mpmc_seq_u32_enq_multi(ring_mpmc_seq_u32_t *ring,
+						   odp_atomic_u64_t *ring_slot,
+						   uint32_t ring_mask, const uint32_t data[],
+						   uint32_t num)
+{
+	uint32_t head, n, i;
+	uint64_t slot = 0;
+
+	if (odp_unlikely(num == 0))
+		return 0;
+
+	head = odp_atomic_load_u32(&ring->w_head);
+
+	while (1) {
+		/* Count free slots */
+		for (n = 0; n < num; n++) {
+			slot = odp_atomic_load_acq_u64(&ring_slot[(head + n) & ring_mask]);
+
+			if (_ring_mpmc_seq_of(slot) != head + n)
+				break;
+		}
+
+		if (odp_unlikely(n == 0)) {
+			/* Ring is full or the first slot is being read */
+			if ((int32_t)(_ring_mpmc_seq_of(slot) - head) < 0)
+				return 0;
+
+			/* Another writer has filled the slot */
+			head = odp_atomic_load_u32(&ring->w_head);
+			continue;
+		}
+
+		if (odp_likely(__atomic_compare_exchange_n(&ring->w_head.v, &head, head + n,
+							   0, __ATOMIC_RELAXED,
+							   __ATOMIC_RELAXED)))
+			break;
+	}
+
+	/* Write data and publish the slots to readers */
+	for (i = 0; i < n; i++)
+		odp_atomic_store_rel_u64(&ring_slot[(head + i) & ring_mask],
+					 _ring_mpmc_seq_slot(head + i + 1, data[i]));
+
+	return n;
+}
+
+/* Check if ring is empty */
+static inline int ring_mpmc_seq_u32_is_empty(ring_mpmc_seq_u32_t *ring)
+{
+	uint32_t head = odp_atomic_load_u32(&ring->r_head);
+	uint32_t tail = odp_atomic_load_u32(&ring->w_head);
+
+	return head == tail;
+}
+
+/* Return current ring length. Includes slots that are being written. */
+static inline uint32_t ring_mpmc_seq_u32_len(ring_mpmc_seq_u32_t *ring)
+{
+	uint32_t head = odp_atomic_load_u32(&ring->r_head);
+	uint32_t tail = odp_atomic_load_u32(&ring->w_head);
+
+	return tail - head;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
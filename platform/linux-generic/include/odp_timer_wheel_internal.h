@@ -16,6 +16,10 @@ typedef uint64_t _odp_timer_wheel_t;
 
 #define _ODP_INT_TIMER_WHEEL_INVALID  0
 
+/* Timer wheel tick is 2^_ODP_INT_TIMER_WHEEL_TICK_SHIFT nanoseconds. Timers
+ * expire with tick resolution. */
+#define _ODP_INT_TIMER_WHEEL_TICK_SHIFT 10
+
 _odp_timer_wheel_t _odp_timer_wheel_create(uint32_t max_concurrent_timers,
 					   void    *tm_system);
 
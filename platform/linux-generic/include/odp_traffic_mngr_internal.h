@@ -33,8 +33,12 @@ extern "C" {
 
 typedef struct stat  file_stat_t;
 
+/* Must be a power of two */
 #define INPUT_WORK_RING_SIZE  (16 * 1024)
 
+/* Maximum number of work items the TM thread processes at a time */
+#define INPUT_WORK_BURST  32
+
 #define TM_QUEUE_MAGIC_NUM   0xBABEBABE
 #define TM_NODE_MAGIC_NUM    0xBEEFBEEF
 
@@ -111,6 +115,9 @@ typedef struct {
 	tm_status_t        status;
 } tm_queue_thresholds_t;
 
+/* Number of WRED drop table entries, covering queue fullness from 0 to 100% */
+#define TM_WRED_TBL_SIZE 512
+
 typedef struct {
 	_odp_int_name_t  name_tbl_id;
 	odp_tm_wred_t    wred_profile;
@@ -122,6 +129,11 @@ typedef struct {
 	odp_bool_t       enable_wred;
 	odp_bool_t       use_byte_fullness;
 	tm_status_t      status;
+	/* Drop thresholds indexed by queue fullness, precomputed from the
+	 * thresholds and drop probabilities above. A pkt is dropped when a
+	 * 16-bit random number is below the threshold, and always when the
+	 * threshold is UINT16_MAX. */
+	uint16_t         drop_thr[TM_WRED_TBL_SIZE];
 } tm_wred_params_t;
 
 typedef struct {
@@ -318,16 +330,20 @@ typedef struct {
 	uint32_t     queue_num;
 } input_work_item_t;
 
+/* Multi-producer, single-consumer ring of work items. Producers (TM enqueue
+ * callers) reserve ring slots by moving w_head, and release written slots in
+ * reservation order by moving w_tail. The TM thread is the only consumer, it
+ * releases read slots by moving r_tail. */
 typedef struct {
-	uint64_t          total_enqueues;
-	uint64_t          enqueue_fail_cnt;
-	uint64_t          total_dequeues;
-	odp_atomic_u64_t  queue_cnt;
+	odp_atomic_u32_t  w_head ODP_ALIGNED_CACHE;
+	odp_atomic_u32_t  w_tail;
+	odp_atomic_u64_t  enqueue_fail_cnt;
+
+	odp_atomic_u32_t  r_tail ODP_ALIGNED_CACHE;
 	uint32_t          peak_cnt;
-	uint32_t          head_idx;
-	uint32_t          tail_idx;
-	odp_ticketlock_t  lock;
-	input_work_item_t work_ring[INPUT_WORK_RING_SIZE];
+	uint64_t          total_dequeues;
+
+	input_work_item_t work_ring[INPUT_WORK_RING_SIZE] ODP_ALIGNED_CACHE;
 } input_work_queue_t;
 
 typedef struct {
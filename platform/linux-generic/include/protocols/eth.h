@@ -103,6 +103,7 @@ ODP_STATIC_ASSERT(sizeof(_odp_vlanhdr_t) == _ODP_VLANHDR_LEN,
 #define _ODP_ETHTYPE_MPLS_MCAST 0x8848 /**< MPLS multicast */
 #define _ODP_ETHTYPE_MACSEC     0x88E5 /**< MAC security IEEE 802.1AE */
 #define _ODP_ETHTYPE_1588       0x88F7 /**< Precision Time Protocol IEEE 1588 */
+#define _ODP_ETHTYPE_TEB        0x6558 /**< Transparent Ethernet Bridging */
 
 /**
  * @}
@@ -19,9 +19,13 @@ extern "C" {
 #include <odp/api/byteorder.h>
 #include <odp/api/debug.h>
 
+#include <odp_debug_internal.h>
+#include <odp_macros_internal.h>
+
 #include <protocols/ip.h>
 
 #include <stdint.h>
+#include <string.h>
 
 /** rss data type */
 typedef union {
@@ -63,41 +67,135 @@ typedef union {
 	thash_ipv6_tuple_t v6;
 } thash_tuple_t;
 
-static inline
-void thash_load_ipv6_addr(const _odp_ipv6hdr_t *ipv6,
-			  thash_tuple_t *tuple)
+/** Order source and destination of a hash tuple
+ *
+ * Tuple data holds source and destination addresses of 'addr_len' bytes each,
+ * optionally followed by source and destination ports. Addresses (and ports
+ * when addresses are equal) are swapped into ascending order, so that both
+ * directions of a flow result in the same hash input.
+ */
+static inline void thash_tuple_sym(uint8_t *data, uint32_t addr_len, int ports)
 {
-	int i;
+	uint8_t *sport = data + 2 * addr_len;
+	uint8_t tmp[16];
+	int cmp = 0;
+
+	if (addr_len) {
+		cmp = memcmp(data, data + addr_len, addr_len);
 
-	for (i = 0; i < 4; i++) {
-		*(tuple->v6.src_addr.u32 + i) =
-		odp_be_to_cpu_32(*(ipv6->src_addr.u32 + i));
+		if (cmp > 0) {
+			memcpy(tmp, data, addr_len);
+			memcpy(data, data + addr_len, addr_len);
+			memcpy(data + addr_len, tmp, addr_len);
+		}
+	}
 
-		*(tuple->v6.dst_addr.u32 + i) =
-		odp_be_to_cpu_32(*(ipv6->dst_addr.u32 + i));
+	if (ports && (cmp > 0 || (cmp == 0 && memcmp(sport, sport + 2, 2) > 0))) {
+		memcpy(tmp, sport, 2);
+		memcpy(sport, sport + 2, 2);
+		memcpy(sport + 2, tmp, 2);
 	}
 }
 
-static inline
-uint32_t thash_softrss(uint32_t *tuple, uint8_t len,
-		       const rss_key key)
+/** Maximum Toeplitz hash input length in bytes (IPv6 addresses and L4 ports) */
+#define THASH_TUPLE_MAX_LEN sizeof(thash_ipv6_tuple_t)
+
+/** Toeplitz hash lookup tables
+ *
+ * Entry 'b' of table 'i' is the XOR of the 32-bit key windows selected by the
+ * set bits of value 'b' at input byte 'i'. Hashing takes one table lookup per
+ * input byte instead of a key shift per input bit.
+ */
+typedef struct thash_tbl {
+	uint32_t tbl[THASH_TUPLE_MAX_LEN][256];
+} thash_tbl_t;
+
+/** Fill in Toeplitz hash lookup tables of a key */
+static inline void thash_tbl_init(thash_tbl_t *tbl, const rss_key *key)
 {
-	uint32_t i, j, ret = 0;
-
-	for (j = 0; j < len; j++) {
-		for (i = 0; i < 32; i++) {
-			if (tuple[j] & (1U << (31 - i))) {
-				ret ^= odp_cpu_to_be_32(((const uint32_t *)
-				key.u32)[j]) << i | (uint32_t)((uint64_t)
-				(odp_cpu_to_be_32(((const uint32_t *)key.u32)
-				[j + 1])) >> (32 - i));
-			}
+	uint32_t i, bit, b;
+	uint32_t win[8];
+
+	for (i = 0; i < THASH_TUPLE_MAX_LEN; i++) {
+		/* 32-bit key window starting at each bit of input byte 'i' */
+		for (bit = 0; bit < 8; bit++) {
+			uint64_t k = ((uint64_t)key->u8[i] << 32) |
+				     ((uint64_t)key->u8[i + 1] << 24) |
+				     ((uint64_t)key->u8[i + 2] << 16) |
+				     ((uint64_t)key->u8[i + 3] << 8) |
+				     (uint64_t)key->u8[i + 4];
+
+			win[bit] = (uint32_t)(k >> (8 - bit));
+		}
+
+		for (b = 0; b < 256; b++) {
+			uint32_t val = 0;
+
+			for (bit = 0; bit < 8; bit++)
+				if (b & (0x80 >> bit))
+					val ^= win[bit];
+
+			tbl->tbl[i][b] = val;
 		}
 	}
+}
 
-	return ret;
+/* Continue Toeplitz hash from input byte 'first' */
+static inline uint32_t thash_hash_from(const thash_tbl_t *tbl, const uint8_t *data,
+				       uint32_t first, uint32_t len, uint32_t hash)
+{
+	uint32_t i;
+
+	_ODP_ASSERT(len <= THASH_TUPLE_MAX_LEN);
+
+	for (i = first; i < len; i++)
+		hash ^= tbl->tbl[i][data[i]];
+
+	return hash;
 }
 
+/** Toeplitz hash of 'len' bytes of data in network byte order */
+static inline uint32_t thash_hash(const thash_tbl_t *tbl, const uint8_t *data,
+				  uint32_t len)
+{
+	return thash_hash_from(tbl, data, 0, len, 0);
+}
+
+/** Toeplitz hash of multiple inputs
+ *
+ * Inputs are processed four at a time, so that the table lookups of different
+ * inputs are independent of each other and can be executed in parallel.
+ */
+static inline void thash_hash_multi(const thash_tbl_t *tbl, const uint8_t *data[],
+				    const uint32_t len[], uint32_t hash[], int num)
+{
+	int n = 0;
+
+	for (; n + 4 <= num; n += 4) {
+		const uint8_t *d0 = data[n], *d1 = data[n + 1];
+		const uint8_t *d2 = data[n + 2], *d3 = data[n + 3];
+		uint32_t h0 = 0, h1 = 0, h2 = 0, h3 = 0;
+		const uint32_t min_01 = _ODP_MIN(len[n], len[n + 1]);
+		const uint32_t min_23 = _ODP_MIN(len[n + 2], len[n + 3]);
+		const uint32_t min_len = _ODP_MIN(min_01, min_23);
+		uint32_t i;
+
+		for (i = 0; i < min_len; i++) {
+			h0 ^= tbl->tbl[i][d0[i]];
+			h1 ^= tbl->tbl[i][d1[i]];
+			h2 ^= tbl->tbl[i][d2[i]];
+			h3 ^= tbl->tbl[i][d3[i]];
+		}
+
+		hash[n] = thash_hash_from(tbl, d0, min_len, len[n], h0);
+		hash[n + 1] = thash_hash_from(tbl, d1, min_len, len[n + 1], h1);
+		hash[n + 2] = thash_hash_from(tbl, d2, min_len, len[n + 2], h2);
+		hash[n + 3] = thash_hash_from(tbl, d3, min_len, len[n + 3], h3);
+	}
+
+	for (; n < num; n++)
+		hash[n] = thash_hash(tbl, data[n], len[n]);
+}
 /**
  * @}
  */
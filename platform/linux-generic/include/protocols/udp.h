@@ -40,6 +40,11 @@ ODP_STATIC_ASSERT(sizeof(_odp_udphdr_t) == _ODP_UDPHDR_LEN,
 
 #define _ODP_UDP_IPSEC_PORT 4500
 
+/* UDP destination ports of tunneling protocols */
+#define _ODP_UDP_GTPU_PORT   2152
+#define _ODP_UDP_VXLAN_PORT  4789
+#define _ODP_UDP_GENEVE_PORT 6081
+
 /**
  * @}
  */
@@ -0,0 +1,118 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+#include <odp_posix_extensions.h>
+
+#include <odp/api/atomic.h>
+#include <odp/api/cpu.h>
+#include <odp/api/init.h>
+#include <odp/api/thread.h>
+
+#include <odp/api/plat/cpu_inlines.h>
+
+#include <odp_bg_thread_internal.h>
+#include <odp_debug_internal.h>
+#include <odp_global_data.h>
+#include <odp_pool_internal.h>
+
+#include <pthread.h>
+#include <stdint.h>
+#include <time.h>
+
+/* Thread polls this many rounds without work before starting to sleep between the rounds */
+#define IDLE_ROUNDS 1000
+#define SLEEP_NS    10000
+
+static void *bg_thread(void *arg)
+{
+	_odp_bg_thread_t *thr = arg;
+	_odp_bg_thread_grp_t *grp = thr->grp;
+	uint32_t idle = 0;
+	int thr_id;
+
+	if (odp_init_local((odp_instance_t)odp_global_ro.main_pid, ODP_THREAD_CONTROL)) {
+		_ODP_ERR("%s thread %i: local init failed\n", grp->name, thr->idx);
+		odp_atomic_inc_u32(&grp->failed);
+		return NULL;
+	}
+
+	odp_atomic_inc_u32(&grp->started);
+	thr_id = odp_thread_id();
+
+	while (odp_atomic_load_acq_u32(&grp->exit) == 0) {
+		/* Events freed into the local pool caches of the thread must become
+		 * available to other threads */
+		_odp_pool_cache_flush_check(thr_id);
+
+		if (grp->fn(grp->arg, thr->idx)) {
+			idle = 0;
+		} else if (idle < IDLE_ROUNDS) {
+			idle++;
+			odp_cpu_pause();
+		} else {
+			struct timespec ts = { .tv_sec = 0, .tv_nsec = SLEEP_NS };
+
+			nanosleep(&ts, NULL);
+		}
+	}
+
+	if (odp_term_local() < 0)
+		_ODP_ERR("%s thread %i: local term failed\n", grp->name, thr->idx);
+
+	return NULL;
+}
+
+static void join_threads(_odp_bg_thread_grp_t *grp, uint32_t num)
+{
+	odp_atomic_store_rel_u32(&grp->exit, 1);
+
+	for (uint32_t i = 0; i < num; i++)
+		pthread_join(grp->thr[i].thread, NULL);
+}
+
+int _odp_bg_thread_grp_start(_odp_bg_thread_grp_t *grp, uint32_t num, const char *name,
+			     _odp_bg_thread_fn_t fn, void *arg)
+{
+	_ODP_ASSERT(num <= _ODP_BG_THREAD_MAX);
+
+	grp->fn = fn;
+	grp->arg = arg;
+	grp->name = name;
+	grp->num = 0;
+	odp_atomic_init_u32(&grp->exit, 0);
+	odp_atomic_init_u32(&grp->started, 0);
+	odp_atomic_init_u32(&grp->failed, 0);
+
+	for (uint32_t i = 0; i < num; i++) {
+		_odp_bg_thread_t *thr = &grp->thr[i];
+
+		thr->grp = grp;
+		thr->idx = i;
+
+		if (pthread_create(&thr->thread, NULL, bg_thread, thr)) {
+			_ODP_ERR("%s thread create failed\n", name);
+			join_threads(grp, i);
+			return -1;
+		}
+	}
+
+	/* Wait until all threads have joined ODP */
+	while (odp_atomic_load_u32(&grp->started) + odp_atomic_load_u32(&grp->failed) < num)
+		odp_cpu_pause();
+
+	if (odp_atomic_load_u32(&grp->failed)) {
+		join_threads(grp, num);
+		return -1;
+	}
+
+	grp->num = num;
+
+	return 0;
+}
+
+void _odp_bg_thread_grp_stop(_odp_bg_thread_grp_t *grp)
+{
+	join_threads(grp, grp->num);
+	grp->num = 0;
+}
@@ -15,6 +15,7 @@
 
 #include <odp_init_internal.h>
 #include <odp_debug_internal.h>
+#include <odp_libconfig_internal.h>
 #include <odp_macros_internal.h>
 #include <odp_packet_internal.h>
 #include <odp_packet_io_internal.h>
@@ -36,6 +37,7 @@
 /* Debug level for per packet classification operations */
 #define CLS_DBG  3
 #define MAX_MARK UINT16_MAX
+#define RSS_KEY_LEN ((int)sizeof(rss_key))
 
 #define LOCK(a)      odp_spinlock_lock(a)
 #define UNLOCK(a)    odp_spinlock_unlock(a)
@@ -47,16 +49,6 @@ static _cls_queue_grp_tbl_t *queue_grp_tbl;
 
 cls_global_t *_odp_cls_global;
 
-static const rss_key default_rss = {
-	.u8 = {
-	0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2,
-	0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0,
-	0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4,
-	0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30, 0xf2, 0x0c,
-	0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa,
-	}
-};
-
 static inline uint32_t _odp_cos_to_ndx(odp_cos_t cos)
 {
 	return _odp_typeval(cos) - 1;
@@ -89,6 +81,78 @@ pmr_t *get_pmr_entry_internal(odp_pmr_t pmr)
 	return &pmr_tbl->pmr[_odp_pmr_to_ndx(pmr)];
 }
 
+/*
+ * Fill in parse metadata of the inner headers of a tunneled packet in the
+ * format of outer header metadata. Only L3 and L4 protocol flags and offsets
+ * are valid.
+ */
+static inline void inner_parser(const packet_parser_t *prs, packet_parser_t *inner)
+{
+	inner->input_flags.all = 0;
+	inner->input_flags.l3 = 1;
+	inner->input_flags.ipv4 = prs->tunnel.ipv4;
+	inner->input_flags.ipv6 = prs->tunnel.ipv6;
+	inner->input_flags.l4 = prs->tunnel.tcp | prs->tunnel.udp | prs->tunnel.sctp;
+	inner->input_flags.tcp = prs->tunnel.tcp;
+	inner->input_flags.udp = prs->tunnel.udp;
+	inner->input_flags.sctp = prs->tunnel.sctp;
+	inner->flags.all_flags = 0;
+	inner->l2_offset = prs->l2_offset;
+	inner->l3_offset = prs->inner_l3_offset;
+	inner->l4_offset = prs->inner_l4_offset;
+	inner->tunnel.all = 0;
+}
+
+static int read_config_file(cls_global_t *cls_glb)
+{
+	const char *str;
+	int val = 0;
+	int key_val[RSS_KEY_LEN];
+	rss_key key;
+
+	_ODP_PRINT("Classifier config:\n");
+
+	str = "classifier.inner_pmr";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	cls_glb->inner_pmr = !!val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "classifier.rss_symmetric";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	cls_glb->rss_sym = !!val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "classifier.rss_key";
+	if (_odp_libconfig_lookup_array(str, key_val, RSS_KEY_LEN) != RSS_KEY_LEN) {
+		_ODP_ERR("Config option '%s' not found or not %i bytes.\n", str, RSS_KEY_LEN);
+		return -1;
+	}
+
+	_ODP_PRINT("  %s[]:", str);
+	for (int i = 0; i < RSS_KEY_LEN; i++) {
+		if (key_val[i] < 0 || key_val[i] > UINT8_MAX) {
+			_ODP_ERR("Bad value for %s: %i\n", str, key_val[i]);
+			return -1;
+		}
+
+		key.u8[i] = key_val[i];
+		_ODP_PRINT(" %02x", key.u8[i]);
+	}
+	_ODP_PRINT("\n\n");
+
+	thash_tbl_init(&cls_glb->rss_tbl, &key);
+
+	return 0;
+}
+
 int _odp_classification_init_global(void)
 {
 	odp_shm_t shm;
@@ -107,6 +171,12 @@ int _odp_classification_init_global(void)
 	pmr_tbl       = &_odp_cls_global->pmr_tbl;
 	queue_grp_tbl = &_odp_cls_global->queue_grp_tbl;
 
+	if (read_config_file(_odp_cls_global)) {
+		odp_shm_free(shm);
+		_odp_cls_global = NULL;
+		return -1;
+	}
+
 	for (i = 0; i < CLS_COS_MAX_ENTRY; i++) {
 		/* init locks */
 		cos_t *cos = get_cos_entry_internal(_odp_cos_from_ndx(i));
@@ -369,13 +439,23 @@ int odp_cls_cos_create_multi(const char *name[], const odp_cls_cos_param_t param
 	return i;
 }
 
-static uint32_t packet_rss_hash(odp_packet_hdr_t *pkt_hdr, odp_cls_hash_proto_t hash_proto,
+static uint32_t packet_rss_hash(const packet_parser_t *prs, odp_cls_hash_proto_t hash_proto,
 				const uint8_t *base);
 
 static inline odp_queue_t get_dest_queue(const cos_t *cos, odp_packet_hdr_t *pkt_hdr,
 					 const uint8_t *base)
 {
-	uint32_t hash = packet_rss_hash(pkt_hdr, cos->hash_proto, base), tbl_index;
+	const packet_parser_t *prs = &pkt_hdr->p;
+	packet_parser_t inner;
+	uint32_t hash, tbl_index;
+
+	/* Spread flows of a tunnel by their inner headers */
+	if (pkt_hdr->p.tunnel.type) {
+		inner_parser(&pkt_hdr->p, &inner);
+		prs = &inner;
+	}
+
+	hash = packet_rss_hash(prs, cos->hash_proto, base);
 
 	/* CLS_COS_QUEUE_MAX is a power of 2 */
 	hash = hash & (CLS_COS_QUEUE_MAX - 1);
@@ -389,7 +469,7 @@ odp_queue_t odp_cls_hash_result(odp_cos_t cos_id, odp_packet_t packet)
 	const cos_t *cos;
 	odp_packet_hdr_t *hdr;
 	uint32_t seg_len, len;
-	uint8_t data[PARSE_BYTES], *base;
+	uint8_t data[PARSE_TUNNEL_BYTES], *base;
 
 	_ODP_ASSERT(cos_id != ODP_COS_INVALID);
 	_ODP_ASSERT(packet != ODP_PACKET_INVALID);
@@ -403,8 +483,9 @@ odp_queue_t odp_cls_hash_result(odp_cos_t cos_id, odp_packet_t packet)
 	seg_len = packet_first_seg_len(hdr);
 	len = packet_len(hdr);
 
-	if (odp_unlikely(seg_len < PARSE_BYTES && len > seg_len)) {
-		if (odp_unlikely(odp_packet_copy_to_mem(packet, 0, _ODP_MIN(len, PARSE_BYTES),
+	if (odp_unlikely(seg_len < PARSE_TUNNEL_BYTES && len > seg_len)) {
+		if (odp_unlikely(odp_packet_copy_to_mem(packet, 0,
+							_ODP_MIN(len, PARSE_TUNNEL_BYTES),
 							data) < 0))
 			return ODP_QUEUE_INVALID;
 
@@ -961,15 +1042,15 @@ static inline int verify_pmr_ipv6_dscp(const _odp_ipv6hdr_t *ipv6, pmr_term_valu
 }
 
 static inline int verify_pmr_ipv4_saddr(const uint8_t *pkt_addr,
-					odp_packet_hdr_t *pkt_hdr,
+					const packet_parser_t *prs,
 					pmr_term_value_t *term_value)
 {
 	const _odp_ipv4hdr_t *ip;
 	uint32_t ipaddr;
 
-	if (!pkt_hdr->p.input_flags.ipv4)
+	if (!prs->input_flags.ipv4)
 		return 0;
-	ip = (const _odp_ipv4hdr_t *)(pkt_addr + pkt_hdr->p.l3_offset);
+	ip = (const _odp_ipv4hdr_t *)(pkt_addr + prs->l3_offset);
 	ipaddr = ip->src_addr;
 	if (term_value->match.value == (ipaddr & term_value->match.mask))
 		return 1;
@@ -978,15 +1059,15 @@ static inline int verify_pmr_ipv4_saddr(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_ipv4_daddr(const uint8_t *pkt_addr,
-					odp_packet_hdr_t *pkt_hdr,
+					const packet_parser_t *prs,
 					pmr_term_value_t *term_value)
 {
 	const _odp_ipv4hdr_t *ip;
 	uint32_t ipaddr;
 
-	if (!pkt_hdr->p.input_flags.ipv4)
+	if (!prs->input_flags.ipv4)
 		return 0;
-	ip = (const _odp_ipv4hdr_t *)(pkt_addr + pkt_hdr->p.l3_offset);
+	ip = (const _odp_ipv4hdr_t *)(pkt_addr + prs->l3_offset);
 	ipaddr = ip->dst_addr;
 	if (term_value->match.value == (ipaddr & term_value->match.mask))
 		return 1;
@@ -995,15 +1076,15 @@ static inline int verify_pmr_ipv4_daddr(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_tcp_sport(const uint8_t *pkt_addr,
-				       odp_packet_hdr_t *pkt_hdr,
+				       const packet_parser_t *prs,
 				       pmr_term_value_t *term_value)
 {
 	uint16_t sport;
 	const _odp_tcphdr_t *tcp;
 
-	if (!pkt_hdr->p.input_flags.tcp)
+	if (!prs->input_flags.tcp)
 		return 0;
-	tcp = (const _odp_tcphdr_t *)(pkt_addr + pkt_hdr->p.l4_offset);
+	tcp = (const _odp_tcphdr_t *)(pkt_addr + prs->l4_offset);
 	sport = tcp->src_port;
 	if (term_value->match.value == (sport & term_value->match.mask))
 		return 1;
@@ -1012,15 +1093,15 @@ static inline int verify_pmr_tcp_sport(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_tcp_dport(const uint8_t *pkt_addr,
-				       odp_packet_hdr_t *pkt_hdr,
+				       const packet_parser_t *prs,
 				       pmr_term_value_t *term_value)
 {
 	uint16_t dport;
 	const _odp_tcphdr_t *tcp;
 
-	if (!pkt_hdr->p.input_flags.tcp)
+	if (!prs->input_flags.tcp)
 		return 0;
-	tcp = (const _odp_tcphdr_t *)(pkt_addr + pkt_hdr->p.l4_offset);
+	tcp = (const _odp_tcphdr_t *)(pkt_addr + prs->l4_offset);
 	dport = tcp->dst_port;
 	if (term_value->match.value == (dport & term_value->match.mask))
 		return 1;
@@ -1029,15 +1110,15 @@ static inline int verify_pmr_tcp_dport(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_udp_dport(const uint8_t *pkt_addr,
-				       odp_packet_hdr_t *pkt_hdr,
+				       const packet_parser_t *prs,
 				       pmr_term_value_t *term_value)
 {
 	uint16_t dport;
 	const _odp_udphdr_t *udp;
 
-	if (!pkt_hdr->p.input_flags.udp)
+	if (!prs->input_flags.udp)
 		return 0;
-	udp = (const _odp_udphdr_t *)(pkt_addr + pkt_hdr->p.l4_offset);
+	udp = (const _odp_udphdr_t *)(pkt_addr + prs->l4_offset);
 	dport = udp->dst_port;
 	if (term_value->match.value == (dport & term_value->match.mask))
 		return 1;
@@ -1046,15 +1127,15 @@ static inline int verify_pmr_udp_dport(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_udp_sport(const uint8_t *pkt_addr,
-				       odp_packet_hdr_t *pkt_hdr,
+				       const packet_parser_t *prs,
 				       pmr_term_value_t *term_value)
 {
 	uint16_t sport;
 	const _odp_udphdr_t *udp;
 
-	if (!pkt_hdr->p.input_flags.udp)
+	if (!prs->input_flags.udp)
 		return 0;
-	udp = (const _odp_udphdr_t *)(pkt_addr + pkt_hdr->p.l4_offset);
+	udp = (const _odp_udphdr_t *)(pkt_addr + prs->l4_offset);
 	sport = udp->src_port;
 	if (term_value->match.value == (sport & term_value->match.mask))
 		return 1;
@@ -1087,16 +1168,16 @@ static inline int verify_pmr_dmac(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_ipv6_saddr(const uint8_t *pkt_addr,
-					odp_packet_hdr_t *pkt_hdr,
+					const packet_parser_t *prs,
 					pmr_term_value_t *term_value)
 {
 	const _odp_ipv6hdr_t *ipv6;
 	uint64_t addr[2];
 
-	if (!packet_hdr_has_ipv6(pkt_hdr))
+	if (!prs->input_flags.ipv6)
 		return 0;
 
-	ipv6 = (const _odp_ipv6hdr_t *)(pkt_addr + pkt_hdr->p.l3_offset);
+	ipv6 = (const _odp_ipv6hdr_t *)(pkt_addr + prs->l3_offset);
 	memcpy(addr, ipv6->src_addr.u64, _ODP_IPV6ADDR_LEN);
 
 	addr[0] = addr[0] & term_value->match.mask_u64[0];
@@ -1110,16 +1191,16 @@ static inline int verify_pmr_ipv6_saddr(const uint8_t *pkt_addr,
 }
 
 static inline int verify_pmr_ipv6_daddr(const uint8_t *pkt_addr,
-					odp_packet_hdr_t *pkt_hdr,
+					const packet_parser_t *prs,
 					pmr_term_value_t *term_value)
 {
 	const _odp_ipv6hdr_t *ipv6;
 	uint64_t addr[2];
 
-	if (!packet_hdr_has_ipv6(pkt_hdr))
+	if (!prs->input_flags.ipv6)
 		return 0;
 
-	ipv6 = (const _odp_ipv6hdr_t *)(pkt_addr + pkt_hdr->p.l3_offset);
+	ipv6 = (const _odp_ipv6hdr_t *)(pkt_addr + prs->l3_offset);
 	memcpy(addr, ipv6->dst_addr.u64, _ODP_IPV6ADDR_LEN);
 
 	addr[0] = addr[0] & term_value->match.mask_u64[0];
@@ -1347,6 +1428,8 @@ static int verify_pmr(pmr_t *pmr, const uint8_t *pkt_addr,
 	pmr_term_value_t *term_value;
 	const _odp_ipv4hdr_t *ipv4 = NULL;
 	const _odp_ipv6hdr_t *ipv6 = NULL;
+	const packet_parser_t *prs = &pkt_hdr->p;
+	packet_parser_t inner;
 
 	/* Locking is not required as PMR rules for in-flight packets
 	delivery during a PMR change is indeterminate*/
@@ -1355,10 +1438,16 @@ static int verify_pmr(pmr_t *pmr, const uint8_t *pkt_addr,
 		return 0;
 	num_pmr = pmr->num_pmr;
 
-	if (pkt_hdr->p.input_flags.ipv4)
-		ipv4 = (const _odp_ipv4hdr_t *)(pkt_addr + pkt_hdr->p.l3_offset);
-	if (pkt_hdr->p.input_flags.ipv6)
-		ipv6 = (const _odp_ipv6hdr_t *)(pkt_addr + pkt_hdr->p.l3_offset);
+	/* L3 and L4 terms match inner headers of tunneled packets */
+	if (odp_unlikely(pkt_hdr->p.tunnel.type && _odp_cls_global->inner_pmr)) {
+		inner_parser(&pkt_hdr->p, &inner);
+		prs = &inner;
+	}
+
+	if (prs->input_flags.ipv4)
+		ipv4 = (const _odp_ipv4hdr_t *)(pkt_addr + prs->l3_offset);
+	if (prs->input_flags.ipv6)
+		ipv6 = (const _odp_ipv6hdr_t *)(pkt_addr + prs->l3_offset);
 
 	/* Iterate through list of PMR Term values in a pmr_t */
 	for (i = 0; i < num_pmr; i++) {
@@ -1420,42 +1509,42 @@ static int verify_pmr(pmr_t *pmr, const uint8_t *pkt_addr,
 			}
 			break;
 		case ODP_PMR_UDP_DPORT:
-			if (!verify_pmr_udp_dport(pkt_addr, pkt_hdr,
+			if (!verify_pmr_udp_dport(pkt_addr, prs,
 						  term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_TCP_DPORT:
-			if (!verify_pmr_tcp_dport(pkt_addr, pkt_hdr,
+			if (!verify_pmr_tcp_dport(pkt_addr, prs,
 						  term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_UDP_SPORT:
-			if (!verify_pmr_udp_sport(pkt_addr, pkt_hdr,
+			if (!verify_pmr_udp_sport(pkt_addr, prs,
 						  term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_TCP_SPORT:
-			if (!verify_pmr_tcp_sport(pkt_addr, pkt_hdr,
+			if (!verify_pmr_tcp_sport(pkt_addr, prs,
 						  term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_SIP_ADDR:
-			if (!verify_pmr_ipv4_saddr(pkt_addr, pkt_hdr,
+			if (!verify_pmr_ipv4_saddr(pkt_addr, prs,
 						   term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_DIP_ADDR:
-			if (!verify_pmr_ipv4_daddr(pkt_addr, pkt_hdr,
+			if (!verify_pmr_ipv4_daddr(pkt_addr, prs,
 						   term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_SIP6_ADDR:
-			if (!verify_pmr_ipv6_saddr(pkt_addr, pkt_hdr,
+			if (!verify_pmr_ipv6_saddr(pkt_addr, prs,
 						   term_value))
 				pmr_failure = 1;
 			break;
 		case ODP_PMR_DIP6_ADDR:
-			if (!verify_pmr_ipv6_daddr(pkt_addr, pkt_hdr,
+			if (!verify_pmr_ipv6_daddr(pkt_addr, prs,
 						   term_value))
 				pmr_failure = 1;
 			break;
@@ -1751,72 +1840,51 @@ int _odp_cls_classify_packet(pktio_entry_t *entry, const uint8_t *base,
 	return 0;
 }
 
-static uint32_t packet_rss_hash(odp_packet_hdr_t *pkt_hdr,
+static uint32_t packet_rss_hash(const packet_parser_t *prs,
 				odp_cls_hash_proto_t hash_proto,
 				const uint8_t *base)
 {
-	thash_tuple_t tuple;
-	const _odp_ipv4hdr_t *ipv4;
-	const _odp_udphdr_t *udp;
-	const _odp_tcphdr_t *tcp;
-	const _odp_ipv6hdr_t *ipv6;
-	uint32_t hash;
+	uint8_t tuple[THASH_TUPLE_MAX_LEN];
+	uint32_t addr_len = 0;
 	uint32_t tuple_len;
+	int ports = 0;
 
-	tuple_len = 0;
-	hash = 0;
-	if (pkt_hdr->p.input_flags.ipv4) {
+	if (prs->input_flags.ipv4) {
 		if (hash_proto.ipv4) {
-			/* add ipv4 */
-			ipv4 = (const _odp_ipv4hdr_t *)(base +
-				pkt_hdr->p.l3_offset);
-			tuple.v4.src_addr = ipv4->src_addr;
-			tuple.v4.dst_addr = ipv4->dst_addr;
-			tuple_len += 2;
-		}
+			const _odp_ipv4hdr_t *ipv4 = (const _odp_ipv4hdr_t *)(base +
+						      prs->l3_offset);
 
-		if (pkt_hdr->p.input_flags.tcp && hash_proto.tcp) {
-			/* add tcp */
-			tcp = (const _odp_tcphdr_t *)(base +
-			       pkt_hdr->p.l4_offset);
-			tuple.v4.sport = tcp->src_port;
-			tuple.v4.dport = tcp->dst_port;
-			tuple_len += 1;
-		} else if (pkt_hdr->p.input_flags.udp && hash_proto.udp) {
-			/* add udp */
-			udp = (const _odp_udphdr_t *)(base +
-			       pkt_hdr->p.l4_offset);
-			tuple.v4.sport = udp->src_port;
-			tuple.v4.dport = udp->dst_port;
-			tuple_len += 1;
+			addr_len = _ODP_IPV4ADDR_LEN;
+			memcpy(tuple, &ipv4->src_addr, addr_len);
+			memcpy(tuple + addr_len, &ipv4->dst_addr, addr_len);
 		}
-	} else if (pkt_hdr->p.input_flags.ipv6) {
+	} else if (prs->input_flags.ipv6) {
 		if (hash_proto.ipv6) {
-			/* add ipv6 */
-			ipv6 = (const _odp_ipv6hdr_t *)(base +
-				pkt_hdr->p.l3_offset);
-			thash_load_ipv6_addr(ipv6, &tuple);
-			tuple_len += 8;
-		}
-		if (pkt_hdr->p.input_flags.tcp && hash_proto.tcp) {
-			tcp = (const _odp_tcphdr_t *)(base +
-			       pkt_hdr->p.l4_offset);
-			tuple.v6.sport = tcp->src_port;
-			tuple.v6.dport = tcp->dst_port;
-			tuple_len += 1;
-		} else if (pkt_hdr->p.input_flags.udp && hash_proto.udp) {
-			/* add udp */
-			udp = (const _odp_udphdr_t *)(base +
-			       pkt_hdr->p.l4_offset);
-			tuple.v6.sport = udp->src_port;
-			tuple.v6.dport = udp->dst_port;
-			tuple_len += 1;
+			const _odp_ipv6hdr_t *ipv6 = (const _odp_ipv6hdr_t *)(base +
+						      prs->l3_offset);
+
+			addr_len = _ODP_IPV6ADDR_LEN;
+			memcpy(tuple, &ipv6->src_addr, addr_len);
+			memcpy(tuple + addr_len, &ipv6->dst_addr, addr_len);
 		}
+	} else {
+		return 0;
 	}
-	if (tuple_len)
-		hash = thash_softrss((uint32_t *)&tuple,
-				     tuple_len, default_rss);
-	return hash;
+
+	/* TCP and UDP source and destination ports are at the same offsets */
+	if ((prs->input_flags.tcp && hash_proto.tcp) ||
+	    (prs->input_flags.udp && hash_proto.udp)) {
+		memcpy(tuple + 2 * addr_len, base + prs->l4_offset, 2 * sizeof(uint16_t));
+		ports = 1;
+	}
+
+	tuple_len = 2 * addr_len + (ports ? 2 * sizeof(uint16_t) : 0);
+	if (tuple_len == 0)
+		return 0;
+
+	_odp_cls_rss_tuple_sym(tuple, addr_len, ports);
+
+	return thash_hash(&_odp_cls_global->rss_tbl, tuple, tuple_len);
 }
 
 uint64_t odp_cos_to_u64(odp_cos_t hdl)
@@ -2,30 +2,64 @@
  * Copyright (c) 2018 Linaro Limited
  */
 
+#include <stdio.h>
 #include <string.h>
 
+#include <odp/api/atomic.h>
 #include <odp/api/comp.h>
+#include <odp/api/cpu.h>
 #include <odp/api/event.h>
 #include <odp/api/packet.h>
 #include <odp/api/queue.h>
+#include <odp/api/shared_memory.h>
+#include <odp/api/ticketlock.h>
 
 #include <odp/api/plat/strong_types.h>
 
+#include <odp_bg_thread_internal.h>
 #include <odp_debug_internal.h>
 #include <odp_global_data.h>
 #include <odp_init_internal.h>
+#include <odp_libconfig_internal.h>
+#include <odp_macros_internal.h>
 #include <odp_packet_internal.h>
+#include <odp_ring_u32_internal.h>
 
 #include "miniz/miniz.h"
 
 #define MAX_SESSIONS  16
 #define MEM_LEVEL   8
 
+/* Maximum number of stream contexts per session */
+#define MAX_CONTEXTS  64
+
+/* Maximum number of worker threads */
+#define MAX_WORKERS   _ODP_BG_THREAD_MAX
+
+/* Stream context ring size. Must be a power of two and larger than MAX_CONTEXTS. */
+#define CTX_RING_SIZE 128
+#define CTX_RING_MASK (CTX_RING_SIZE - 1)
+
+/* Number of operations per session that can be queued to worker threads */
+#define MAX_JOBS      256
+#define JOB_RING_SIZE (2 * MAX_JOBS)
+#define JOB_RING_MASK (JOB_RING_SIZE - 1)
+
+/* Maximum number of jobs a worker thread dequeues from a session at a time */
+#define JOB_BURST     8
+
+ODP_STATIC_ASSERT(_ODP_CHECK_IS_POWER2(CTX_RING_SIZE), "Context ring size not a power of two");
+ODP_STATIC_ASSERT(CTX_RING_SIZE > MAX_CONTEXTS, "Too small context ring");
+ODP_STATIC_ASSERT(_ODP_CHECK_IS_POWER2(JOB_RING_SIZE), "Job ring size not a power of two");
+
 /** Forward declaration of session structure */
 typedef struct odp_comp_generic_session odp_comp_generic_session_t;
 
 #define to_gen_session(s) ((odp_comp_generic_session_t *)(intptr_t)(s))
 
+/** Forward declaration of stream context structure */
+typedef struct comp_ctx_s comp_ctx_t;
+
 /**
  * Algorithm handler function prototype
  */
@@ -33,7 +67,60 @@ typedef
 int (*comp_func_t)(odp_packet_t pkt_in,
 		   odp_packet_t pkt_out,
 		   const odp_comp_packet_op_param_t *params,
-		   odp_comp_generic_session_t *session);
+		   odp_comp_generic_session_t *session,
+		   comp_ctx_t *ctx);
+
+/**
+ * Stream context. A context is used by one operation at a time, so that
+ * multiple threads may process operations of the same session concurrently.
+ */
+struct comp_ctx_s {
+	mz_stream stream;
+	union {
+		tdefl_compressor comp;
+		inflate_state inflate;
+	} data;
+};
+
+/**
+ * Operation passed to worker threads
+ */
+typedef struct comp_job_s {
+	odp_packet_t pkt_in;
+	odp_packet_t pkt_out;
+	odp_comp_packet_op_param_t param;
+	/* Synchronous burst: number of pending operations of the burst.
+	 * NULL for asynchronous operations. */
+	odp_atomic_u32_t *pending;
+} comp_job_t;
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+/**
+ * Session memory for stream contexts and worker thread jobs. Reserved on
+ * the first use of a session slot and kept until global termination, so that
+ * worker threads never access freed memory.
+ */
+typedef struct comp_session_mem_s {
+	struct {
+		ring_u32_t hdr;
+		uint32_t data[CTX_RING_SIZE];
+	} ctx_free;
+
+	struct {
+		ring_u32_t hdr;
+		uint32_t data[JOB_RING_SIZE];
+	} job_free;
+
+	struct {
+		ring_u32_t hdr;
+		uint32_t data[JOB_RING_SIZE];
+	} job_pending;
+
+	comp_job_t job[MAX_JOBS];
+	comp_ctx_t ctx[];
+} comp_session_mem_t;
+#pragma GCC diagnostic pop
 
 /**
  * Per session data structure
@@ -43,12 +130,15 @@ struct odp_comp_generic_session {
 	odp_comp_session_param_t        params;
 	struct {
 		comp_func_t func;
-		mz_stream stream;
-		union {
-			tdefl_compressor comp;
-			inflate_state inflate;
-		} data;
+		/* Number of initialized stream contexts */
+		uint32_t num_ctx;
 	} comp;
+	/* Non-zero when worker threads process operations of the session */
+	odp_atomic_u32_t active;
+	/* Worker thread of a session with ordered completions, or -1 for any thread */
+	int owner;
+	odp_shm_t mem_shm;
+	comp_session_mem_t *mem;
 };
 
 typedef struct odp_comp_global_s {
@@ -56,6 +146,16 @@ typedef struct odp_comp_global_s {
 	odp_shm_t global_shm;
 	odp_comp_generic_session_t *free;
 	odp_comp_generic_session_t  sessions[MAX_SESSIONS];
+
+	struct {
+		uint32_t session_contexts;
+		uint32_t worker_threads;
+	} config;
+
+	/* Worker threads. Running while there are sessions. */
+	odp_ticketlock_t thr_lock;
+	uint32_t num_sessions;
+	_odp_bg_thread_grp_t thr_grp;
 } odp_comp_global_t;
 
 static odp_comp_global_t *global;
@@ -89,7 +189,8 @@ static int
 null_comp_routine(odp_packet_t pkt_in ODP_UNUSED,
 		  odp_packet_t pkt_out ODP_UNUSED,
 		  const odp_comp_packet_op_param_t *params ODP_UNUSED,
-		  odp_comp_generic_session_t *session ODP_UNUSED)
+		  odp_comp_generic_session_t *session ODP_UNUSED,
+		  comp_ctx_t *ctx ODP_UNUSED)
 {
 	return 0;
 }
@@ -108,10 +209,11 @@ void odp_comp_session_param_init(odp_comp_session_param_t *param)
 static void process_input(odp_packet_t pkt_out,
 			  const odp_comp_packet_op_param_t *params,
 			  odp_comp_generic_session_t *session,
+			  comp_ctx_t *ctx,
 			  odp_comp_packet_result_t *result,
 			  odp_bool_t sync)
 {
-	mz_streamp streamp = &session->comp.stream;
+	mz_streamp streamp = &ctx->stream;
 	int ret = 0;
 	uint8_t *out_data = NULL;
 	uint32_t out_len = 0;
@@ -222,7 +324,8 @@ static void process_input(odp_packet_t pkt_out,
 static int deflate_comp(odp_packet_t pkt_in,
 			odp_packet_t pkt_out,
 			const odp_comp_packet_op_param_t *params,
-			odp_comp_generic_session_t *session)
+			odp_comp_generic_session_t *session,
+			comp_ctx_t *ctx)
 {
 	mz_streamp streamp;
 	uint8_t *data = NULL;
@@ -239,7 +342,7 @@ static int deflate_comp(odp_packet_t pkt_in,
 	_ODP_ASSERT(pkt_in != ODP_PACKET_INVALID);
 	_ODP_ASSERT(pkt_out != ODP_PACKET_INVALID);
 
-	streamp = &session->comp.stream;
+	streamp = &ctx->stream;
 
 	/* Adjust pointer for beginning of area to compress.
 	   Since we need to pass phys cont area so we need to deal with segments
@@ -271,10 +374,17 @@ static int deflate_comp(odp_packet_t pkt_in,
 			sync = true;
 		}
 
-		process_input(pkt_out, params, session, result, sync);
+		process_input(pkt_out, params, session, ctx, result, sync);
+
+		if (result->status != ODP_COMP_STATUS_SUCCESS) {
+			/* Reset the stream for the next operation */
+			if (session->params.op == ODP_COMP_OP_COMPRESS)
+				mz_deflateReset(streamp);
+			else
+				mz_inflateReset(streamp);
 
-		if (result->status != ODP_COMP_STATUS_SUCCESS)
 			return -1;
+		}
 
 		read += in_len;
 	}
@@ -286,12 +396,12 @@ static int deflate_comp(odp_packet_t pkt_in,
 
 static void *comp_zalloc(void *opaque, size_t items, size_t size)
 {
-	odp_comp_generic_session_t *session = opaque;
+	comp_ctx_t *ctx = opaque;
 
-	if (items * size > sizeof(session->comp.data))
+	if (items * size > sizeof(ctx->data))
 		return NULL;
 	else
-		return &session->comp.data;
+		return &ctx->data;
 }
 
 static void comp_zfree(void *opaque ODP_UNUSED, void *data ODP_UNUSED)
@@ -299,9 +409,9 @@ static void comp_zfree(void *opaque ODP_UNUSED, void *data ODP_UNUSED)
 	/* Do nothing */
 }
 
-static int deflate_init(odp_comp_generic_session_t *session)
+static int deflate_init(odp_comp_generic_session_t *session, comp_ctx_t *ctx)
 {
-	mz_streamp streamp = &session->comp.stream;
+	mz_streamp streamp = &ctx->stream;
 	uint32_t level;
 	uint32_t strategy;
 	int32_t window_bits;
@@ -311,7 +421,7 @@ static int deflate_init(odp_comp_generic_session_t *session)
 	/* optional check as such may not required */
 	_ODP_ASSERT(strcmp(mz_version(), MZ_VERSION) == 0);
 
-	memset(&session->comp.stream, 0, sizeof(mz_stream));
+	memset(&ctx->stream, 0, sizeof(mz_stream));
 
 	/*  let zlib handles required memory allocations
 	   we will identify if there any memory allocations issues that
@@ -319,7 +429,7 @@ static int deflate_init(odp_comp_generic_session_t *session)
 	 */
 	streamp->zalloc = comp_zalloc;
 	streamp->zfree = comp_zfree;
-	streamp->opaque = session;
+	streamp->opaque = ctx;
 
 	switch (session->params.comp_algo) {
 	case ODP_COMP_ALG_ZLIB:
@@ -371,10 +481,10 @@ static int deflate_init(odp_comp_generic_session_t *session)
 	return 0;
 }
 
-static int term_def(odp_comp_generic_session_t *session)
+static int term_def(odp_comp_generic_session_t *session, comp_ctx_t *ctx)
 {
 	int rc = 0;
-	mz_streamp streamp = &session->comp.stream;
+	mz_streamp streamp = &ctx->stream;
 
 	if (ODP_COMP_OP_COMPRESS == session->params.op) {
 		rc = mz_deflateEnd(streamp);
@@ -394,6 +504,138 @@ static int term_def(odp_comp_generic_session_t *session)
 	return 0;
 }
 
+static int _odp_comp_single(odp_packet_t pkt_in, odp_packet_t pkt_out,
+			    const odp_comp_packet_op_param_t *param);
+
+static void complete_async(odp_packet_t pkt_out, const odp_comp_packet_op_param_t *param)
+{
+	odp_event_t event = odp_packet_to_event(pkt_out);
+	odp_comp_generic_session_t *session = to_gen_session(param->session);
+
+	if (odp_queue_enq(session->params.compl_queue, event)) {
+		_ODP_ERR("Completion event enqueue failed\n");
+		odp_event_free(event);
+	}
+}
+
+/* Process up to 'max' queued operations of a session. Returns the number of
+ * processed operations. */
+static uint32_t process_jobs(odp_comp_generic_session_t *session, uint32_t max)
+{
+	comp_session_mem_t *mem = session->mem;
+	uint32_t idx[JOB_BURST];
+	uint32_t num;
+
+	num = ring_u32_deq_multi(&mem->job_pending.hdr, JOB_RING_MASK, idx,
+				 _ODP_MIN(max, (uint32_t)JOB_BURST));
+
+	for (uint32_t i = 0; i < num; i++) {
+		comp_job_t *job = &mem->job[idx[i]];
+		odp_atomic_u32_t *pending = job->pending;
+
+		/* Operation status is reported in the output packet */
+		_odp_comp_single(job->pkt_in, job->pkt_out, &job->param);
+
+		if (pending) {
+			ring_u32_enq(&mem->job_free.hdr, JOB_RING_MASK, idx[i]);
+			odp_atomic_sub_rel_u32(pending, 1);
+		} else {
+			complete_async(job->pkt_out, &job->param);
+			ring_u32_enq(&mem->job_free.hdr, JOB_RING_MASK, idx[i]);
+		}
+	}
+
+	return num;
+}
+
+/* Worker thread work function */
+static uint32_t worker_process(void *arg ODP_UNUSED, int thr_idx)
+{
+	uint32_t num = 0;
+
+	for (int i = 0; i < MAX_SESSIONS; i++) {
+		odp_comp_generic_session_t *session = &global->sessions[i];
+
+		if (odp_atomic_load_acq_u32(&session->active) == 0)
+			continue;
+
+		/* Operations of an ordered session are processed by a single thread */
+		if (session->owner >= 0 && session->owner != thr_idx)
+			continue;
+
+		num += process_jobs(session, JOB_BURST);
+	}
+
+	return num;
+}
+
+static int session_mem_alloc(odp_comp_generic_session_t *session)
+{
+	char name[ODP_SHM_NAME_LEN];
+	comp_session_mem_t *mem;
+	odp_shm_t shm;
+	uint64_t size;
+	int idx = (int)(session - global->sessions);
+
+	if (session->mem)
+		return 0;
+
+	size = sizeof(comp_session_mem_t) +
+	       (uint64_t)global->config.session_contexts * sizeof(comp_ctx_t);
+	snprintf(name, sizeof(name), "_odp_comp_session_%i", idx);
+	shm = odp_shm_reserve(name, size, ODP_CACHE_LINE_SIZE, 0);
+	mem = odp_shm_addr(shm);
+
+	if (mem == NULL) {
+		_ODP_ERR("SHM reserve failed\n");
+		return -1;
+	}
+
+	ring_u32_init(&mem->ctx_free.hdr);
+	ring_u32_init(&mem->job_free.hdr);
+	ring_u32_init(&mem->job_pending.hdr);
+
+	for (uint32_t i = 0; i < MAX_JOBS; i++)
+		ring_u32_enq(&mem->job_free.hdr, JOB_RING_MASK, i);
+
+	session->mem_shm = shm;
+	session->mem = mem;
+
+	return 0;
+}
+
+static void term_contexts(odp_comp_generic_session_t *session)
+{
+	comp_session_mem_t *mem = session->mem;
+	uint32_t idx[CTX_RING_SIZE];
+
+	/* Empty the free ring, all contexts are free when the session is destroyed */
+	while (ring_u32_deq_multi(&mem->ctx_free.hdr, CTX_RING_MASK, idx, CTX_RING_MASK))
+		;
+
+	for (uint32_t i = 0; i < session->comp.num_ctx; i++)
+		term_def(session, &mem->ctx[i]);
+
+	session->comp.num_ctx = 0;
+}
+
+static int init_contexts(odp_comp_generic_session_t *session)
+{
+	comp_session_mem_t *mem = session->mem;
+
+	for (uint32_t i = 0; i < global->config.session_contexts; i++) {
+		if (deflate_init(session, &mem->ctx[i]) < 0) {
+			term_contexts(session);
+			return -1;
+		}
+
+		session->comp.num_ctx++;
+		ring_u32_enq(&mem->ctx_free.hdr, CTX_RING_MASK, i);
+	}
+
+	return 0;
+}
+
 odp_comp_session_t
 odp_comp_session_create(const odp_comp_session_param_t *params)
 {
@@ -408,6 +650,9 @@ odp_comp_session_create(const odp_comp_session_param_t *params)
 	/* Copy stuff over */
 	memcpy(&session->params, params, sizeof(*params));
 
+	if (session_mem_alloc(session))
+		goto cleanup;
+
 	/* Process based on compress */
 	switch (params->comp_algo) {
 	case ODP_COMP_ALG_NULL:
@@ -415,7 +660,7 @@ odp_comp_session_create(const odp_comp_session_param_t *params)
 		break;
 	case ODP_COMP_ALG_DEFLATE:
 	case ODP_COMP_ALG_ZLIB:
-		rc = deflate_init(session);
+		rc = init_contexts(session);
 		if (rc < 0)
 			goto cleanup;
 		break;
@@ -424,6 +669,35 @@ odp_comp_session_create(const odp_comp_session_param_t *params)
 		goto cleanup;
 	}
 
+	session->owner = -1;
+
+	if (global->config.worker_threads) {
+		if (params->mode == ODP_COMP_OP_MODE_ASYNC && params->packet_order)
+			session->owner = (int)(session - global->sessions) %
+					 global->config.worker_threads;
+
+		odp_ticketlock_lock(&global->thr_lock);
+
+		rc = 0;
+		if (global->num_sessions == 0)
+			rc = _odp_bg_thread_grp_start(&global->thr_grp,
+						      global->config.worker_threads,
+						      "Compression worker", worker_process, NULL);
+
+		if (rc == 0) {
+			global->num_sessions++;
+			odp_atomic_store_rel_u32(&session->active, 1);
+		}
+
+		odp_ticketlock_unlock(&global->thr_lock);
+
+		if (rc) {
+			if (session->comp.num_ctx)
+				term_contexts(session);
+			goto cleanup;
+		}
+	}
+
 	return (odp_comp_session_t)session;
 
 cleanup:
@@ -435,24 +709,36 @@ cleanup:
 int odp_comp_session_destroy(odp_comp_session_t session)
 {
 	odp_comp_generic_session_t *generic;
-	int32_t rc = 0;
 
 	generic = (odp_comp_generic_session_t *)(intptr_t)session;
 
+	if (odp_atomic_load_u32(&generic->active)) {
+		/* Wait for worker threads to complete all queued operations */
+		while (ring_u32_len(&generic->mem->job_free.hdr) < MAX_JOBS)
+			odp_cpu_pause();
+
+		odp_ticketlock_lock(&global->thr_lock);
+
+		odp_atomic_store_rel_u32(&generic->active, 0);
+		global->num_sessions--;
+
+		if (global->num_sessions == 0)
+			_odp_bg_thread_grp_stop(&global->thr_grp);
+
+		odp_ticketlock_unlock(&global->thr_lock);
+	}
+
 	switch (generic->params.comp_algo) {
 	case ODP_COMP_ALG_DEFLATE:
 	case ODP_COMP_ALG_ZLIB:
-		rc = term_def(generic);
+		term_contexts(generic);
 		break;
 	default:
 		break;
 	}
-	if (rc < 0) {
-		_ODP_ERR("Compression Unit could not be terminated\n");
-		return -1;
-	}
 
-	memset(generic, 0, sizeof(*generic));
+	memset(&generic->params, 0, sizeof(generic->params));
+	generic->comp.func = NULL;
 	free_session(generic);
 	return 0;
 }
@@ -519,6 +805,8 @@ static int _odp_comp_single(odp_packet_t pkt_in, odp_packet_t pkt_out,
 {
 	odp_comp_generic_session_t *session;
 	odp_comp_packet_result_t *result;
+	comp_ctx_t *ctx = NULL;
+	uint32_t ctx_idx = 0;
 	int rc;
 
 	session = to_gen_session(param->session);
@@ -535,19 +823,94 @@ static int _odp_comp_single(odp_packet_t pkt_in, odp_packet_t pkt_out,
 
 	packet_subtype_set(pkt_out, ODP_EVENT_PACKET_COMP);
 
-	rc = session->comp.func(pkt_in, pkt_out, param, session);
+	if (session->comp.num_ctx) {
+		ring_u32_t *ring = &session->mem->ctx_free.hdr;
+
+		/* Wait for a free stream context */
+		while (odp_unlikely(ring_u32_deq(ring, CTX_RING_MASK, &ctx_idx) == 0))
+			odp_cpu_pause();
+
+		ctx = &session->mem->ctx[ctx_idx];
+	}
+
+	rc = session->comp.func(pkt_in, pkt_out, param, session, ctx);
+
+	if (ctx)
+		ring_u32_enq(&session->mem->ctx_free.hdr, CTX_RING_MASK, ctx_idx);
+
 	if (rc < 0)
 		return rc;
 
 	return 0;
 }
 
+/* Pass a burst of operations to worker threads, process the first one
+ * and help to process the rest. All operations are processed also after
+ * a failed one, so all of those are consumed. Results of failed operations
+ * are reported in the output packets. */
+static int comp_burst(const odp_packet_t pkt_in[], odp_packet_t pkt_out[],
+		      int num_pkt, const odp_comp_packet_op_param_t param[])
+{
+	odp_comp_generic_session_t *session[MAX_SESSIONS];
+	odp_atomic_u32_t pending;
+	uint32_t num_session = 0;
+	int i;
+
+	odp_atomic_init_u32(&pending, 0);
+
+	for (i = 1; i < num_pkt; i++) {
+		odp_comp_generic_session_t *s = to_gen_session(param[i].session);
+		comp_session_mem_t *mem = s->mem;
+		comp_job_t *job;
+		uint32_t idx, j;
+
+		if (odp_unlikely(odp_atomic_load_u32(&s->active) == 0 ||
+				 ring_u32_deq(&mem->job_free.hdr, JOB_RING_MASK, &idx) == 0)) {
+			_odp_comp_single(pkt_in[i], pkt_out[i], &param[i]);
+			continue;
+		}
+
+		job = &mem->job[idx];
+		job->pkt_in = pkt_in[i];
+		job->pkt_out = pkt_out[i];
+		job->param = param[i];
+		job->pending = &pending;
+		odp_atomic_inc_u32(&pending);
+		ring_u32_enq(&mem->job_pending.hdr, JOB_RING_MASK, idx);
+
+		/* Sessions to help with, while waiting for the burst to complete */
+		for (j = 0; j < num_session; j++)
+			if (session[j] == s)
+				break;
+
+		if (j == num_session && s->owner < 0)
+			session[num_session++] = s;
+	}
+
+	_odp_comp_single(pkt_in[0], pkt_out[0], &param[0]);
+
+	while (odp_atomic_load_acq_u32(&pending)) {
+		uint32_t num = 0;
+
+		for (uint32_t j = 0; j < num_session; j++)
+			num += process_jobs(session[j], 1);
+
+		if (num == 0)
+			odp_cpu_pause();
+	}
+
+	return num_pkt;
+}
+
 int odp_comp_op(const odp_packet_t pkt_in[], odp_packet_t pkt_out[],
 		int num_pkt, const odp_comp_packet_op_param_t param[])
 {
 	int i;
 	int rc;
 
+	if (global->config.worker_threads && num_pkt > 1)
+		return comp_burst(pkt_in, pkt_out, num_pkt, param);
+
 	for (i = 0; i < num_pkt; i++) {
 		rc = _odp_comp_single(pkt_in[i], pkt_out[i], &param[i]);
 		if (rc < 0)
@@ -557,12 +920,43 @@ int odp_comp_op(const odp_packet_t pkt_in[], odp_packet_t pkt_out[],
 	return i;
 }
 
+/* Pass operation to worker threads. Returns 0 when all job slots of the session
+ * are in use. */
+static int comp_enq_job(odp_packet_t pkt_in, odp_packet_t pkt_out,
+			const odp_comp_packet_op_param_t *param)
+{
+	odp_comp_generic_session_t *session = to_gen_session(param->session);
+	comp_session_mem_t *mem = session->mem;
+	comp_job_t *job;
+	uint32_t idx;
+
+	if (odp_unlikely(ring_u32_deq(&mem->job_free.hdr, JOB_RING_MASK, &idx) == 0))
+		return 0;
+
+	job = &mem->job[idx];
+	job->pkt_in = pkt_in;
+	job->pkt_out = pkt_out;
+	job->param = *param;
+	job->pending = NULL;
+	ring_u32_enq(&mem->job_pending.hdr, JOB_RING_MASK, idx);
+
+	return 1;
+}
+
 int odp_comp_op_enq(const odp_packet_t pkt_in[], odp_packet_t pkt_out[],
 		    int num_pkt, const odp_comp_packet_op_param_t param[])
 {
 	int i;
 	int rc;
 
+	if (global->config.worker_threads) {
+		for (i = 0; i < num_pkt; i++)
+			if (comp_enq_job(pkt_in[i], pkt_out[i], &param[i]) == 0)
+				break;
+
+		return i;
+	}
+
 	for (i = 0; i < num_pkt; i++) {
 		odp_event_t event;
 		odp_comp_generic_session_t *session;
@@ -596,6 +990,45 @@ int odp_comp_result(odp_comp_packet_result_t *result,
 	return 0;
 }
 
+static int read_config_file(odp_comp_global_t *global)
+{
+	const char *str;
+	int val = 0;
+
+	_ODP_PRINT("Compression config:\n");
+
+	str = "comp.session_contexts";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 1 || val > MAX_CONTEXTS) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	global->config.session_contexts = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "comp.worker_threads";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 0 || val > MAX_WORKERS) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	global->config.worker_threads = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+	_ODP_PRINT("\n");
+
+	return 0;
+}
+
 int _odp_comp_init_global(void)
 {
 	size_t mem_size;
@@ -615,17 +1048,27 @@ int _odp_comp_init_global(void)
 			      ODP_CACHE_LINE_SIZE, 0);
 
 	global = odp_shm_addr(shm);
+	if (global == NULL) {
+		_ODP_ERR("SHM reserve failed\n");
+		return -1;
+	}
 
 	/* Clear it out */
 	memset(global, 0, mem_size);
 	global->global_shm = shm;
 
+	if (read_config_file(global))
+		return -1;
+
 	/* Initialize free list and lock */
 	for (idx = 0; idx < MAX_SESSIONS; idx++) {
+		odp_atomic_init_u32(&global->sessions[idx].active, 0);
+		global->sessions[idx].mem_shm = ODP_SHM_INVALID;
 		global->sessions[idx].next = global->free;
 		global->free = &global->sessions[idx];
 	}
 	odp_spinlock_init(&global->lock);
+	odp_ticketlock_init(&global->thr_lock);
 
 	return 0;
 }
@@ -648,6 +1091,17 @@ int _odp_comp_term_global(void)
 		rc = -1;
 	}
 
+	if (global->num_sessions)
+		_odp_bg_thread_grp_stop(&global->thr_grp);
+
+	for (int i = 0; i < MAX_SESSIONS; i++) {
+		if (global->sessions[i].mem_shm != ODP_SHM_INVALID &&
+		    odp_shm_free(global->sessions[i].mem_shm)) {
+			_ODP_ERR("shm free failed for comp session\n");
+			rc = -1;
+		}
+	}
+
 	ret = odp_shm_free(global->global_shm);
 	if (ret < 0) {
 		_ODP_ERR("shm free failed for comp_pool\n");
@@ -2,6 +2,10 @@
  * Copyright (c) 2021-2025 Nokia
  */
 
+#include <odp_posix_extensions.h>
+
+#include <odp/api/atomic.h>
+#include <odp/api/cpu.h>
 #include <odp/api/dma.h>
 #include <odp/api/event.h>
 #include <odp/api/shared_memory.h>
@@ -16,22 +20,43 @@
 #include <odp/api/plat/std_inlines.h>
 #include <odp/api/plat/strong_types.h>
 
+#include <odp_bg_thread_internal.h>
 #include <odp_global_data.h>
 #include <odp_debug_internal.h>
 #include <odp_init_internal.h>
 #include <odp_event_internal.h>
+#include <odp_libconfig_internal.h>
+#include <odp_macros_internal.h>
 #include <odp_pool_internal.h>
+#include <odp_ring_u32_internal.h>
 #include <odp_string_internal.h>
 
+#include <stdio.h>
 #include <string.h>
 #include <inttypes.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #define MAX_SESSIONS  CONFIG_MAX_DMA_SESSIONS
 #define MAX_TRANSFERS 256
 #define MAX_SEGS      16
 #define MAX_SEG_LEN   (128 * 1024)
 
+/* Maximum number of background copy threads */
+#define MAX_COPY_THREADS _ODP_BG_THREAD_MAX
+
+/* Job ring size. Must be a power of two and larger than MAX_TRANSFERS. */
+#define JOB_RING_SIZE 512
+#define JOB_RING_MASK (JOB_RING_SIZE - 1)
+
+/* Maximum number of jobs a copy thread dequeues from a session at a time */
+#define JOB_BURST 8
+
 ODP_STATIC_ASSERT(MAX_TRANSFERS < UINT32_MAX, "Too many inflight transfers");
+ODP_STATIC_ASSERT(JOB_RING_SIZE > MAX_TRANSFERS, "Too small job ring");
+ODP_STATIC_ASSERT(_ODP_CHECK_IS_POWER2(JOB_RING_SIZE), "Job ring size not a power of two");
 
 typedef struct segment_t {
 	void     *addr;
@@ -51,15 +76,54 @@ typedef struct result_t {
 	void *user_ptr;
 	/* Space for implementation allocated packets if requested */
 	odp_packet_t pkts[MAX_SEGS];
+	/* Transfer done flag of a poll mode transfer processed by a copy thread */
+	odp_atomic_u32_t done;
 
 } result_t;
 
+/* Transfer started by odp_dma_transfer_start() and processed by a copy thread */
+typedef struct dma_job_t {
+	odp_dma_compl_mode_t compl_mode;
+	odp_event_t event;
+	odp_queue_t queue;
+	result_t *result;
+	uint32_t num_trs;
+	uint32_t num_free;
+	odp_packet_t free_pkt[MAX_SEGS];
+	transfer_t trs[2 * MAX_SEGS];
+
+} dma_job_t;
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+typedef struct dma_job_ring_t {
+	ring_u32_t hdr;
+	uint32_t data[JOB_RING_SIZE];
+
+} dma_job_ring_t;
+#pragma GCC diagnostic pop
+
+/* Job memory of a session. Reserved on the first asynchronous use of a session slot and kept
+ * until global termination, so that copy threads never access freed memory. */
+typedef struct dma_jobs_t {
+	dma_job_ring_t free;
+	dma_job_ring_t pending;
+	dma_job_t job[MAX_TRANSFERS];
+
+} dma_jobs_t;
+
 typedef struct ODP_ALIGNED_CACHE dma_session_t {
 	odp_ticketlock_t  lock;
 	odp_dma_param_t   dma_param;
 	uint8_t           active;
 	char              name[ODP_DMA_NAME_LEN];
 	odp_stash_t       stash;
+	/* Non-zero when copy threads process started transfers of the session */
+	odp_atomic_u32_t  async;
+	/* Copy thread of a session with ordered transfers, or -1 for any thread */
+	int               owner;
+	odp_shm_t         jobs_shm;
+	dma_jobs_t        *jobs;
 	/* Last element in array reserved for sync transfers, others added to ID stash */
 	result_t          result[MAX_TRANSFERS + 1];
 
@@ -72,6 +136,16 @@ typedef struct dma_global_t {
 	odp_pool_capability_t pool_capa;
 	odp_pool_param_t pool_param;
 
+	struct {
+		uint32_t copy_threads;
+		uint32_t nt_copy_min_len;
+	} config;
+
+	/* Background copy threads */
+	odp_ticketlock_t thr_lock;
+	uint32_t num_async;
+	_odp_bg_thread_grp_t thr_grp;
+
 	dma_session_t session[MAX_SESSIONS];
 
 } dma_global_t;
@@ -200,6 +274,109 @@ static int destroy_stash(odp_stash_t stash)
 	return ret;
 }
 
+static void process_job(const dma_job_t *job);
+
+/* Copy thread work function */
+static uint32_t copy_transfers(void *arg ODP_UNUSED, int thr_idx)
+{
+	uint32_t idx[JOB_BURST];
+	uint32_t num_jobs = 0;
+
+	for (int i = 0; i < MAX_SESSIONS; i++) {
+		dma_session_t *session = &_odp_dma_glb->session[i];
+		dma_jobs_t *jobs;
+		uint32_t num;
+
+		if (odp_atomic_load_acq_u32(&session->async) == 0)
+			continue;
+
+		/* Transfers of an ordered session are processed by a single thread */
+		if (session->owner >= 0 && session->owner != thr_idx)
+			continue;
+
+		jobs = session->jobs;
+		num = ring_u32_deq_multi(&jobs->pending.hdr, JOB_RING_MASK, idx, JOB_BURST);
+
+		for (uint32_t j = 0; j < num; j++) {
+			process_job(&jobs->job[idx[j]]);
+			ring_u32_enq(&jobs->free.hdr, JOB_RING_MASK, idx[j]);
+		}
+
+		num_jobs += num;
+	}
+
+	return num_jobs;
+}
+
+static int enable_async(dma_session_t *session)
+{
+	int ret = 0;
+
+	if (session->jobs == NULL) {
+		char name[ODP_SHM_NAME_LEN];
+		dma_jobs_t *jobs;
+		odp_shm_t shm;
+		int idx = (int)(session - _odp_dma_glb->session);
+
+		snprintf(name, sizeof(name), "_odp_dma_jobs_%i", idx);
+		shm = odp_shm_reserve(name, sizeof(dma_jobs_t), ODP_CACHE_LINE_SIZE, 0);
+		jobs = odp_shm_addr(shm);
+
+		if (jobs == NULL) {
+			_ODP_ERR("SHM reserve failed\n");
+			return -1;
+		}
+
+		ring_u32_init(&jobs->free.hdr);
+		ring_u32_init(&jobs->pending.hdr);
+
+		for (uint32_t i = 0; i < MAX_TRANSFERS; i++)
+			ring_u32_enq(&jobs->free.hdr, JOB_RING_MASK, i);
+
+		session->jobs_shm = shm;
+		session->jobs = jobs;
+	}
+
+	if (session->dma_param.order != ODP_DMA_ORDER_NONE)
+		session->owner = (int)(session - _odp_dma_glb->session) %
+				 _odp_dma_glb->config.copy_threads;
+
+	odp_ticketlock_lock(&_odp_dma_glb->thr_lock);
+
+	if (_odp_dma_glb->num_async == 0)
+		ret = _odp_bg_thread_grp_start(&_odp_dma_glb->thr_grp,
+					       _odp_dma_glb->config.copy_threads, "DMA copy",
+					       copy_transfers, NULL);
+
+	if (ret == 0) {
+		_odp_dma_glb->num_async++;
+		odp_atomic_store_rel_u32(&session->async, 1);
+	}
+
+	odp_ticketlock_unlock(&_odp_dma_glb->thr_lock);
+
+	return ret;
+}
+
+static void disable_async(dma_session_t *session)
+{
+	dma_jobs_t *jobs = session->jobs;
+
+	/* Wait for copy threads to complete all started transfers */
+	while (ring_u32_len(&jobs->free.hdr) < MAX_TRANSFERS)
+		odp_cpu_pause();
+
+	odp_ticketlock_lock(&_odp_dma_glb->thr_lock);
+
+	odp_atomic_store_rel_u32(&session->async, 0);
+	_odp_dma_glb->num_async--;
+
+	if (_odp_dma_glb->num_async == 0)
+		_odp_bg_thread_grp_stop(&_odp_dma_glb->thr_grp);
+
+	odp_ticketlock_unlock(&_odp_dma_glb->thr_lock);
+}
+
 odp_dma_t odp_dma_create(const char *name, const odp_dma_param_t *param)
 {
 	odp_dma_capability_t dma_capa;
@@ -272,6 +449,17 @@ odp_dma_t odp_dma_create(const char *name, const odp_dma_param_t *param)
 		_odp_strcpy(session->name, name, ODP_DMA_NAME_LEN);
 
 	session->dma_param = *param;
+	session->owner = -1;
+
+	if (_odp_dma_glb->config.copy_threads) {
+		if (enable_async(session)) {
+			if (session->stash != ODP_STASH_INVALID)
+				destroy_stash(session->stash);
+
+			session->active = 0;
+			return ODP_DMA_INVALID;
+		}
+	}
 
 	return (odp_dma_t)session;
 }
@@ -286,6 +474,9 @@ int odp_dma_destroy(odp_dma_t dma)
 		return -1;
 	}
 
+	if (odp_atomic_load_u32(&session->async))
+		disable_async(session);
+
 	if (session->stash != ODP_STASH_INVALID)
 		if (destroy_stash(session->stash))
 			ret = -1;
@@ -332,7 +523,7 @@ odp_dma_t odp_dma_lookup(const char *name)
 
 static inline result_t *get_sync_res(dma_session_t *session)
 {
-	return &session->result[MAX_SESSIONS];
+	return &session->result[MAX_TRANSFERS];
 }
 
 static uint32_t transfer_len(const odp_dma_transfer_param_t *trs_param)
@@ -538,32 +729,82 @@ static uint32_t add_to_free_set(odp_packet_t pkt, odp_packet_t set[], uint32_t n
 	return num;
 }
 
-static void free_src_segs(const odp_dma_transfer_param_t *transfer)
+static uint32_t src_free_set(const odp_dma_transfer_param_t *transfer, odp_packet_t set[])
 {
 	const uint32_t num_src = transfer->num_src;
+	uint32_t num = 0;
 
 	if (transfer->opts.unique_src_segs) {
 		for (uint32_t i = 0; i < num_src; i++)
-			odp_packet_free(transfer->src_seg[i].packet);
-	} else {
-		odp_packet_t free_set[num_src];
-		uint32_t num = 0;
+			set[i] = transfer->src_seg[i].packet;
 
-		for (uint32_t i = 0; i < num_src; i++)
-			num = add_to_free_set(transfer->src_seg[i].packet, free_set, num);
+		return num_src;
+	}
+
+	for (uint32_t i = 0; i < num_src; i++)
+		num = add_to_free_set(transfer->src_seg[i].packet, set, num);
+
+	return num;
+}
+
+static void free_src_segs(const odp_dma_transfer_param_t *transfer)
+{
+	odp_packet_t free_set[transfer->num_src];
+	uint32_t num = src_free_set(transfer, free_set);
+
+	odp_packet_free_multi(free_set, num);
+}
+
+static inline void copy_data(void *dst, const void *src, uint32_t len)
+{
+#if defined(__SSE2__)
+	const uint32_t nt_min = _odp_dma_glb->config.nt_copy_min_len;
+
+	/* Use non-temporal stores for large copies to avoid evicting useful data from caches */
+	if (nt_min && len >= nt_min) {
+		uint8_t *d = dst;
+		const uint8_t *s = src;
+		uint32_t head = (16 - ((uintptr_t)d & 15)) & 15;
+
+		memcpy(d, s, head);
+		d += head;
+		s += head;
+		len -= head;
+
+		while (len >= 64) {
+			__m128i v0 = _mm_loadu_si128((const __m128i *)(uintptr_t)s);
+			__m128i v1 = _mm_loadu_si128((const __m128i *)(uintptr_t)(s + 16));
+			__m128i v2 = _mm_loadu_si128((const __m128i *)(uintptr_t)(s + 32));
+			__m128i v3 = _mm_loadu_si128((const __m128i *)(uintptr_t)(s + 48));
+
+			_mm_stream_si128((__m128i *)(uintptr_t)d, v0);
+			_mm_stream_si128((__m128i *)(uintptr_t)(d + 16), v1);
+			_mm_stream_si128((__m128i *)(uintptr_t)(d + 32), v2);
+			_mm_stream_si128((__m128i *)(uintptr_t)(d + 48), v3);
+			d += 64;
+			s += 64;
+			len -= 64;
+		}
+
+		memcpy(d, s, len);
 
-		odp_packet_free_multi(free_set, num);
+		/* Order streaming stores before transfer completion */
+		_mm_sfence();
+		return;
 	}
+#endif
+	memcpy(dst, src, len);
 }
 
-static int do_transfer(dma_session_t *session, const odp_dma_transfer_param_t *transfer,
-		       result_t *result)
+/* Validate transfer parameters, allocate destination segments when requested and fill in
+ * the copy table. Returns number of table entries, or -1 on failure. */
+static int prepare_transfer(dma_session_t *session, const odp_dma_transfer_param_t *transfer,
+			    result_t *result, transfer_t trs[])
 {
-	int num, i;
+	int num;
 	uint32_t tot_len;
 	int num_src, num_dst;
 	const int max_num = 2 * MAX_SEGS;
-	transfer_t trs[max_num];
 	segment_t src[MAX_SEGS];
 	segment_t dst[MAX_SEGS];
 
@@ -633,8 +874,20 @@ static int do_transfer(dma_session_t *session, const odp_dma_transfer_param_t *t
 		return -1;
 	}
 
-	for (i = 0; i < num; i++)
-		memcpy(trs[i].dst, trs[i].src, trs[i].len);
+	return num;
+}
+
+static int do_transfer(dma_session_t *session, const odp_dma_transfer_param_t *transfer,
+		       result_t *result)
+{
+	transfer_t trs[2 * MAX_SEGS];
+	int num = prepare_transfer(session, transfer, result, trs);
+
+	if (odp_unlikely(num < 0))
+		return -1;
+
+	for (int i = 0; i < num; i++)
+		copy_data(trs[i].dst, trs[i].src, trs[i].len);
 
 	if (transfer->opts.seg_free)
 		free_src_segs(transfer);
@@ -750,6 +1003,63 @@ static inline uint32_t index_from_transfer_id(odp_dma_transfer_id_t transfer_id)
 	return transfer_id - 1;
 }
 
+static void process_job(const dma_job_t *job)
+{
+	for (uint32_t i = 0; i < job->num_trs; i++)
+		copy_data(job->trs[i].dst, job->trs[i].src, job->trs[i].len);
+
+	/* Segments are freed into the local cache of a copy thread. Those are flushed
+	 * back to the pool when other threads run short of them. */
+	if (job->num_free)
+		odp_packet_free_multi(job->free_pkt, job->num_free);
+
+	if (job->compl_mode == ODP_DMA_COMPL_POLL) {
+		odp_atomic_store_rel_u32(&job->result->done, 1);
+	} else if (job->compl_mode == ODP_DMA_COMPL_EVENT) {
+		if (odp_unlikely(odp_queue_enq(job->queue, job->event))) {
+			_ODP_ERR("Completion event enqueue failed %" PRIu64 "\n",
+				 odp_queue_to_u64(job->queue));
+			odp_event_free(job->event);
+		}
+	}
+}
+
+/* Pass transfer to copy threads. Returns 0 when all transfer slots of the session are in use. */
+static int start_async(dma_session_t *session, const odp_dma_transfer_param_t *transfer,
+		       const odp_dma_compl_param_t *compl, result_t *res)
+{
+	dma_jobs_t *jobs = session->jobs;
+	dma_job_t *job;
+	uint32_t idx;
+	int num;
+
+	if (odp_unlikely(ring_u32_deq(&jobs->free.hdr, JOB_RING_MASK, &idx) == 0))
+		return 0;
+
+	job = &jobs->job[idx];
+	num = prepare_transfer(session, transfer, transfer->opts.seg_alloc ? res : NULL,
+			       job->trs);
+
+	if (odp_unlikely(num < 0)) {
+		ring_u32_enq(&jobs->free.hdr, JOB_RING_MASK, idx);
+		return -1;
+	}
+
+	job->num_trs = num;
+	job->num_free = transfer->opts.seg_free ? src_free_set(transfer, job->free_pkt) : 0;
+	job->compl_mode = compl->compl_mode;
+	job->event = compl->event;
+	job->queue = compl->queue;
+	job->result = res;
+
+	if (compl->compl_mode == ODP_DMA_COMPL_POLL)
+		odp_atomic_store_u32(&res->done, 0);
+
+	ring_u32_enq(&jobs->pending.hdr, JOB_RING_MASK, idx);
+
+	return 1;
+}
+
 int odp_dma_transfer_start(odp_dma_t dma, const odp_dma_transfer_param_t *transfer,
 			   const odp_dma_compl_param_t *compl)
 {
@@ -798,6 +1108,9 @@ int odp_dma_transfer_start(odp_dma_t dma, const odp_dma_transfer_param_t *transf
 		return -1;
 	}
 
+	if (odp_atomic_load_u32(&session->async))
+		return start_async(session, transfer, compl, res);
+
 	ret = do_transfer(session, transfer, transfer->opts.seg_alloc ? res : NULL);
 
 	if (odp_unlikely(ret < 1))
@@ -857,9 +1170,13 @@ int odp_dma_transfer_done(odp_dma_t dma, odp_dma_transfer_id_t transfer_id,
 		return -1;
 	}
 
-	if (result) {
-		result_t *res = &session->result[index_from_transfer_id(id)];
+	result_t *res = &session->result[index_from_transfer_id(id)];
 
+	if (odp_atomic_load_u32(&session->async) &&
+	    odp_atomic_load_acq_u32(&res->done) == 0)
+		return 0;
+
+	if (result) {
 		result->success  = 1;
 		result->user_ptr = res->user_ptr;
 		result->num_dst = res->num_dst;
@@ -988,6 +1305,18 @@ void odp_dma_print(odp_dma_t dma)
 	_ODP_PRINT("--------\n");
 	_ODP_PRINT("  DMA handle      0x%" PRIx64 "\n", odp_dma_to_u64(dma));
 	_ODP_PRINT("  name            %s\n", session->name);
+
+	if (odp_atomic_load_u32(&session->async)) {
+		_ODP_PRINT("  copy threads    %u\n", _odp_dma_glb->config.copy_threads);
+
+		if (session->owner >= 0)
+			_ODP_PRINT("  copy thread     %i\n", session->owner);
+
+		_ODP_PRINT("  pending         %u\n", ring_u32_len(&session->jobs->pending.hdr));
+	} else {
+		_ODP_PRINT("  copy threads    0\n");
+	}
+
 	_ODP_PRINT("\n");
 }
 
@@ -1017,6 +1346,45 @@ void odp_dma_compl_print(odp_dma_compl_t dma_compl)
 	_ODP_PRINT("\n");
 }
 
+static int read_config_file(dma_global_t *global)
+{
+	const char *str;
+	int val = 0;
+
+	_ODP_PRINT("DMA config:\n");
+
+	str = "dma.copy_threads";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 0 || val > MAX_COPY_THREADS) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	global->config.copy_threads = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "dma.nt_copy_min_len";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 0) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	global->config.nt_copy_min_len = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+	_ODP_PRINT("\n");
+
+	return 0;
+}
+
 int _odp_dma_init_global(void)
 {
 	odp_shm_t shm;
@@ -1045,8 +1413,21 @@ int _odp_dma_init_global(void)
 		return -1;
 	}
 
-	for (i = 0; i < MAX_SESSIONS; i++)
-		odp_ticketlock_init(&_odp_dma_glb->session[i].lock);
+	if (read_config_file(_odp_dma_glb))
+		return -1;
+
+	odp_ticketlock_init(&_odp_dma_glb->thr_lock);
+
+	for (i = 0; i < MAX_SESSIONS; i++) {
+		dma_session_t *session = &_odp_dma_glb->session[i];
+
+		odp_ticketlock_init(&session->lock);
+		odp_atomic_init_u32(&session->async, 0);
+		session->jobs_shm = ODP_SHM_INVALID;
+
+		for (int j = 0; j < MAX_TRANSFERS + 1; j++)
+			odp_atomic_init_u32(&session->result[j].done, 0);
+	}
 
 	return 0;
 }
@@ -1061,6 +1442,19 @@ int _odp_dma_term_global(void)
 	if (_odp_dma_glb == NULL)
 		return 0;
 
+	if (_odp_dma_glb->num_async) {
+		_ODP_ERR("DMA sessions not destroyed\n");
+		_odp_bg_thread_grp_stop(&_odp_dma_glb->thr_grp);
+	}
+
+	for (int i = 0; i < MAX_SESSIONS; i++) {
+		if (_odp_dma_glb->session[i].jobs_shm != ODP_SHM_INVALID &&
+		    odp_shm_free(_odp_dma_glb->session[i].jobs_shm)) {
+			_ODP_ERR("SHM free failed\n");
+			return -1;
+		}
+	}
+
 	shm = _odp_dma_glb->shm;
 
 	if (odp_shm_free(shm)) {
@@ -0,0 +1,389 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+#include <odp/api/byteorder.h>
+#include <odp/api/hints.h>
+#include <odp/api/packet.h>
+
+#include <odp/api/plat/byteorder_inlines.h>
+#include <odp/api/plat/packet_inlines.h>
+
+#include <odp_chksum_internal.h>
+#include <odp_debug_internal.h>
+#include <odp_gro_internal.h>
+#include <odp_packet_internal.h>
+#include <odp_pool_internal.h>
+
+#include <protocols/ip.h>
+#include <protocols/tcp.h>
+
+#include <stdint.h>
+#include <string.h>
+
+/* Maximum number of flows coalesced at the same time */
+#define MAX_FLOWS 8
+
+/* Offset of the flags byte in TCP header */
+#define TCP_FLAGS_OFFSET 13
+
+#define TCP_FLAG_PSH 0x08
+#define TCP_FLAG_ACK 0x10
+
+/* Segment parse results */
+#define SEG_SKIP  0 /* Not a TCP segment */
+#define SEG_FLUSH 1 /* TCP segment that cannot be coalesced, ends coalescing of its flow */
+#define SEG_OK    2 /* TCP segment that can be coalesced */
+
+typedef struct {
+	odp_packet_hdr_t *pkt_hdr;
+	uint8_t *l3;
+	uint8_t *tcp;
+	uint32_t l3_offset;
+	uint32_t l4_offset;
+	/* Offset of TCP payload */
+	uint32_t hdr_len;
+	/* Length of TCP payload */
+	uint32_t len;
+	/* Hash of addresses and ports */
+	uint32_t hash;
+	uint8_t ipv4;
+	uint8_t flags;
+
+} seg_t;
+
+typedef struct {
+	/* First segment, the others are concatenated into it */
+	seg_t head;
+	/* Sequence number that continues the flow */
+	uint32_t next_seq;
+	/* Sum of TCP payload lengths */
+	uint32_t len;
+	/* Number of coalesced TCP segments */
+	uint32_t num;
+	/* Number of packet segments */
+	uint32_t num_segs;
+	/* Partial checksum of pseudo header addresses */
+	uint64_t addr_sum;
+	/* Partial checksum of TCP payloads */
+	uint64_t payload_sum;
+	/* Window of the latest segment */
+	odp_u16be_t window;
+	/* TCP flags of all segments */
+	uint8_t flags;
+
+} flow_t;
+
+static int seg_parse(odp_packet_t pkt, seg_t *seg)
+{
+	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
+	uint32_t seg_len = packet_first_seg_len(pkt_hdr);
+	uint32_t l3_offset = pkt_hdr->p.l3_offset;
+	uint32_t l4_offset = pkt_hdr->p.l4_offset;
+	uint8_t *data = packet_data(pkt_hdr);
+	uint32_t hdr_len, ip_len, src, dst, ports;
+
+	if (!pkt_hdr->p.input_flags.tcp || pkt_hdr->p.input_flags.ipfrag ||
+	    pkt_hdr->p.flags.all.error || pkt_hdr->p.flags.reass)
+		return SEG_SKIP;
+
+	if (odp_unlikely(l4_offset + _ODP_TCPHDR_LEN > seg_len))
+		return SEG_SKIP;
+
+	hdr_len = l4_offset + 4 * (data[l4_offset + 12] >> 4);
+
+	if (odp_unlikely(hdr_len < l4_offset + _ODP_TCPHDR_LEN || hdr_len > seg_len))
+		return SEG_SKIP;
+
+	seg->pkt_hdr = pkt_hdr;
+	seg->l3 = data + l3_offset;
+	seg->tcp = data + l4_offset;
+	seg->l3_offset = l3_offset;
+	seg->l4_offset = l4_offset;
+	seg->hdr_len = hdr_len;
+	seg->ipv4 = pkt_hdr->p.input_flags.ipv4;
+	seg->flags = seg->tcp[TCP_FLAGS_OFFSET];
+
+	if (seg->ipv4) {
+		const _odp_ipv4hdr_t *ip = (const _odp_ipv4hdr_t *)(uintptr_t)seg->l3;
+
+		ip_len = odp_be_to_cpu_16(ip->tot_len);
+		memcpy(&src, &ip->src_addr, sizeof(src));
+		memcpy(&dst, &ip->dst_addr, sizeof(dst));
+	} else {
+		const _odp_ipv6hdr_t *ip = (const _odp_ipv6hdr_t *)(uintptr_t)seg->l3;
+
+		ip_len = _ODP_IPV6HDR_LEN + odp_be_to_cpu_16(ip->payload_len);
+		memcpy(&src, &ip->src_addr.u8[12], sizeof(src));
+		memcpy(&dst, &ip->dst_addr.u8[12], sizeof(dst));
+	}
+
+	memcpy(&ports, seg->tcp, sizeof(ports));
+	seg->hash = src ^ dst ^ ports;
+
+	/* Ethernet padding would end up in the middle of the payload */
+	if (l3_offset + ip_len != pkt_hdr->frame_len)
+		return SEG_FLUSH;
+
+	seg->len = pkt_hdr->frame_len - hdr_len;
+
+	/* Only ACK segments with payload, PSH flag ends coalescing */
+	if (seg->len == 0 || (seg->flags & ~TCP_FLAG_PSH) != TCP_FLAG_ACK)
+		return SEG_FLUSH;
+
+	/* IPv6 extension headers are not supported */
+	if (!seg->ipv4 && l4_offset != l3_offset + _ODP_IPV6HDR_LEN)
+		return SEG_FLUSH;
+
+	return SEG_OK;
+}
+
+static inline int same_flow(const flow_t *flow, const seg_t *seg)
+{
+	const seg_t *head = &flow->head;
+
+	if (head->hash != seg->hash || head->ipv4 != seg->ipv4)
+		return 0;
+
+	if (memcmp(head->tcp, seg->tcp, 4))
+		return 0;
+
+	if (seg->ipv4)
+		return !memcmp(head->l3 + ODP_OFFSETOF(_odp_ipv4hdr_t, src_addr),
+			       seg->l3 + ODP_OFFSETOF(_odp_ipv4hdr_t, src_addr),
+			       2 * _ODP_IPV4ADDR_LEN);
+
+	return !memcmp(head->l3 + ODP_OFFSETOF(_odp_ipv6hdr_t, src_addr),
+		       seg->l3 + ODP_OFFSETOF(_odp_ipv6hdr_t, src_addr),
+		       2 * _ODP_IPV6ADDR_LEN);
+}
+
+static inline int can_merge(const _odp_gro_config_t *config, const flow_t *flow,
+			    const seg_t *seg)
+{
+	const seg_t *head = &flow->head;
+	uint32_t ip_hdr_len = head->l4_offset - head->l3_offset;
+	uint32_t tcp_hdr_len = head->hdr_len - head->l4_offset;
+	odp_u32be_t seq;
+
+	if (seg->l3_offset != head->l3_offset || seg->l4_offset != head->l4_offset ||
+	    seg->hdr_len != head->hdr_len)
+		return 0;
+
+	/* Headers are pulled from the first packet segment, so that they can be pushed back */
+	if (seg->hdr_len >= packet_first_seg_len(seg->pkt_hdr))
+		return 0;
+
+	memcpy(&seq, seg->tcp + ODP_OFFSETOF(_odp_tcphdr_t, seq_no), sizeof(seq));
+	if (odp_be_to_cpu_32(seq) != flow->next_seq)
+		return 0;
+
+	if (flow->num >= config->max_segs ||
+	    head->hdr_len - head->l3_offset + flow->len + seg->len > config->max_len)
+		return 0;
+
+	if (seg->pkt_hdr->event_hdr.pool != head->pkt_hdr->event_hdr.pool ||
+	    flow->num_segs + seg->pkt_hdr->seg_count > PKT_MAX_SEGS ||
+	    head->hdr_len + flow->len + seg->len >
+	    _odp_pool_entry(head->pkt_hdr->event_hdr.pool)->max_len)
+		return 0;
+
+	/* L2 headers */
+	if (memcmp(head->l3 - head->l3_offset, seg->l3 - seg->l3_offset, head->l3_offset))
+		return 0;
+
+	/* IP headers except length, identification and checksum fields */
+	if (seg->ipv4) {
+		if (memcmp(head->l3, seg->l3, 2) ||
+		    memcmp(head->l3 + 6, seg->l3 + 6, 4) ||
+		    memcmp(head->l3 + 12, seg->l3 + 12, ip_hdr_len - 12))
+			return 0;
+	} else {
+		if (memcmp(head->l3, seg->l3, 4) ||
+		    memcmp(head->l3 + 6, seg->l3 + 6, _ODP_IPV6HDR_LEN - 6))
+			return 0;
+	}
+
+	/* TCP headers except sequence number, flags, window and checksum fields. Acknowledgment
+	 * number and options must match. */
+	if (memcmp(head->tcp + 8, seg->tcp + 8, 5) ||
+	    memcmp(head->tcp + 18, seg->tcp + 18, tcp_hdr_len - 18))
+		return 0;
+
+	return 1;
+}
+
+/*
+ * Partial checksum of TCP payload
+ *
+ * Calculated from the pseudo header and TCP header, without reading the
+ * payload: the checksum of a valid segment sums up to 0xffff, so the payload
+ * sums up to the complement of the headers. A bad checksum in any of the
+ * coalesced segments results a bad checksum in the coalesced packet.
+ */
+static inline uint16_t payload_sum(const seg_t *seg, uint64_t addr_sum)
+{
+	uint32_t tcp_hdr_len = seg->hdr_len - seg->l4_offset;
+	uint64_t sum = addr_sum;
+
+	sum += odp_cpu_to_be_16(_ODP_IPPROTO_TCP) + odp_cpu_to_be_16(tcp_hdr_len + seg->len);
+	sum += chksum_partial(seg->tcp, tcp_hdr_len, 0);
+
+	return ~chksum_finalize(sum);
+}
+
+static inline void flow_open(flow_t *flow, const seg_t *seg)
+{
+	odp_u32be_t seq;
+
+	if (seg->ipv4)
+		flow->addr_sum = chksum_partial(seg->l3 + ODP_OFFSETOF(_odp_ipv4hdr_t, src_addr),
+						2 * _ODP_IPV4ADDR_LEN, 0);
+	else
+		flow->addr_sum = chksum_partial(seg->l3 + ODP_OFFSETOF(_odp_ipv6hdr_t, src_addr),
+						2 * _ODP_IPV6ADDR_LEN, 0);
+
+	memcpy(&seq, seg->tcp + ODP_OFFSETOF(_odp_tcphdr_t, seq_no), sizeof(seq));
+	memcpy(&flow->window, seg->tcp + ODP_OFFSETOF(_odp_tcphdr_t, window),
+	       sizeof(flow->window));
+
+	flow->head = *seg;
+	flow->next_seq = odp_be_to_cpu_32(seq) + seg->len;
+	flow->len = seg->len;
+	flow->num = 1;
+	flow->num_segs = seg->pkt_hdr->seg_count;
+	flow->payload_sum = payload_sum(seg, flow->addr_sum);
+	flow->flags = seg->flags;
+}
+
+/* Returns 0 when the packet was consumed. On failure, the packet is not modified. */
+static inline int flow_add(flow_t *flow, const seg_t *seg)
+{
+	odp_packet_t head = packet_handle(flow->head.pkt_hdr);
+	odp_packet_t pkt = packet_handle(seg->pkt_hdr);
+	uint32_t num_segs = seg->pkt_hdr->seg_count;
+	uint16_t sum = payload_sum(seg, flow->addr_sum);
+	odp_u16be_t window;
+
+	memcpy(&window, seg->tcp + ODP_OFFSETOF(_odp_tcphdr_t, window), sizeof(window));
+
+	if (odp_unlikely(odp_packet_pull_head(pkt, seg->hdr_len) == NULL))
+		return -1;
+
+	if (odp_unlikely(odp_packet_concat(&head, pkt) < 0)) {
+		_ODP_DBG("Packet concat failed\n");
+		odp_packet_push_head(pkt, seg->hdr_len);
+		return -1;
+	}
+
+	/* Payload data at an odd offset is summed in swapped byte order */
+	if (flow->len & 1)
+		sum = (uint16_t)((sum << 8) | (sum >> 8));
+
+	flow->payload_sum += sum;
+	flow->next_seq += seg->len;
+	flow->len += seg->len;
+	flow->num++;
+	flow->num_segs += num_segs;
+	flow->window = window;
+	flow->flags |= seg->flags;
+
+	return 0;
+}
+
+/* Update headers of a coalesced packet */
+static void flow_close(flow_t *flow)
+{
+	seg_t *head = &flow->head;
+	uint32_t ip_len = head->hdr_len - head->l3_offset + flow->len;
+	uint32_t tcp_len = head->hdr_len - head->l4_offset + flow->len;
+	_odp_tcphdr_t *tcp = (_odp_tcphdr_t *)(uintptr_t)head->tcp;
+	uint64_t sum;
+
+	if (flow->num < 2)
+		return;
+
+	if (head->ipv4) {
+		_odp_ipv4hdr_t *ip = (_odp_ipv4hdr_t *)(uintptr_t)head->l3;
+
+		ip->tot_len = odp_cpu_to_be_16(ip_len);
+		ip->chksum = 0;
+		ip->chksum = ~chksum_finalize(chksum_partial(ip, head->l4_offset -
+							     head->l3_offset, 0));
+	} else {
+		_odp_ipv6hdr_t *ip = (_odp_ipv6hdr_t *)(uintptr_t)head->l3;
+
+		ip->payload_len = odp_cpu_to_be_16(ip_len - _ODP_IPV6HDR_LEN);
+	}
+
+	head->tcp[TCP_FLAGS_OFFSET] = flow->flags;
+	tcp->window = flow->window;
+	tcp->cksm = 0;
+
+	sum = flow->addr_sum + flow->payload_sum;
+	sum += odp_cpu_to_be_16(_ODP_IPPROTO_TCP) + odp_cpu_to_be_16(tcp_len);
+	sum += chksum_partial(tcp, head->hdr_len - head->l4_offset, 0);
+	tcp->cksm = ~chksum_finalize(sum);
+}
+
+int _odp_gro_burst(const _odp_gro_config_t *config, odp_packet_t pkt[], int num)
+{
+	flow_t flow[MAX_FLOWS];
+	seg_t seg;
+	int i, j;
+	int num_flows = 0;
+	int merged = 0;
+
+	for (i = 0; i < num; i++) {
+		int ret = seg_parse(pkt[i], &seg);
+
+		if (ret == SEG_SKIP)
+			continue;
+
+		for (j = 0; j < num_flows; j++) {
+			if (same_flow(&flow[j], &seg))
+				break;
+		}
+
+		if (j < num_flows) {
+			if (ret == SEG_OK && can_merge(config, &flow[j], &seg) &&
+			    flow_add(&flow[j], &seg) == 0) {
+				pkt[i] = ODP_PACKET_INVALID;
+				merged++;
+
+				if (!(seg.flags & TCP_FLAG_PSH))
+					continue;
+			}
+
+			/* Out of order or otherwise different segment ends the flow */
+			flow_close(&flow[j]);
+			flow[j] = flow[--num_flows];
+
+			if (pkt[i] == ODP_PACKET_INVALID)
+				continue;
+		}
+
+		if (ret != SEG_OK || (seg.flags & TCP_FLAG_PSH))
+			continue;
+
+		if (num_flows == MAX_FLOWS) {
+			flow_close(&flow[0]);
+			flow[0] = flow[--num_flows];
+		}
+
+		flow_open(&flow[num_flows++], &seg);
+	}
+
+	for (j = 0; j < num_flows; j++)
+		flow_close(&flow[j]);
+
+	if (merged == 0)
+		return num;
+
+	for (i = 0, j = 0; i < num; i++) {
+		if (pkt[i] != ODP_PACKET_INVALID)
+			pkt[j++] = pkt[i];
+	}
+
+	return j;
+}
@@ -0,0 +1,718 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+#include <odp/api/atomic.h>
+#include <odp/api/hash.h>
+#include <odp/api/packet.h>
+#include <odp/api/packet_io.h>
+#include <odp/api/reassembly.h>
+#include <odp/api/shared_memory.h>
+#include <odp/api/spinlock.h>
+
+#include <odp/api/plat/atomic_inlines.h>
+#include <odp/api/plat/byteorder_inlines.h>
+#include <odp/api/plat/packet_inlines.h>
+
+#include <odp_chksum_internal.h>
+#include <odp_config_internal.h>
+#include <odp_debug_internal.h>
+#include <odp_ip_reass_internal.h>
+#include <odp_macros_internal.h>
+#include <odp_packet_internal.h>
+#include <odp_pool_internal.h>
+
+#include <protocols/eth.h>
+#include <protocols/ip.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Number of flows per hash bucket */
+#define BUCKET_SIZE 4
+
+#define NUM_BUCKETS (CONFIG_IP_REASS_MAX_FLOWS / BUCKET_SIZE)
+
+/* Timed out flows are swept with this fraction of the maximum wait time */
+#define SWEEP_DIV 8
+
+/* Enough data for Ethernet, two VLAN tags, IPv4 header with options, or IPv6
+ * header with the fragment header */
+#define FRAG_PARSE_BYTES 96U
+
+/* Maximum number of VLAN tags in front of the IP header of a fragment */
+#define FRAG_MAX_VLAN_TAGS 2
+
+/* Length of IPv6 fragment header */
+#define IPV6_FRAG_HDR_LEN 8
+
+/* Maximum length of an IP datagram */
+#define IP_DATAGRAM_MAX_LEN UINT16_MAX
+
+ODP_STATIC_ASSERT(_ODP_CHECK_IS_POWER2(NUM_BUCKETS), "IP_REASS_NUM_BUCKETS_NOT_POWER_OF_TWO");
+
+ODP_STATIC_ASSERT(CONFIG_IP_REASS_MAX_FRAGS <= UINT8_MAX, "IP_REASS_MAX_FRAGS_TOO_LARGE");
+
+typedef struct {
+	/* Source and destination addresses. IPv4 addresses use the first words. */
+	uint32_t src[4];
+	uint32_t dst[4];
+	/* Identification */
+	uint32_t id;
+	/* IPv4 protocol, zero with IPv6 */
+	uint8_t proto;
+	/* IP version */
+	uint8_t ver;
+	uint16_t pad;
+
+} flow_key_t;
+
+typedef struct {
+	odp_packet_t pkt;
+	/* Offset of fragment data in the original datagram */
+	uint16_t offset;
+	/* Length of fragment data */
+	uint16_t len;
+	/* Offset of fragment data in the packet */
+	uint16_t hdr_len;
+	/* Offset of IP header in the packet */
+	uint16_t l3_offset;
+
+} frag_t;
+
+typedef struct {
+	flow_key_t key;
+	/* Arrival time of the first fragment */
+	uint64_t first_ns;
+	/* Datagram payload length, zero until the last fragment has been received */
+	uint32_t total_len;
+	/* Sum of received fragment data lengths */
+	uint32_t recv_len;
+	uint8_t num_frags;
+	uint8_t used;
+	/* Fragments in arrival order */
+	frag_t frag[CONFIG_IP_REASS_MAX_FRAGS];
+
+} flow_t;
+
+typedef struct ODP_ALIGNED_CACHE {
+	odp_spinlock_t lock;
+	flow_t flow[BUCKET_SIZE];
+
+} bucket_t;
+
+struct ip_reass_t {
+	odp_shm_t shm;
+	odp_pktio_t pktio;
+	odp_pool_t pool;
+	uint64_t max_wait_ns;
+	uint64_t sweep_ns;
+	uint8_t max_frags;
+	uint8_t en_ipv4;
+	uint8_t en_ipv6;
+
+	/* Number of flows in the table */
+	odp_atomic_u32_t num_flows;
+	/* Time of the next timeout sweep */
+	odp_atomic_u64_t next_sweep_ns ODP_ALIGNED_CACHE;
+
+	bucket_t bucket[NUM_BUCKETS];
+};
+
+/* Data of a packet with incomplete reassembly status */
+typedef struct {
+	/* Time since the arrival of the first fragment */
+	uint64_t elapsed_ns;
+	uint32_t num_frags;
+	odp_packet_t frag[CONFIG_IP_REASS_MAX_FRAGS];
+
+} partial_t;
+
+/* Parsed fragment */
+typedef struct {
+	flow_key_t key;
+	frag_t frag;
+	/* More fragments flag */
+	uint8_t more;
+
+} frag_info_t;
+
+void _odp_ip_reass_capability(odp_reass_capability_t *capa)
+{
+	capa->ip = true;
+	capa->ipv4 = true;
+	capa->ipv6 = true;
+	capa->max_wait_time = CONFIG_IP_REASS_MAX_WAIT_NS;
+	capa->max_num_frags = CONFIG_IP_REASS_MAX_FRAGS;
+}
+
+ip_reass_t *_odp_ip_reass_create(odp_pktio_t pktio, odp_pool_t pool,
+				 const odp_reass_config_t *config)
+{
+	char name[ODP_SHM_NAME_LEN];
+	ip_reass_t *reass;
+	odp_shm_t shm;
+
+	snprintf(name, sizeof(name), "_odp_ip_reass_%" PRIu64, odp_pktio_to_u64(pktio));
+
+	shm = odp_shm_reserve(name, sizeof(ip_reass_t), ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID) {
+		_ODP_ERR("Reserving reassembly table failed\n");
+		return NULL;
+	}
+
+	reass = odp_shm_addr(shm);
+	memset(reass, 0, sizeof(ip_reass_t));
+
+	reass->shm = shm;
+	reass->pktio = pktio;
+	reass->pool = pool;
+	reass->max_wait_ns = config->max_wait_time ? config->max_wait_time :
+						     CONFIG_IP_REASS_MAX_WAIT_NS;
+	reass->sweep_ns = reass->max_wait_ns / SWEEP_DIV;
+	reass->max_frags = config->max_num_frags;
+	reass->en_ipv4 = config->en_ipv4;
+	reass->en_ipv6 = config->en_ipv6;
+	odp_atomic_init_u32(&reass->num_flows, 0);
+	odp_atomic_init_u64(&reass->next_sweep_ns, 0);
+
+	for (int i = 0; i < NUM_BUCKETS; i++)
+		odp_spinlock_init(&reass->bucket[i].lock);
+
+	return reass;
+}
+
+void _odp_ip_reass_destroy(ip_reass_t *reass)
+{
+	for (int i = 0; i < NUM_BUCKETS; i++) {
+		for (int j = 0; j < BUCKET_SIZE; j++) {
+			flow_t *flow = &reass->bucket[i].flow[j];
+
+			if (!flow->used)
+				continue;
+
+			for (int k = 0; k < flow->num_frags; k++)
+				odp_packet_free(flow->frag[k].pkt);
+		}
+	}
+
+	if (odp_shm_free(reass->shm))
+		_ODP_ERR("Freeing reassembly table failed\n");
+}
+
+static int parse_ipv4(const uint8_t *data, uint32_t offset, uint32_t data_len,
+		      uint32_t pkt_len, frag_info_t *info)
+{
+	const _odp_ipv4hdr_t *ip = (const _odp_ipv4hdr_t *)(uintptr_t)(data + offset);
+	uint16_t frag_offset, tot_len, ihl;
+	uint32_t len;
+
+	if (odp_unlikely(offset + _ODP_IPV4HDR_LEN > data_len))
+		return 0;
+
+	frag_offset = odp_be_to_cpu_16(ip->frag_offset);
+
+	if (odp_likely(!_ODP_IPV4HDR_IS_FRAGMENT(frag_offset)))
+		return 0;
+
+	ihl = _ODP_IPV4HDR_IHL(ip->ver_ihl) * 4;
+	tot_len = odp_be_to_cpu_16(ip->tot_len);
+
+	/* Leave malformed packets to the parser */
+	if (_ODP_IPV4HDR_VER(ip->ver_ihl) != _ODP_IPV4 || ihl < _ODP_IPV4HDR_LEN ||
+	    offset + ihl > data_len || tot_len <= ihl || offset + tot_len > pkt_len)
+		return 0;
+
+	len = tot_len - ihl;
+	info->more = !!(frag_offset & _ODP_IPV4HDR_FRAG_OFFSET_MORE_FRAGS);
+	info->frag.offset = _ODP_IPV4HDR_FRAG_OFFSET(frag_offset) * 8;
+	info->frag.len = len;
+	info->frag.hdr_len = offset + ihl;
+	info->frag.l3_offset = offset;
+
+	/* Reassembled header and data must fit into a datagram */
+	if ((info->more && (len % 8)) || info->frag.offset + tot_len > IP_DATAGRAM_MAX_LEN)
+		return 0;
+
+	info->key.src[0] = ip->src_addr;
+	info->key.dst[0] = ip->dst_addr;
+	info->key.id = ip->id;
+	info->key.proto = ip->proto;
+	info->key.ver = _ODP_IPV4;
+
+	return 1;
+}
+
+static int parse_ipv6(const uint8_t *data, uint32_t offset, uint32_t data_len,
+		      uint32_t pkt_len, frag_info_t *info)
+{
+	const _odp_ipv6hdr_t *ip = (const _odp_ipv6hdr_t *)(uintptr_t)(data + offset);
+	const uint8_t *frag_hdr = data + offset + _ODP_IPV6HDR_LEN;
+	uint16_t payload_len, offset_flags;
+	uint32_t id;
+
+	/* Only a fragment header directly after the IPv6 header is supported */
+	if (odp_unlikely(offset + _ODP_IPV6HDR_LEN + IPV6_FRAG_HDR_LEN > data_len) ||
+	    odp_likely(ip->next_hdr != _ODP_IPPROTO_FRAG))
+		return 0;
+
+	payload_len = odp_be_to_cpu_16(ip->payload_len);
+
+	if ((odp_be_to_cpu_32(ip->ver_tc_flow) >> _ODP_IPV6HDR_VERSION_SHIFT) != _ODP_IPV6 ||
+	    payload_len <= IPV6_FRAG_HDR_LEN ||
+	    offset + _ODP_IPV6HDR_LEN + payload_len > pkt_len)
+		return 0;
+
+	memcpy(&offset_flags, frag_hdr + 2, sizeof(offset_flags));
+	memcpy(&id, frag_hdr + 4, sizeof(id));
+	offset_flags = odp_be_to_cpu_16(offset_flags);
+
+	info->more = offset_flags & 1;
+	info->frag.offset = offset_flags & 0xfff8;
+	info->frag.len = payload_len - IPV6_FRAG_HDR_LEN;
+	info->frag.hdr_len = offset + _ODP_IPV6HDR_LEN + IPV6_FRAG_HDR_LEN;
+	info->frag.l3_offset = offset;
+
+	/* Atomic fragments (RFC 6946) are processed as normal packets */
+	if ((info->frag.offset == 0 && !info->more) || (info->more && (info->frag.len % 8)) ||
+	    info->frag.offset + info->frag.len > IP_DATAGRAM_MAX_LEN)
+		return 0;
+
+	memcpy(info->key.src, ip->src_addr.u32, sizeof(info->key.src));
+	memcpy(info->key.dst, ip->dst_addr.u32, sizeof(info->key.dst));
+	info->key.id = id;
+	info->key.ver = _ODP_IPV6;
+
+	return 1;
+}
+
+/* Returns 1 when the packet is a fragment that can be reassembled */
+static int frag_parse(const ip_reass_t *reass, odp_packet_t pkt, frag_info_t *info)
+{
+	uint8_t buf[FRAG_PARSE_BYTES];
+	const uint8_t *data;
+	uint32_t pkt_len = odp_packet_len(pkt);
+	uint32_t data_len = odp_packet_seg_len(pkt);
+	uint32_t offset = _ODP_ETHHDR_LEN;
+	uint16_t ethtype;
+	int num_vlan = 0;
+	int ret = 0;
+
+	if (odp_unlikely(data_len < FRAG_PARSE_BYTES && pkt_len > data_len)) {
+		data_len = _ODP_MIN(pkt_len, FRAG_PARSE_BYTES);
+		odp_packet_copy_to_mem(pkt, 0, data_len, buf);
+		data = buf;
+	} else {
+		data = odp_packet_data(pkt);
+	}
+
+	if (odp_unlikely(data_len < _ODP_ETHHDR_LEN))
+		return 0;
+
+	ethtype = (data[offset - 2] << 8) | data[offset - 1];
+
+	/* Fragments with more VLAN tags are left unprocessed */
+	while ((ethtype == _ODP_ETHTYPE_VLAN || ethtype == _ODP_ETHTYPE_VLAN_OUTER) &&
+	       num_vlan < FRAG_MAX_VLAN_TAGS && offset + _ODP_VLANHDR_LEN <= data_len) {
+		ethtype = (data[offset + 2] << 8) | data[offset + 3];
+		offset += _ODP_VLANHDR_LEN;
+		num_vlan++;
+	}
+
+	memset(&info->key, 0, sizeof(flow_key_t));
+	info->frag.pkt = pkt;
+
+	if (ethtype == _ODP_ETHTYPE_IPV4 && reass->en_ipv4)
+		ret = parse_ipv4(data, offset, data_len, pkt_len, info);
+	else if (ethtype == _ODP_ETHTYPE_IPV6 && reass->en_ipv6)
+		ret = parse_ipv6(data, offset, data_len, pkt_len, info);
+
+	/* Headers are copied into FRAG_PARSE_BYTES buffers on reassembly */
+	if (ret && odp_unlikely(info->frag.hdr_len > FRAG_PARSE_BYTES))
+		return 0;
+
+	return ret;
+}
+
+static inline void flow_release(ip_reass_t *reass, flow_t *flow)
+{
+	flow->used = 0;
+	odp_atomic_dec_u32(&reass->num_flows);
+}
+
+static inline int flow_timeout(const ip_reass_t *reass, const flow_t *flow, uint64_t now_ns)
+{
+	return now_ns > flow->first_ns + reass->max_wait_ns;
+}
+
+static flow_t *flow_find(bucket_t *bucket, const flow_key_t *key)
+{
+	for (int i = 0; i < BUCKET_SIZE; i++) {
+		flow_t *flow = &bucket->flow[i];
+
+		if (flow->used && !memcmp(&flow->key, key, sizeof(flow_key_t)))
+			return flow;
+	}
+
+	return NULL;
+}
+
+static flow_t *flow_alloc(ip_reass_t *reass, bucket_t *bucket, const flow_key_t *key,
+			  uint64_t now_ns)
+{
+	for (int i = 0; i < BUCKET_SIZE; i++) {
+		flow_t *flow = &bucket->flow[i];
+
+		if (flow->used)
+			continue;
+
+		flow->key = *key;
+		flow->first_ns = now_ns;
+		flow->total_len = 0;
+		flow->recv_len = 0;
+		flow->num_frags = 0;
+		flow->used = 1;
+		odp_atomic_inc_u32(&reass->num_flows);
+
+		return flow;
+	}
+
+	return NULL;
+}
+
+/* Add a fragment into a flow. Returns non-zero when the fragment overlaps or
+ * conflicts with the already received ones. */
+static int flow_add(flow_t *flow, const frag_info_t *info)
+{
+	const frag_t *new = &info->frag;
+	uint32_t end = new->offset + new->len;
+	int err = 0;
+
+	for (int i = 0; i < flow->num_frags; i++) {
+		const frag_t *frag = &flow->frag[i];
+
+		if (new->offset < frag->offset + frag->len && frag->offset < end)
+			err = 1;
+
+		if (!info->more && frag->offset + frag->len > end)
+			err = 1;
+	}
+
+	if (!info->more) {
+		if (flow->total_len)
+			err = 1;
+
+		flow->total_len = end;
+	} else if (flow->total_len && end > flow->total_len) {
+		err = 1;
+	}
+
+	flow->frag[flow->num_frags++] = *new;
+	flow->recv_len += new->len;
+
+	return err;
+}
+
+/* Output fragments of a flow as a packet with incomplete reassembly status */
+static odp_packet_t flow_incomplete(ip_reass_t *reass, const flow_t *flow, uint64_t now_ns)
+{
+	partial_t partial;
+	odp_packet_hdr_t *pkt_hdr;
+	odp_packet_t pkt;
+
+	pkt = odp_packet_alloc(reass->pool, sizeof(partial_t));
+
+	if (odp_unlikely(pkt == ODP_PACKET_INVALID)) {
+		for (int i = 0; i < flow->num_frags; i++)
+			odp_packet_free(flow->frag[i].pkt);
+
+		return ODP_PACKET_INVALID;
+	}
+
+	memset(&partial, 0, sizeof(partial_t));
+	/* Another thread may have stored the flow with a later time */
+	partial.elapsed_ns = now_ns > flow->first_ns ? now_ns - flow->first_ns : 0;
+	partial.num_frags = flow->num_frags;
+
+	for (int i = 0; i < flow->num_frags; i++)
+		partial.frag[i] = flow->frag[i].pkt;
+
+	odp_packet_copy_from_mem(pkt, 0, sizeof(partial_t), &partial);
+
+	pkt_hdr = packet_hdr(pkt);
+	pkt_hdr->p.flags.reass = ODP_PACKET_REASS_INCOMPLETE;
+	pkt_hdr->input = reass->pktio;
+
+	return pkt;
+}
+
+static void ipv4_hdr_update(odp_packet_t pkt, const frag_t *first, uint32_t total_len)
+{
+	uint8_t buf[_ODP_IPV4HDR_LEN * 3];
+	_odp_ipv4hdr_t *ip = (_odp_ipv4hdr_t *)(uintptr_t)buf;
+	uint32_t ihl = first->hdr_len - first->l3_offset;
+	uint16_t frag_offset;
+
+	odp_packet_copy_to_mem(pkt, first->l3_offset, ihl, buf);
+
+	/* Keep only the don't fragment flag */
+	frag_offset = odp_be_to_cpu_16(ip->frag_offset);
+	ip->frag_offset = odp_cpu_to_be_16(_ODP_IPV4HDR_FLAGS_DONT_FRAG(frag_offset));
+	ip->tot_len = odp_cpu_to_be_16(ihl + total_len);
+	ip->chksum = 0;
+	ip->chksum = ~chksum_finalize(chksum_partial(buf, ihl, 0));
+
+	odp_packet_copy_from_mem(pkt, first->l3_offset, ihl, buf);
+}
+
+static int ipv6_hdr_update(odp_packet_t *pkt, const frag_t *first, uint32_t total_len)
+{
+	uint8_t buf[FRAG_PARSE_BYTES];
+	_odp_ipv6hdr_t *ip = (_odp_ipv6hdr_t *)(uintptr_t)(buf + first->l3_offset);
+	uint32_t len = first->hdr_len - IPV6_FRAG_HDR_LEN;
+
+	/* Replace the fragment header with L2 and IPv6 headers moved forward */
+	odp_packet_copy_to_mem(*pkt, 0, first->hdr_len, buf);
+
+	ip->next_hdr = buf[len];
+	ip->payload_len = odp_cpu_to_be_16(total_len);
+
+	odp_packet_copy_from_mem(*pkt, IPV6_FRAG_HDR_LEN, len, buf);
+
+	return odp_packet_trunc_head(pkt, IPV6_FRAG_HDR_LEN, NULL, NULL) < 0 ? -1 : 0;
+}
+
+/* Trim packet to fragment data, and optionally remove the headers before it */
+static int frag_trim(odp_packet_t *pkt, const frag_t *frag, odp_bool_t trim_head)
+{
+	uint32_t pkt_len = odp_packet_len(*pkt);
+	uint32_t end = frag->hdr_len + frag->len;
+
+	if (pkt_len > end && odp_packet_trunc_tail(pkt, pkt_len - end, NULL, NULL) < 0)
+		return -1;
+
+	if (trim_head && odp_packet_trunc_head(pkt, frag->hdr_len, NULL, NULL) < 0)
+		return -1;
+
+	return 0;
+}
+
+/* Build a reassembled packet by linking fragment segments to the first fragment */
+static odp_packet_t flow_complete(ip_reass_t *reass, flow_t *flow, uint64_t now_ns)
+{
+	frag_t *frag = flow->frag;
+	const int num = flow->num_frags;
+	odp_packet_hdr_t *pkt_hdr;
+	odp_packet_t pkt;
+	uint32_t num_segs = 0;
+	int i;
+
+	/* Sort by offset. Fragments do not overlap and cover the datagram. */
+	for (i = 1; i < num; i++) {
+		frag_t tmp = frag[i];
+		int j = i - 1;
+
+		while (j >= 0 && frag[j].offset > tmp.offset) {
+			frag[j + 1] = frag[j];
+			j--;
+		}
+
+		frag[j + 1] = tmp;
+	}
+
+	for (i = 0; i < num; i++)
+		num_segs += odp_packet_num_segs(frag[i].pkt);
+
+	if (odp_unlikely(num_segs > PKT_MAX_SEGS ||
+			 frag[0].hdr_len + flow->total_len >
+			 _odp_pool_entry(odp_packet_pool(frag[0].pkt))->max_len))
+		return flow_incomplete(reass, flow, now_ns);
+
+	pkt = frag[0].pkt;
+
+	if (odp_unlikely(frag_trim(&pkt, &frag[0], false))) {
+		i = 1;
+		goto error;
+	}
+
+	for (i = 1; i < num; i++) {
+		odp_packet_t tail = frag[i].pkt;
+
+		if (odp_unlikely(frag_trim(&tail, &frag[i], true) ||
+				 odp_packet_concat(&pkt, tail) < 0)) {
+			odp_packet_free(tail);
+			i++;
+			goto error;
+		}
+	}
+
+	if (flow->key.ver == _ODP_IPV4) {
+		ipv4_hdr_update(pkt, &frag[0], flow->total_len);
+	} else if (odp_unlikely(ipv6_hdr_update(&pkt, &frag[0], flow->total_len))) {
+		odp_packet_free(pkt);
+		return ODP_PACKET_INVALID;
+	}
+
+	pkt_hdr = packet_hdr(pkt);
+	pkt_hdr->p.flags.reass = ODP_PACKET_REASS_COMPLETE;
+	pkt_hdr->reass_num_frags = num;
+
+	return pkt;
+
+error:
+	_ODP_DBG("Building reassembled packet failed\n");
+	odp_packet_free(pkt);
+
+	for (; i < num; i++)
+		odp_packet_free(frag[i].pkt);
+
+	return ODP_PACKET_INVALID;
+}
+
+odp_packet_t _odp_ip_reass_recv(ip_reass_t *reass, odp_packet_t pkt, uint64_t now_ns)
+{
+	frag_info_t info;
+	bucket_t *bucket;
+	flow_t *flow;
+	flow_t done;
+	odp_bool_t timeout = false;
+	odp_bool_t output = false;
+	odp_bool_t complete = false;
+
+	packet_hdr(pkt)->p.flags.reass = ODP_PACKET_REASS_NONE;
+
+	if (odp_likely(!frag_parse(reass, pkt, &info)))
+		return pkt;
+
+	bucket = &reass->bucket[odp_hash_crc32c(&info.key, sizeof(flow_key_t), 0) &
+				(NUM_BUCKETS - 1)];
+
+	odp_spinlock_lock(&bucket->lock);
+
+	flow = flow_find(bucket, &info.key);
+
+	/* Flow has timed out but has not been swept yet. Output it and start a new flow
+	 * with the fragment. */
+	if (flow && flow_timeout(reass, flow, now_ns)) {
+		done = *flow;
+		flow_release(reass, flow);
+		flow = NULL;
+		timeout = true;
+	}
+
+	if (flow == NULL) {
+		flow = flow_alloc(reass, bucket, &info.key, now_ns);
+
+		/* Table is full, pass the fragment through */
+		if (odp_unlikely(flow == NULL)) {
+			odp_spinlock_unlock(&bucket->lock);
+			return pkt;
+		}
+	}
+
+	/* A flow is output when it is complete, or when it cannot complete anymore. A new
+	 * flow is never output with its first fragment. */
+	if (flow_add(flow, &info)) {
+		output = true;
+	} else if (flow->total_len && flow->recv_len == flow->total_len) {
+		output = true;
+		complete = true;
+	} else if (flow->num_frags >= reass->max_frags) {
+		output = true;
+	}
+
+	if (output) {
+		done = *flow;
+		flow_release(reass, flow);
+	}
+
+	odp_spinlock_unlock(&bucket->lock);
+
+	if (timeout)
+		return flow_incomplete(reass, &done, now_ns);
+
+	if (!output)
+		return ODP_PACKET_INVALID;
+
+	if (complete)
+		return flow_complete(reass, &done, now_ns);
+
+	return flow_incomplete(reass, &done, now_ns);
+}
+
+int _odp_ip_reass_expire(ip_reass_t *reass, odp_packet_t pkt[], int num, uint64_t now_ns)
+{
+	uint64_t next_ns = odp_atomic_load_u64(&reass->next_sweep_ns);
+	int num_out = 0;
+	int num_left = 0;
+
+	if (odp_likely(now_ns < next_ns || num == 0 ||
+		       odp_atomic_load_u32(&reass->num_flows) == 0))
+		return 0;
+
+	/* One thread at a time sweeps the table */
+	if (!odp_atomic_cas_u64(&reass->next_sweep_ns, &next_ns, now_ns + reass->sweep_ns))
+		return 0;
+
+	for (int i = 0; i < NUM_BUCKETS; i++) {
+		bucket_t *bucket = &reass->bucket[i];
+		flow_t done[BUCKET_SIZE];
+		int num_done = 0;
+
+		odp_spinlock_lock(&bucket->lock);
+
+		for (int j = 0; j < BUCKET_SIZE; j++) {
+			flow_t *flow = &bucket->flow[j];
+
+			if (!flow->used || !flow_timeout(reass, flow, now_ns))
+				continue;
+
+			if (num_out + num_done == num) {
+				num_left++;
+				continue;
+			}
+
+			done[num_done++] = *flow;
+			flow_release(reass, flow);
+		}
+
+		odp_spinlock_unlock(&bucket->lock);
+
+		for (int j = 0; j < num_done; j++) {
+			pkt[num_out] = flow_incomplete(reass, &done[j], now_ns);
+
+			if (pkt[num_out] != ODP_PACKET_INVALID)
+				num_out++;
+		}
+
+		if (num_left)
+			break;
+	}
+
+	/* Output array was filled, continue on the next call */
+	if (num_left)
+		odp_atomic_store_u64(&reass->next_sweep_ns, now_ns);
+
+	return num_out;
+}
+
+int _odp_ip_reass_partial_state(odp_packet_t pkt, odp_packet_t frags[],
+				odp_packet_reass_partial_state_t *res)
+{
+	partial_t partial;
+
+	if (odp_packet_copy_to_mem(pkt, 0, sizeof(partial_t), &partial))
+		return -1;
+
+	for (uint32_t i = 0; i < partial.num_frags; i++)
+		frags[i] = partial.frag[i];
+
+	res->num_frags = partial.num_frags;
+	res->elapsed_time = partial.elapsed_ns;
+
+	odp_packet_free(pkt);
+
+	return 0;
+}
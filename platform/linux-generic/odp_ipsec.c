@@ -950,42 +950,6 @@ static int ipsec_in_prepare_packet(odp_packet_t *pkt, ipsec_state_t *state, ipse
 	       _odp_ipsec_sa_stats_precheck(*ipsec_sa, status) < 0;
 }
 
-static int ipsec_in_do_crypto(odp_packet_t *pkt, odp_crypto_packet_op_param_t *param,
-			      odp_ipsec_op_status_t *status)
-{
-	odp_crypto_packet_result_t result;
-	int rc;
-
-	if (odp_unlikely(odp_crypto_op(pkt, pkt, param, 1) < 0)) {
-		_ODP_DBG("Crypto failed\n");
-		goto alg_err;
-	}
-
-	rc = odp_crypto_result(&result, *pkt);
-
-	if (odp_likely(rc == 0))
-		return 0;
-
-	if (odp_unlikely(rc < -1)) {
-		_ODP_DBG("Crypto failed\n");
-		goto alg_err;
-	}
-
-	if (result.cipher_status.alg_err == ODP_CRYPTO_ALG_ERR_ICV_CHECK ||
-	    result.auth_status.alg_err == ODP_CRYPTO_ALG_ERR_ICV_CHECK)
-		goto auth_err;
-
-alg_err:
-	status->error.alg = 1;
-
-	return -1;
-
-auth_err:
-	status->error.auth = 1;
-
-	return -1;
-}
-
 static int ipsec_in_finalize_op(odp_packet_t *pkt, ipsec_state_t *state, ipsec_sa_t *ipsec_sa,
 				odp_ipsec_op_status_t *status)
 {
@@ -1150,58 +1114,13 @@ static void ipsec_in_parse_decap_packet(odp_packet_t pkt, ipsec_state_t *state,
 	op(pkt, state);
 }
 
-static ipsec_sa_t *ipsec_in_single(odp_packet_t pkt,
-				   odp_ipsec_sa_t sa,
-				   odp_packet_t *pkt_out,
-				   odp_bool_t enqueue_op,
-				   odp_ipsec_op_status_t *status,
-				   uint32_t *orig_ip_len)
-{
-	ipsec_state_t state;
-	ipsec_sa_t *ipsec_sa = NULL;
-	odp_crypto_packet_op_param_t param;
-
-	if (odp_unlikely(ipsec_in_prepare_packet(&pkt, &state, &ipsec_sa, sa, &param, status,
-						 orig_ip_len)))
-		goto exit;
-
-	if (ipsec_in_do_crypto(&pkt, &param, status))
-		goto exit;
-
-	if (ipsec_sa->antireplay) {
-		if (enqueue_op)
-			wait_for_order(ipsec_global->inbound_ordering_mode);
-
-		if (_odp_ipsec_sa_replay_update(ipsec_sa, state.in.seq_no, status) < 0)
-			goto exit;
-	}
-
-	if (odp_unlikely(ipsec_in_finalize_packet(&pkt, &state, ipsec_sa, status)))
-		goto post_lifetime_err_cnt_update;
-
-	ipsec_in_parse_decap_packet(pkt, &state, ipsec_sa);
-
-	goto exit;
-
-post_lifetime_err_cnt_update:
-	if (ipsec_config->stats_en) {
-		odp_atomic_inc_u64(&ipsec_sa->stats.post_lifetime_err_pkts);
-		odp_atomic_add_u64(&ipsec_sa->stats.post_lifetime_err_bytes, state.stats_length);
-	}
-
-exit:
-	*pkt_out = pkt;
-
-	if (ipsec_config->stats_en)
-		ipsec_sa_err_stats_update(ipsec_sa, status);
-
-	return ipsec_sa;
-}
-
 /* Generate sequence number */
 static inline
 uint64_t ipsec_seq_no(ipsec_sa_t *ipsec_sa)
 {
+	if (ipsec_sa->out.seq_block)
+		return _odp_ipsec_sa_alloc_seq_no(ipsec_sa);
+
 	return odp_atomic_fetch_add_u64(&ipsec_sa->hot.out.seq, 1);
 }
 
@@ -2137,6 +2056,31 @@ static inline void finish_packet_proc(odp_packet_t pkt, ipsec_op_t *op, odp_queu
 	}
 }
 
+static void ipsec_in_finalize_op_pkt(odp_packet_t *pkt, ipsec_op_t *op, odp_bool_t is_enq)
+{
+	if (odp_unlikely(op->status.error.all))
+		return;
+
+	if (odp_unlikely(ipsec_in_check_crypto_result(*pkt, &op->status)))
+		return;
+
+	if (op->sa->antireplay) {
+		if (is_enq)
+			wait_for_order(ipsec_global->inbound_ordering_mode);
+
+		if (odp_unlikely(_odp_ipsec_sa_replay_update(op->sa, op->state.in.seq_no,
+							     &op->status) < 0))
+			return;
+	}
+
+	if (odp_unlikely(ipsec_in_finalize_packet(pkt, &op->state, op->sa, &op->status))) {
+		update_post_lifetime_stats(op->sa, &op->state);
+		return;
+	}
+
+	ipsec_in_parse_decap_packet(*pkt, &op->state, op->sa);
+}
+
 static void ipsec_in_finalize(odp_packet_t pkt_in[], ipsec_op_t ops[], int num, odp_bool_t is_enq)
 {
 	for (int i = 0; i < num; i++) {
@@ -2144,35 +2088,64 @@ static void ipsec_in_finalize(odp_packet_t pkt_in[], ipsec_op_t ops[], int num,
 		odp_packet_t *pkt = &pkt_in[i];
 		odp_queue_t q = ODP_QUEUE_INVALID;
 
-		if (odp_unlikely(op->status.error.all))
-			goto finish;
+		ipsec_in_finalize_op_pkt(pkt, op, is_enq);
 
-		if (odp_unlikely(ipsec_in_check_crypto_result(*pkt, &op->status)))
-			goto finish;
+		if (is_enq)
+			q = NULL != op->sa ? op->sa->queue : ipsec_config->inbound.default_queue;
 
-		if (op->sa->antireplay) {
-			if (is_enq)
-				wait_for_order(ipsec_global->inbound_ordering_mode);
+		finish_packet_proc(*pkt, op, q);
+	}
+}
 
-			if (odp_unlikely(_odp_ipsec_sa_replay_update(op->sa, op->state.in.seq_no,
-								     &op->status) < 0))
-				goto finish;
-		}
+/*
+ * Finalize packets of inline inbound processing. Packets without an SA are
+ * left for normal packet input processing. Others get their IPsec result and
+ * SA destination queue.
+ */
+static int ipsec_in_inline_finalize(odp_packet_t pkt_in[], ipsec_op_t ops[], int num,
+				    odp_bool_t processed[])
+{
+	int num_processed = 0;
 
-		if (odp_unlikely(ipsec_in_finalize_packet(pkt, &op->state, op->sa,
-							  &op->status))) {
-			update_post_lifetime_stats(op->sa, &op->state);
-			goto finish;
+	for (int i = 0; i < num; i++) {
+		ipsec_op_t *op = &ops[i];
+		odp_packet_t *pkt = &pkt_in[i];
+		odp_ipsec_packet_result_t *res;
+		odp_packet_hdr_t *pkt_hdr;
+
+		/* Route packet back in case of lookup failure or early error before lookup */
+		if (NULL == op->sa) {
+			processed[i] = false;
+			continue;
 		}
 
-		ipsec_in_parse_decap_packet(*pkt, &op->state, op->sa);
+		ipsec_in_finalize_op_pkt(pkt, op, false);
 
-finish:
-		if (is_enq)
-			q = NULL != op->sa ? op->sa->queue : ipsec_config->inbound.default_queue;
+		if (ipsec_config->stats_en)
+			ipsec_sa_err_stats_update(op->sa, &op->status);
 
-		finish_packet_proc(*pkt, op, q);
+		packet_subtype_set(*pkt, ODP_EVENT_PACKET_IPSEC);
+		res = ipsec_pkt_result(*pkt);
+		memset(res, 0, sizeof(*res));
+		res->status = op->status;
+		res->orig_ip_len = op->orig_ip_len;
+		res->sa = op->sa->ipsec_sa_hdl;
+		res->flag.inline_mode = 1;
+
+		pkt_hdr = packet_hdr(*pkt);
+		pkt_hdr->p.input_flags.dst_queue = 1;
+		pkt_hdr->dst_queue = op->sa->queue;
+		/* Distinguish inline IPsec packets from classifier packets */
+		pkt_hdr->cos = CLS_COS_IDX_NONE;
+
+		/* Last thing */
+		_odp_ipsec_sa_unuse(op->sa);
+
+		processed[i] = true;
+		num_processed++;
 	}
+
+	return num_processed;
 }
 
 int odp_ipsec_in(const odp_packet_t pkt_in[], int num_in, odp_packet_t pkt_out[], int *num_out,
@@ -2337,46 +2310,34 @@ int odp_ipsec_out_enq(const odp_packet_t pkt_in[], int num_in, const odp_ipsec_o
 	return max_out;
 }
 
-int _odp_ipsec_try_inline(odp_packet_t *pkt)
+int _odp_ipsec_try_inline_multi(odp_packet_t pkt[], odp_bool_t processed[], int num)
 {
-	odp_ipsec_op_status_t status;
-	ipsec_sa_t *ipsec_sa;
-	uint32_t orig_ip_len = 0;
-	odp_ipsec_packet_result_t *result;
-	odp_packet_hdr_t *pkt_hdr;
-
-	if (odp_global_ro.disable.ipsec)
-		return -1;
+	odp_ipsec_in_param_t param;
+	odp_packet_t crypto_pkts[MAX_BURST];
+	odp_crypto_packet_op_param_t crypto_param[MAX_BURST];
+	ipsec_op_t ops[MAX_BURST], *crypto_ops[MAX_BURST];
+	int num_crypto, num_processed = 0;
 
-	memset(&status, 0, sizeof(status));
+	if (odp_global_ro.disable.ipsec) {
+		for (int i = 0; i < num; i++)
+			processed[i] = false;
 
-	ipsec_sa = ipsec_in_single(*pkt, ODP_IPSEC_SA_INVALID, pkt, false,
-				   &status, &orig_ip_len);
-	/*
-	 * Route packet back in case of lookup failure or early error before
-	 * lookup
-	 */
-	if (NULL == ipsec_sa)
-		return -1;
+		return 0;
+	}
 
-	packet_subtype_set(*pkt, ODP_EVENT_PACKET_IPSEC);
-	result = ipsec_pkt_result(*pkt);
-	memset(result, 0, sizeof(*result));
-	result->status = status;
-	result->orig_ip_len = orig_ip_len;
-	result->sa = ipsec_sa->ipsec_sa_hdl;
-	result->flag.inline_mode = 1;
+	/* SA lookup of each packet */
+	memset(&param, 0, sizeof(param));
 
-	pkt_hdr = packet_hdr(*pkt);
-	pkt_hdr->p.input_flags.dst_queue = 1;
-	pkt_hdr->dst_queue = ipsec_sa->queue;
-	/* Distinguish inline IPsec packets from classifier packets */
-	pkt_hdr->cos = CLS_COS_IDX_NONE;
+	for (int i = 0; i < num; i += MAX_BURST) {
+		int burst = _ODP_MIN(num - i, MAX_BURST);
 
-	/* Last thing */
-	_odp_ipsec_sa_unuse(ipsec_sa);
+		ipsec_in_prepare(&pkt[i], &pkt[i], burst, &param, ops, crypto_pkts, crypto_param,
+				 crypto_ops, &num_crypto);
+		ipsec_do_crypto_burst(crypto_pkts, crypto_param, crypto_ops, num_crypto);
+		num_processed += ipsec_in_inline_finalize(&pkt[i], ops, burst, &processed[i]);
+	}
 
-	return 0;
+	return num_processed;
 }
 
 static inline int ipsec_out_inline_check_out_hdrs(odp_packet_t pkt,
@@ -2584,7 +2545,7 @@ int odp_ipsec_test_sa_update(odp_ipsec_sa_t sa,
 
 	switch (sa_op) {
 	case ODP_IPSEC_TEST_SA_UPDATE_SEQ_NUM:
-		odp_atomic_store_u64(&ipsec_sa->hot.out.seq, sa_param->seq_num);
+		_odp_ipsec_sa_seq_no_set(ipsec_sa, sa_param->seq_num);
 		break;
 	default:
 		return -1;
@@ -2709,7 +2670,9 @@ void odp_ipsec_print(void)
 {
 	_ODP_PRINT("\nIPSEC print\n");
 	_ODP_PRINT("-----------\n");
-	_ODP_PRINT("  max number of SA %u\n\n", ipsec_config->max_num_sa);
+	_ODP_PRINT("  max number of SA %u\n", ipsec_config->max_num_sa);
+	_odp_ipsec_sad_print();
+	_ODP_PRINT("\n");
 }
 
 void odp_ipsec_sa_print(odp_ipsec_sa_t sa)
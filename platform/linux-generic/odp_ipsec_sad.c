@@ -8,14 +8,17 @@
 #include <odp/api/ipsec.h>
 #include <odp/api/random.h>
 #include <odp/api/shared_memory.h>
+#include <odp/api/sync.h>
 
 #include <odp/api/plat/atomic_inlines.h>
 #include <odp/api/plat/cpu_inlines.h>
+#include <odp/api/plat/sync_inlines.h>
 
 #include <odp_config_internal.h>
 #include <odp_init_internal.h>
 #include <odp_debug_internal.h>
 #include <odp_ipsec_internal.h>
+#include <odp_libconfig_internal.h>
 #include <odp_macros_internal.h>
 #include <odp_ring_mpmc_u32_internal.h>
 #include <odp_global_data.h>
@@ -74,6 +77,18 @@
 #define SA_LIFE_PACKETS_PREALLOC  64
 #define SA_LIFE_BYTES_PREALLOC    4000
 
+/*
+ * Outbound sequence numbers can be allocated in a similar way (see
+ * ipsec.out_seq_block config option). A thread reserves a block of sequence
+ * numbers from the SA-global counter and numbers its packets from the block.
+ * Sequence numbers remain unique, but packets processed by different threads
+ * are not numbered in processing order. Blocks are reserved only when
+ * needed, so unused numbers are skipped only at the end of the current block
+ * of each thread. Those are returned to the SA when it is disabled, if no
+ * other thread has reserved numbers after them.
+ */
+#define SA_SEQ_BLOCK_MAX (64 * 1024)
+
 typedef struct sa_thread_local_s {
 	/*
 	 * Packets that can be processed in this thread before looking at
@@ -90,10 +105,38 @@ typedef struct sa_thread_local_s {
 	 * counter(s).
 	 */
 	odp_ipsec_op_status_t lifetime_status;
+	/*
+	 * Next outbound sequence number of this thread, or zero when the
+	 * thread has not reserved a block of sequence numbers.
+	 */
+	odp_atomic_u64_t seq_next;
+	/* End of the current block of sequence numbers */
+	uint64_t seq_end;
 } sa_thread_local_t;
 
+/*
+ * Thread local SA state is allocated on first use in slabs of SA_SLAB_SIZE
+ * consecutive SAs, so that memory is used only for the SAs that each thread
+ * actually processes. Slabs are taken from a pool that is shared by all
+ * threads and sized by ipsec.sa_thread_state config option. A slab is never
+ * freed, but is reused by the next SAs created into the same SA indexes.
+ *
+ * When the pool runs out, a thread processes SAs of unallocated slabs
+ * without thread local state: it updates SA-global counters for every
+ * packet.
+ */
+#define SA_SLAB_SHIFT 6
+#define SA_SLAB_SIZE (1 << SA_SLAB_SHIFT)
+#define SA_SLAB_MASK (SA_SLAB_SIZE - 1)
+#define SA_SLABS_PER_THREAD ((CONFIG_IPSEC_MAX_NUM_SA + SA_SLAB_SIZE - 1) / SA_SLAB_SIZE)
+
+typedef struct sa_slab_s {
+	sa_thread_local_t sa[SA_SLAB_SIZE];
+} sa_slab_t;
+
 typedef struct ODP_ALIGNED_CACHE ipsec_thread_local_s {
-	sa_thread_local_t sa[CONFIG_IPSEC_MAX_NUM_SA];
+	/* Slab index + 1 for each group of SA_SLAB_SIZE SAs, or 0 */
+	odp_atomic_u32_t slab[SA_SLABS_PER_THREAD];
 	uint16_t first_ipv4_id; /* first ID of current block of IDs */
 	uint16_t next_ipv4_id;  /* next ID to be used */
 } ipsec_thread_local_t;
@@ -109,7 +152,13 @@ typedef struct ipsec_sa_table_t {
 		odp_spinlock_t lock;
 	} sa_freelist;
 	uint32_t max_num_sa;
+	uint32_t out_seq_block;
 	odp_shm_t shm;
+	struct {
+		sa_slab_t *slab;
+		uint32_t num;
+		odp_atomic_u32_t used;
+	} slab_pool;
 	ipsec_thread_local_t per_thread[];
 } ipsec_sa_table_t;
 
@@ -136,9 +185,68 @@ ipsec_sa_t *_odp_ipsec_sa_entry_from_hdl(odp_ipsec_sa_t sa)
 	return ipsec_sa_entry_from_hdl(sa);
 }
 
+static void sa_thread_local_reset(sa_thread_local_t *sa_tl)
+{
+	odp_atomic_init_u32(&sa_tl->packet_quota, 0);
+	odp_atomic_init_u32(&sa_tl->byte_quota, 0);
+	sa_tl->lifetime_status.all = 0;
+	odp_atomic_init_u64(&sa_tl->seq_next, 0);
+	sa_tl->seq_end = 0;
+}
+
+static uint32_t sa_slab_alloc(ipsec_thread_local_t *tl, uint32_t i)
+{
+	odp_atomic_u32_t *used = &ipsec_sa_tbl->slab_pool.used;
+	uint32_t num = ipsec_sa_tbl->slab_pool.num;
+	sa_slab_t *slab;
+	uint32_t idx;
+
+	/* Avoid incrementing the counter further when the pool is empty */
+	if (odp_atomic_load_u32(used) >= num)
+		return 0;
+
+	idx = odp_atomic_fetch_inc_u32(used);
+	if (idx >= num)
+		return 0;
+
+	slab = &ipsec_sa_tbl->slab_pool.slab[idx];
+
+	for (int j = 0; j < SA_SLAB_SIZE; j++)
+		sa_thread_local_reset(&slab->sa[j]);
+
+	/* Publish initialized slab to other threads */
+	odp_atomic_store_rel_u32(&tl->slab[i], idx + 1);
+
+	return idx + 1;
+}
+
+/* Thread local state of an SA in the calling thread, or NULL if out of memory */
 static inline sa_thread_local_t *ipsec_sa_thread_local(ipsec_sa_t *sa)
 {
-	return &ipsec_sa_tbl->per_thread[odp_thread_id()].sa[sa->ipsec_sa_idx];
+	ipsec_thread_local_t *tl = &ipsec_sa_tbl->per_thread[odp_thread_id()];
+	uint32_t i = sa->ipsec_sa_idx >> SA_SLAB_SHIFT;
+	uint32_t slab = odp_atomic_load_u32(&tl->slab[i]);
+
+	if (odp_unlikely(slab == 0)) {
+		slab = sa_slab_alloc(tl, i);
+
+		if (slab == 0)
+			return NULL;
+	}
+
+	return &ipsec_sa_tbl->slab_pool.slab[slab - 1].sa[sa->ipsec_sa_idx & SA_SLAB_MASK];
+}
+
+/* Thread local state of an SA in another thread, or NULL if not allocated */
+static inline sa_thread_local_t *ipsec_sa_thread_local_of(int thr, ipsec_sa_t *sa)
+{
+	ipsec_thread_local_t *tl = &ipsec_sa_tbl->per_thread[thr];
+	uint32_t slab = odp_atomic_load_acq_u32(&tl->slab[sa->ipsec_sa_idx >> SA_SLAB_SHIFT]);
+
+	if (slab == 0)
+		return NULL;
+
+	return &ipsec_sa_tbl->slab_pool.slab[slab - 1].sa[sa->ipsec_sa_idx & SA_SLAB_MASK];
 }
 
 static void init_sa_thread_local(ipsec_sa_t *sa)
@@ -148,19 +256,54 @@ static void init_sa_thread_local(ipsec_sa_t *sa)
 	int thread_count_max = odp_thread_count_max();
 
 	for (n = 0; n < thread_count_max; n++) {
-		sa_tl = &ipsec_sa_tbl->per_thread[n].sa[sa->ipsec_sa_idx];
-		odp_atomic_init_u32(&sa_tl->packet_quota, 0);
-		odp_atomic_init_u32(&sa_tl->byte_quota, 0);
-		sa_tl->lifetime_status.all = 0;
+		sa_tl = ipsec_sa_thread_local_of(n, sa);
+
+		if (sa_tl)
+			sa_thread_local_reset(sa_tl);
+	}
+}
+
+static int read_config_file(uint32_t *out_seq_block, uint32_t *sa_thread_state)
+{
+	const char *str = "ipsec.out_seq_block";
+	int val;
+
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 0 || val > SA_SEQ_BLOCK_MAX) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	/* Block of one number is the same as the SA-global counter */
+	*out_seq_block = val > 1 ? val : 0;
+
+	str = "ipsec.sa_thread_state";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
 	}
+
+	if (val < 0) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	*sa_thread_state = val;
+
+	return 0;
 }
 
 int _odp_ipsec_sad_init_global(void)
 {
 	odp_crypto_capability_t crypto_capa;
 	uint32_t max_num_sa = CONFIG_IPSEC_MAX_NUM_SA;
-	uint64_t shm_size;
+	uint64_t shm_size, slab_offset;
 	unsigned int thread_count_max = odp_thread_count_max();
+	uint32_t out_seq_block, sa_thread_state, num_slabs, max_slabs;
 	odp_shm_t shm;
 	unsigned i;
 
@@ -176,8 +319,19 @@ int _odp_ipsec_sad_init_global(void)
 	if (max_num_sa > crypto_capa.max_sessions)
 		max_num_sa = crypto_capa.max_sessions;
 
-	shm_size = sizeof(ipsec_sa_table_t) +
-		sizeof(ipsec_thread_local_t) * thread_count_max;
+	if (read_config_file(&out_seq_block, &sa_thread_state))
+		return -1;
+
+	/* Slabs needed for thread local state of every SA in every thread */
+	max_slabs = thread_count_max * ((max_num_sa + SA_SLAB_SIZE - 1) / SA_SLAB_SIZE);
+	num_slabs = (sa_thread_state + SA_SLAB_SIZE - 1) / SA_SLAB_SIZE;
+
+	if (sa_thread_state == 0 || num_slabs > max_slabs)
+		num_slabs = max_slabs;
+
+	slab_offset = _ODP_ROUNDUP_CACHE_LINE(sizeof(ipsec_sa_table_t) +
+					      sizeof(ipsec_thread_local_t) * thread_count_max);
+	shm_size = slab_offset + sizeof(sa_slab_t) * num_slabs;
 
 	shm = odp_shm_reserve("_odp_ipsec_sa_table",
 			      shm_size,
@@ -190,9 +344,17 @@ int _odp_ipsec_sad_init_global(void)
 	memset(ipsec_sa_tbl, 0, sizeof(ipsec_sa_table_t));
 	ipsec_sa_tbl->shm = shm;
 	ipsec_sa_tbl->max_num_sa = max_num_sa;
+	ipsec_sa_tbl->out_seq_block = out_seq_block;
+	ipsec_sa_tbl->slab_pool.slab = (sa_slab_t *)(uintptr_t)((uint8_t *)ipsec_sa_tbl +
+								slab_offset);
+	ipsec_sa_tbl->slab_pool.num = num_slabs;
+	odp_atomic_init_u32(&ipsec_sa_tbl->slab_pool.used, 0);
 
 	ring_mpmc_u32_init(&ipsec_sa_tbl->hot.ipv4_id_ring);
 	for (i = 0; i < thread_count_max; i++) {
+		for (int j = 0; j < SA_SLABS_PER_THREAD; j++)
+			odp_atomic_init_u32(&ipsec_sa_tbl->per_thread[i].slab[j], 0);
+
 		/*
 		 * Make the current ID block fully used, forcing allocation
 		 * of a fresh block at first use.
@@ -269,6 +431,24 @@ uint32_t _odp_ipsec_max_num_sa(void)
 	return ipsec_sa_tbl->max_num_sa;
 }
 
+void _odp_ipsec_sad_print(void)
+{
+	uint32_t num = ipsec_sa_tbl->slab_pool.num;
+	uint32_t used = odp_atomic_load_u32(&ipsec_sa_tbl->slab_pool.used);
+	odp_shm_info_t info;
+
+	if (used > num)
+		used = num;
+
+	if (odp_shm_info(ipsec_sa_tbl->shm, &info) == 0)
+		_ODP_PRINT("  SA table size    %" PRIu64 " kB\n", info.size / 1024);
+
+	_ODP_PRINT("  thread SA state  %u / %u slabs used, %" PRIu64 " / %" PRIu64 " kB\n",
+		   used, num, (uint64_t)used * sizeof(sa_slab_t) / 1024,
+		   (uint64_t)num * sizeof(sa_slab_t) / 1024);
+	_ODP_PRINT("  out seq block    %u\n", ipsec_sa_tbl->out_seq_block);
+}
+
 static ipsec_sa_t *ipsec_sa_reserve(void)
 {
 	ipsec_sa_t *ipsec_sa = NULL;
@@ -459,9 +639,8 @@ static int ipsec_antireplay_init(ipsec_sa_t *ipsec_sa,
 	num_bkts = IPSEC_AR_WIN_NUM_BUCKETS(ipsec_sa->in.ar.win_size);
 	ipsec_sa->in.ar.num_buckets = num_bkts;
 	odp_atomic_init_u64(&ipsec_sa->hot.in.wintop_seq, 0);
-	memset(ipsec_sa->hot.in.bucket_arr, 0, sizeof(uint64_t) * num_bkts);
-
-	odp_spinlock_init(&ipsec_sa->hot.in.lock);
+	for (uint16_t i = 0; i < num_bkts; i++)
+		odp_atomic_init_u64(&ipsec_sa->hot.in.bucket_arr[i], 0);
 
 	return 0;
 }
@@ -555,6 +734,7 @@ odp_ipsec_sa_t odp_ipsec_sa_create(const odp_ipsec_sa_param_t *param)
 	} else {
 		ipsec_sa->lookup_mode = ODP_IPSEC_LOOKUP_DISABLED;
 		odp_atomic_init_u64(&ipsec_sa->hot.out.seq, 1);
+		ipsec_sa->out.seq_block = ipsec_sa_tbl->out_seq_block;
 		ipsec_sa->out.frag_mode = param->outbound.frag_mode;
 		odp_atomic_init_u32(&ipsec_sa->out.mtu, param->outbound.mtu);
 	}
@@ -785,6 +965,39 @@ error:
 	return ODP_IPSEC_SA_INVALID;
 }
 
+/*
+ * Return unused sequence numbers of thread blocks to the SA. A block can be
+ * returned when it is the last one reserved. Outbound operations on the SA
+ * must have completed.
+ */
+static void ipsec_sa_seq_block_return(ipsec_sa_t *ipsec_sa)
+{
+	int thread_count_max = odp_thread_count_max();
+	odp_bool_t returned = true;
+	sa_thread_local_t *sa_tl;
+	uint64_t next;
+
+	while (returned) {
+		returned = false;
+
+		for (int n = 0; n < thread_count_max; n++) {
+			sa_tl = ipsec_sa_thread_local_of(n, ipsec_sa);
+			if (sa_tl == NULL)
+				continue;
+
+			next = odp_atomic_load_u64(&sa_tl->seq_next);
+
+			if (next == sa_tl->seq_end ||
+			    sa_tl->seq_end != odp_atomic_load_u64(&ipsec_sa->hot.out.seq))
+				continue;
+
+			odp_atomic_store_u64(&ipsec_sa->hot.out.seq, next);
+			sa_tl->seq_end = next;
+			returned = true;
+		}
+	}
+}
+
 int odp_ipsec_sa_disable(odp_ipsec_sa_t sa)
 {
 	ipsec_sa_t *ipsec_sa = ipsec_sa_entry_from_hdl(sa);
@@ -804,6 +1017,10 @@ int odp_ipsec_sa_disable(odp_ipsec_sa_t sa)
 					     state | IPSEC_SA_STATE_DISABLE);
 	}
 
+	/* Application must not disable an SA during outbound operations on it */
+	if (!ipsec_sa->inbound && ipsec_sa->out.seq_block)
+		ipsec_sa_seq_block_return(ipsec_sa);
+
 	if (ODP_QUEUE_INVALID != ipsec_sa->queue) {
 		odp_ipsec_warn_t warn = { .all = 0 };
 
@@ -910,12 +1127,69 @@ ipsec_sa_t *_odp_ipsec_sa_lookup(const ipsec_sa_lookup_t *lookup)
 	return best;
 }
 
+static void ipsec_sa_lifetime_check(ipsec_sa_t *ipsec_sa, uint64_t packets, uint64_t bytes,
+				    odp_ipsec_op_status_t *lifetime_status)
+{
+	if (ipsec_sa->soft_limit_packets > 0 &&
+	    packets >= ipsec_sa->soft_limit_packets)
+		lifetime_status->warn.soft_exp_packets = 1;
+
+	if (ipsec_sa->hard_limit_packets > 0 &&
+	    packets >= ipsec_sa->hard_limit_packets)
+		lifetime_status->error.hard_exp_packets = 1;
+
+	if (ipsec_sa->soft_limit_bytes > 0 &&
+	    bytes >= ipsec_sa->soft_limit_bytes)
+		lifetime_status->warn.soft_exp_bytes = 1;
+
+	if (ipsec_sa->hard_limit_bytes > 0 &&
+	    bytes >= ipsec_sa->hard_limit_bytes)
+		lifetime_status->error.hard_exp_bytes = 1;
+}
+
+/* Lifetime update without thread local state */
+static int ipsec_sa_lifetime_update_global(ipsec_sa_t *ipsec_sa, uint32_t len,
+					   odp_ipsec_op_status_t *status)
+{
+	odp_ipsec_op_status_t lifetime_status;
+	uint64_t packets, bytes;
+
+	packets = odp_atomic_fetch_add_u64(&ipsec_sa->hot.packets, 1) + 1;
+	bytes = odp_atomic_fetch_add_u64(&ipsec_sa->hot.bytes, len) + len;
+
+	lifetime_status.all = 0;
+	ipsec_sa_lifetime_check(ipsec_sa, packets, bytes, &lifetime_status);
+	status->all |= lifetime_status.all;
+
+	if (lifetime_status.error.hard_exp_packets ||
+	    lifetime_status.error.hard_exp_bytes)
+		return -1;
+	return 0;
+}
+
 int _odp_ipsec_sa_stats_precheck(ipsec_sa_t *ipsec_sa,
 				 odp_ipsec_op_status_t *status)
 {
 	int rc = 0;
 	sa_thread_local_t *sa_tl = ipsec_sa_thread_local(ipsec_sa);
 
+	if (odp_unlikely(sa_tl == NULL)) {
+		odp_ipsec_op_status_t lifetime_status;
+
+		lifetime_status.all = 0;
+		ipsec_sa_lifetime_check(ipsec_sa, odp_atomic_load_u64(&ipsec_sa->hot.packets),
+					odp_atomic_load_u64(&ipsec_sa->hot.bytes),
+					&lifetime_status);
+
+		if (lifetime_status.error.hard_exp_packets ||
+		    lifetime_status.error.hard_exp_bytes) {
+			status->all |= lifetime_status.all;
+			rc = -1;
+		}
+
+		return rc;
+	}
+
 	if (sa_tl->lifetime_status.error.hard_exp_packets ||
 	    sa_tl->lifetime_status.error.hard_exp_bytes) {
 		status->all |= sa_tl->lifetime_status.all;
@@ -933,6 +1207,9 @@ int _odp_ipsec_sa_lifetime_update(ipsec_sa_t *ipsec_sa, uint32_t len,
 	uint32_t tl_byte_quota;
 	uint32_t tl_pkt_quota;
 
+	if (odp_unlikely(sa_tl == NULL))
+		return ipsec_sa_lifetime_update_global(ipsec_sa, len, status);
+
 	tl_pkt_quota = odp_atomic_load_u32(&sa_tl->packet_quota);
 	if (odp_unlikely(tl_pkt_quota == 0)) {
 		packets = odp_atomic_fetch_add_u64(&ipsec_sa->hot.packets,
@@ -1007,55 +1284,64 @@ int _odp_ipsec_sa_replay_precheck(ipsec_sa_t *ipsec_sa, uint64_t seq,
 	return 0;
 }
 
+/*
+ * Lock-free AR window update for window sizes larger than 32.
+ *
+ * The window top is advanced first and the packet is then marked as seen in its
+ * bucket with a CAS that also checks the bucket tag. The tag holds only the
+ * lower 32 bits of the bucket sequence number, so tags are compared only for
+ * equality. A bucket with a different tag belongs either to an older range that
+ * has already slid out of the window, and is reused as if it was cleared, or to
+ * a newer range that has moved the window past the sequence number. Since a
+ * newer range is marked only after its window top update, the two cases are
+ * told apart by re-reading the window top.
+ */
 static inline int ipsec_wslarge_replay_update(ipsec_sa_t *ipsec_sa, uint64_t seq,
 					      odp_ipsec_op_status_t *status)
 {
-	uint64_t bucket, wintop_bucket, new_bucket;
-	uint64_t bkt_diff, bkt_cnt;
-	uint64_t bit = 0, top_seq;
-
-	odp_spinlock_lock(&ipsec_sa->hot.in.lock);
+	odp_atomic_u64_t *bucket;
+	uint64_t top_seq, old, new;
+	uint64_t blk = seq >> IPSEC_AR_WIN_BUCKET_BITS;
+	uint32_t tag = (uint32_t)blk;
+	uint32_t bit = 1U << (seq & IPSEC_AR_WIN_BITLOC_MASK);
+	uint32_t win_size = ipsec_sa->in.ar.win_size;
 
 	top_seq = odp_atomic_load_u64(&ipsec_sa->hot.in.wintop_seq);
-	if ((seq + ipsec_sa->in.ar.win_size) <= top_seq)
+	if ((seq + win_size) <= top_seq)
 		goto ar_err;
 
-	bucket = (seq >> IPSEC_AR_WIN_BUCKET_BITS);
+	/* AR window top sequence number */
+	while (seq > top_seq &&
+	       !odp_atomic_cas_acq_rel_u64(&ipsec_sa->hot.in.wintop_seq, &top_seq, seq))
+		;
 
-	/* Check if the seq is within the range */
-	if (seq > top_seq) {
-		wintop_bucket =	top_seq >> IPSEC_AR_WIN_BUCKET_BITS;
-		bkt_diff = bucket - wintop_bucket;
+	bucket = &ipsec_sa->hot.in.bucket_arr[blk % ipsec_sa->in.ar.num_buckets];
+	old = odp_atomic_load_u64(bucket);
 
-		/* Seq is way after the range of AR window size */
-		if (bkt_diff > ipsec_sa->in.ar.num_buckets)
-			bkt_diff = ipsec_sa->in.ar.num_buckets;
+	do {
+		uint32_t old_tag = old >> 32;
+		uint32_t bits = 0;
 
-		for (bkt_cnt = 0; bkt_cnt < bkt_diff; bkt_cnt++) {
-			new_bucket = (bkt_cnt + wintop_bucket + 1) %
-				     ipsec_sa->in.ar.num_buckets;
-			ipsec_sa->hot.in.bucket_arr[new_bucket] = 0;
+		if (old_tag == tag) {
+			bits = (uint32_t)old;
+		} else {
+			/* Pairs with the release of the bucket CAS */
+			odp_mb_acquire();
+			top_seq = odp_atomic_load_u64(&ipsec_sa->hot.in.wintop_seq);
+			if ((seq + win_size) <= top_seq)
+				goto ar_err;
 		}
 
-		/* AR window top sequence number */
-		odp_atomic_store_u64(&ipsec_sa->hot.in.wintop_seq, seq);
-	}
-
-	bucket %= ipsec_sa->in.ar.num_buckets;
-	bit = (uint64_t)1 << (seq & IPSEC_AR_WIN_BITLOC_MASK);
+		/* Already seen the packet, discard it */
+		if (bits & bit)
+			goto ar_err;
 
-	/* Already seen the packet, discard it */
-	if (ipsec_sa->hot.in.bucket_arr[bucket] & bit)
-		goto ar_err;
-
-	/* Packet is new, mark it as seen */
-	ipsec_sa->hot.in.bucket_arr[bucket] |= bit;
-	odp_spinlock_unlock(&ipsec_sa->hot.in.lock);
+		new = ((uint64_t)tag << 32) | bits | bit;
+	} while (!odp_atomic_cas_acq_rel_u64(bucket, &old, new));
 
 	return 0;
 ar_err:
 	status->error.antireplay = 1;
-	odp_spinlock_unlock(&ipsec_sa->hot.in.lock);
 	return -1;
 }
 
@@ -1137,6 +1423,93 @@ uint16_t _odp_ipsec_sa_alloc_ipv4_id(ipsec_sa_t *ipsec_sa)
 	return tl->next_ipv4_id++;
 }
 
+uint64_t _odp_ipsec_sa_alloc_seq_no(ipsec_sa_t *ipsec_sa)
+{
+	sa_thread_local_t *sa_tl = ipsec_sa_thread_local(ipsec_sa);
+	uint64_t seq, num;
+
+	if (odp_unlikely(sa_tl == NULL))
+		return odp_atomic_fetch_add_u64(&ipsec_sa->hot.out.seq, 1);
+
+	seq = odp_atomic_load_u64(&sa_tl->seq_next);
+
+	if (odp_unlikely(seq == sa_tl->seq_end)) {
+		/* Reserve a new block */
+		seq = odp_atomic_load_u64(&ipsec_sa->hot.out.seq);
+
+		do {
+			num = ipsec_sa->out.seq_block;
+
+			/*
+			 * Without ESN, a block ends at the 32-bit sequence
+			 * number wrap, so that a thread does not number its
+			 * packets across the wrap.
+			 */
+			if (!ipsec_sa->esn && (seq & UINT32_MAX) + num > UINT32_MAX + 1ull)
+				num = UINT32_MAX + 1ull - (seq & UINT32_MAX);
+		} while (!odp_atomic_cas_u64(&ipsec_sa->hot.out.seq, &seq, seq + num));
+
+		sa_tl->seq_end = seq + num;
+	}
+
+	odp_atomic_store_u64(&sa_tl->seq_next, seq + 1);
+
+	return seq;
+}
+
+void _odp_ipsec_sa_seq_no_set(ipsec_sa_t *ipsec_sa, uint64_t seq)
+{
+	int thread_count_max = odp_thread_count_max();
+	sa_thread_local_t *sa_tl;
+
+	for (int n = 0; n < thread_count_max; n++) {
+		sa_tl = ipsec_sa_thread_local_of(n, ipsec_sa);
+		if (sa_tl == NULL)
+			continue;
+
+		odp_atomic_store_u64(&sa_tl->seq_next, 0);
+		sa_tl->seq_end = 0;
+	}
+
+	odp_atomic_store_u64(&ipsec_sa->hot.out.seq, seq);
+}
+
+/* Sequence number of the last packet sent */
+static uint64_t ipsec_sa_out_seq_last(ipsec_sa_t *ipsec_sa)
+{
+	int thread_count_max = odp_thread_count_max();
+	uint64_t last = odp_atomic_load_u64(&ipsec_sa->hot.out.seq) - 1;
+	odp_bool_t found = false;
+	sa_thread_local_t *sa_tl;
+	uint64_t next, max = 0;
+
+	if (!ipsec_sa->out.seq_block)
+		return last;
+
+	/*
+	 * Every thread has used at least the first number of its current
+	 * block, and all its previous blocks. Thus the last number used by
+	 * any thread is the last sent number, unless no thread has a block.
+	 */
+	for (int n = 0; n < thread_count_max; n++) {
+		sa_tl = ipsec_sa_thread_local_of(n, ipsec_sa);
+		if (sa_tl == NULL)
+			continue;
+
+		next = odp_atomic_load_u64(&sa_tl->seq_next);
+
+		if (next == 0)
+			continue;
+
+		if (!found || next - 1 > max)
+			max = next - 1;
+
+		found = true;
+	}
+
+	return found ? max : last;
+}
+
 void _odp_ipsec_sa_stats_pkts(ipsec_sa_t *sa, odp_ipsec_stats_t *stats)
 {
 	int thread_count_max = odp_thread_count_max();
@@ -1157,7 +1530,10 @@ void _odp_ipsec_sa_stats_pkts(ipsec_sa_t *sa, odp_ipsec_stats_t *stats)
 	 */
 
 	for (n = 0; n < thread_count_max; n++) {
-		sa_tl = &ipsec_sa_tbl->per_thread[n].sa[sa->ipsec_sa_idx];
+		sa_tl = ipsec_sa_thread_local_of(n, sa);
+		if (sa_tl == NULL)
+			continue;
+
 		tl_pkt_quota += odp_atomic_load_u32(&sa_tl->packet_quota);
 		tl_byte_quota += odp_atomic_load_u32(&sa_tl->byte_quota);
 	}
@@ -1191,8 +1567,7 @@ static void ipsec_out_sa_info(ipsec_sa_t *ipsec_sa, odp_ipsec_sa_info_t *sa_info
 	sa_info->param.outbound.frag_mode = ipsec_sa->out.frag_mode;
 	sa_info->param.outbound.mtu = ipsec_sa->sa_info.out.mtu;
 
-	sa_info->outbound.seq_num =
-		(uint64_t)odp_atomic_load_u64(&ipsec_sa->hot.out.seq) -	1;
+	sa_info->outbound.seq_num = ipsec_sa_out_seq_last(ipsec_sa);
 
 	if (ipsec_sa->mode == ODP_IPSEC_MODE_TUNNEL) {
 		uint8_t *src, *dst;
@@ -20,6 +20,7 @@
 #include <odp_debug_internal.h>
 #include <odp_event_internal.h>
 #include <odp_event_validation_internal.h>
+#include <odp_ip_reass_internal.h>
 #include <odp_macros_internal.h>
 #include <odp_packet_internal.h>
 #include <odp_packet_io_internal.h>
@@ -38,7 +39,6 @@
 #include <protocols/tcp.h>
 #include <protocols/udp.h>
 
-#include <errno.h>
 #include <string.h>
 #include <stdio.h>
 #include <inttypes.h>
@@ -1524,6 +1524,14 @@ void odp_packet_print(odp_packet_t pkt)
 			    "  l3_offset      %" PRIu32 "\n", hdr->p.l3_offset);
 	len += _odp_snprint(&str[len], n - len,
 			    "  l4_offset      %" PRIu32 "\n", hdr->p.l4_offset);
+	if (hdr->p.tunnel.type) {
+		len += _odp_snprint(&str[len], n - len,
+				    "  tunnel         0x%" PRIx16 "\n", hdr->p.tunnel.all);
+		len += _odp_snprint(&str[len], n - len,
+				    "  inner l3_offs  %" PRIu32 "\n", hdr->p.inner_l3_offset);
+		len += _odp_snprint(&str[len], n - len,
+				    "  inner l4_offs  %" PRIu32 "\n", hdr->p.inner_l4_offset);
+	}
 	len += _odp_snprint(&str[len], n - len,
 			    "  frame_len      %" PRIu32 "\n", hdr->frame_len);
 	len += _odp_snprint(&str[len], n - len,
@@ -2352,25 +2360,28 @@ odp_packet_free_ctrl_t odp_packet_free_ctrl(odp_packet_t pkt)
 odp_packet_reass_status_t
 odp_packet_reass_status(odp_packet_t pkt)
 {
-	(void)pkt;
-	return ODP_PACKET_REASS_NONE;
+	return packet_hdr(pkt)->p.flags.reass;
 }
 
 int odp_packet_reass_info(odp_packet_t pkt, odp_packet_reass_info_t *info)
 {
-	(void)pkt;
-	(void)info;
-	return -1;
+	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
+
+	if (pkt_hdr->p.flags.reass != ODP_PACKET_REASS_COMPLETE)
+		return -1;
+
+	info->num_frags = pkt_hdr->reass_num_frags;
+	return 0;
 }
 
 int
 odp_packet_reass_partial_state(odp_packet_t pkt, odp_packet_t frags[],
 			       odp_packet_reass_partial_state_t *res)
 {
-	(void)pkt;
-	(void)frags;
-	(void)res;
-	return -ENOTSUP;
+	if (packet_hdr(pkt)->p.flags.reass != ODP_PACKET_REASS_INCOMPLETE)
+		return -1;
+
+	return _odp_ip_reass_partial_state(pkt, frags, res);
 }
 
 uint32_t odp_packet_disassemble(odp_packet_t pkt, odp_packet_buf_t pkt_buf[], uint32_t num)
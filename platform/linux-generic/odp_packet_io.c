@@ -22,6 +22,7 @@
 #include <odp/api/plat/time_inlines.h>
 
 #include <odp/autoheader_internal.h>
+#include <odp_chksum_internal.h>
 #include <odp_classification_internal.h>
 #include <odp_config_internal.h>
 #include <odp_debug_internal.h>
@@ -35,6 +36,9 @@
 #include <odp_queue_if.h>
 #include <odp_schedule_if.h>
 
+#include <protocols/ip.h>
+#include <protocols/tcp.h>
+
 #include <ifaddrs.h>
 #include <inttypes.h>
 #include <string.h>
@@ -116,6 +120,43 @@ static int read_config_file(pktio_global_t *pktio_glb)
 	pktio_glb->config.tx_compl_pool_size = val;
 	_ODP_PRINT("  %s: %i\n", str, val);
 
+	str = "pktio.gro.enable";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	pktio_glb->config.gro.enable = !!val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "pktio.gro.max_len";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val <= 0 || val > UINT16_MAX) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	pktio_glb->config.gro.max_len = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "pktio.gro.max_segs";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val <= 0) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	pktio_glb->config.gro.max_segs = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
 	_ODP_PRINT("\n");
 
 	return 0;
@@ -635,6 +676,22 @@ int odp_pktio_config(odp_pktio_t hdl, const odp_pktio_config_t *config)
 		return -1;
 	}
 
+	if ((config->reassembly.en_ipv4 && !capa.reassembly.ipv4 &&
+	     !(capa.reassembly.ip && config->reassembly.en_ipv6)) ||
+	    (config->reassembly.en_ipv6 && !capa.reassembly.ipv6 &&
+	     !(capa.reassembly.ip && config->reassembly.en_ipv4))) {
+		_ODP_ERR("Reassembly not supported\n");
+		return -1;
+	}
+
+	if ((config->reassembly.en_ipv4 || config->reassembly.en_ipv6) &&
+	    (config->reassembly.max_wait_time > capa.reassembly.max_wait_time ||
+	     config->reassembly.max_num_frags < 2 ||
+	     config->reassembly.max_num_frags > capa.reassembly.max_num_frags)) {
+		_ODP_ERR("Bad reassembly configuration\n");
+		return -1;
+	}
+
 	if (config->flow_control.pause_rx != ODP_PKTIO_LINK_PAUSE_OFF ||
 	    config->flow_control.pause_tx != ODP_PKTIO_LINK_PAUSE_OFF) {
 		_ODP_ERR("Link flow control is not supported\n");
@@ -849,6 +906,16 @@ static inline odp_packet_vector_t packet_vector_create(odp_packet_t packets[], u
 	return pktv;
 }
 
+static inline int pktin_gro(pktio_entry_t *entry, int pktin_index, odp_packet_t packets[],
+			    int num)
+{
+	if (odp_likely(!entry->in_queue[pktin_index].gro) || num < 2 ||
+	    entry->parse_layer < ODP_PROTO_LAYER_L4)
+		return num;
+
+	return _odp_gro_burst(&pktio_global->config.gro, packets, num);
+}
+
 static inline int pktin_recv_buf(pktio_entry_t *entry, int pktin_index,
 				 _odp_event_hdr_t *event_hdrs[], int num)
 {
@@ -864,6 +931,7 @@ static inline int pktin_recv_buf(pktio_entry_t *entry, int pktin_index,
 	}
 
 	num_rx = entry->ops->recv(entry, pktin_index, (odp_packet_t *)event_hdrs, num);
+	num_rx = pktin_gro(entry, pktin_index, (odp_packet_t *)event_hdrs, num_rx);
 
 	if (!vector_enabled || num_rx < 2)
 		return num_rx;
@@ -1491,6 +1559,9 @@ void odp_pktio_print(odp_pktio_t hdl)
 
 	_ODP_PRINT("\n%s", str);
 
+	if (_ODP_PCAPNG)
+		_odp_pcapng_print(entry);
+
 	if (entry->ops->print)
 		entry->ops->print(entry);
 
@@ -1592,6 +1663,8 @@ int odp_pktio_capability(odp_pktio_t pktio, odp_pktio_capability_t *capa)
 	capa->lso.max_payload_offset     = PKTIO_LSO_MAX_PAYLOAD_OFFSET;
 	capa->lso.max_num_custom         = ODP_LSO_MAX_CUSTOM;
 	capa->lso.proto.ipv4             = 1;
+	capa->lso.proto.tcp_ipv4         = 1;
+	capa->lso.proto.tcp_ipv6         = 1;
 	capa->lso.proto.custom           = 1;
 	capa->lso.mod_op.add_segment_num = 1;
 	capa->lso.mod_op.write_bits      = 1;
@@ -1613,9 +1686,6 @@ int odp_pktio_capability(odp_pktio_t pktio, odp_pktio_capability_t *capa)
 		capa->vector.min_tmo_ns = 0;
 	}
 
-	capa->reassembly.ip = false;
-	capa->reassembly.ipv4 = false;
-	capa->reassembly.ipv6 = false;
 	capa->flow_control.pause_rx = 0;
 	capa->flow_control.pfc_rx = 0;
 	capa->flow_control.pause_tx = 0;
@@ -2147,6 +2217,7 @@ int odp_pktin_queue_config(odp_pktio_t pktio, const odp_pktin_queue_param_t *par
 		entry->in_queue[i].pktin.index = i;
 		entry->in_queue[i].pktin.pktio = entry->handle;
 		entry->in_queue[i].vector = param->vector;
+		entry->in_queue[i].gro = pktio_global->config.gro.enable;
 	}
 
 	entry->num_in_queue = num_queues;
@@ -2521,7 +2592,7 @@ int odp_pktin_recv(odp_pktin_queue_t queue, odp_packet_t packets[], int num)
 	if (_ODP_PCAPNG)
 		_odp_pcapng_dump_pkts(entry, queue.index, packets, ret);
 
-	return ret;
+	return pktin_gro(entry, queue.index, packets, ret);
 }
 
 int odp_pktin_recv_tmo(odp_pktin_queue_t queue, odp_packet_t packets[], int num,
@@ -2552,7 +2623,7 @@ int odp_pktin_recv_tmo(odp_pktin_queue_t queue, odp_packet_t packets[], int num,
 		if (_ODP_PCAPNG)
 			_odp_pcapng_dump_pkts(entry, queue.index, packets, ret);
 
-		return ret;
+		return pktin_gro(entry, queue.index, packets, ret);
 	}
 
 	while (1) {
@@ -2561,7 +2632,7 @@ int odp_pktin_recv_tmo(odp_pktin_queue_t queue, odp_packet_t packets[], int num,
 			_odp_pcapng_dump_pkts(entry, queue.index, packets, ret);
 
 		if (ret != 0 || wait == 0)
-			return ret;
+			return pktin_gro(entry, queue.index, packets, ret);
 
 		/* Avoid unnecessary system calls. Record the start time
 		 * only when needed and after the first call to recv. */
@@ -2619,15 +2690,15 @@ int odp_pktin_recv_mq_tmo(const odp_pktin_queue_t queues[], uint32_t num_q, uint
 	if (ret > 0 && from)
 		*from = lfrom;
 	if (trial_successful) {
-		if (_ODP_PCAPNG) {
-			pktio_entry_t *entry;
+		pktio_entry_t *entry = get_pktio_entry(queues[lfrom].pktio);
 
-			entry = get_pktio_entry(queues[lfrom].pktio);
-			if (entry)
-				_odp_pcapng_dump_pkts(entry, lfrom, packets, ret);
-		}
+		if (entry == NULL)
+			return ret;
 
-		return ret;
+		if (_ODP_PCAPNG)
+			_odp_pcapng_dump_pkts(entry, lfrom, packets, ret);
+
+		return pktin_gro(entry, queues[lfrom].index, packets, ret);
 	}
 
 	ts.tv_sec  = 0;
@@ -2839,8 +2910,10 @@ odp_lso_profile_t odp_lso_profile_create(odp_pktio_t pktio, const odp_lso_profil
 	lso_profile_t *lso_prof = NULL;
 	(void)pktio;
 
-	/* Currently only IPv4 and custom implemented */
+	/* Currently only IPv4, TCP and custom implemented */
 	if (param->lso_proto != ODP_LSO_PROTO_IPV4 &&
+	    param->lso_proto != ODP_LSO_PROTO_TCP_IPV4 &&
+	    param->lso_proto != ODP_LSO_PROTO_TCP_IPV6 &&
 	    param->lso_proto != ODP_LSO_PROTO_CUSTOM) {
 		_ODP_ERR("Protocol not supported\n");
 		return ODP_LSO_PROFILE_INVALID;
@@ -3078,6 +3151,195 @@ static int lso_update_custom(lso_profile_t *lso_prof, odp_packet_t pkt, int segn
 	return 0;
 }
 
+static int lso_check_tcp(odp_packet_t pkt, odp_lso_protocol_t lso_proto, uint32_t hdr_len)
+{
+	_odp_tcphdr_t tcp;
+	uint32_t l3_offset = odp_packet_l3_offset(pkt);
+	uint32_t l4_offset = odp_packet_l4_offset(pkt);
+	const int ipv4 = lso_proto == ODP_LSO_PROTO_TCP_IPV4;
+	uint32_t l3_min = ipv4 ? _ODP_IPV4HDR_LEN : _ODP_IPV6HDR_LEN;
+
+	if (l3_offset == ODP_PACKET_OFFSET_INVALID || l4_offset == ODP_PACKET_OFFSET_INVALID) {
+		_ODP_ERR("Invalid L3 or L4 offset\n");
+		return -1;
+	}
+
+	if (l4_offset < l3_offset + l3_min || hdr_len < l4_offset + _ODP_TCPHDR_LEN) {
+		_ODP_ERR("Bad payload, L3 or L4 offset\n");
+		return -1;
+	}
+
+	if (odp_packet_copy_to_mem(pkt, l4_offset, sizeof(tcp), &tcp))
+		return -1;
+
+	if (l4_offset + 4 * tcp.hl != hdr_len) {
+		_ODP_ERR("TCP header length does not match payload offset\n");
+		return -1;
+	}
+
+	if (tcp.syn || tcp.rst || tcp.urg) {
+		_ODP_ERR("Cannot segment TCP packets with SYN, RST or URG flag\n");
+		return -1;
+	}
+
+	if (ipv4) {
+		_odp_ipv4hdr_t ip;
+
+		if (odp_packet_copy_to_mem(pkt, l3_offset, sizeof(ip), &ip))
+			return -1;
+
+		if (_ODP_IPV4HDR_VER(ip.ver_ihl) != _ODP_IPV4 || ip.proto != _ODP_IPPROTO_TCP ||
+		    _ODP_IPV4HDR_IS_FRAGMENT(odp_be_to_cpu_16(ip.frag_offset))) {
+			_ODP_ERR("Not a TCP over IPv4 packet\n");
+			return -1;
+		}
+	} else {
+		_odp_ipv6hdr_t ip;
+		uint32_t ver;
+
+		if (odp_packet_copy_to_mem(pkt, l3_offset, sizeof(ip), &ip))
+			return -1;
+
+		ver = (odp_be_to_cpu_32(ip.ver_tc_flow) & _ODP_IPV6HDR_VERSION_MASK) >>
+		      _ODP_IPV6HDR_VERSION_SHIFT;
+
+		if (ver != _ODP_IPV6 || ip.next_hdr != _ODP_IPPROTO_TCP) {
+			_ODP_ERR("Not a TCP over IPv6 packet\n");
+			return -1;
+		}
+
+		/* TCP header must follow the IPv6 header */
+		if (l4_offset != l3_offset + _ODP_IPV6HDR_LEN) {
+			_ODP_ERR("IPv6 extension headers not supported\n");
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+/* Sum of the source and destination addresses of the TCP pseudo header */
+static int lso_tcp_addr_sum(odp_packet_t pkt, uint32_t l3_offset, int ipv4, uint64_t *sum)
+{
+	uint32_t addr_offset, addr_len;
+	uint8_t addr[2 * _ODP_IPV6ADDR_LEN];
+
+	if (ipv4) {
+		addr_offset = l3_offset + ODP_OFFSETOF(_odp_ipv4hdr_t, src_addr);
+		addr_len = 2 * _ODP_IPV4ADDR_LEN;
+	} else {
+		addr_offset = l3_offset + ODP_OFFSETOF(_odp_ipv6hdr_t, src_addr);
+		addr_len = 2 * _ODP_IPV6ADDR_LEN;
+	}
+
+	if (odp_packet_copy_to_mem(pkt, addr_offset, addr_len, addr))
+		return -1;
+
+	*sum = chksum_partial(addr, addr_len, 0);
+
+	return 0;
+}
+
+/*
+ * Copy payload data between packets. When 'sum' is not NULL, a partial
+ * checksum of the copied data is calculated in the same pass while the data
+ * is still in cache.
+ */
+static int lso_copy_payload(odp_packet_t dst, uint32_t dst_offset, odp_packet_t src,
+			    uint32_t src_offset, uint32_t len, uint64_t *sum)
+{
+	uint32_t src_seg_len, dst_seg_len, cpy_len;
+	uint8_t *src_ptr, *dst_ptr;
+	uint32_t done = 0;
+	uint64_t partial = 0;
+
+	if (sum == NULL)
+		return odp_packet_copy_from_pkt(dst, dst_offset, src, src_offset, len);
+
+	while (done < len) {
+		src_ptr = odp_packet_offset(src, src_offset + done, &src_seg_len, NULL);
+		dst_ptr = odp_packet_offset(dst, dst_offset + done, &dst_seg_len, NULL);
+
+		if (odp_unlikely(src_ptr == NULL || dst_ptr == NULL))
+			return -1;
+
+		cpy_len = len - done;
+		if (src_seg_len < cpy_len)
+			cpy_len = src_seg_len;
+		if (dst_seg_len < cpy_len)
+			cpy_len = dst_seg_len;
+
+		memcpy(dst_ptr, src_ptr, cpy_len);
+		partial += chksum_partial(src_ptr, cpy_len, done);
+		done += cpy_len;
+	}
+
+	*sum = partial;
+
+	return 0;
+}
+
+/*
+ * Update IP and TCP headers of a TCP segment. 'sum' is the partial checksum of
+ * the pseudo header addresses and the segment payload.
+ */
+static int lso_update_tcp(odp_packet_t pkt, int index, int num_pkt, uint32_t l3_offset,
+			  uint32_t l4_offset, uint32_t hdr_len, uint32_t payload_len,
+			  int ipv4, uint64_t sum)
+{
+	_odp_tcphdr_t *tcp;
+	uint8_t *l3;
+	uint32_t seg_len;
+	uint32_t pkt_len = odp_packet_len(pkt);
+	uint16_t tcp_len = pkt_len - l4_offset;
+
+	odp_packet_l3_offset_set(pkt, l3_offset);
+	odp_packet_l4_offset_set(pkt, l4_offset);
+	l3 = odp_packet_l3_ptr(pkt, &seg_len);
+
+	if (odp_unlikely(l3 == NULL || seg_len < hdr_len - l3_offset)) {
+		_ODP_ERR("Headers not contiguous in memory\n");
+		return -1;
+	}
+
+	if (ipv4) {
+		_odp_ipv4hdr_t *ip = (_odp_ipv4hdr_t *)(uintptr_t)l3;
+
+		ip->tot_len = odp_cpu_to_be_16(pkt_len - l3_offset);
+
+		/* Generate unique identification values unless DF flag is set */
+		if (!_ODP_IPV4HDR_FLAGS_DONT_FRAG(odp_be_to_cpu_16(ip->frag_offset)))
+			ip->id = odp_cpu_to_be_16(odp_be_to_cpu_16(ip->id) + index);
+
+		if (_odp_packet_ipv4_chksum_insert(pkt))
+			return -1;
+	} else {
+		_odp_ipv6hdr_t *ip = (_odp_ipv6hdr_t *)(uintptr_t)l3;
+
+		ip->payload_len = odp_cpu_to_be_16(pkt_len - l3_offset - _ODP_IPV6HDR_LEN);
+	}
+
+	tcp = (_odp_tcphdr_t *)(uintptr_t)(l3 + l4_offset - l3_offset);
+	tcp->seq_no = odp_cpu_to_be_32(odp_be_to_cpu_32(tcp->seq_no) +
+				       (uint32_t)index * payload_len);
+
+	/* FIN and PSH flags only in the last, CWR flag only in the first segment */
+	if (index < (num_pkt - 1)) {
+		tcp->fin = 0;
+		tcp->psh = 0;
+	}
+
+	if (index > 0)
+		tcp->cwr = 0;
+
+	tcp->cksm = 0;
+	sum += odp_cpu_to_be_16(_ODP_IPPROTO_TCP) + odp_cpu_to_be_16(tcp_len);
+	sum += chksum_partial(tcp, hdr_len - l4_offset, 0);
+	tcp->cksm = ~chksum_finalize(sum);
+
+	return 0;
+}
+
 int _odp_lso_num_packets(odp_packet_t packet, const odp_packet_lso_opt_t *lso_opt,
 			 uint32_t *len_out, uint32_t *left_over_out)
 {
@@ -3123,6 +3385,10 @@ int _odp_lso_num_packets(odp_packet_t packet, const odp_packet_lso_opt_t *lso_op
 
 		/* Round down payload len to a multiple of 8 (on other than the last fragment). */
 		payload_len = (payload_len / 8) * 8;
+	} else if (lso_prof->param.lso_proto == ODP_LSO_PROTO_TCP_IPV4 ||
+		   lso_prof->param.lso_proto == ODP_LSO_PROTO_TCP_IPV6) {
+		if (lso_check_tcp(packet, lso_prof->param.lso_proto, hdr_len))
+			return -1;
 	}
 
 	num_pkt = pkt_payload / payload_len;
@@ -3155,6 +3421,9 @@ int _odp_lso_create_packets(odp_packet_t packet, const odp_packet_lso_opt_t *lso
 	const uint32_t hdr_len = lso_opt->payload_offset;
 	const uint32_t pkt_len = hdr_len + payload_len;
 	odp_pool_t pool = odp_packet_pool(packet);
+	const odp_lso_protocol_t lso_proto = lso_prof->param.lso_proto;
+	const int tcp = lso_proto == ODP_LSO_PROTO_TCP_IPV4 || lso_proto == ODP_LSO_PROTO_TCP_IPV6;
+	uint64_t payload_sum[num_pkt];
 	int num_free = 0;
 	int num_full = num_pkt;
 
@@ -3193,7 +3462,8 @@ int _odp_lso_create_packets(odp_packet_t packet, const odp_packet_lso_opt_t *lso
 	/* Copy payload */
 	for (i = 0; i < num_full; i++) {
 		offset = hdr_len + (i * payload_len);
-		if (odp_packet_copy_from_pkt(pkt_out[i], hdr_len, packet, offset, payload_len)) {
+		if (lso_copy_payload(pkt_out[i], hdr_len, packet, offset, payload_len,
+				     tcp ? &payload_sum[i] : NULL)) {
 			_ODP_ERR("Payload copy failed\n");
 			goto error;
 		}
@@ -3202,14 +3472,36 @@ int _odp_lso_create_packets(odp_packet_t packet, const odp_packet_lso_opt_t *lso
 	/* Copy left over payload */
 	if (left_over_len) {
 		offset = hdr_len + (num_full * payload_len);
-		if (odp_packet_copy_from_pkt(pkt_out[num_pkt - 1], hdr_len, packet, offset,
-					     left_over_len)){
+		if (lso_copy_payload(pkt_out[num_pkt - 1], hdr_len, packet, offset, left_over_len,
+				     tcp ? &payload_sum[num_pkt - 1] : NULL)) {
 			_ODP_ERR("Payload copy failed\n");
 			goto error;
 		}
 	}
 
-	if (lso_prof->param.lso_proto == ODP_LSO_PROTO_IPV4) {
+	if (tcp) {
+		const int ipv4 = lso_proto == ODP_LSO_PROTO_TCP_IPV4;
+		uint32_t l3_offset = odp_packet_l3_offset(packet);
+		uint32_t l4_offset = odp_packet_l4_offset(packet);
+		uint64_t addr_sum;
+
+		if (l3_offset == ODP_PACKET_OFFSET_INVALID ||
+		    l4_offset == ODP_PACKET_OFFSET_INVALID) {
+			_ODP_ERR("Invalid L3 or L4 offset\n");
+			goto error;
+		}
+
+		if (lso_tcp_addr_sum(packet, l3_offset, ipv4, &addr_sum))
+			goto error;
+
+		for (i = 0; i < num_pkt; i++) {
+			if (lso_update_tcp(pkt_out[i], i, num_pkt, l3_offset, l4_offset, hdr_len,
+					   payload_len, ipv4, addr_sum + payload_sum[i])) {
+				_ODP_ERR("TCP header update failed. Packet %i.\n", i);
+				goto error;
+			}
+		}
+	} else if (lso_proto == ODP_LSO_PROTO_IPV4) {
 		offset = odp_packet_l3_offset(packet);
 
 		if (offset == ODP_PACKET_OFFSET_INVALID) {
@@ -351,6 +351,306 @@ static inline void parse_sctp(packet_parser_t *prs, const uint8_t **parseptr,
 	*parseptr += sizeof(_odp_sctphdr_t);
 }
 
+/* GRE header flags */
+#define GRE_FLAG_CSUM    0x8000
+#define GRE_FLAG_ROUTING 0x4000
+#define GRE_FLAG_KEY     0x2000
+#define GRE_FLAG_SEQ     0x1000
+#define GRE_VERSION_MASK 0x0007
+
+/* VXLAN, GENEVE and GTP-U base header length */
+#define TUNNEL_UDP_HDR_LEN 8
+
+/* VXLAN valid VNI flag */
+#define VXLAN_FLAG_VNI 0x08
+
+/* GTP-U version 1 flags and G-PDU message type */
+#define GTPU_VER_PT_MASK 0xf0
+#define GTPU_VER1_PT     0x30
+#define GTPU_FLAG_EXT    0x04
+#define GTPU_FLAGS_OPT   0x07
+#define GTPU_MSG_GPDU    0xff
+#define GTPU_OPT_HDR_LEN 12
+
+/* MPLS bottom of stack flag in the third byte of a label stack entry */
+#define MPLS_BOS      0x01
+#define MPLS_LSE_LEN  4
+
+/* Maximum number of MPLS labels skipped when looking for the inner IP header */
+#define MPLS_MAX_LABELS 8
+
+/**
+ * Parser helper function for inner IP and L4 headers of a tunneled packet
+ *
+ * - ptr points to the inner header at offset
+ * - end is the maximum offset that can be accessed plus one
+ * - ethtype is the inner header type. Zero selects IPv4 or IPv6 by the IP
+ *   version field. An inner Ethernet header (_ODP_ETHTYPE_TEB) is skipped
+ *   together with up to one VLAN tag.
+ *
+ * Tunnel metadata is stored only when a valid inner IP header was found.
+ * L4 headers of inner IP fragments are not parsed, so that all fragments of a
+ * flow hash and classify alike.
+ */
+static inline void parse_inner(packet_parser_t *prs, const uint8_t *ptr,
+			       uint32_t offset, uint32_t end, uint16_t ethtype,
+			       _odp_tunnel_type_t type)
+{
+	_odp_packet_tunnel_t tunnel;
+	uint32_t hlen;
+	uint8_t ip_proto;
+
+	if (ethtype == _ODP_ETHTYPE_TEB) {
+		if (offset + _ODP_ETHHDR_LEN + _ODP_VLANHDR_LEN > end)
+			return;
+
+		ethtype = odp_be_to_cpu_16(((const _odp_ethhdr_t *)ptr)->type);
+		ptr += _ODP_ETHHDR_LEN;
+		offset += _ODP_ETHHDR_LEN;
+
+		if (ethtype == _ODP_ETHTYPE_VLAN) {
+			ethtype = odp_be_to_cpu_16(((const _odp_vlanhdr_t *)ptr)->type);
+			ptr += _ODP_VLANHDR_LEN;
+			offset += _ODP_VLANHDR_LEN;
+		}
+	}
+
+	if (offset + _ODP_IPV4HDR_LEN > end)
+		return;
+
+	if (ethtype == 0) {
+		if ((ptr[0] >> 4) == _ODP_IPV4)
+			ethtype = _ODP_ETHTYPE_IPV4;
+		else if ((ptr[0] >> 4) == _ODP_IPV6)
+			ethtype = _ODP_ETHTYPE_IPV6;
+	}
+
+	tunnel.all = 0;
+	tunnel.type = type;
+
+	if (ethtype == _ODP_ETHTYPE_IPV4) {
+		const _odp_ipv4hdr_t *ipv4 = (const _odp_ipv4hdr_t *)ptr;
+
+		hlen = _ODP_IPV4HDR_IHL(ipv4->ver_ihl) * 4;
+		if (_ODP_IPV4HDR_VER(ipv4->ver_ihl) != _ODP_IPV4 ||
+		    hlen < _ODP_IPV4HDR_LEN || offset + hlen > end)
+			return;
+
+		tunnel.ipv4 = 1;
+		ip_proto = ipv4->proto;
+		if (_ODP_IPV4HDR_IS_FRAGMENT(odp_be_to_cpu_16(ipv4->frag_offset)))
+			ip_proto = _ODP_IPPROTO_INVALID;
+	} else if (ethtype == _ODP_ETHTYPE_IPV6) {
+		hlen = _ODP_IPV6HDR_LEN;
+		if ((ptr[0] >> 4) != _ODP_IPV6 || offset + hlen > end)
+			return;
+
+		tunnel.ipv6 = 1;
+		ip_proto = ((const _odp_ipv6hdr_t *)ptr)->next_hdr;
+	} else {
+		return;
+	}
+
+	prs->inner_l3_offset = offset;
+	offset += hlen;
+
+	switch (ip_proto) {
+	case _ODP_IPPROTO_TCP:
+		tunnel.tcp = offset + _ODP_TCPHDR_LEN <= end;
+		break;
+	case _ODP_IPPROTO_UDP:
+		tunnel.udp = offset + _ODP_UDPHDR_LEN <= end;
+		break;
+	case _ODP_IPPROTO_SCTP:
+		tunnel.sctp = offset + _ODP_SCTPHDR_LEN <= end;
+		break;
+	default:
+		break;
+	}
+
+	prs->inner_l4_offset = offset;
+	prs->tunnel = tunnel;
+}
+
+/**
+ * Parser helper function for GRE
+ *
+ * Only version 0 GRE without source routing is supported.
+ */
+static inline void parse_gre(packet_parser_t *prs, const uint8_t *ptr,
+			     uint32_t offset, uint32_t end)
+{
+	uint16_t flags, ethtype;
+	uint32_t hlen = 4;
+
+	if (offset + hlen > end)
+		return;
+
+	flags = odp_be_to_cpu_16(*((const odp_una_u16_t *)ptr));
+	ethtype = odp_be_to_cpu_16(*((const odp_una_u16_t *)ptr + 1));
+
+	if (flags & (GRE_FLAG_ROUTING | GRE_VERSION_MASK))
+		return;
+
+	if (flags & GRE_FLAG_CSUM)
+		hlen += 4;
+	if (flags & GRE_FLAG_KEY)
+		hlen += 4;
+	if (flags & GRE_FLAG_SEQ)
+		hlen += 4;
+
+	/* Inner Ethernet type must not be zero, which would mean autodetect */
+	if (ethtype)
+		parse_inner(prs, ptr + hlen, offset + hlen, end, ethtype, _ODP_TUNNEL_GRE);
+}
+
+/**
+ * Parser helper function for GTP-U
+ *
+ * Only G-PDU messages of GTP version 1 are parsed. Extension headers are
+ * skipped.
+ */
+static inline void parse_gtpu(packet_parser_t *prs, const uint8_t *ptr,
+			      uint32_t offset, uint32_t end)
+{
+	uint8_t flags = ptr[0];
+	uint32_t hlen = TUNNEL_UDP_HDR_LEN;
+
+	if ((flags & GTPU_VER_PT_MASK) != GTPU_VER1_PT || ptr[1] != GTPU_MSG_GPDU)
+		return;
+
+	if (flags & GTPU_FLAGS_OPT) {
+		uint8_t next;
+
+		hlen = GTPU_OPT_HDR_LEN;
+		if (offset + hlen > end)
+			return;
+
+		next = ptr[hlen - 1];
+
+		while ((flags & GTPU_FLAG_EXT) && next) {
+			uint32_t ext_len;
+
+			if (offset + hlen + 1 > end)
+				return;
+
+			/* Extension header length is in 4 byte units */
+			ext_len = ptr[hlen] * 4;
+			if (ext_len == 0 || offset + hlen + ext_len > end)
+				return;
+
+			hlen += ext_len;
+			next = ptr[hlen - 1];
+		}
+	}
+
+	parse_inner(prs, ptr + hlen, offset + hlen, end, 0, _ODP_TUNNEL_GTPU);
+}
+
+/**
+ * Parser helper function for UDP based tunnels (VXLAN, GENEVE and GTP-U)
+ *
+ * Tunnels are recognized by the well-known UDP destination port.
+ */
+static inline void parse_udp_tunnel(packet_parser_t *prs, const uint8_t *ptr,
+				    uint32_t offset, uint32_t end)
+{
+	const _odp_udphdr_t *udp = (const _odp_udphdr_t *)ptr;
+	uint16_t dport = odp_be_to_cpu_16(udp->dst_port);
+	uint32_t hlen = TUNNEL_UDP_HDR_LEN;
+
+	if (odp_likely(dport != _ODP_UDP_VXLAN_PORT && dport != _ODP_UDP_GENEVE_PORT &&
+		       dport != _ODP_UDP_GTPU_PORT))
+		return;
+
+	ptr += _ODP_UDPHDR_LEN;
+	offset += _ODP_UDPHDR_LEN;
+
+	if (offset + hlen > end)
+		return;
+
+	switch (dport) {
+	case _ODP_UDP_VXLAN_PORT:
+		if (ptr[0] & VXLAN_FLAG_VNI)
+			parse_inner(prs, ptr + hlen, offset + hlen, end, _ODP_ETHTYPE_TEB,
+				    _ODP_TUNNEL_VXLAN);
+		break;
+
+	case _ODP_UDP_GENEVE_PORT:
+		/* Version 0, option length in 4 byte units */
+		if (ptr[0] >> 6)
+			break;
+
+		hlen += (ptr[0] & 0x3f) * 4;
+		parse_inner(prs, ptr + hlen, offset + hlen, end,
+			    odp_be_to_cpu_16(*((const odp_una_u16_t *)ptr + 1)),
+			    _ODP_TUNNEL_GENEVE);
+		break;
+
+	default:
+		parse_gtpu(prs, ptr, offset, end);
+		break;
+	}
+}
+
+/**
+ * Parser helper function for MPLS
+ *
+ * Skips the label stack and parses the IP packet following it. Pseudowire
+ * payloads are not parsed.
+ */
+static inline void parse_mpls(packet_parser_t *prs, const uint8_t *ptr,
+			      uint32_t offset, uint32_t end)
+{
+	int i;
+
+	for (i = 0; i < MPLS_MAX_LABELS; i++) {
+		uint8_t bos;
+
+		if (offset + MPLS_LSE_LEN > end)
+			return;
+
+		bos = ptr[2] & MPLS_BOS;
+		ptr += MPLS_LSE_LEN;
+		offset += MPLS_LSE_LEN;
+
+		if (bos) {
+			parse_inner(prs, ptr, offset, end, 0, _ODP_TUNNEL_MPLS);
+			return;
+		}
+	}
+}
+
+/**
+ * Parser helper function for tunnels carried over IP
+ *
+ * - ptr points to the first byte after the outer IP header at offset
+ */
+static inline void parse_tunnel(packet_parser_t *prs, const uint8_t *ptr,
+				uint32_t offset, uint32_t end, uint8_t ip_proto)
+{
+	switch (ip_proto) {
+	case _ODP_IPPROTO_IPIP:
+		parse_inner(prs, ptr, offset, end, _ODP_ETHTYPE_IPV4, _ODP_TUNNEL_IPIP);
+		break;
+
+	case _ODP_IPPROTO_IPV6:
+		parse_inner(prs, ptr, offset, end, _ODP_ETHTYPE_IPV6, _ODP_TUNNEL_IPIP);
+		break;
+
+	case _ODP_IPPROTO_GRE:
+		parse_gre(prs, ptr, offset, end);
+		break;
+
+	case _ODP_IPPROTO_UDP:
+		parse_udp_tunnel(prs, ptr, offset, end);
+		break;
+
+	default:
+		break;
+	}
+}
+
 /*
  * Requires up to PARSE_L3_L4_BYTES bytes of contiguous packet data.
  *
@@ -365,6 +665,7 @@ int _odp_packet_parse_common_l3_l4(packet_parser_t *prs,
 				   odp_pktin_config_opt_t opt)
 {
 	uint8_t  ip_proto;
+	const uint8_t *l4_ptr;
 
 	prs->l3_offset = offset;
 
@@ -401,6 +702,15 @@ int _odp_packet_parse_common_l3_l4(packet_parser_t *prs,
 		ip_proto = 255;  /* Reserved invalid by IANA */
 		break;
 
+	case _ODP_ETHTYPE_MPLS:
+	case _ODP_ETHTYPE_MPLS_MCAST:
+		prs->input_flags.l3 = 0;
+		ip_proto = 255;  /* Reserved invalid by IANA */
+		if (layer == ODP_PROTO_LAYER_ALL)
+			parse_mpls(prs, parseptr, offset,
+				   _ODP_MIN(seg_end, PARSE_TUNNEL_BYTES));
+		break;
+
 	default:
 		prs->input_flags.l3 = 0;
 		ip_proto = 255;  /* Reserved invalid by IANA */
@@ -411,6 +721,7 @@ int _odp_packet_parse_common_l3_l4(packet_parser_t *prs,
 
 	/* Set l4 flag only for known ip_proto */
 	prs->input_flags.l4 = 1;
+	l4_ptr = parseptr;
 
 	/* Parse Layer 4 headers */
 	switch (ip_proto) {
@@ -422,7 +733,7 @@ int _odp_packet_parse_common_l3_l4(packet_parser_t *prs,
 		break;
 
 	case _ODP_IPPROTO_IPIP:
-		/* Do nothing */
+		/* Inner headers are parsed below */
 		break;
 
 	case _ODP_IPPROTO_TCP:
@@ -471,5 +782,229 @@ int _odp_packet_parse_common_l3_l4(packet_parser_t *prs,
 		break;
 	}
 
+	if (layer == ODP_PROTO_LAYER_ALL && !prs->input_flags.ipfrag &&
+	    !prs->flags.all.error)
+		parse_tunnel(prs, l4_ptr, prs->l4_offset,
+			     _ODP_MIN(seg_end, PARSE_TUNNEL_BYTES), ip_proto);
+
 	return prs->flags.all.error != 0;
 }
+
+/* Frames shorter than this are always parsed with the scalar parser */
+#define PARSE_MULTI_MIN_LEN (_ODP_ETHHDR_LEN + _ODP_IPV4HDR_LEN + _ODP_TCPHDR_LEN)
+
+/* L4 header offsets of frames selected for the burst parser fast path */
+#define PARSE_MULTI_IPV4_L4 (_ODP_ETHHDR_LEN + _ODP_IPV4HDR_LEN)
+#define PARSE_MULTI_IPV6_L4 (_ODP_ETHHDR_LEN + _ODP_IPV6HDR_LEN)
+
+/* One vector lane per frame of a burst. The compiler maps operations on these
+ * to the SIMD instructions of the target, or to scalar code when none are
+ * available. */
+typedef uint32_t parse_vec_t __attribute__((vector_size(PARSE_MULTI_BURST * sizeof(uint32_t))));
+typedef int32_t parse_mask_t __attribute__((vector_size(PARSE_MULTI_BURST * sizeof(int32_t))));
+
+/*
+ * Select frames for the burst parser fast path
+ *
+ * Header fields, which tell if a frame is a plain Ethernet / IPv4 (no options,
+ * not fragmented) or Ethernet / IPv6 (no extension headers) TCP or UDP packet,
+ * are gathered into vectors and checked for all frames of the burst at once.
+ * Writes into l4_off[] the L4 header offset of the selected frames, and zero
+ * for frames that need the scalar parser.
+ */
+static inline void parse_multi_select(const uint8_t *data[], const uint32_t len[], int num,
+				      uint32_t l4_off[])
+{
+	static const uint8_t zero_hdr[PARSE_MULTI_MIN_LEN];
+	parse_vec_t v_len, v_mac, v_type, v_ver, v_len4, v_len6, v_frag, v_proto4, v_proto6;
+	parse_vec_t v_l4, v_proto, v_need;
+	parse_mask_t ipv4, ipv6, sel;
+	int i;
+
+	/* Short frames and unused lanes read an all zero header, which is
+	 * never selected */
+	for (i = 0; i < PARSE_MULTI_BURST; i++) {
+		const int valid = i < num && len[i] >= PARSE_MULTI_MIN_LEN;
+		const uint8_t *p = valid ? data[i] : zero_hdr;
+
+		v_len[i] = valid ? len[i] : 0;
+		v_mac[i] = p[0];
+		v_type[i] = (p[12] << 8) | p[13];
+		v_ver[i] = p[14];
+		v_len4[i] = (p[16] << 8) | p[17];
+		v_len6[i] = (p[18] << 8) | p[19];
+		v_frag[i] = (p[20] << 8) | p[21];
+		v_proto4[i] = p[23];
+		v_proto6[i] = p[20];
+	}
+
+	/* IP length checks of the scalar parser. Length of a selected frame
+	 * is at least PARSE_MULTI_MIN_LEN, so the subtraction does not wrap. */
+	ipv4 = (v_type == _ODP_ETHTYPE_IPV4) & (v_ver == 0x45) &
+	       ((v_frag & 0x3fff) == 0) & (v_len4 <= v_len - _ODP_ETHHDR_LEN) &
+	       ((v_proto4 == _ODP_IPPROTO_TCP) | (v_proto4 == _ODP_IPPROTO_UDP));
+	ipv6 = (v_type == _ODP_ETHTYPE_IPV6) & ((v_ver >> 4) == _ODP_IPV6) &
+	       (v_len6 + _ODP_IPV6HDR_LEN <= v_len - _ODP_ETHHDR_LEN) &
+	       ((v_proto6 == _ODP_IPPROTO_TCP) | (v_proto6 == _ODP_IPPROTO_UDP));
+
+	/* Lane masks are all ones or zero */
+	v_l4 = ((parse_vec_t)ipv4 & PARSE_MULTI_IPV4_L4) | ((parse_vec_t)ipv6 & PARSE_MULTI_IPV6_L4);
+	v_proto = ((parse_vec_t)ipv4 & v_proto4) | ((parse_vec_t)ipv6 & v_proto6);
+	v_need = v_l4 + (((parse_vec_t)(v_proto == _ODP_IPPROTO_TCP) & _ODP_TCPHDR_LEN) |
+			 ((parse_vec_t)(v_proto == _ODP_IPPROTO_UDP) & _ODP_UDPHDR_LEN));
+
+	/* Multicast and broadcast Ethernet frames are left to the scalar parser */
+	sel = (ipv4 | ipv6) & ((v_mac & 1) == 0) & (v_len >= v_need);
+	v_l4 &= (parse_vec_t)sel;
+
+	for (i = 0; i < num; i++)
+		l4_off[i] = v_l4[i];
+}
+
+/*
+ * Parse a frame selected by parse_multi_select()
+ *
+ * Produces the same metadata as _odp_packet_parse_common(). Returns 0 without
+ * modifying the packet header when the frame needs the scalar parser after
+ * all, otherwise returns 1 and writes the parse result into 'ret'.
+ */
+static inline int parse_multi_fast(odp_packet_hdr_t *pkt_hdr, const uint8_t *data,
+				   uint32_t len, uint32_t l4_off, int layer,
+				   odp_pktin_config_opt_t opt, int *ret)
+{
+	packet_parser_t *prs = &pkt_hdr->p;
+	_odp_packet_input_flags_t input_flags;
+	const int l4_sum = opt.bit.udp_chksum || opt.bit.tcp_chksum;
+	uint64_t l4_part_sum = 0;
+	uint8_t ip_proto;
+
+	if (odp_unlikely(prs->flags.l3_chksum_err))
+		return 0;
+
+	input_flags.all = 0;
+	input_flags.l2 = 1;
+	input_flags.eth = 1;
+	input_flags.jumbo = len > _ODP_ETH_LEN_MAX;
+	input_flags.l3 = 1;
+	input_flags.l4 = 1;
+
+	if (l4_off == PARSE_MULTI_IPV4_L4) {
+		const _odp_ipv4hdr_t *ipv4 = (const _odp_ipv4hdr_t *)(data + _ODP_ETHHDR_LEN);
+		uint32_t dstaddr = odp_be_to_cpu_32(ipv4->dst_addr);
+
+		if (opt.bit.ipv4_chksum) {
+			if (chksum_finalize(chksum_partial(ipv4, _ODP_IPV4HDR_LEN, 0)) != 0xffff)
+				return 0;
+
+			input_flags.l3_chksum_done = 1;
+		}
+
+		input_flags.ipv4 = 1;
+		input_flags.ip_bcast = dstaddr == 0xffffffff;
+		input_flags.ip_mcast = (dstaddr >> 28) == 0xe;
+		ip_proto = ipv4->proto;
+
+		if (l4_sum)
+			l4_part_sum = chksum_partial((const uint8_t *)&ipv4->src_addr,
+						     2 * _ODP_IPV4ADDR_LEN, 0);
+	} else {
+		const _odp_ipv6hdr_t *ipv6 = (const _odp_ipv6hdr_t *)(data + _ODP_ETHHDR_LEN);
+
+		input_flags.ipv6 = 1;
+		input_flags.ip_mcast = ipv6->dst_addr.u8[0] == 0xff;
+		ip_proto = ipv6->next_hdr;
+
+		if (l4_sum)
+			l4_part_sum = chksum_partial((const uint8_t *)&ipv6->src_addr,
+						     2 * _ODP_IPV6ADDR_LEN, 0);
+	}
+
+	if (ip_proto == _ODP_IPPROTO_TCP) {
+		const _odp_tcphdr_t *tcp = (const _odp_tcphdr_t *)(data + l4_off);
+
+		if (odp_unlikely(tcp->hl < sizeof(_odp_tcphdr_t) / sizeof(uint32_t)))
+			return 0;
+
+		input_flags.tcp = 1;
+
+		if (opt.bit.tcp_chksum) {
+			l4_part_sum += odp_cpu_to_be_16((uint16_t)(len - l4_off));
+#if ODP_BYTE_ORDER == ODP_BIG_ENDIAN
+			l4_part_sum += _ODP_IPPROTO_TCP;
+#else
+			l4_part_sum += _ODP_IPPROTO_TCP << 8;
+#endif
+		}
+	} else {
+		const _odp_udphdr_t *udp = (const _odp_udphdr_t *)(data + l4_off);
+		uint16_t dport = odp_be_to_cpu_16(udp->dst_port);
+
+		/* IPsec NAT traversal and UDP tunnels are left to the scalar
+		 * parser */
+		if (odp_unlikely(odp_be_to_cpu_16(udp->length) < sizeof(_odp_udphdr_t) ||
+				 dport == _ODP_UDP_IPSEC_PORT))
+			return 0;
+
+		if (layer == ODP_PROTO_LAYER_ALL &&
+		    odp_unlikely(dport == _ODP_UDP_VXLAN_PORT || dport == _ODP_UDP_GENEVE_PORT ||
+				 dport == _ODP_UDP_GTPU_PORT))
+			return 0;
+
+		input_flags.udp = 1;
+
+		if (opt.bit.udp_chksum) {
+			if (udp->chksum == 0) {
+				/* Zero checksum is an error with IPv6 */
+				if (input_flags.ipv6)
+					return 0;
+
+				input_flags.l4_chksum_done = 1;
+			} else {
+				l4_part_sum += udp->length;
+#if ODP_BYTE_ORDER == ODP_BIG_ENDIAN
+				l4_part_sum += _ODP_IPPROTO_UDP;
+#else
+				l4_part_sum += _ODP_IPPROTO_UDP << 8;
+#endif
+			}
+			input_flags.udp_chksum_zero = (udp->chksum == 0);
+		}
+	}
+
+	prs->input_flags.all |= input_flags.all;
+	prs->l2_offset = 0;
+	prs->l3_offset = _ODP_ETHHDR_LEN;
+	prs->l4_offset = l4_off;
+
+	*ret = _odp_packet_l4_chksum(pkt_hdr, opt, l4_part_sum);
+
+	return 1;
+}
+
+void _odp_packet_parse_multi(odp_packet_hdr_t *pkt_hdr[], const uint8_t *data[],
+			     const uint32_t len[], int num, int layer,
+			     odp_pktin_config_opt_t opt, int ret[])
+{
+	uint32_t l4_off[PARSE_MULTI_BURST];
+	int i, j, n;
+
+	for (i = 0; i < num; i += n) {
+		n = _ODP_MIN(num - i, PARSE_MULTI_BURST);
+
+		if (layer >= ODP_PROTO_LAYER_L4)
+			parse_multi_select(&data[i], &len[i], n, l4_off);
+		else
+			memset(l4_off, 0, sizeof(l4_off));
+
+		for (j = 0; j < n; j++) {
+			const int k = i + j;
+
+			if (l4_off[j] && parse_multi_fast(pkt_hdr[k], data[k], len[k], l4_off[j],
+							  layer, opt, &ret[k]))
+				continue;
+
+			ret[k] = _odp_packet_parse_common(pkt_hdr[k], data[k], len[k], len[k],
+							  layer, opt);
+		}
+	}
+}
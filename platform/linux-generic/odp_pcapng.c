@@ -9,23 +9,32 @@
 
 #if defined(_ODP_PCAPNG) && _ODP_PCAPNG == 1
 
+#include <odp/api/atomic.h>
+#include <odp/api/byteorder.h>
 #include <odp/api/hints.h>
 #include <odp/api/shared_memory.h>
 #include <odp/api/spinlock.h>
+#include <odp/api/time.h>
 
 #include <odp/api/plat/packet_inlines.h>
 #include <odp/api/plat/packet_io_inlines.h>
+#include <odp/api/plat/time_inlines.h>
 
 #include <odp_config_internal.h>
 #include <odp_global_data.h>
 #include <odp_init_internal.h>
+#include <odp_libconfig_internal.h>
 #include <odp_macros_internal.h>
 #include <odp_packet_io_internal.h>
 #include <odp_pcapng.h>
+#include <odp_ring_u32_internal.h>
+#include <protocols/eth.h>
 
 #include <errno.h>
 #include <fcntl.h>
+#include <inttypes.h>
 #include <limits.h>
+#include <poll.h>
 #include <pthread.h>
 #include <unistd.h>
 #include <sys/stat.h>
@@ -47,6 +56,23 @@
 #define PKTIO_MAX_QUEUES (ODP_PKTIN_MAX_QUEUES > ODP_PKTOUT_MAX_QUEUES ? \
 				ODP_PKTIN_MAX_QUEUES : ODP_PKTOUT_MAX_QUEUES)
 
+/* Maximum number of capture records written with one writev() call */
+#define PCAPNG_WRITE_BURST 32
+
+/* Writer thread sleep time when there is nothing to write */
+#define PCAPNG_WRITER_SLEEP_US 1000
+
+/* Poll timeout for waiting the reader to make room for a partially written burst */
+#define PCAPNG_WRITE_POLL_MS 10
+
+/* Maximum time to wait for the reader to make room for a partially written burst.
+ * Records that are not completely written by then are dropped. */
+#define PCAPNG_WRITE_TIMEOUT_NS (100 * ODP_TIME_MSEC_IN_NS)
+
+/* Packet header bytes needed by the capture filter (Ethernet, two VLAN tags
+ * and IP protocol/next header field) */
+#define PCAPNG_FILTER_HDR_LEN (_ODP_ETHHDR_LEN + 8 + 10)
+
 /* pcapng: enhanced packet block file encoding */
 typedef struct ODP_PACKED pcapng_section_hdr_block_s {
 	uint32_t block_type;
@@ -77,6 +103,32 @@ typedef struct pcapng_enhanced_packet_block_s {
 	uint32_t packet_len;
 } pcapng_enhanced_packet_block_t;
 
+/* Captured packet copy */
+typedef struct {
+	uint64_t timestamp;
+	uint32_t pkt_len;
+	uint32_t cap_len;
+	uint8_t data[];
+} pcapng_rec_t;
+
+/* Capture ring of a pktio queue. Workers take records from the free ring,
+ * copy packet data into those and pass them to the writer thread through
+ * the full ring. */
+typedef struct {
+	ring_u32_t *free;
+	ring_u32_t *full;
+	uint8_t *rec_base;
+
+	/* Packets written into the fifo */
+	odp_atomic_u64_t captured;
+
+	/* Packets dropped due to no free capture records */
+	odp_atomic_u64_t drop_ring;
+
+	/* Packets dropped due to full fifo */
+	odp_atomic_u64_t drop_fifo;
+} pcapng_queue_t;
+
 /** Pktio entry specific data */
 typedef struct {
 	pktio_entry_t *pktio_entry;
@@ -87,6 +139,16 @@ typedef struct {
 		PCAPNG_WR_PKT,
 	} state[PKTIO_MAX_QUEUES];
 	int fd[PKTIO_MAX_QUEUES];
+
+	/* Capture rings */
+	odp_shm_t shm;
+	uint32_t num_queues;
+	uint32_t snaplen;
+	uint32_t rec_size;
+	pcapng_queue_t queue[PKTIO_MAX_QUEUES];
+
+	/* Writer thread is writing the capture rings of the entry into fifos */
+	odp_atomic_u32_t writer_busy;
 } pcapng_entry_t;
 
 typedef struct ODP_ALIGNED_CACHE {
@@ -96,7 +158,17 @@ typedef struct ODP_ALIGNED_CACHE {
 	int inotify_fd;
 	int inotify_watch_fd;
 	int inotify_is_running;
+	pthread_t writer_thread;
+	odp_atomic_u32_t writer_exit;
 	odp_spinlock_t lock;
+
+	struct {
+		uint32_t ring_size;
+		uint32_t snaplen;
+		uint16_t filter_ethtype;
+		uint8_t filter_ip_proto;
+	} config;
+
 	pcapng_entry_t entry[CONFIG_PKTIO_ENTRIES];
 } pcapng_global_t;
 
@@ -109,6 +181,72 @@ static inline pcapng_entry_t *pcapng_entry(pktio_entry_t *pktio_entry)
 
 int write_pcapng_hdr(pktio_entry_t *entry, int qidx);
 
+static int read_config_file(pcapng_global_t *pcapng_glb)
+{
+	const char *str;
+	int val = 0;
+
+	_ODP_PRINT("Pcapng config:\n");
+
+	str = "pktio.pcapng.ring_size";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 2 || !_ODP_CHECK_IS_POWER2(val)) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	pcapng_glb->config.ring_size = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "pktio.pcapng.snaplen";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 0) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	pcapng_glb->config.snaplen = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "pktio.pcapng.filter_ethtype";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 0 || val > UINT16_MAX) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	pcapng_glb->config.filter_ethtype = val;
+	_ODP_PRINT("  %s: 0x%04x\n", str, val);
+
+	str = "pktio.pcapng.filter_ip_proto";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 0 || val > UINT8_MAX) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	pcapng_glb->config.filter_ip_proto = val;
+	_ODP_PRINT("  %s: %i\n\n", str, val);
+
+	return 0;
+}
+
 int _odp_pcapng_init_global(void)
 {
 	odp_shm_t shm;
@@ -124,6 +262,15 @@ int _odp_pcapng_init_global(void)
 	pcapng_gbl->shm = shm;
 
 	odp_spinlock_init(&pcapng_gbl->lock);
+	odp_atomic_init_u32(&pcapng_gbl->writer_exit, 0);
+
+	for (int i = 0; i < CONFIG_PKTIO_ENTRIES; i++)
+		odp_atomic_init_u32(&pcapng_gbl->entry[i].writer_busy, 0);
+
+	if (read_config_file(pcapng_gbl)) {
+		odp_shm_free(shm);
+		return -1;
+	}
 
 	return 0;
 }
@@ -154,19 +301,10 @@ static void inotify_event_handle(pktio_entry_t *entry, int qidx,
 				 struct inotify_event *event)
 {
 	pcapng_entry_t *pcapng = pcapng_entry(entry);
-	int mtu = _ODP_MAX(odp_pktin_maxlen(entry->handle), odp_pktout_maxlen(entry->handle));
 
 	if (event->mask & IN_OPEN) {
 		int ret;
 
-		if (PIPE_BUF < mtu + sizeof(pcapng_enhanced_packet_block_t) +
-		    sizeof(uint32_t)) {
-			_ODP_ERR("PIPE_BUF:%d too small. Disabling pcap\n", PIPE_BUF);
-			pcapng->state[qidx] = PCAPNG_WR_STOP;
-
-			return;
-		}
-
 		ret = write_pcapng_hdr(entry, qidx);
 		if (ret) {
 			pcapng->state[qidx] = PCAPNG_WR_STOP;
@@ -177,9 +315,15 @@ static void inotify_event_handle(pktio_entry_t *entry, int qidx,
 	} else if (event->mask & IN_CLOSE) {
 		int fd = pcapng->fd[qidx];
 
-		pcapng_drain_fifo(fd);
+		pcapng_queue_t *queue = &pcapng->queue[qidx];
+
 		pcapng->state[qidx] = PCAPNG_WR_STOP;
-		_ODP_DBG("Close %s for pcap tracing\n", event->name);
+		pcapng_drain_fifo(fd);
+		_ODP_DBG("Close %s for pcap tracing: captured %" PRIu64 ", ring drops %" PRIu64
+			 ", fifo drops %" PRIu64 "\n", event->name,
+			 odp_atomic_load_u64(&queue->captured),
+			 odp_atomic_load_u64(&queue->drop_ring),
+			 odp_atomic_load_u64(&queue->drop_fifo));
 	} else {
 		_ODP_ERR("Unknown inotify event 0x%08x\n", event->mask);
 	}
@@ -289,6 +433,255 @@ static void *inotify_update(void *arg)
 	return NULL;
 }
 
+/* Write the rest of a partially written burst. Only the writer thread writes
+ * packet blocks into a fifo, so the block stream stays consistent as long as
+ * a started burst is completed. Gives up when the fifo is closed or the reader
+ * does not make room in PCAPNG_WRITE_TIMEOUT_NS. Returns the total number of
+ * bytes written. */
+static ssize_t write_fifo_rest(pcapng_entry_t *pcapng, int qidx, struct iovec *iov,
+			       int iovcnt, ssize_t done)
+{
+	uint64_t deadline = odp_time_local_ns() + PCAPNG_WRITE_TIMEOUT_NS;
+	ssize_t written = done;
+	struct pollfd pfd;
+	ssize_t len;
+
+	pfd.fd = pcapng->fd[qidx];
+	pfd.events = POLLOUT;
+
+	while (1) {
+		while (iovcnt && done >= (ssize_t)iov->iov_len) {
+			done -= iov->iov_len;
+			iov++;
+			iovcnt--;
+		}
+
+		if (iovcnt == 0)
+			break;
+
+		iov->iov_base = (uint8_t *)iov->iov_base + done;
+		iov->iov_len -= done;
+		done = 0;
+
+		if (pcapng->state[qidx] != PCAPNG_WR_PKT || odp_time_local_ns() > deadline)
+			break;
+
+		if (poll(&pfd, 1, PCAPNG_WRITE_POLL_MS) <= 0)
+			continue;
+
+		len = writev(pfd.fd, iov, iovcnt);
+		if (len > 0) {
+			done = len;
+			written += len;
+		}
+	}
+
+	return written;
+}
+
+static inline pcapng_rec_t *pcapng_rec(pcapng_entry_t *pcapng, pcapng_queue_t *queue,
+				       uint32_t idx)
+{
+	return (pcapng_rec_t *)(uintptr_t)(queue->rec_base + (size_t)idx * pcapng->rec_size);
+}
+
+static int write_queue(pcapng_entry_t *pcapng, int qidx)
+{
+	pcapng_queue_t *queue = &pcapng->queue[qidx];
+	uint32_t mask = pcapng_gbl->config.ring_size - 1;
+	uint32_t idx[PCAPNG_WRITE_BURST];
+	pcapng_enhanced_packet_block_t epb[PCAPNG_WRITE_BURST];
+	struct iovec iov[4 * PCAPNG_WRITE_BURST];
+	static const uint8_t pad[PCAPNG_DATA_ALIGN];
+	ssize_t total = 0, len;
+	int iovcnt = 0;
+	uint32_t i, num;
+
+	num = ring_u32_deq_multi(queue->full, mask, idx, PCAPNG_WRITE_BURST);
+	if (num == 0)
+		return 0;
+
+	/* Fifo was closed after the packets were captured */
+	if (odp_unlikely(pcapng->state[qidx] != PCAPNG_WR_PKT)) {
+		ring_u32_enq_multi(queue->free, mask, idx, num);
+		return num;
+	}
+
+	for (i = 0; i < num; i++) {
+		pcapng_rec_t *rec = pcapng_rec(pcapng, queue, idx[i]);
+		uint32_t data_len = _ODP_ROUNDUP_ALIGN(rec->cap_len, PCAPNG_DATA_ALIGN);
+
+		epb[i].block_type = PCAPNG_BLOCK_TYPE_EPB;
+		epb[i].block_total_length = sizeof(epb[i]) + data_len + sizeof(uint32_t);
+		epb[i].interface_idx = 0;
+		epb[i].timestamp_high = (uint32_t)(rec->timestamp >> 32);
+		epb[i].timestamp_low = (uint32_t)(rec->timestamp);
+		epb[i].captured_len = rec->cap_len;
+		epb[i].packet_len = rec->pkt_len;
+
+		/* epb */
+		iov[iovcnt].iov_base = &epb[i];
+		iov[iovcnt].iov_len = sizeof(epb[i]);
+		iovcnt++;
+
+		/* data */
+		iov[iovcnt].iov_base = rec->data;
+		iov[iovcnt].iov_len = rec->cap_len;
+		iovcnt++;
+
+		/* padding and trailing length */
+		if (data_len != rec->cap_len) {
+			iov[iovcnt].iov_base = (void *)(uintptr_t)pad;
+			iov[iovcnt].iov_len = data_len - rec->cap_len;
+			iovcnt++;
+		}
+
+		iov[iovcnt].iov_base = &epb[i].block_total_length;
+		iov[iovcnt].iov_len = sizeof(uint32_t);
+		iovcnt++;
+
+		total += epb[i].block_total_length;
+	}
+
+	len = writev(pcapng->fd[qidx], iov, iovcnt);
+
+	if (odp_likely(len == total)) {
+		odp_atomic_add_u64(&queue->captured, num);
+	} else if (len <= 0) {
+		/* Reader is not keeping up, drop instead of blocking */
+		odp_atomic_add_u64(&queue->drop_fifo, num);
+	} else {
+		len = write_fifo_rest(pcapng, qidx, iov, iovcnt, len);
+
+		if (odp_likely(len == total)) {
+			odp_atomic_add_u64(&queue->captured, num);
+		} else {
+			ssize_t done = 0;
+
+			/* Count records that were completely written */
+			for (i = 0; i < num && done + epb[i].block_total_length <= len; i++)
+				done += epb[i].block_total_length;
+
+			odp_atomic_add_u64(&queue->captured, i);
+			odp_atomic_add_u64(&queue->drop_fifo, num - i);
+
+			/* Block stream is broken, stop writing until the fifo is reopened */
+			pcapng->state[qidx] = PCAPNG_WR_STOP;
+			_ODP_DBG("pcapng fifo %d stalled, capture stopped\n", qidx);
+		}
+	}
+
+	ring_u32_enq_multi(queue->free, mask, idx, num);
+
+	return num;
+}
+
+static void *pcapng_writer(void *arg ODP_UNUSED)
+{
+	while (!odp_atomic_load_u32(&pcapng_gbl->writer_exit)) {
+		int num = 0;
+
+		for (int i = 0; i < CONFIG_PKTIO_ENTRIES; i++) {
+			pcapng_entry_t *pcapng = &pcapng_gbl->entry[i];
+
+			/* Mark the entry busy under the lock, so that _odp_pcapng_stop() waits
+			 * for the writes to complete before freeing the capture rings. Fifo
+			 * writes are done without holding the lock. */
+			odp_spinlock_lock(&pcapng_gbl->lock);
+
+			if (pcapng->pktio_entry == NULL) {
+				odp_spinlock_unlock(&pcapng_gbl->lock);
+				continue;
+			}
+
+			odp_atomic_store_u32(&pcapng->writer_busy, 1);
+			odp_spinlock_unlock(&pcapng_gbl->lock);
+
+			for (uint32_t q = 0; q < pcapng->num_queues; q++)
+				num += write_queue(pcapng, q);
+
+			odp_atomic_store_rel_u32(&pcapng->writer_busy, 0);
+		}
+
+		if (num == 0)
+			usleep(PCAPNG_WRITER_SLEEP_US);
+	}
+
+	return NULL;
+}
+
+static int reserve_capture_rings(pktio_entry_t *entry, uint32_t num_queues)
+{
+	pcapng_entry_t *pcapng = pcapng_entry(entry);
+	uint32_t ring_size = pcapng_gbl->config.ring_size;
+	uint32_t mtu = _ODP_MAX(odp_pktin_maxlen(entry->handle),
+				odp_pktout_maxlen(entry->handle));
+	uint32_t snaplen = pcapng_gbl->config.snaplen;
+	uint64_t ring_len, rec_len, queue_len;
+	char name[ODP_SHM_NAME_LEN];
+	odp_shm_t shm;
+	uint8_t *addr;
+
+	if (snaplen == 0 || (mtu && snaplen > mtu))
+		snaplen = mtu;
+
+	if (snaplen == 0)
+		snaplen = _ODP_ETH_LEN_MAX;
+
+	pcapng->snaplen = snaplen;
+	pcapng->rec_size = _ODP_ROUNDUP_CACHE_LINE(sizeof(pcapng_rec_t) + snaplen);
+	pcapng->num_queues = num_queues;
+
+	/* Ring size must be larger than the number of records stored in it */
+	ring_len = _ODP_ROUNDUP_CACHE_LINE(sizeof(ring_u32_t) + ring_size * sizeof(uint32_t));
+	rec_len = (uint64_t)(ring_size - 1) * pcapng->rec_size;
+	queue_len = 2 * ring_len + rec_len;
+
+	snprintf(name, sizeof(name), "_odp_pcapng_rings_%i", odp_pktio_index(entry->handle));
+	shm = odp_shm_reserve(name, queue_len * num_queues, ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID) {
+		_ODP_ERR("Capture ring reserve failed\n");
+		return -1;
+	}
+
+	pcapng->shm = shm;
+	addr = odp_shm_addr(shm);
+
+	for (uint32_t q = 0; q < num_queues; q++) {
+		pcapng_queue_t *queue = &pcapng->queue[q];
+		uint32_t mask = ring_size - 1;
+
+		queue->free = (ring_u32_t *)(uintptr_t)addr;
+		queue->full = (ring_u32_t *)(uintptr_t)(addr + ring_len);
+		queue->rec_base = addr + 2 * ring_len;
+		addr += queue_len;
+
+		ring_u32_init(queue->free);
+		ring_u32_init(queue->full);
+
+		for (uint32_t i = 0; i < ring_size - 1; i++)
+			ring_u32_enq(queue->free, mask, i);
+
+		odp_atomic_init_u64(&queue->captured, 0);
+		odp_atomic_init_u64(&queue->drop_ring, 0);
+		odp_atomic_init_u64(&queue->drop_fifo, 0);
+	}
+
+	return 0;
+}
+
+static void free_capture_rings(pcapng_entry_t *pcapng)
+{
+	if (pcapng->shm == ODP_SHM_INVALID)
+		return;
+
+	if (odp_shm_free(pcapng->shm))
+		_ODP_ERR("Capture ring free failed\n");
+
+	pcapng->shm = ODP_SHM_INVALID;
+	pcapng->num_queues = 0;
+}
+
 static int get_fifo_max_size(void)
 {
 	FILE *file;
@@ -316,6 +709,9 @@ int _odp_pcapng_start(pktio_entry_t *entry)
 	unsigned int max_queue = _ODP_MAX(entry->num_in_queue, entry->num_out_queue);
 	int fifo_sz;
 
+	if (reserve_capture_rings(entry, max_queue))
+		return -1;
+
 	fifo_sz = get_fifo_max_size();
 	if (fifo_sz < 0)
 		_ODP_DBG("failed to read max fifo size\n");
@@ -394,13 +790,24 @@ int _odp_pcapng_start(pktio_entry_t *entry)
 	if (ret) {
 		_ODP_ERR("Can't start inotify thread (ret=%d). pcapng disabled.\n", ret);
 	} else {
-		pcapng->pktio_entry = entry;
-		pcapng_gbl->num_entries++;
-		pcapng_gbl->inotify_is_running = 1;
+		/* create a thread to write captured packets into fifos */
+		odp_atomic_store_u32(&pcapng_gbl->writer_exit, 0);
+		ret = pthread_create(&pcapng_gbl->writer_thread, &attr, pcapng_writer, NULL);
+		if (ret) {
+			_ODP_ERR("Can't start writer thread (ret=%d). pcapng disabled.\n", ret);
+			pthread_cancel(pcapng_gbl->inotify_thread);
+		} else {
+			pcapng->pktio_entry = entry;
+			pcapng_gbl->num_entries++;
+			pcapng_gbl->inotify_is_running = 1;
+		}
 	}
 
 	odp_spinlock_unlock(&pcapng_gbl->lock);
 
+	if (ret)
+		free_capture_rings(pcapng);
+
 	return ret;
 
 out_destroy:
@@ -417,6 +824,7 @@ void _odp_pcapng_stop(pktio_entry_t *entry)
 	int ret;
 	unsigned int i;
 	unsigned int max_queue = _ODP_MAX(entry->num_in_queue, entry->num_out_queue);
+	int join_writer = 0;
 
 	odp_spinlock_lock(&pcapng_gbl->lock);
 
@@ -429,6 +837,9 @@ void _odp_pcapng_stop(pktio_entry_t *entry)
 		if (ret)
 			_ODP_ERR("can't cancel inotify thread %s\n", strerror(errno));
 		pcapng_gbl->inotify_is_running = 0;
+
+		odp_atomic_store_u32(&pcapng_gbl->writer_exit, 1);
+		join_writer = 1;
 	}
 
 	if (pcapng_gbl->num_entries == 0) {
@@ -438,15 +849,25 @@ void _odp_pcapng_stop(pktio_entry_t *entry)
 		if (ret)
 			_ODP_ERR("can't deregister inotify %s\n", strerror(errno));
 
+		/* Watch descriptor is not a file descriptor, it was released
+		 * by inotify_rm_watch() */
 		if (pcapng_gbl->inotify_fd != -1)
 			close(pcapng_gbl->inotify_fd);
-
-		if (pcapng_gbl->inotify_watch_fd != -1)
-			close(pcapng_gbl->inotify_watch_fd);
 	}
 
 	odp_spinlock_unlock(&pcapng_gbl->lock);
 
+	if (join_writer && pthread_join(pcapng_gbl->writer_thread, NULL))
+		_ODP_ERR("can't join writer thread\n");
+
+	/* Writer thread may still be writing the entry, when it keeps running for
+	 * other entries. Writes give up in PCAPNG_WRITE_TIMEOUT_NS. */
+	while (odp_atomic_load_acq_u32(&pcapng->writer_busy))
+		usleep(PCAPNG_WRITER_SLEEP_US);
+
+	/* Writer thread does not access the entry anymore */
+	free_capture_rings(pcapng);
+
 	for (i = 0; i < max_queue; i++) {
 		char pcapng_name[128];
 		char pcapng_path[256];
@@ -495,7 +916,7 @@ int write_pcapng_hdr(pktio_entry_t *entry, int qidx)
 	idb.block_total_length = sizeof(idb);
 	idb.block_total_length2 = sizeof(idb);
 	idb.linktype = PCAPNG_LINKTYPE_ETHERNET;
-	idb.snaplen = 0x0; /* unlimited */
+	idb.snaplen = pcapng->snaplen;
 	len = write(fd, &idb, sizeof(idb));
 	if (len != sizeof(idb)) {
 		_ODP_ERR("Failed to write pcapng interface description\n");
@@ -506,96 +927,135 @@ int write_pcapng_hdr(pktio_entry_t *entry, int qidx)
 	return 0;
 }
 
-/*
- * make sure that each fifo write is less than PIPE_BUF
- * this will make sure writes are atomic (on non blocking mode).
- * writev() transfers all the data and returns the number of bytes requested or
- * -EAGAIN
- */
-static ssize_t write_fifo(int fd, struct iovec *iov, int iovcnt)
+static inline uint16_t read_be16(const uint8_t *p)
+{
+	return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static int filter_match(odp_packet_t pkt)
 {
-	ssize_t len = 0;
-
-	len = writev(fd, iov, iovcnt);
-	/*
-	 * we don't care if a writev fails, we asynchronously read the fifo
-	 * so the next block of packets might be successful. This error only
-	 * means that some packets failed to append on the pcap file
-	 */
-	if (len > 0)
-		fsync(fd);
-
-	return len;
+	uint16_t filter_ethtype = pcapng_gbl->config.filter_ethtype;
+	uint8_t filter_ip_proto = pcapng_gbl->config.filter_ip_proto;
+	uint8_t hdr[PCAPNG_FILTER_HDR_LEN];
+	uint32_t len, offset = _ODP_ETHHDR_LEN - 2;
+	uint16_t ethtype;
+
+	if (odp_likely(filter_ethtype == 0 && filter_ip_proto == 0))
+		return 1;
+
+	len = _ODP_MIN(odp_packet_len(pkt), (uint32_t)sizeof(hdr));
+	if (len < _ODP_ETHHDR_LEN || odp_packet_copy_to_mem(pkt, 0, len, hdr))
+		return 0;
+
+	ethtype = read_be16(&hdr[offset]);
+
+	/* Skip up to two VLAN tags */
+	for (int i = 0; i < 2; i++) {
+		if (ethtype != _ODP_ETHTYPE_VLAN && ethtype != _ODP_ETHTYPE_VLAN_OUTER)
+			break;
+
+		offset += 4;
+		if (offset + 2 > len)
+			return 0;
+
+		ethtype = read_be16(&hdr[offset]);
+	}
+
+	if (filter_ethtype && ethtype != filter_ethtype)
+		return 0;
+
+	if (filter_ip_proto) {
+		/* Offset of IPv4 protocol or IPv6 next header field */
+		if (ethtype == _ODP_ETHTYPE_IPV4)
+			offset += 2 + 9;
+		else if (ethtype == _ODP_ETHTYPE_IPV6)
+			offset += 2 + 6;
+		else
+			return 0;
+
+		if (offset >= len || hdr[offset] != filter_ip_proto)
+			return 0;
+	}
+
+	return 1;
 }
 
+/*
+ * Copy packets into capture records and pass those to the writer thread.
+ * Packets are dropped from the capture, when the capture ring is full. This
+ * function never blocks, and does not make any system calls.
+ */
 int _odp_pcapng_dump_pkts(pktio_entry_t *entry, int qidx,
 			  const odp_packet_t packets[], int num)
 {
 	pcapng_entry_t *pcapng = pcapng_entry(entry);
-	int i = 0;
-	struct iovec packet_iov[3 * num];
-	pcapng_enhanced_packet_block_t epb[num];
-	int iovcnt = 0;
-	ssize_t block_len = 0;
-	int fd = pcapng->fd[qidx];
-	ssize_t len = 0, wlen;
+	pcapng_queue_t *queue;
+	uint32_t mask, num_match, num_rec, i;
 
 	if (odp_likely(pcapng->state[qidx] != PCAPNG_WR_PKT))
 		return 0;
 
-	for (i = 0; i < num; i++) {
-		odp_packet_hdr_t *pkt_hdr = packet_hdr(packets[i]);
-		uint32_t seg_len;
-		char *buf = (char *)odp_packet_offset(packets[i], 0, &seg_len,
-						      NULL);
-
-		if (block_len + sizeof(epb[i]) +
-		    _ODP_ROUNDUP_ALIGN(seg_len, PCAPNG_DATA_ALIGN) +
-		    sizeof(uint32_t) > PIPE_BUF) {
-			wlen = write_fifo(fd, packet_iov, iovcnt);
-			if (wlen > 0) {
-				len += wlen;
-				block_len = 0;
-				iovcnt = 0;
-			}
-		}
-		epb[i].block_type = PCAPNG_BLOCK_TYPE_EPB;
-		epb[i].block_total_length = sizeof(epb[i]) +
-			_ODP_ROUNDUP_ALIGN(seg_len, PCAPNG_DATA_ALIGN) +
-			PCAPNG_DATA_ALIGN;
-		epb[i].interface_idx = 0;
-		epb[i].timestamp_high =
-			(uint32_t)(pkt_hdr->timestamp.u64 >> 32);
-		epb[i].timestamp_low = (uint32_t)(pkt_hdr->timestamp.u64);
-		epb[i].captured_len = seg_len;
-		epb[i].packet_len = seg_len;
+	if (odp_unlikely(num <= 0))
+		return 0;
 
-		/* epb */
-		packet_iov[iovcnt].iov_base = &epb[i];
-		packet_iov[iovcnt].iov_len = sizeof(epb[i]);
-		block_len += packet_iov[iovcnt].iov_len;
-		iovcnt++;
+	queue = &pcapng->queue[qidx];
+	mask = pcapng_gbl->config.ring_size - 1;
 
-		/* data */
-		packet_iov[iovcnt].iov_base = buf;
-		packet_iov[iovcnt].iov_len = _ODP_ROUNDUP_ALIGN(seg_len, PCAPNG_DATA_ALIGN);
-		block_len += packet_iov[iovcnt].iov_len;
-		iovcnt++;
+	odp_packet_t pkt[num];
+	uint32_t idx[num];
 
-		/* trailing */
-		packet_iov[iovcnt].iov_base = &epb[i].block_total_length;
-		packet_iov[iovcnt].iov_len = sizeof(uint32_t);
-		block_len += packet_iov[iovcnt].iov_len;
-		iovcnt++;
+	num_match = 0;
+	for (i = 0; i < (uint32_t)num; i++) {
+		if (filter_match(packets[i]))
+			pkt[num_match++] = packets[i];
 	}
 
-	if (iovcnt) {
-		wlen = write_fifo(fd, packet_iov, iovcnt);
-		if (wlen > 0)
-			len += wlen;
+	if (num_match == 0)
+		return 0;
+
+	num_rec = ring_u32_deq_multi(queue->free, mask, idx, _ODP_MIN(num_match, mask));
+
+	if (odp_unlikely(num_rec < num_match))
+		odp_atomic_add_u64(&queue->drop_ring, num_match - num_rec);
+
+	if (num_rec == 0)
+		return 0;
+
+	for (i = 0; i < num_rec; i++) {
+		odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt[i]);
+		pcapng_rec_t *rec = pcapng_rec(pcapng, queue, idx[i]);
+		uint32_t pkt_len = odp_packet_len(pkt[i]);
+		uint32_t cap_len = _ODP_MIN(pkt_len, pcapng->snaplen);
+
+		rec->timestamp = pkt_hdr->timestamp.u64;
+		rec->pkt_len = pkt_len;
+		rec->cap_len = cap_len;
+		odp_packet_copy_to_mem(pkt[i], 0, cap_len, rec->data);
 	}
 
-	return len;
+	ring_u32_enq_multi(queue->full, mask, idx, num_rec);
+
+	return num_rec;
+}
+
+void _odp_pcapng_print(pktio_entry_t *entry)
+{
+	pcapng_entry_t *pcapng = pcapng_entry(entry);
+
+	if (pcapng->num_queues == 0)
+		return;
+
+	_ODP_PRINT("  pcapng snaplen     %" PRIu32 "\n", pcapng->snaplen);
+
+	for (uint32_t q = 0; q < pcapng->num_queues; q++) {
+		pcapng_queue_t *queue = &pcapng->queue[q];
+
+		_ODP_PRINT("  pcapng queue %2" PRIu32 "   captured %" PRIu64 ", ring drops %"
+			   PRIu64 ", fifo drops %" PRIu64 "\n", q,
+			   odp_atomic_load_u64(&queue->captured),
+			   odp_atomic_load_u64(&queue->drop_ring),
+			   odp_atomic_load_u64(&queue->drop_fifo));
+	}
 }
 
 #else /* _ODP_PCAPNG */
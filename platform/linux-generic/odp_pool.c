@@ -54,6 +54,14 @@
 /* Maximum packet user area size */
 #define MAX_UAREA_SIZE 2048
 
+/* Maximum number of depot magazines per thread */
+#define POOL_DEPOT_MAGS_PER_THR 2
+
+/* Number of magazine misses between cache size adaptations, and miss ratio
+ * of alloc and free over which the cache is limited to a single magazine */
+#define POOL_ADAPT_WINDOW 16
+#define POOL_ADAPT_RATIO  8
+
 ODP_STATIC_ASSERT(CONFIG_PACKET_SEG_LEN_MIN >= 256,
 		  "ODP Segment size must be a minimum of 256 bytes");
 
@@ -91,58 +99,284 @@ const _odp_pool_inline_offset_t _odp_pool_inline ODP_ALIGNED_CACHE = {
 
 static inline void cache_init(pool_cache_t *cache)
 {
-	memset(cache, 0, sizeof(pool_cache_t));
+	/* Magazines are owned by the pool, they are assigned on pool create */
 	odp_atomic_init_u32(&cache->cache_num, 0);
+	odp_atomic_init_u32(&cache->flush_req, 0);
+	cache->alloc_miss = 0;
+	cache->free_miss  = 0;
+	cache->one_mag    = 0;
+}
+
+static inline void cache_update_num(pool_cache_t *cache)
+{
+	odp_atomic_store_u32(&cache->cache_num, cache->loaded->num + cache->prev->num);
 }
 
 static inline uint32_t cache_pop(pool_cache_t *cache,
 				 _odp_event_hdr_t *event_hdr[], int max_num)
 {
-	uint32_t cache_num = odp_atomic_load_u32(&cache->cache_num);
-	uint32_t num_ch = max_num;
-	uint32_t cache_begin;
-	uint32_t i;
+	uint32_t num_ch = 0;
+
+	if (odp_unlikely(odp_atomic_load_u32(&cache->cache_num) == 0))
+		return 0;
+
+	while (1) {
+		pool_mag_t *mag = cache->loaded;
+		uint32_t num = mag->num;
+		uint32_t begin, i;
+
+		if (odp_unlikely(num > max_num - num_ch))
+			num = max_num - num_ch;
 
-	/* Cache does not have enough buffers */
-	if (odp_unlikely(cache_num < (uint32_t)max_num))
-		num_ch = cache_num;
+		/* Get buffers from the top of the magazine */
+		begin = mag->num - num;
+		for (i = 0; i < num; i++)
+			event_hdr[num_ch + i] = mag->event_hdr[begin + i];
 
-	/* Get buffers from the cache */
-	cache_begin = cache_num - num_ch;
-	for (i = 0; i < num_ch; i++)
-		event_hdr[i] = cache->event_hdr[cache_begin + i];
+		mag->num = begin;
+		num_ch  += num;
+
+		if (odp_likely(num_ch == (uint32_t)max_num || cache->prev->num == 0))
+			break;
+
+		/* Loaded magazine is empty, continue from the full previous one */
+		cache->loaded = cache->prev;
+		cache->prev   = mag;
+	}
 
-	odp_atomic_store_u32(&cache->cache_num, cache_num - num_ch);
+	cache_update_num(cache);
 
 	return num_ch;
 }
 
-static inline void cache_push(pool_cache_t *cache, _odp_event_hdr_t *event_hdr[],
+/* Move previous magazine out of the cache. Full magazine is exchanged for an
+ * empty one from the depot, or its buffers are returned to the pool ring when
+ * the depot does not have an empty magazine. */
+static void cache_release_prev(pool_t *pool, pool_cache_t *cache)
+{
+	pool_mag_t *mag = cache->prev;
+	pool_mag_t *empty;
+
+	if (mag->num == 0)
+		return;
+
+	if (ring_ptr_deq(pool->depot.empty, pool->depot.mask, (void **)&empty)) {
+		ring_ptr_enq(pool->depot.full, pool->depot.mask, mag);
+		cache->prev = empty;
+	} else {
+		ring_ptr_enq_multi(&pool->ring->hdr, pool->ring_mask, (void **)mag->event_hdr,
+				   mag->num);
+		mag->num = 0;
+	}
+
+	cache_update_num(cache);
+}
+
+/* Adapt cache size to the ratio of magazine misses on alloc and free. Threads
+ * that mostly only allocate or only free (e.g. RX or TX only threads) do not
+ * benefit from the previous magazine. Those are limited to the loaded magazine,
+ * so that fewer buffers are held in the thread local cache. */
+static inline void cache_adapt(pool_t *pool, pool_cache_t *cache, int alloc)
+{
+	uint32_t min, max;
+	uint8_t one_mag;
+
+	if (alloc)
+		cache->alloc_miss++;
+	else
+		cache->free_miss++;
+
+	if (odp_likely(cache->alloc_miss + cache->free_miss < POOL_ADAPT_WINDOW))
+		return;
+
+	min = _ODP_MIN(cache->alloc_miss, cache->free_miss);
+	max = _ODP_MAX(cache->alloc_miss, cache->free_miss);
+	one_mag = (min * POOL_ADAPT_RATIO) < max;
+
+	cache->alloc_miss = 0;
+	cache->free_miss  = 0;
+	cache->one_mag    = one_mag;
+
+	if (one_mag)
+		cache_release_prev(pool, cache);
+}
+
+/* Loaded magazine is empty. Exchange it for a full magazine from the depot.
+ * Returns 1 on success, 0 when depot does not have full magazines. */
+static inline int cache_refill(pool_t *pool, pool_cache_t *cache)
+{
+	pool_mag_t *full;
+
+	cache_adapt(pool, cache, 1);
+
+	if (!ring_ptr_deq(pool->depot.full, pool->depot.mask, (void **)&full))
+		return 0;
+
+	ring_ptr_enq(pool->depot.empty, pool->depot.mask, cache->loaded);
+	cache->loaded = full;
+	cache_update_num(cache);
+
+	if (CONFIG_POOL_STATISTICS && pool->params.stats.bit.alloc_ops)
+		odp_atomic_inc_u64(&pool->stats.alloc_ops);
+
+	return 1;
+}
+
+/* Loaded magazine is full. Swap it with an empty previous magazine, or
+ * exchange it for an empty magazine from the depot. When the depot does not
+ * have an empty magazine, buffers are returned to the pool ring. */
+static void cache_mag_full(pool_t *pool, pool_cache_t *cache)
+{
+	pool_mag_t *mag = cache->loaded;
+	pool_mag_t *empty;
+
+	cache_adapt(pool, cache, 0);
+
+	if (!cache->one_mag && cache->prev->num == 0) {
+		cache->loaded = cache->prev;
+		cache->prev   = mag;
+		return;
+	}
+
+	if (ring_ptr_deq(pool->depot.empty, pool->depot.mask, (void **)&empty)) {
+		ring_ptr_enq(pool->depot.full, pool->depot.mask, mag);
+		cache->loaded = empty;
+	} else {
+		ring_ptr_enq_multi(&pool->ring->hdr, pool->ring_mask, (void **)mag->event_hdr,
+				   mag->num);
+		mag->num = 0;
+	}
+
+	if (CONFIG_POOL_STATISTICS && pool->params.stats.bit.free_ops)
+		odp_atomic_inc_u64(&pool->stats.free_ops);
+
+	_odp_pool_cache_flush_check(local.thr_id);
+}
+
+static inline void cache_push(pool_t *pool, pool_cache_t *cache, _odp_event_hdr_t *event_hdr[],
 			      uint32_t num)
 {
-	uint32_t cache_num = odp_atomic_load_u32(&cache->cache_num);
-	uint32_t i;
+	const uint32_t mag_size = pool->mag_size;
+	uint32_t num_push = 0;
+
+	while (1) {
+		pool_mag_t *mag = cache->loaded;
+		uint32_t begin = mag->num;
+		uint32_t n = mag_size - begin;
+		uint32_t i;
+
+		if (odp_likely(n > num - num_push))
+			n = num - num_push;
+
+		for (i = 0; i < n; i++)
+			mag->event_hdr[begin + i] = event_hdr[num_push + i];
 
-	for (i = 0; i < num; i++)
-		cache->event_hdr[cache_num + i] = event_hdr[i];
+		mag->num  = begin + n;
+		num_push += n;
 
-	odp_atomic_store_u32(&cache->cache_num, cache_num + num);
+		if (odp_likely(num_push == num))
+			break;
+
+		cache_mag_full(pool, cache);
+	}
+
+	cache_update_num(cache);
 }
 
-static void cache_flush(pool_cache_t *cache, pool_t *pool)
+static uint32_t cache_flush(pool_cache_t *cache, pool_t *pool)
 {
-	_odp_event_hdr_t *event_hdr;
 	ring_ptr_t *ring;
 	uint32_t mask;
+	uint32_t num = odp_atomic_load_u32(&cache->cache_num);
 
-	if (!pool->ring)
-		return;
+	if (!pool->ring || num == 0)
+		return 0;
 
 	ring = &pool->ring->hdr;
 	mask = pool->ring_mask;
 
-	while (cache_pop(cache, &event_hdr, 1))
-		ring_ptr_enq(ring, mask, event_hdr);
+	ring_ptr_enq_multi(ring, mask, (void **)cache->loaded->event_hdr, cache->loaded->num);
+	ring_ptr_enq_multi(ring, mask, (void **)cache->prev->event_hdr, cache->prev->num);
+	cache->loaded->num = 0;
+	cache->prev->num   = 0;
+	odp_atomic_store_u32(&cache->cache_num, 0);
+
+	return num;
+}
+
+/* Request other threads to flush their local caches of the pool. Caches are
+ * owned by a single thread, so the owner does the flush when it checks its
+ * requests next time. Returns the number of posted requests.
+ *
+ * Pool flush_pending counts posted requests that are not yet handled. When
+ * 'force' is not set, a new round of requests is posted only when there are
+ * no pending requests. This limits the cost of short allocations, which would
+ * otherwise scan all thread caches every time the pool runs low. A thread that
+ * stays outside of ODP calls delays new automatic requests until it handles
+ * its request, but odp_pool_cache_trim() always posts requests. */
+static uint32_t cache_flush_request(pool_t *pool, int force)
+{
+	const int max_threads = odp_thread_count_max();
+	uint32_t num = 0;
+	uint32_t zero = 0;
+
+	/* Reference held during the scan keeps other non-forced requesters out */
+	if (force)
+		odp_atomic_inc_u32(&pool->flush_pending);
+	else if (!odp_atomic_cas_acq_u32(&pool->flush_pending, &zero, 1))
+		return 0;
+
+	for (int i = 0; i < max_threads; i++) {
+		pool_cache_t *cache = &pool->local_cache[i];
+
+		if (i == local.thr_id || odp_atomic_load_u32(&cache->cache_num) == 0 ||
+		    odp_atomic_load_acq_u32(&cache->flush_req))
+			continue;
+
+		odp_atomic_inc_u32(&pool->flush_pending);
+		odp_atomic_store_u32(&cache->flush_req, 1);
+		/* Publish the cache request before the thread level flag */
+		odp_atomic_store_rel_u32(&_odp_pool_glb->flush_req[i], 1);
+		num++;
+	}
+
+	odp_atomic_dec_u32(&pool->flush_pending);
+
+	if (CONFIG_POOL_STATISTICS && pool->params.stats.bit.cache_flush_reqs && num)
+		odp_atomic_add_u64(&pool->stats.cache_flush_reqs, num);
+
+	return num;
+}
+
+void _odp_pool_cache_flush_req_handle(void)
+{
+	int thr = local.thr_id;
+	uint32_t one = 1;
+
+	/* Acquire pairs with the release store of the requester */
+	if (odp_atomic_load_acq_u32(&_odp_pool_glb->flush_req[thr]) == 0 ||
+	    !odp_atomic_cas_acq_u32(&_odp_pool_glb->flush_req[thr], &one, 0))
+		return;
+
+	for (int i = 0; i < CONFIG_POOLS; i++) {
+		pool_cache_t *cache = local.cache[i];
+		pool_t *pool;
+		uint32_t num;
+
+		if (odp_atomic_load_u32(&cache->flush_req) == 0)
+			continue;
+
+		pool = _odp_pool_entry_from_idx(i);
+		num = cache_flush(cache, pool);
+
+		/* Events are back in the pool ring before the request is marked
+		 * handled */
+		odp_atomic_store_rel_u32(&cache->flush_req, 0);
+		odp_atomic_sub_rel_u32(&pool->flush_pending, 1);
+
+		if (CONFIG_POOL_STATISTICS && pool->params.stats.bit.cache_flushed && num)
+			odp_atomic_add_u64(&pool->stats.cache_flushed, num);
+	}
 }
 
 static inline int cache_available(pool_t *pool, odp_pool_stats_t *stats)
@@ -203,6 +437,18 @@ static inline uint64_t cache_total_available(pool_t *pool)
 	return cached;
 }
 
+/* Number of buffers in the pool ring and in the depot. Depot stores only
+ * full magazines. */
+static inline uint64_t pool_available(pool_t *pool)
+{
+	uint64_t available = ring_ptr_len(&pool->ring->hdr);
+
+	if (pool->cache_size)
+		available += (uint64_t)ring_ptr_len(pool->depot.full) * pool->mag_size;
+
+	return available;
+}
+
 static int read_config_file(pool_global_t *pool_glb)
 {
 	uint32_t local_cache_size, burst_size, align;
@@ -316,6 +562,24 @@ static int read_config_file(pool_global_t *pool_glb)
 	pool_glb->config.buf_min_align = align;
 	_ODP_PRINT("  %s: %u\n", str, align);
 
+	str = "pool.huge_pages";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	pool_glb->config.huge_pages = !!val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "pool.prefault";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	pool_glb->config.prefault = !!val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
 	_ODP_PRINT("\n");
 
 	return 0;
@@ -352,6 +616,9 @@ int _odp_pool_init_global(void)
 		pool->pool_idx = i;
 	}
 
+	for (i = 0; i < ODP_THREAD_COUNT_MAX; i++)
+		odp_atomic_init_u32(&_odp_pool_glb->flush_req[i], 0);
+
 	_ODP_DBG("\nPool init global\n");
 	_ODP_DBG("  event_hdr_t size               %zu\n", sizeof(_odp_event_hdr_t));
 	_ODP_DBG("  buffer_hdr_t size              %zu\n", sizeof(odp_buffer_hdr_t));
@@ -416,6 +683,9 @@ int _odp_pool_term_local(void)
 {
 	int i;
 
+	/* Mark pending flush requests handled */
+	_odp_pool_cache_flush_req_handle();
+
 	for (i = 0; i < CONFIG_POOLS; i++) {
 		pool_t *pool = _odp_pool_entry_from_idx(i);
 
@@ -657,6 +927,34 @@ static bool shm_is_from_huge_pages(odp_shm_t shm)
 	return (info.page_size >= huge_page_size);
 }
 
+/* Touch every page of a memory block. Contents of the memory are not modified. */
+static void prefault_shm(odp_shm_t shm)
+{
+	odp_shm_info_t info;
+	volatile uint8_t *addr;
+
+	if (shm == ODP_SHM_INVALID)
+		return;
+
+	if (odp_shm_info(shm, &info)) {
+		_ODP_ERR("Failed to fetch shm info\n");
+		return;
+	}
+
+	addr = info.addr;
+
+	for (uint64_t offset = 0; offset < info.size; offset += info.page_size)
+		addr[offset] = addr[offset];
+}
+
+static void prefault_pool(pool_t *pool)
+{
+	prefault_shm(pool->shm);
+	prefault_shm(pool->uarea_shm);
+	prefault_shm(pool->ring_shm);
+	prefault_shm(pool->depot_shm);
+}
+
 static void set_pool_name(pool_t *pool, const char *name)
 {
 	if (name == NULL)
@@ -716,6 +1014,64 @@ static int reserve_uarea(pool_t *pool, uint32_t uarea_size, uint32_t num_pkt, ui
 	return 0;
 }
 
+/* Reserve magazine depot and assign initial magazines to thread local caches.
+ * Depot has enough magazines to store all pool buffers, up to a per thread
+ * limit. Buffers that do not fit into depot magazines are stored in the pool
+ * ring. */
+static int reserve_depot(pool_t *pool, uint32_t num, uint32_t shmflags)
+{
+	odp_shm_t shm;
+	uint8_t *addr;
+	pool_mag_t *mag;
+	uint32_t num_mag, ring_size;
+	uint64_t ring_mem_size;
+	const uint32_t max_threads = odp_thread_count_max();
+	char depot_name[ODP_SHM_NAME_LEN];
+
+	pool->depot_shm = ODP_SHM_INVALID;
+	pool->mag_size  = pool->cache_size / 2;
+
+	if (pool->cache_size == 0)
+		return 0;
+
+	num_mag = _ODP_MIN(num / pool->mag_size, max_threads * POOL_DEPOT_MAGS_PER_THR) + 2;
+	ring_size = _ODP_ROUNDUP_POWER2_U32(num_mag + 1);
+	ring_mem_size = _ODP_ROUNDUP_CACHE_LINE(sizeof(ring_ptr_t) + ring_size * sizeof(void *));
+
+	sprintf(depot_name, "_odp_pool_depot_%d", pool->pool_idx);
+	shm = odp_shm_reserve(depot_name, (2 * ring_mem_size) + num_mag * sizeof(pool_mag_t),
+			      ODP_CACHE_LINE_SIZE, shmflags);
+
+	if (shm == ODP_SHM_INVALID)
+		return -1;
+
+	addr = odp_shm_addr(shm);
+	pool->depot_shm   = shm;
+	pool->depot.full  = (ring_ptr_t *)(uintptr_t)addr;
+	pool->depot.empty = (ring_ptr_t *)(uintptr_t)(addr + ring_mem_size);
+	pool->depot.mask  = ring_size - 1;
+	mag = (pool_mag_t *)(uintptr_t)(addr + 2 * ring_mem_size);
+
+	ring_ptr_init(pool->depot.full);
+	ring_ptr_init(pool->depot.empty);
+
+	for (uint32_t i = 0; i < num_mag; i++) {
+		mag[i].num = 0;
+		ring_ptr_enq(pool->depot.empty, pool->depot.mask, &mag[i]);
+	}
+
+	for (uint32_t i = 0; i < max_threads; i++) {
+		pool_cache_t *cache = &pool->local_cache[i];
+
+		cache->mag[0].num = 0;
+		cache->mag[1].num = 0;
+		cache->loaded     = &cache->mag[0];
+		cache->prev       = &cache->mag[1];
+	}
+
+	return 0;
+}
+
 static void set_mem_src_ops(pool_t *pool)
 {
 	odp_bool_t is_active_found = false;
@@ -758,6 +1114,8 @@ odp_pool_t _odp_pool_create(const char *name, const odp_pool_param_t *params,
 		shmflags = ODP_SHM_PROC;
 	if (odp_global_ro.shm_single_va)
 		shmflags |= ODP_SHM_SINGLE_VA;
+	if (_odp_pool_glb->config.huge_pages)
+		shmflags |= ODP_SHM_HP;
 
 	align = 0;
 
@@ -981,6 +1339,14 @@ odp_pool_t _odp_pool_create(const char *name, const odp_pool_param_t *params,
 		goto error;
 	}
 
+	if (reserve_depot(pool, num, shmflags)) {
+		_ODP_ERR("Magazine depot SHM reserve failed\n");
+		goto error;
+	}
+
+	if (_odp_pool_glb->config.prefault)
+		prefault_pool(pool);
+
 	ring_ptr_init(&pool->ring->hdr);
 	init_buffers(pool);
 
@@ -1002,6 +1368,9 @@ odp_pool_t _odp_pool_create(const char *name, const odp_pool_param_t *params,
 	odp_atomic_init_u64(&pool->stats.free_ops, 0);
 	odp_atomic_init_u64(&pool->stats.cache_alloc_ops, 0);
 	odp_atomic_init_u64(&pool->stats.cache_free_ops, 0);
+	odp_atomic_init_u64(&pool->stats.cache_flush_reqs, 0);
+	odp_atomic_init_u64(&pool->stats.cache_flushed, 0);
+	odp_atomic_init_u32(&pool->flush_pending, 0);
 
 	return _odp_pool_handle(pool);
 
@@ -1012,6 +1381,9 @@ error:
 	if (pool->uarea_shm != ODP_SHM_INVALID)
 		odp_shm_free(pool->uarea_shm);
 
+	if (pool->depot_shm != ODP_SHM_INVALID)
+		odp_shm_free(pool->depot_shm);
+
 	if (pool->ring_shm != ODP_SHM_INVALID)
 		odp_shm_free(pool->ring_shm);
 
@@ -1268,6 +1640,9 @@ int odp_pool_destroy(odp_pool_t pool_hdl)
 	if (pool->uarea_shm != ODP_SHM_INVALID)
 		odp_shm_free(pool->uarea_shm);
 
+	if (pool->depot_shm != ODP_SHM_INVALID)
+		odp_shm_free(pool->depot_shm);
+
 	pool->reserved = 0;
 	odp_shm_free(pool->ring_shm);
 	pool->ring = NULL;
@@ -1347,6 +1722,11 @@ int _odp_event_alloc_multi(pool_t *pool, _odp_event_hdr_t *event_hdr[], int max_
 	/* First pull packets from local cache */
 	num_ch = cache_pop(cache, event_hdr, max_num);
 
+	/* Local cache is empty, exchange the empty magazine for a full one */
+	if (odp_unlikely(num_ch != (uint32_t)max_num) && pool->cache_size &&
+	    cache_refill(pool, cache))
+		num_ch += cache_pop(cache, &event_hdr[num_ch], max_num - num_ch);
+
 	if (CONFIG_POOL_STATISTICS && pool->params.stats.bit.cache_alloc_ops && num_ch)
 		odp_atomic_inc_u64(&pool->stats.cache_alloc_ops);
 
@@ -1377,8 +1757,15 @@ int _odp_event_alloc_multi(pool_t *pool, _odp_event_hdr_t *event_hdr[], int max_
 		if (odp_unlikely(burst < num_deq)) {
 			num_deq   = burst;
 			cache_num = 0;
+
+			/* Pool is running out of events. Ask other threads to return
+			 * events stored in their local caches. */
+			if (pool->cache_size)
+				cache_flush_request(pool, 0);
 		}
 
+		_odp_pool_cache_flush_check(local.thr_id);
+
 		for (i = 0; i < num_deq; i++) {
 			uint32_t idx = num_ch + i;
 
@@ -1389,7 +1776,7 @@ int _odp_event_alloc_multi(pool_t *pool, _odp_event_hdr_t *event_hdr[], int max_
 
 		/* Cache possible extra buffers. Cache is currently empty. */
 		if (cache_num)
-			cache_push(cache, &hdr_tmp[num_deq], cache_num);
+			cache_push(pool, cache, &hdr_tmp[num_deq], cache_num);
 	}
 
 	num_alloc = num_ch + num_deq;
@@ -1403,7 +1790,7 @@ static inline void event_free_to_pool(pool_t *pool,
 	uint32_t pool_idx = pool->pool_idx;
 	pool_cache_t *cache = local.cache[pool_idx];
 	ring_ptr_t *ring;
-	uint32_t cache_num, mask;
+	uint32_t mask;
 	uint32_t cache_size = pool->cache_size;
 
 	/* Special case of a very large free. Move directly to
@@ -1420,31 +1807,8 @@ static inline void event_free_to_pool(pool_t *pool,
 		return;
 	}
 
-	/* Make room into local cache if needed. Do at least burst size
-	 * transfer. */
-	cache_num = odp_atomic_load_u32(&cache->cache_num);
-
-	if (odp_unlikely((int)(cache_size - cache_num) < num)) {
-		int burst = pool->burst_size;
-
-		ring  = &pool->ring->hdr;
-		mask  = pool->ring_mask;
-
-		if (odp_unlikely(num > burst))
-			burst = num;
-		if (odp_unlikely((uint32_t)num > cache_num))
-			burst = cache_num;
-
-		_odp_event_hdr_t *ev_hdr[burst];
-
-		cache_pop(cache, ev_hdr, burst);
-
-		ring_ptr_enq_multi(ring, mask, (void **)ev_hdr, burst);
-		if (CONFIG_POOL_STATISTICS && pool->params.stats.bit.free_ops)
-			odp_atomic_inc_u64(&pool->stats.free_ops);
-	}
-
-	cache_push(cache, event_hdr, num);
+	/* Full magazines are moved to the depot while pushing */
+	cache_push(pool, cache, event_hdr, num);
 	if (CONFIG_POOL_STATISTICS && pool->params.stats.bit.cache_free_ops)
 		odp_atomic_inc_u64(&pool->stats.cache_free_ops);
 }
@@ -1567,6 +1931,8 @@ int odp_pool_capability(odp_pool_capability_t *capa)
 	supported_stats.bit.cache_alloc_ops = CONFIG_POOL_STATISTICS;
 	supported_stats.bit.cache_free_ops = CONFIG_POOL_STATISTICS;
 	supported_stats.bit.thread_cache_available = 1;
+	supported_stats.bit.cache_flush_reqs = CONFIG_POOL_STATISTICS;
+	supported_stats.bit.cache_flushed = CONFIG_POOL_STATISTICS;
 
 	/* Buffer pools */
 	capa->buf.max_pools = max_pools;
@@ -1695,12 +2061,14 @@ void odp_pool_print(odp_pool_t pool_hdl)
 	_ODP_PRINT("  block size      %u\n", pool->block_size);
 	_ODP_PRINT("  uarea size      %u\n", pool->uarea_size);
 	_ODP_PRINT("  shm size        %" PRIu64 "\n", pool->shm_size);
+	_ODP_PRINT("  huge pages      %u\n", pool->mem_from_huge_pages);
 	_ODP_PRINT("  base addr       %p\n", (void *)pool->base_addr);
 	_ODP_PRINT("  max addr        %p\n", (void *)pool->max_addr);
 	_ODP_PRINT("  uarea shm size  %" PRIu64 "\n", pool->uarea_shm_size);
 	_ODP_PRINT("  uarea base addr %p\n", (void *)pool->uarea_base_addr);
 	_ODP_PRINT("  cache size      %u\n", pool->cache_size);
 	_ODP_PRINT("  burst size      %u\n", pool->burst_size);
+	_ODP_PRINT("  magazine size   %u\n", pool->mag_size);
 	_ODP_PRINT("  mem src         %s\n",
 		   pool->mem_src_ops ? pool->mem_src_ops->name : "(none)");
 	_ODP_PRINT("  event valid.    %d\n", _ODP_EVENT_VALIDATION);
@@ -1730,7 +2098,7 @@ void odp_pool_print_all(void)
 			continue;
 		}
 
-		available  = ring_ptr_len(&pool->ring->hdr);
+		available  = pool_available(pool);
 		cache_size = pool->cache_size;
 		ext        = pool->pool_ext;
 		index      = pool->pool_idx;
@@ -1794,7 +2162,7 @@ int odp_pool_stats(odp_pool_t pool_hdl, odp_pool_stats_t *stats)
 	memset(stats, 0, offsetof(odp_pool_stats_t, thread));
 
 	if (pool->params.stats.bit.available)
-		stats->available = ring_ptr_len(&pool->ring->hdr);
+		stats->available = pool_available(pool);
 
 	if (pool->params.stats.bit.alloc_ops)
 		stats->alloc_ops = odp_atomic_load_u64(&pool->stats.alloc_ops);
@@ -1820,6 +2188,12 @@ int odp_pool_stats(odp_pool_t pool_hdl, odp_pool_stats_t *stats)
 	if (pool->params.stats.bit.cache_free_ops)
 		stats->cache_free_ops = odp_atomic_load_u64(&pool->stats.cache_free_ops);
 
+	if (pool->params.stats.bit.cache_flush_reqs)
+		stats->cache_flush_reqs = odp_atomic_load_u64(&pool->stats.cache_flush_reqs);
+
+	if (pool->params.stats.bit.cache_flushed)
+		stats->cache_flushed = odp_atomic_load_u64(&pool->stats.cache_flushed);
+
 	return 0;
 }
 
@@ -1849,7 +2223,7 @@ int odp_pool_stats_selected(odp_pool_t pool_hdl, odp_pool_stats_selected_t *stat
 	}
 
 	if (opt->bit.available)
-		stats->available = ring_ptr_len(&pool->ring->hdr);
+		stats->available = pool_available(pool);
 
 	if (opt->bit.alloc_ops || opt->bit.total_ops)
 		stats->alloc_ops = odp_atomic_load_u64(&pool->stats.alloc_ops);
@@ -1872,6 +2246,12 @@ int odp_pool_stats_selected(odp_pool_t pool_hdl, odp_pool_stats_selected_t *stat
 	if (opt->bit.cache_free_ops)
 		stats->cache_free_ops = odp_atomic_load_u64(&pool->stats.cache_free_ops);
 
+	if (opt->bit.cache_flush_reqs)
+		stats->cache_flush_reqs = odp_atomic_load_u64(&pool->stats.cache_flush_reqs);
+
+	if (opt->bit.cache_flushed)
+		stats->cache_flushed = odp_atomic_load_u64(&pool->stats.cache_flushed);
+
 	return 0;
 }
 
@@ -1891,6 +2271,41 @@ int odp_pool_stats_reset(odp_pool_t pool_hdl)
 	odp_atomic_store_u64(&pool->stats.free_ops, 0);
 	odp_atomic_store_u64(&pool->stats.cache_alloc_ops, 0);
 	odp_atomic_store_u64(&pool->stats.cache_free_ops, 0);
+	odp_atomic_store_u64(&pool->stats.cache_flush_reqs, 0);
+	odp_atomic_store_u64(&pool->stats.cache_flushed, 0);
+
+	return 0;
+}
+
+void _odp_pool_cache_flush_local(pool_t *pool)
+{
+	uint32_t num;
+
+	if (pool->cache_size == 0)
+		return;
+
+	num = cache_flush(local.cache[pool->pool_idx], pool);
+
+	if (CONFIG_POOL_STATISTICS && pool->params.stats.bit.cache_flushed && num)
+		odp_atomic_add_u64(&pool->stats.cache_flushed, num);
+}
+
+int odp_pool_cache_trim(odp_pool_t pool_hdl)
+{
+	pool_t *pool;
+
+	if (odp_unlikely(pool_hdl == ODP_POOL_INVALID)) {
+		_ODP_ERR("Invalid pool handle\n");
+		return -1;
+	}
+
+	pool = _odp_pool_entry(pool_hdl);
+
+	if (pool->cache_size == 0)
+		return 0;
+
+	_odp_pool_cache_flush_local(pool);
+	cache_flush_request(pool, 1);
 
 	return 0;
 }
@@ -2085,6 +2500,8 @@ odp_pool_t odp_pool_ext_create(const char *name, const odp_pool_ext_param_t *par
 
 	if (odp_global_ro.shm_single_va)
 		shm_flags |= ODP_SHM_SINGLE_VA;
+	if (_odp_pool_glb->config.huge_pages)
+		shm_flags |= ODP_SHM_HP;
 
 	pool = reserve_pool(shm_flags, 1, num_buf);
 
@@ -2102,6 +2519,11 @@ odp_pool_t odp_pool_ext_create(const char *name, const odp_pool_ext_param_t *par
 		goto error;
 	}
 
+	if (reserve_depot(pool, num_buf, shm_flags)) {
+		_ODP_ERR("Magazine depot SHM reserve failed\n");
+		goto error;
+	}
+
 	/* Ring size must be larger than the number of items stored */
 	if (num_buf + 1 <= RING_SIZE_MIN)
 		ring_size = RING_SIZE_MIN;
@@ -2122,11 +2544,21 @@ odp_pool_t odp_pool_ext_create(const char *name, const odp_pool_ext_param_t *par
 	pool->base_addr      = (uint8_t *)(uintptr_t)UINT64_MAX;
 	pool->max_addr       = 0;
 
+	/* Event memory is provided by the application */
+	if (_odp_pool_glb->config.prefault)
+		prefault_pool(pool);
+
 	ring_ptr_init(&pool->ring->hdr);
 
 	return _odp_pool_handle(pool);
 
 error:
+	if (pool->uarea_shm != ODP_SHM_INVALID)
+		odp_shm_free(pool->uarea_shm);
+
+	if (pool->depot_shm != ODP_SHM_INVALID)
+		odp_shm_free(pool->depot_shm);
+
 	if (pool->ring_shm != ODP_SHM_INVALID)
 		odp_shm_free(pool->ring_shm);
 
@@ -12,11 +12,13 @@
 #include <odp/api/std_types.h>
 #include <odp/api/sync.h>
 #include <odp/api/ticketlock.h>
+#include <odp/api/time.h>
 #include <odp/api/traffic_mngr.h>
 
 #include <odp/api/plat/queue_inline_types.h>
 #include <odp/api/plat/sync_inlines.h>
 #include <odp/api/plat/ticketlock_inlines.h>
+#include <odp/api/plat/time_inlines.h>
 
 #include <odp_config_internal.h>
 #include <odp_debug_internal.h>
@@ -104,7 +106,21 @@ static int read_config_file(queue_global_t *_odp_queue_glb)
 	}
 
 	_odp_queue_glb->config.default_queue_size = val_u32;
-	_ODP_PRINT("  %s: %u\n\n", str, val_u32);
+	_ODP_PRINT("  %s: %u\n", str, val_u32);
+
+	str = "queue_basic.plain_ring_type";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val != QUEUE_RING_MPMC && val != QUEUE_RING_MPMC_SEQ) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	_odp_queue_glb->config.plain_ring_type = val;
+	_ODP_PRINT("  %s: %i\n\n", str, val);
 
 	return 0;
 }
@@ -152,8 +168,14 @@ static int queue_init_global(void)
 	}
 
 	_odp_queue_glb->queue_gbl_shm = shm;
+
+	/* Sequence number ring slots are 64 bits */
+	_odp_queue_glb->ring_data_num = _odp_queue_glb->config.max_queue_size;
+	if (_odp_queue_glb->config.plain_ring_type == QUEUE_RING_MPMC_SEQ)
+		_odp_queue_glb->ring_data_num *= 2;
+
 	mem_size = sizeof(uint32_t) * CONFIG_MAX_QUEUES *
-		   (uint64_t)_odp_queue_glb->config.max_queue_size;
+		   (uint64_t)_odp_queue_glb->ring_data_num;
 
 	shm = odp_shm_reserve("_odp_queue_basic_rings", mem_size,
 			      ODP_CACHE_LINE_SIZE,
@@ -433,6 +455,8 @@ static int queue_destroy(odp_queue_t handle)
 		empty = ring_spsc_is_empty(&queue->ring_spsc);
 	else if (queue->type == ODP_QUEUE_TYPE_SCHED)
 		empty = ring_st_is_empty(&queue->ring_st);
+	else if (_odp_queue_glb->config.plain_ring_type == QUEUE_RING_MPMC_SEQ)
+		empty = ring_mpmc_seq_u32_is_empty(&queue->ring_mpmc_seq);
 	else
 		empty = ring_mpmc_u32_is_empty(&queue->ring_mpmc);
 
@@ -579,6 +603,79 @@ static inline int _plain_queue_deq_multi(odp_queue_t handle,
 	return num_deq;
 }
 
+static inline odp_atomic_u64_t *ring_slot(queue_entry_t *queue)
+{
+	return (odp_atomic_u64_t *)(uintptr_t)queue->ring_data;
+}
+
+static inline int _plain_seq_queue_enq_multi(odp_queue_t handle,
+					     _odp_event_hdr_t *event_hdr[], int num)
+{
+	queue_entry_t *queue;
+	int ret;
+	uint32_t event_idx[num];
+
+	queue = qentry_from_handle(handle);
+
+	if (_odp_sched_fn->ord_enq_multi(handle, (void **)event_hdr, num, &ret))
+		return ret;
+
+	event_index_from_hdr(event_idx, event_hdr, num);
+
+	return ring_mpmc_seq_u32_enq_multi(&queue->ring_mpmc_seq, ring_slot(queue),
+					   queue->ring_mask, event_idx, num);
+}
+
+static inline int _plain_seq_queue_deq_multi(odp_queue_t handle,
+					     _odp_event_hdr_t *event_hdr[], int num)
+{
+	int num_deq;
+	queue_entry_t *queue;
+	uint32_t event_idx[num];
+
+	queue = qentry_from_handle(handle);
+
+	num_deq = ring_mpmc_seq_u32_deq_multi(&queue->ring_mpmc_seq, ring_slot(queue),
+					      queue->ring_mask, event_idx, num);
+
+	if (num_deq == 0)
+		return 0;
+
+	event_index_to_hdr(event_hdr, event_idx, num_deq);
+
+	return num_deq;
+}
+
+static int plain_seq_queue_enq_multi(odp_queue_t handle,
+				     _odp_event_hdr_t *event_hdr[], int num)
+{
+	return _plain_seq_queue_enq_multi(handle, event_hdr, num);
+}
+
+static int plain_seq_queue_enq(odp_queue_t handle, _odp_event_hdr_t *event_hdr)
+{
+	if (_plain_seq_queue_enq_multi(handle, &event_hdr, 1) == 1)
+		return 0;
+
+	return -1;
+}
+
+static int plain_seq_queue_deq_multi(odp_queue_t handle,
+				     _odp_event_hdr_t *event_hdr[], int num)
+{
+	return _plain_seq_queue_deq_multi(handle, event_hdr, num);
+}
+
+static _odp_event_hdr_t *plain_seq_queue_deq(odp_queue_t handle)
+{
+	_odp_event_hdr_t *event_hdr = NULL;
+
+	if (_plain_seq_queue_deq_multi(handle, &event_hdr, 1) == 1)
+		return event_hdr;
+
+	return NULL;
+}
+
 static int plain_queue_enq_multi(odp_queue_t handle,
 				 _odp_event_hdr_t *event_hdr[], int num)
 {
@@ -794,6 +891,10 @@ static void queue_print(odp_queue_t handle)
 		_ODP_PRINT("  implementation  ring_st\n");
 		_ODP_PRINT("  length          %" PRIu32 "/%" PRIu32 "\n",
 			   ring_st_length(&queue->ring_st), queue->ring_mask + 1);
+	} else if (_odp_queue_glb->config.plain_ring_type == QUEUE_RING_MPMC_SEQ) {
+		_ODP_PRINT("  implementation  ring_mpmc_seq\n");
+		_ODP_PRINT("  length          %" PRIu32 "/%" PRIu32 "\n",
+			   ring_mpmc_seq_u32_len(&queue->ring_mpmc_seq), queue->ring_mask + 1);
 	} else {
 		_ODP_PRINT("  implementation  ring_mpmc\n");
 		_ODP_PRINT("  length          %" PRIu32 "/%" PRIu32 "\n",
@@ -862,6 +963,9 @@ static void queue_print_all(void)
 			sync    = queue->param.sched.sync;
 			if (_odp_sched_id == _ODP_SCHED_ID_BASIC)
 				spr = _odp_sched_basic_get_spread(index);
+		} else if (_odp_queue_glb->config.plain_ring_type == QUEUE_RING_MPMC_SEQ) {
+			len     = ring_mpmc_seq_u32_len(&queue->ring_mpmc_seq);
+			max_len = queue->ring_mask + 1;
 		} else {
 			len     = ring_mpmc_u32_len(&queue->ring_mpmc);
 			max_len = queue->ring_mask + 1;
@@ -926,6 +1030,9 @@ static inline int _sched_queue_enq_multi(odp_queue_t handle,
 	if (_odp_sched_fn->ord_enq_multi(handle, (void **)event_hdr, num, &ret))
 		return ret;
 
+	if (CONFIG_SCHED_STATISTICS)
+		_odp_event_enq_ts_set(event_hdr, num, odp_time_local_ns());
+
 	event_index_from_hdr(event_idx, event_hdr, num);
 
 	LOCK(queue);
@@ -1045,7 +1152,6 @@ int _odp_sched_queue_empty(uint32_t queue_index)
 static int queue_init(queue_entry_t *queue, const char *name,
 		      const odp_queue_param_t *param)
 {
-	uint64_t offset;
 	uint32_t queue_size;
 	odp_queue_type_t queue_type;
 	int spsc;
@@ -1084,8 +1190,6 @@ static int queue_init(queue_entry_t *queue, const char *name,
 		return -1;
 	}
 
-	offset = queue->index * (uint64_t)_odp_queue_glb->config.max_queue_size;
-
 	/* Single-producer / single-consumer plain queue has simple and
 	 * lock-free implementation */
 	spsc = (queue_type == ODP_QUEUE_TYPE_PLAIN) &&
@@ -1105,14 +1209,27 @@ static int queue_init(queue_entry_t *queue, const char *name,
 	if (spsc) {
 		_odp_queue_spsc_init(queue, queue_size);
 	} else {
-		if (queue_type == ODP_QUEUE_TYPE_PLAIN) {
+		if (queue_type == ODP_QUEUE_TYPE_PLAIN &&
+		    _odp_queue_glb->config.plain_ring_type == QUEUE_RING_MPMC_SEQ) {
+			queue->enqueue            = plain_seq_queue_enq;
+			queue->enqueue_multi      = plain_seq_queue_enq_multi;
+			queue->dequeue            = plain_seq_queue_deq;
+			queue->dequeue_multi      = plain_seq_queue_deq_multi;
+			queue->orig_dequeue_multi = plain_seq_queue_deq_multi;
+
+			queue->ring_data = queue_ring_data(queue);
+			queue->ring_mask = queue_size - 1;
+			ring_mpmc_seq_u32_init(&queue->ring_mpmc_seq, ring_slot(queue),
+					       queue->ring_mask);
+
+		} else if (queue_type == ODP_QUEUE_TYPE_PLAIN) {
 			queue->enqueue            = plain_queue_enq;
 			queue->enqueue_multi      = plain_queue_enq_multi;
 			queue->dequeue            = plain_queue_deq;
 			queue->dequeue_multi      = plain_queue_deq_multi;
 			queue->orig_dequeue_multi = plain_queue_deq_multi;
 
-			queue->ring_data = &_odp_queue_glb->ring_data[offset];
+			queue->ring_data = queue_ring_data(queue);
 			queue->ring_mask = queue_size - 1;
 			ring_mpmc_u32_init(&queue->ring_mpmc);
 
@@ -1120,7 +1237,7 @@ static int queue_init(queue_entry_t *queue, const char *name,
 			queue->enqueue            = sched_queue_enq;
 			queue->enqueue_multi      = sched_queue_enq_multi;
 
-			queue->ring_data = &_odp_queue_glb->ring_data[offset];
+			queue->ring_data = queue_ring_data(queue);
 			queue->ring_mask = queue_size - 1;
 			ring_st_init(&queue->ring_st);
 		}
@@ -31,6 +31,7 @@
 #include <odp/api/packet_io.h>
 #include <odp_ring_u32_internal.h>
 #include <odp_timer_internal.h>
+#include <odp_pool_internal.h>
 #include <odp_queue_basic_internal.h>
 #include <odp_libconfig_internal.h>
 #include <odp/api/plat/queue_inlines.h>
@@ -171,6 +172,12 @@ static uint8_t sched_random_u8[] = {
 
 ODP_STATIC_ASSERT(sizeof(sched_random_u8) == RANDOM_TBL_SIZE, "Bad_random_table_size");
 
+/* Per thread scheduler statistics. Updated only by the owner thread. */
+typedef struct ODP_ALIGNED_CACHE {
+	odp_schedule_stats_t s;
+
+} sched_stats_t;
+
 /* Scheduler local data */
 typedef struct ODP_ALIGNED_CACHE {
 	uint32_t sched_round;
@@ -197,6 +204,21 @@ typedef struct ODP_ALIGNED_CACHE {
 	uint8_t grp[NUM_SCHED_GRPS];
 	uint8_t spread_tbl[SPREAD_TBL_SIZE];
 
+	/* Statistics of this thread (CONFIG_SCHED_STATISTICS) */
+	sched_stats_t *stats;
+
+	/* Adaptive burst size state */
+	struct {
+		/* Start time of the previous schedule round */
+		uint64_t ts;
+		/* Number of events dequeued on the previous schedule round */
+		uint32_t num;
+		/* Average processing time per event */
+		uint32_t ev_nsec;
+		/* Burst size limit from latency target */
+		uint16_t burst;
+	} adapt;
+
 	struct {
 		/* Source queue index */
 		uint32_t src_queue;
@@ -243,6 +265,11 @@ typedef struct {
 		uint16_t order_stash_size;
 		uint8_t num_spread;
 		uint8_t prefer_ratio;
+		struct {
+			uint8_t  enable;
+			uint8_t  min;
+			uint32_t latency_target;
+		} burst_adapt;
 	} config;
 	uint32_t         ring_mask;
 	uint16_t         max_spread;
@@ -284,6 +311,7 @@ typedef struct {
 		char           name[ODP_SCHED_GROUP_NAME_LEN];
 		odp_thrmask_t  mask;
 		uint16_t       spread_thrs[MAX_SPREAD];
+		uint16_t       num_thr;
 		uint8_t        allocated;
 	} sched_grp[NUM_SCHED_GRPS];
 
@@ -304,6 +332,10 @@ typedef struct {
 	uint32_t max_queues;
 	odp_atomic_u32_t next_rand;
 
+	/* Per thread statistics (CONFIG_SCHED_STATISTICS) */
+	sched_stats_t *stats;
+	odp_shm_t stats_shm;
+
 } sched_global_t;
 
 /* Check that queue[] variables are large enough */
@@ -506,6 +538,43 @@ static int read_config_file(sched_global_t *sched)
 				 "sched_basic.burst_size_max_ordered", 0, BURST_MAX, 1))
 		return -1;
 
+	str = "sched_basic.burst_adapt.enable";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val > 1 || val < 0) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	sched->config.burst_adapt.enable = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "sched_basic.burst_adapt.min";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val > BURST_MAX || val < 1) {
+		_ODP_ERR("Bad value %s = %i [min: 1, max: %u]\n", str, val, BURST_MAX);
+		return -1;
+	}
+
+	sched->config.burst_adapt.min = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "sched_basic.burst_adapt.latency_target_nsec";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	sched->config.burst_adapt.latency_target = _ODP_MAX(0, val);
+	_ODP_PRINT("  %s: %i\n", str, val);
+
 	str = "sched_basic.group_enable.all";
 	if (!_odp_libconfig_lookup_int(str, &val)) {
 		_ODP_ERR("Config option '%s' not found.\n", str);
@@ -579,6 +648,11 @@ static void sched_local_init(void)
 	sched_local.sync_ctx    = NO_SYNC_CONTEXT;
 	sched_local.stash.queue = ODP_QUEUE_INVALID;
 
+	if (CONFIG_SCHED_STATISTICS)
+		sched_local.stats = &sched->stats[sched_local.thr];
+
+	sched_local.adapt.burst = BURST_MAX;
+
 	spread = spread_from_index(sched_local.thr);
 	prefer_ratio = sched->config.prefer_ratio;
 
@@ -689,6 +763,23 @@ static int schedule_init_global(void)
 
 	odp_thrmask_setall(&sched->mask_all);
 
+	sched->stats_shm = ODP_SHM_INVALID;
+
+	if (CONFIG_SCHED_STATISTICS) {
+		uint64_t stats_size = sizeof(sched_stats_t) * ODP_THREAD_COUNT_MAX;
+
+		shm = odp_shm_reserve("_odp_sched_basic_stats", stats_size, ODP_CACHE_LINE_SIZE, 0);
+		if (shm == ODP_SHM_INVALID) {
+			_ODP_ERR("Schedule init: Stats shm reserve failed.\n");
+			odp_shm_free(sched->shm);
+			return -1;
+		}
+
+		sched->stats_shm = shm;
+		sched->stats = odp_shm_addr(shm);
+		memset(sched->stats, 0, stats_size);
+	}
+
 	_ODP_DBG("done\n");
 
 	return 0;
@@ -722,6 +813,11 @@ static int schedule_term_global(void)
 		}
 	}
 
+	if (sched->stats_shm != ODP_SHM_INVALID && odp_shm_free(sched->stats_shm)) {
+		_ODP_ERR("Shm free failed for scheduler statistics\n");
+		rc = -1;
+	}
+
 	ret = odp_shm_free(sched->shm);
 	if (ret < 0) {
 		_ODP_ERR("Shm free failed for odp_scheduler");
@@ -740,6 +836,7 @@ static int schedule_init_local(void)
 static inline void grp_update_mask(int grp, const odp_thrmask_t *new_mask)
 {
 	odp_thrmask_copy(&sched->sched_grp[grp].mask, new_mask);
+	sched->sched_grp[grp].num_thr = odp_thrmask_count(new_mask);
 	odp_atomic_add_rel_u32(&sched->grp_epoch, 1);
 }
 
@@ -1204,6 +1301,53 @@ static inline int balance_spread(int grp, int prio, int cur_spr)
 	return new_spr;
 }
 
+static inline void stats_hist_add(odp_schedule_stats_hist_t *hist, uint64_t val)
+{
+	int bin = 0;
+
+	/* Value range of bin N (N > 0) is [2^(N-1), 2^N - 1] */
+	if (val)
+		bin = _ODP_MIN(64 - __builtin_clzll(val), ODP_SCHED_STATS_HIST_BINS - 1);
+
+	if (odp_unlikely(hist->num == 0 || val < hist->min))
+		hist->min = val;
+
+	if (val > hist->max)
+		hist->max = val;
+
+	hist->num++;
+	hist->sum += val;
+	hist->bin[bin]++;
+}
+
+static inline void stats_queue_delay(odp_event_t ev[], int num)
+{
+	odp_schedule_stats_hist_t *hist = &sched_local.stats->s.queue_delay;
+	uint64_t now = odp_time_local_ns();
+
+	for (int i = 0; i < num; i++) {
+		uint64_t enq_ts = _odp_event_enq_ts(_odp_event_hdr(ev[i]));
+
+		stats_hist_add(hist, now > enq_ts ? now - enq_ts : 0);
+	}
+}
+
+static inline void stats_round(int num, uint64_t latency)
+{
+	odp_schedule_stats_t *stats = &sched_local.stats->s;
+
+	stats->rounds++;
+
+	if (num <= 0) {
+		stats->empty_rounds++;
+		return;
+	}
+
+	stats->events += num;
+	stats_hist_add(&stats->latency, latency);
+	stats_hist_add(&stats->burst, num);
+}
+
 static inline int copy_from_stash(odp_event_t *restrict out_ev, uint32_t max)
 {
 	int i = 0;
@@ -1367,6 +1511,57 @@ static inline int poll_pktin(uint32_t qi, int direct_recv,
 	return ret;
 }
 
+/* Update burst size limit of the latency target. Previous burst was processed
+ * between the start of the previous round and now. */
+static inline void burst_adapt_latency(void)
+{
+	uint64_t now = odp_time_local_ns();
+	uint32_t num = sched_local.adapt.num;
+
+	if (num) {
+		uint64_t ev_nsec = (now - sched_local.adapt.ts) / num;
+		uint64_t avg = sched_local.adapt.ev_nsec;
+		uint64_t burst;
+
+		/* Moving average with 1/8 weight on the new sample */
+		avg = avg ? (7 * avg + ev_nsec) / 8 : ev_nsec;
+		if (avg > UINT32_MAX)
+			avg = UINT32_MAX;
+
+		burst = sched->config.burst_adapt.latency_target / (avg ? avg : 1);
+		if (burst > BURST_MAX)
+			burst = BURST_MAX;
+		if (burst == 0)
+			burst = 1;
+
+		sched_local.adapt.ev_nsec = avg;
+		sched_local.adapt.burst   = burst;
+		sched_local.adapt.num     = 0;
+	}
+
+	sched_local.adapt.ts = now;
+}
+
+/* Scale dequeue burst size with queue backlog. Backlog of a parallel or ordered queue
+ * is shared between threads of the group. Atomic queues are served by one thread at a
+ * time. */
+static inline uint32_t burst_adapt(uint32_t qi, int grp, int sync, uint32_t max_deq)
+{
+	uint32_t burst = _odp_sched_queue_len(qi);
+	uint32_t num_thr = sched->sched_grp[grp].num_thr;
+
+	if (sync != ODP_SCHED_SYNC_ATOMIC && num_thr > 1)
+		burst = (burst + num_thr - 1) / num_thr;
+
+	if (sched->config.burst_adapt.latency_target && burst > sched_local.adapt.burst)
+		burst = sched_local.adapt.burst;
+
+	if (burst < sched->config.burst_adapt.min)
+		burst = sched->config.burst_adapt.min;
+
+	return burst < max_deq ? burst : max_deq;
+}
+
 static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[], uint32_t max_num,
 				    int grp, int prio, int first_spr, int balance)
 {
@@ -1437,6 +1632,11 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 
 		pktin = queue_is_pktin(qi);
 
+		/* Packet input queues are polled with full burst size, since their backlog
+		 * is in the pktio interface. */
+		if (odp_unlikely(sched->config.burst_adapt.enable) && !pktin)
+			max_deq = burst_adapt(qi, grp, sync_ctx, max_deq);
+
 		/* Update queue spread before dequeue. Dequeue changes status of an empty
 		 * queue, which enables a following enqueue operation to insert the queue
 		 * back into scheduling (with new spread). */
@@ -1458,6 +1658,9 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 			continue;
 		}
 
+		if (CONFIG_SCHED_STATISTICS && num > 0)
+			stats_queue_delay(ev_tbl, num);
+
 		if (num == 0) {
 			int direct_recv = !ordered;
 			int num_pkt;
@@ -1491,6 +1694,8 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 			num = num_pkt;
 		}
 
+		sched_local.adapt.num = num;
+
 		if (ordered) {
 			uint64_t ctx;
 			odp_atomic_u64_t *next_ctx;
@@ -1540,7 +1745,7 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 /*
  * Schedule queues
  */
-static inline int do_schedule(odp_queue_t *out_q, odp_event_t out_ev[], uint32_t max_num)
+static inline int do_schedule_round(odp_queue_t *out_q, odp_event_t out_ev[], uint32_t max_num)
 {
 	int i, num_grp, ret, spr, first_id, grp_id, grp, prio;
 	uint32_t sched_round;
@@ -1567,6 +1772,9 @@ static inline int do_schedule(odp_queue_t *out_q, odp_event_t out_ev[], uint32_t
 	if (odp_unlikely(sched_local.pause))
 		return 0;
 
+	if (odp_unlikely(sched->config.burst_adapt.latency_target))
+		burst_adapt_latency();
+
 	sched_round = sched_local.sched_round++;
 
 	/* Each thread prefers a priority queue. Spread weight table avoids
@@ -1648,6 +1856,21 @@ static inline int do_schedule(odp_queue_t *out_q, odp_event_t out_ev[], uint32_t
 	return 0;
 }
 
+static inline int do_schedule(odp_queue_t *out_q, odp_event_t out_ev[], uint32_t max_num)
+{
+	uint64_t start;
+	int ret;
+
+	if (!CONFIG_SCHED_STATISTICS)
+		return do_schedule_round(out_q, out_ev, max_num);
+
+	start = odp_time_local_ns();
+	ret = do_schedule_round(out_q, out_ev, max_num);
+	stats_round(ret, odp_time_local_ns() - start);
+
+	return ret;
+}
+
 static inline int schedule_run(odp_queue_t *out_queue, odp_event_t out_ev[], uint32_t max_num)
 {
 	timer_run(1);
@@ -1669,6 +1892,7 @@ static inline int schedule_loop(odp_queue_t *out_queue, uint64_t wait,
 			break;
 		}
 		timer_run(1);
+		_odp_pool_cache_flush_check(sched_local.thr);
 
 		if (wait == ODP_SCHED_WAIT)
 			continue;
@@ -1704,6 +1928,8 @@ static inline int schedule_loop_sleep(odp_queue_t *out_queue, uint64_t wait,
 		}
 		uint64_t next = timer_run(sleep ? TIMER_SCAN_FORCE : 1);
 
+		_odp_pool_cache_flush_check(sched_local.thr);
+
 		if (first) {
 			start = odp_time_local();
 			start_sleep = odp_time_add_ns(start, sched->powersave.poll_time);
@@ -2242,6 +2468,7 @@ static int schedule_capability(odp_schedule_capability_t *capa)
 	capa->max_queue_size = _odp_queue_glb->config.max_queue_size;
 	capa->max_flow_id = BUF_HDR_MAX_FLOW_ID;
 	capa->order_wait = ODP_SUPPORT_YES;
+	capa->stats = CONFIG_SCHED_STATISTICS ? ODP_SUPPORT_YES : ODP_SUPPORT_NO;
 
 	return 0;
 }
@@ -2328,6 +2555,137 @@ static void schedule_print(void)
 	_ODP_PRINT("\n");
 }
 
+static void stats_hist_combine(odp_schedule_stats_hist_t *hist,
+			       const odp_schedule_stats_hist_t *thr_hist)
+{
+	if (thr_hist->num == 0)
+		return;
+
+	if (hist->num == 0 || thr_hist->min < hist->min)
+		hist->min = thr_hist->min;
+
+	if (thr_hist->max > hist->max)
+		hist->max = thr_hist->max;
+
+	hist->num += thr_hist->num;
+	hist->sum += thr_hist->sum;
+
+	for (int i = 0; i < ODP_SCHED_STATS_HIST_BINS; i++)
+		hist->bin[i] += thr_hist->bin[i];
+}
+
+static void stats_combine(odp_schedule_stats_t *stats, const odp_schedule_stats_t *thr_stats)
+{
+	stats->rounds += thr_stats->rounds;
+	stats->empty_rounds += thr_stats->empty_rounds;
+	stats->events += thr_stats->events;
+	stats_hist_combine(&stats->latency, &thr_stats->latency);
+	stats_hist_combine(&stats->queue_delay, &thr_stats->queue_delay);
+	stats_hist_combine(&stats->burst, &thr_stats->burst);
+}
+
+static int schedule_stats(int thr, odp_schedule_stats_t *stats)
+{
+	if (!CONFIG_SCHED_STATISTICS) {
+		_ODP_ERR("Scheduler statistics not enabled\n");
+		return -1;
+	}
+
+	if (thr >= ODP_THREAD_COUNT_MAX) {
+		_ODP_ERR("Bad thread ID %i\n", thr);
+		return -1;
+	}
+
+	memset(stats, 0, sizeof(odp_schedule_stats_t));
+
+	if (thr >= 0) {
+		stats_combine(stats, &sched->stats[thr].s);
+		return 0;
+	}
+
+	for (int i = 0; i < ODP_THREAD_COUNT_MAX; i++)
+		stats_combine(stats, &sched->stats[i].s);
+
+	return 0;
+}
+
+static int schedule_stats_reset(void)
+{
+	if (!CONFIG_SCHED_STATISTICS) {
+		_ODP_ERR("Scheduler statistics not enabled\n");
+		return -1;
+	}
+
+	memset(sched->stats, 0, sizeof(sched_stats_t) * ODP_THREAD_COUNT_MAX);
+
+	return 0;
+}
+
+static inline uint64_t stats_hist_avg(const odp_schedule_stats_hist_t *hist)
+{
+	return hist->num ? hist->sum / hist->num : 0;
+}
+
+static void stats_hist_print(const char *name, const odp_schedule_stats_hist_t *hist)
+{
+	_ODP_PRINT("\n  %s histogram:\n", name);
+
+	for (int i = 0; i < ODP_SCHED_STATS_HIST_BINS; i++) {
+		uint64_t low = i ? (uint64_t)1 << (i - 1) : 0;
+
+		if (hist->bin[i] == 0)
+			continue;
+
+		_ODP_PRINT("    >= %20" PRIu64 ": %" PRIu64 "\n", low, hist->bin[i]);
+	}
+}
+
+static void stats_line_print(const char *name, const odp_schedule_stats_t *stats)
+{
+	_ODP_PRINT("  %-6s %12" PRIu64 " %12" PRIu64 " %14" PRIu64 " %8" PRIu64 " %10" PRIu64 " %8"
+		   PRIu64 " %10" PRIu64 " %6" PRIu64 "\n", name, stats->rounds, stats->empty_rounds,
+		   stats->events, stats_hist_avg(&stats->latency), stats->latency.max,
+		   stats_hist_avg(&stats->queue_delay), stats->queue_delay.max,
+		   stats_hist_avg(&stats->burst));
+}
+
+static void schedule_stats_print(void)
+{
+	odp_schedule_stats_t total;
+	char name[16];
+
+	_ODP_PRINT("\nScheduler statistics\n");
+	_ODP_PRINT("--------------------\n");
+
+	if (!CONFIG_SCHED_STATISTICS) {
+		_ODP_PRINT("  Not enabled (CONFIG_SCHED_STATISTICS)\n\n");
+		return;
+	}
+
+	_ODP_PRINT("  Latency and delay values in nsec\n\n");
+	_ODP_PRINT("  thread       rounds        empty         events  lat avg    lat max"
+		   "  dly avg    dly max  burst\n");
+
+	memset(&total, 0, sizeof(odp_schedule_stats_t));
+
+	for (int i = 0; i < ODP_THREAD_COUNT_MAX; i++) {
+		const odp_schedule_stats_t *stats = &sched->stats[i].s;
+
+		if (stats->rounds == 0)
+			continue;
+
+		snprintf(name, sizeof(name), "%i", i);
+		stats_line_print(name, stats);
+		stats_combine(&total, stats);
+	}
+
+	stats_line_print("total", &total);
+	stats_hist_print("Latency", &total.latency);
+	stats_hist_print("Queue delay", &total.queue_delay);
+	stats_hist_print("Burst size", &total.burst);
+	_ODP_PRINT("\n");
+}
+
 /* Returns spread for queue debug prints */
 int _odp_sched_basic_get_spread(uint32_t queue_index)
 {
@@ -2398,7 +2756,10 @@ const _odp_schedule_api_fn_t _odp_schedule_basic_api = {
 	.schedule_order_lock_start  = schedule_order_lock_start,
 	.schedule_order_lock_wait   = schedule_order_lock_wait,
 	.schedule_order_wait      = order_lock,
-	.schedule_print           = schedule_print
+	.schedule_print           = schedule_print,
+	.schedule_stats           = schedule_stats,
+	.schedule_stats_reset     = schedule_stats_reset,
+	.schedule_stats_print     = schedule_stats_print
 };
 
 /* API functions used when powersave is enabled in the config file. */
@@ -2435,5 +2796,8 @@ const _odp_schedule_api_fn_t _odp_schedule_basic_sleep_api = {
 	.schedule_order_lock_start  = schedule_order_lock_start,
 	.schedule_order_lock_wait   = schedule_order_lock_wait,
 	.schedule_order_wait      = order_lock,
-	.schedule_print           = schedule_print
+	.schedule_print           = schedule_print,
+	.schedule_stats           = schedule_stats,
+	.schedule_stats_reset     = schedule_stats_reset,
+	.schedule_stats_print     = schedule_stats_print
 };
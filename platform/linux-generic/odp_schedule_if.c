@@ -152,6 +152,21 @@ void odp_schedule_print(void)
 	_odp_sched_api->schedule_print();
 }
 
+int odp_schedule_stats(int thr, odp_schedule_stats_t *stats)
+{
+	return _odp_sched_api->schedule_stats(thr, stats);
+}
+
+int odp_schedule_stats_reset(void)
+{
+	return _odp_sched_api->schedule_stats_reset();
+}
+
+void odp_schedule_stats_print(void)
+{
+	_odp_sched_api->schedule_stats_print();
+}
+
 int _odp_schedule_init_global(void)
 {
 	const char *sched = getenv("ODP_SCHEDULER");
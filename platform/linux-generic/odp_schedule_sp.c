@@ -27,6 +27,7 @@
 #include <odp_config_internal.h>
 #include <odp_event_internal.h>
 #include <odp_macros_internal.h>
+#include <odp_pool_internal.h>
 #include <odp_ring_u32_internal.h>
 #include <odp_timer_internal.h>
 #include <odp_queue_basic_internal.h>
@@ -674,6 +675,7 @@ static int schedule_multi(odp_queue_t *from, uint64_t wait,
 
 		if (cmd == NULL) {
 			timer_run(1);
+			_odp_pool_cache_flush_check(sched_local.thr_id);
 			/* All priority queues are empty */
 			if (wait == ODP_SCHED_NO_WAIT)
 				return 0;
@@ -1056,6 +1058,23 @@ static void schedule_print(void)
 	_ODP_PRINT("\n");
 }
 
+static int schedule_stats(int thr ODP_UNUSED, odp_schedule_stats_t *stats ODP_UNUSED)
+{
+	_ODP_ERR("Scheduler statistics not supported\n");
+	return -1;
+}
+
+static int schedule_stats_reset(void)
+{
+	_ODP_ERR("Scheduler statistics not supported\n");
+	return -1;
+}
+
+static void schedule_stats_print(void)
+{
+	_ODP_PRINT("\nScheduler statistics not supported\n\n");
+}
+
 static void get_config(schedule_config_t *config)
 {
 	*config = sched_global->config_if;
@@ -1121,5 +1140,8 @@ const _odp_schedule_api_fn_t _odp_schedule_sp_api = {
 	.schedule_order_lock_start  = schedule_order_lock_start,
 	.schedule_order_lock_wait   = schedule_order_lock_wait,
 	.schedule_order_wait      = order_lock,
-	.schedule_print           = schedule_print
+	.schedule_print           = schedule_print,
+	.schedule_stats           = schedule_stats,
+	.schedule_stats_reset     = schedule_stats_reset,
+	.schedule_stats_print     = schedule_stats_print
 };
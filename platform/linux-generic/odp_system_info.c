@@ -633,6 +633,7 @@ void odp_sys_config_print(void)
 	_ODP_PRINT("CONFIG_POOL_MAX_NUM:           %i\n", CONFIG_POOL_MAX_NUM);
 	_ODP_PRINT("CONFIG_POOL_CACHE_MAX_SIZE:    %i\n", CONFIG_POOL_CACHE_MAX_SIZE);
 	_ODP_PRINT("CONFIG_POOL_STATISTICS:        %i\n", CONFIG_POOL_STATISTICS);
+	_ODP_PRINT("CONFIG_SCHED_STATISTICS:       %i\n", CONFIG_SCHED_STATISTICS);
 	_ODP_PRINT("CONFIG_IPSEC_MAX_NUM_SA:       %i\n", CONFIG_IPSEC_MAX_NUM_SA);
 	_ODP_PRINT("CONFIG_TIMER_128BIT_ATOMICS:   %i\n", CONFIG_TIMER_128BIT_ATOMICS);
 	_ODP_PRINT("CONFIG_TIMER_PROFILE_INLINE:   %i\n", CONFIG_TIMER_PROFILE_INLINE);
@@ -17,7 +17,7 @@
  * as long as the following constraints are met (by the way REV stands for
  * REVOLUTION, i.e. one complete sweep through a specific timer wheel):
  */
-#define TIME_TO_TICKS_SHIFT    10
+#define TIME_TO_TICKS_SHIFT    _ODP_INT_TIMER_WHEEL_TICK_SHIFT
 #define TIME_PER_TICK          BIT(TIME_TO_TICKS_SHIFT)
 #define CURRENT_TIMER_SLOTS    1024
 #define LEVEL1_TIMER_SLOTS     2048
@@ -113,6 +113,9 @@ static const tm_prop_t basic_prop_tbl[MAX_PRIORITIES][NUM_SHAPER_COLORS] = {
 #define MAX_THRESHOLD_PROFILES 128
 #define MAX_WRED_PROFILES 128
 
+/* Maximum number of pkts sent to the egress pktout queue at a time */
+#define TM_EGRESS_BURST 32
+
 typedef struct {
 	struct {
 		tm_shaper_params_t profile[MAX_SHAPER_PROFILES];
@@ -269,19 +272,6 @@ static uint16_t tm_random16(tm_random_data_t *tm_random_data)
 	return (rand8b << 8) | rand8a;
 }
 
-static odp_bool_t tm_random_drop(tm_random_data_t *tm_random_data,
-				 odp_tm_percent_t drop_prob)
-{
-	odp_bool_t drop;
-	uint32_t random_int, scaled_random_int;
-
-	/* Pick a random integer between 0 and 10000. */
-	random_int = tm_random16(tm_random_data);
-	scaled_random_int = (random_int * 10000) >> 16;
-	drop = scaled_random_int < (uint32_t)drop_prob;
-	return drop;
-}
-
 static void *alloc_entry_in_tbl(profile_tbl_t *profile_tbl,
 				profile_kind_t profile_kind,
 				uint32_t *idx)
@@ -405,8 +395,10 @@ static void free_tbl_entry(profile_tbl_t *profile_tbl,
 static void input_work_queue_init(input_work_queue_t *input_work_queue)
 {
 	memset(input_work_queue, 0, sizeof(input_work_queue_t));
-	odp_atomic_init_u64(&input_work_queue->queue_cnt, 0);
-	odp_ticketlock_init(&input_work_queue->lock);
+	odp_atomic_init_u32(&input_work_queue->w_head, 0);
+	odp_atomic_init_u32(&input_work_queue->w_tail, 0);
+	odp_atomic_init_u32(&input_work_queue->r_tail, 0);
+	odp_atomic_init_u64(&input_work_queue->enqueue_fail_cnt, 0);
 }
 
 static void input_work_queue_destroy(input_work_queue_t *input_work_queue)
@@ -415,66 +407,85 @@ static void input_work_queue_destroy(input_work_queue_t *input_work_queue)
 	* freeing it.  Of course, elsewhere it is essential to have first
 	* stopped new tm_enq() (et al) calls from succeeding.
 	*/
-	odp_ticketlock_lock(&input_work_queue->lock);
 	memset(input_work_queue, 0, sizeof(input_work_queue_t));
 }
 
-static int input_work_queue_append(tm_system_t *tm_system,
-				   input_work_item_t *work_item)
+static inline uint32_t input_work_queue_len(input_work_queue_t *input_work_queue)
+{
+	return odp_atomic_load_u32(&input_work_queue->w_tail) -
+	       odp_atomic_load_u32(&input_work_queue->r_tail);
+}
+
+/* Append up to num work items. Returns the number of items appended. */
+static uint32_t input_work_queue_append(tm_system_t *tm_system,
+					const input_work_item_t work_item[],
+					uint32_t num)
 {
 	input_work_queue_t *input_work_queue;
-	input_work_item_t *entry_ptr;
-	uint32_t queue_cnt, tail_idx;
+	uint32_t old_head, new_head, r_tail, num_free, i;
+	const uint32_t mask = INPUT_WORK_RING_SIZE - 1;
 
 	input_work_queue = &tm_system->input_work_queue;
-	queue_cnt = odp_atomic_load_u64(&input_work_queue->queue_cnt);
-	if (INPUT_WORK_RING_SIZE <= queue_cnt) {
-		input_work_queue->enqueue_fail_cnt++;
-		return -1;
-	}
 
-	odp_ticketlock_lock(&input_work_queue->lock);
-	tail_idx = input_work_queue->tail_idx;
-	entry_ptr = &input_work_queue->work_ring[tail_idx];
-
-	*entry_ptr = *work_item;
-	tail_idx++;
-	if (INPUT_WORK_RING_SIZE <= tail_idx)
-		tail_idx = 0;
-
-	input_work_queue->total_enqueues++;
-	input_work_queue->tail_idx = tail_idx;
-	odp_ticketlock_unlock(&input_work_queue->lock);
-	odp_atomic_inc_u64(&input_work_queue->queue_cnt);
-	if (input_work_queue->peak_cnt <= queue_cnt)
-		input_work_queue->peak_cnt = queue_cnt + 1;
-	return 0;
+	/* Reserve ring slots between old and new w_head. Load acquire of
+	 * r_tail pairs with the store release of the TM thread, so that the
+	 * reserved slots have been read before they are overwritten. */
+	do {
+		old_head = odp_atomic_load_acq_u32(&input_work_queue->w_head);
+		r_tail = odp_atomic_load_acq_u32(&input_work_queue->r_tail);
+		num_free = INPUT_WORK_RING_SIZE - (old_head - r_tail);
+
+		if (num_free == 0) {
+			odp_atomic_inc_u64(&input_work_queue->enqueue_fail_cnt);
+			return 0;
+		}
+
+		if (num > num_free)
+			num = num_free;
+
+		new_head = old_head + num;
+
+	} while (odp_unlikely(!odp_atomic_cas_u32(&input_work_queue->w_head,
+						  &old_head, new_head)));
+
+	for (i = 0; i < num; i++)
+		input_work_queue->work_ring[(old_head + i) & mask] = work_item[i];
+
+	/* Wait until earlier reservations have been released */
+	while (odp_unlikely(odp_atomic_load_u32(&input_work_queue->w_tail) !=
+			    old_head))
+		odp_cpu_pause();
+
+	odp_atomic_store_rel_u32(&input_work_queue->w_tail, new_head);
+	return num;
 }
 
-static int input_work_queue_remove(input_work_queue_t *input_work_queue,
-				   input_work_item_t *work_item)
+/* Remove up to max_num work items. Only the TM thread calls this. */
+static uint32_t input_work_queue_remove(input_work_queue_t *input_work_queue,
+					input_work_item_t work_item[],
+					uint32_t max_num)
 {
-	input_work_item_t *entry_ptr;
-	uint32_t queue_cnt, head_idx;
+	uint32_t r_tail, w_tail, num, i;
+	const uint32_t mask = INPUT_WORK_RING_SIZE - 1;
 
-	queue_cnt = odp_atomic_load_u64(&input_work_queue->queue_cnt);
-	if (queue_cnt == 0)
-		return -1;
+	r_tail = odp_atomic_load_u32(&input_work_queue->r_tail);
+	w_tail = odp_atomic_load_acq_u32(&input_work_queue->w_tail);
+	num = w_tail - r_tail;
+	if (num == 0)
+		return 0;
 
-	odp_ticketlock_lock(&input_work_queue->lock);
-	head_idx = input_work_queue->head_idx;
-	entry_ptr = &input_work_queue->work_ring[head_idx];
+	if (input_work_queue->peak_cnt < num)
+		input_work_queue->peak_cnt = num;
 
-	*work_item = *entry_ptr;
-	head_idx++;
-	if (INPUT_WORK_RING_SIZE <= head_idx)
-		head_idx = 0;
+	if (num > max_num)
+		num = max_num;
 
-	input_work_queue->total_dequeues++;
-	input_work_queue->head_idx = head_idx;
-	odp_ticketlock_unlock(&input_work_queue->lock);
-	odp_atomic_dec_u64(&input_work_queue->queue_cnt);
-	return 0;
+	for (i = 0; i < num; i++)
+		work_item[i] = input_work_queue->work_ring[(r_tail + i) & mask];
+
+	input_work_queue->total_dequeues += num;
+	odp_atomic_store_rel_u32(&input_work_queue->r_tail, r_tail + num);
+	return num;
 }
 
 static tm_system_t *tm_system_alloc(void)
@@ -821,6 +832,14 @@ static void update_shaper_elapsed_time(tm_system_t        *tm_system,
 	if (time_delta < (uint64_t)shaper_params->min_time_delta)
 		return;
 
+	/* Full token buckets stay full, skip the token arithmetic. */
+	if ((shaper_obj->commit_cnt == shaper_params->max_commit) &&
+	    ((!shaper_params->dual_rate) ||
+	     (shaper_obj->peak_cnt == shaper_params->max_peak))) {
+		shaper_obj->last_update_time = tm_system->current_time;
+		return;
+	}
+
 	commit = shaper_obj->commit_cnt;
 	max_commit = shaper_params->max_commit;
 
@@ -999,6 +1018,31 @@ static odp_bool_t delay_pkt(tm_system_t *tm_system,
 	return true;
 }
 
+/* Returns true if the pkt already waits for a shaper timer, which expires on
+ * the same timer wheel tick as a timer started by delay_pkt() now would. */
+static odp_bool_t delay_pkt_pending(tm_system_t *tm_system,
+				    tm_shaper_obj_t *shaper_obj,
+				    pkt_desc_t *pkt_desc)
+{
+	tm_queue_obj_t *tm_queue_obj;
+	uint64_t wakeup_time;
+
+	if ((shaper_obj->callback_reason != UNDELAY_PKT) ||
+	    pkt_descs_not_equal(&shaper_obj->in_pkt_desc, pkt_desc))
+		return false;
+
+	tm_queue_obj = get_tm_queue_obj(tm_system, pkt_desc);
+	if (!tm_queue_obj || (tm_queue_obj->timer_shaper != shaper_obj) ||
+	    (tm_queue_obj->timer_reason != UNDELAY_PKT))
+		return false;
+
+	wakeup_time = tm_system->current_time +
+		      time_till_not_red(shaper_obj->shaper_params, shaper_obj);
+
+	return (wakeup_time >> _ODP_INT_TIMER_WHEEL_TICK_SHIFT) ==
+	       (shaper_obj->callback_time >> _ODP_INT_TIMER_WHEEL_TICK_SHIFT);
+}
+
 /* We call rm_pkt_from_shaper for pkts sent AND for pkts demoted. This function
  * returns true iff the shaper has a change in its output (e.g. empty to
  * non-empty, non-empty to empty or non-empty to a different non-empty pkt). */
@@ -1121,11 +1165,18 @@ static odp_bool_t run_shaper(tm_system_t     *tm_system,
 		priority   = propagation.output_priority;
 
 		/* See if this shaper had a previous timer associated with it.
-		 * If so we need to cancel it. */
+		 * If so we need to cancel it - unless the same pkt is delayed
+		 * again and the timer expires on the same timer wheel tick as
+		 * a new one would. */
 		if ((shaper_obj->timer_outstanding != 0) &&
-		    (shaper_obj->in_pkt_desc.queue_num != 0))
+		    (shaper_obj->in_pkt_desc.queue_num != 0)) {
+			if (propagation.action == DELAY_PKT &&
+			    delay_pkt_pending(tm_system, shaper_obj, pkt_desc))
+				return false;
+
 			(void)rm_pkt_from_shaper(tm_system, shaper_obj,
 						 &shaper_obj->in_pkt_desc, 0);
+		}
 
 		shaper_obj->propagation_result = propagation;
 		if (propagation.action == DELAY_PKT)
@@ -1782,11 +1833,13 @@ static odp_bool_t tm_consume_sent_pkt(tm_system_t *tm_system,
 				   sent_pkt_desc);
 }
 
-static odp_tm_percent_t tm_queue_fullness(tm_wred_params_t      *wred_params,
-					  tm_queue_thresholds_t *thresholds,
-					  tm_queue_cnts_t       *queue_cnts)
+/* Returns the queue fullness as an index into the WRED drop table. Values of
+ * TM_WRED_TBL_SIZE and above mean that the queue is full. */
+static uint32_t tm_queue_fullness(tm_wred_params_t      *wred_params,
+				  tm_queue_thresholds_t *thresholds,
+				  tm_queue_cnts_t       *queue_cnts)
 {
-	uint64_t current_cnt, max_cnt, fullness;
+	uint64_t current_cnt, max_cnt;
 
 	if (wred_params->use_byte_fullness) {
 		current_cnt = odp_atomic_load_u64(&queue_cnts->byte_cnt);
@@ -1799,60 +1852,31 @@ static odp_tm_percent_t tm_queue_fullness(tm_wred_params_t      *wred_params,
 	if (max_cnt == 0)
 		return 0;
 
-	fullness = (10000 * current_cnt) / max_cnt;
-	return (odp_tm_percent_t)_ODP_MIN(fullness, UINT64_C(50000));
+	if (max_cnt <= current_cnt)
+		return TM_WRED_TBL_SIZE;
+
+	return (uint32_t)((current_cnt * TM_WRED_TBL_SIZE) / max_cnt);
 }
 
 static odp_bool_t tm_local_random_drop(tm_system_t      *tm_system,
 				       tm_wred_params_t *wred_params,
-				       odp_tm_percent_t  queue_fullness)
+				       uint32_t          fullness_idx)
 {
-	odp_tm_percent_t min_threshold, med_threshold, first_threshold;
-	odp_tm_percent_t drop_prob;
-	odp_tm_percent_t med_drop_prob, max_drop_prob;
-	uint32_t denom, numer;
+	uint16_t drop_thr;
 
 	if (wred_params->enable_wred == 0)
 		return 0;
 
-	min_threshold = wred_params->min_threshold;
-	med_threshold = wred_params->med_threshold;
-	first_threshold = (min_threshold != 0) ? min_threshold : med_threshold;
-	if (10000 <= queue_fullness)
+	if (TM_WRED_TBL_SIZE <= fullness_idx)
 		return 1;
-	else if (queue_fullness <= first_threshold)
-		return 0;
 
-       /* Determine if we have two active thresholds, min_threshold and
-	* med_threshold or just med_threshold. */
-	med_drop_prob = wred_params->med_drop_prob;
-	max_drop_prob = wred_params->max_drop_prob;
-	if (min_threshold == 0) {
-		denom = (uint32_t)(10000 - med_threshold);
-		numer = (uint32_t)max_drop_prob;
-		drop_prob =
-			(numer * (uint32_t)(queue_fullness - med_threshold)) /
-			denom;
-	} else if ((min_threshold < queue_fullness) &&
-		   (queue_fullness < med_threshold)) {
-		denom = (uint32_t)(med_threshold - min_threshold);
-		numer = (uint32_t)med_drop_prob;
-		drop_prob =
-			(numer * (uint32_t)(queue_fullness - min_threshold)) /
-			denom;
-	} else { /* med_threshold <= queue_fullness. */
-		denom = (uint32_t)(10000 - med_threshold);
-		numer = (uint32_t)(max_drop_prob - med_drop_prob);
-		drop_prob = max_drop_prob -
-			((numer * (10000 - queue_fullness)) / denom);
-	}
-
-	if (drop_prob == 0)
+	drop_thr = wred_params->drop_thr[fullness_idx];
+	if (drop_thr == 0)
 		return 0;
-	else if (10000 <= drop_prob)
+	else if (drop_thr == UINT16_MAX)
 		return 1;
 	else
-		return tm_random_drop(&tm_system->tm_random_data, drop_prob);
+		return tm_random16(&tm_system->tm_random_data) < drop_thr;
 }
 
 static odp_bool_t tm_queue_is_full(tm_queue_thresholds_t *thresholds,
@@ -1883,7 +1907,7 @@ static odp_bool_t random_early_discard(tm_system_t *tm_system,
 {
 	tm_queue_thresholds_t *thresholds;
 	tm_wred_params_t      *wred_params;
-	odp_tm_percent_t       fullness;
+	uint32_t               fullness;
 	tm_queue_cnts_t       *queue_cnts;
 
 	thresholds = tm_wred_node->threshold_params;
@@ -2010,54 +2034,99 @@ static inline void activate_packet_aging(odp_packet_hdr_t *pkt_hdr)
 		pkt_hdr->tx_aging_ns = pkt_hdr->tx_aging_ns + odp_time_global_ns();
 }
 
-static int tm_enqueue(tm_system_t *tm_system,
-		      tm_queue_obj_t *tm_queue_obj,
-		      odp_packet_t pkt)
+static inline void tm_first_enq_wait(tm_system_t *tm_system)
 {
 	tm_system_group_t *tm_group;
-	input_work_item_t work_item;
-	odp_packet_color_t pkt_color;
-	tm_wred_node_t *initial_tm_wred_node;
-	odp_bool_t drop_eligible, drop;
-	uint32_t frame_len, pkt_depth;
-	int rc;
 
 	tm_group = GET_TM_GROUP(tm_system->odp_tm_group);
 	if (tm_group->first_enq == 0) {
 		odp_barrier_wait(&tm_group->tm_group_barrier);
 		tm_group->first_enq = 1;
 	}
+}
+
+/* Returns true if the pkt is dropped by WRED */
+static inline odp_bool_t tm_enq_drop(tm_system_t *tm_system,
+				     tm_queue_obj_t *tm_queue_obj,
+				     odp_packet_t pkt)
+{
+	if (!odp_packet_drop_eligible(pkt))
+		return false;
+
+	return random_early_discard(tm_system, tm_queue_obj,
+				    &tm_queue_obj->tm_wred_node,
+				    odp_packet_color(pkt));
+}
+
+/* Count a pkt into the queue depths. Pkts are counted before they are appended
+ * into the input work queue, so that WRED decisions of following pkts see them
+ * and the TM thread never uncounts a pkt that has not been counted yet. Returns
+ * the new pkt depth of the queue. */
+static inline uint32_t tm_enq_count(tm_system_t *tm_system,
+				    tm_queue_obj_t *tm_queue_obj,
+				    odp_packet_t pkt)
+{
+	return tm_queue_cnts_increment(tm_system, &tm_queue_obj->tm_wred_node,
+				       tm_queue_obj->priority,
+				       odp_packet_len(pkt));
+}
+
+/* Uncount a pkt that did not fit into the input work queue */
+static inline void tm_enq_uncount(tm_system_t *tm_system,
+				  tm_queue_obj_t *tm_queue_obj,
+				  odp_packet_t pkt)
+{
+	tm_queue_cnts_decrement(tm_system, &tm_queue_obj->tm_wred_node,
+				tm_queue_obj->priority, odp_packet_len(pkt));
+}
 
-	pkt_color = odp_packet_color(pkt);
-	drop_eligible = odp_packet_drop_eligible(pkt);
+/* Append counted pkts (max INPUT_WORK_BURST) into the input work queue.
+ * Returns the number of pkts appended. */
+static uint32_t tm_enq_append(tm_system_t *tm_system,
+			      tm_queue_obj_t *tm_queue_obj,
+			      const odp_packet_t pkt[], uint32_t num)
+{
+	input_work_item_t work_item[INPUT_WORK_BURST];
+	uint32_t i, num_enq;
 
-	initial_tm_wred_node = &tm_queue_obj->tm_wred_node;
-	if (drop_eligible) {
-		drop = random_early_discard(tm_system, tm_queue_obj,
-					    initial_tm_wred_node, pkt_color);
-		if (drop)
-			return -2;
+	for (i = 0; i < num; i++) {
+		work_item[i].queue_num = tm_queue_obj->queue_num;
+		work_item[i].pkt = pkt[i];
+		activate_packet_aging(packet_hdr(pkt[i]));
 	}
 
-	work_item.queue_num = tm_queue_obj->queue_num;
-	work_item.pkt = pkt;
 	if (tm_queue_obj->ordered_enqueue)
 		_odp_sched_fn->order_lock();
 
-	activate_packet_aging(packet_hdr(pkt));
-	rc = input_work_queue_append(tm_system, &work_item);
+	num_enq = input_work_queue_append(tm_system, work_item, num);
 
 	if (tm_queue_obj->ordered_enqueue)
 		_odp_sched_fn->order_unlock();
 
-	if (rc < 0) {
+	if (num_enq < num)
 		_ODP_DBG("%s work queue full\n", __func__);
-		return rc;
+
+	return num_enq;
+}
+
+static int tm_enqueue(tm_system_t *tm_system,
+		      tm_queue_obj_t *tm_queue_obj,
+		      odp_packet_t pkt)
+{
+	uint32_t pkt_depth;
+
+	tm_first_enq_wait(tm_system);
+
+	if (tm_enq_drop(tm_system, tm_queue_obj, pkt))
+		return -2;
+
+	pkt_depth = tm_enq_count(tm_system, tm_queue_obj, pkt);
+
+	if (tm_enq_append(tm_system, tm_queue_obj, &pkt, 1) != 1) {
+		tm_enq_uncount(tm_system, tm_queue_obj, pkt);
+		return -1;
 	}
 
-	frame_len = odp_packet_len(pkt);
-	pkt_depth = tm_queue_cnts_increment(tm_system, initial_tm_wred_node,
-					    tm_queue_obj->priority, frame_len);
 	return pkt_depth;
 }
 
@@ -2247,53 +2316,91 @@ static inline odp_bool_t is_packet_aged(odp_packet_hdr_t *pkt_hdr)
 	return pkt_hdr->p.flags.tx_aging && pkt_hdr->tx_aging_ns < odp_time_global_ns();
 }
 
+static void tm_egress_pktout_burst(tm_system_t *tm_system, odp_packet_t pkt[],
+				   tm_queue_obj_t *tm_queue_obj[], uint32_t num)
+{
+	pktio_entry_t *pktio_entry = get_pktio_entry(tm_system->pktout.pktio);
+	odp_packet_t send_pkt[TM_EGRESS_BURST], drop_pkt[TM_EGRESS_BURST];
+	tm_queue_obj_t *send_qobj[TM_EGRESS_BURST];
+	uint32_t i, num_send = 0, num_drop = 0;
+	odp_bool_t aging = _odp_pktio_tx_aging_enabled(pktio_entry);
+	int ret;
+
+	/* Mark pkts and drop aged ones in one pass over the burst */
+	for (i = 0; i < num; i++) {
+		if (tm_system->marking_enabled)
+			tm_egress_marking(tm_system, pkt[i]);
+
+		if (odp_unlikely(aging && is_packet_aged(packet_hdr(pkt[i])))) {
+			/* Aged packet handled as a discard */
+			drop_pkt[num_drop++] = pkt[i];
+			odp_atomic_inc_u64(&tm_queue_obj[i]->stats.discards);
+			continue;
+		}
+
+		send_pkt[num_send] = pkt[i];
+		send_qobj[num_send++] = tm_queue_obj[i];
+	}
+
+	ret = 0;
+	if (num_send)
+		ret = odp_pktout_send(tm_system->pktout, send_pkt, num_send);
+
+	for (i = 0; i < num_send; i++) {
+		if (odp_likely((int)i < ret)) {
+			odp_atomic_inc_u64(&send_qobj[i]->stats.packets);
+			continue;
+		}
+
+		drop_pkt[num_drop++] = send_pkt[i];
+		if (odp_unlikely(ret < 0))
+			odp_atomic_inc_u64(&send_qobj[i]->stats.errors);
+		else
+			odp_atomic_inc_u64(&send_qobj[i]->stats.discards);
+	}
+
+	if (odp_unlikely(num_drop)) {
+		if (odp_unlikely(_odp_pktio_tx_compl_enabled(pktio_entry)))
+			_odp_pktio_process_tx_compl(pktio_entry, drop_pkt, num_drop);
+		odp_packet_free_multi(drop_pkt, num_drop);
+	}
+}
+
+/* Pkts egressing to a pktout queue are collected and sent in bursts of up
+ * to TM_EGRESS_BURST pkts. */
 static void tm_send_pkt(tm_system_t *tm_system, uint32_t max_sends)
 {
 	tm_queue_obj_t *tm_queue_obj;
 	odp_packet_t odp_pkt;
 	pkt_desc_t *pkt_desc;
 	uint32_t cnt;
-	int ret;
-	pktio_entry_t *pktio_entry;
+	odp_packet_t burst_pkt[TM_EGRESS_BURST];
+	tm_queue_obj_t *burst_qobj[TM_EGRESS_BURST];
+	uint32_t num = 0;
 
 	for (cnt = 1; cnt <= max_sends; cnt++) {
 		pkt_desc = &tm_system->egress_pkt_desc;
 		tm_queue_obj = get_tm_queue_obj(tm_system, pkt_desc);
 		if (!tm_queue_obj)
-			return;
+			break;
 
 		odp_pkt = tm_queue_obj->pkt;
 		if (odp_pkt == ODP_PACKET_INVALID) {
 			tm_system->egress_pkt_desc = EMPTY_PKT_DESC;
-			return;
+			break;
 		}
 
-		if (tm_system->marking_enabled)
-			tm_egress_marking(tm_system, odp_pkt);
-
 		tm_system->egress_pkt_desc = EMPTY_PKT_DESC;
 		if (tm_system->egress.egress_kind == ODP_TM_EGRESS_PKT_IO) {
-			pktio_entry = get_pktio_entry(tm_system->pktout.pktio);
-			if (odp_unlikely(_odp_pktio_tx_aging_enabled(pktio_entry) &&
-					 is_packet_aged(packet_hdr(odp_pkt))))
-				ret = 0; /* Aged packet handled as a discard */
-			else
-				ret = odp_pktout_send(tm_system->pktout, &odp_pkt, 1);
-			if (odp_unlikely(ret != 1)) {
-				if (odp_unlikely(_odp_pktio_tx_compl_enabled(pktio_entry)))
-					_odp_pktio_process_tx_compl(pktio_entry, &odp_pkt, 1);
-				odp_packet_free(odp_pkt);
-				if (odp_unlikely(ret < 0))
-					odp_atomic_inc_u64(&tm_queue_obj->stats.errors);
-				else
-					odp_atomic_inc_u64(&tm_queue_obj->stats.discards);
-			} else {
-				odp_atomic_inc_u64(&tm_queue_obj->stats.packets);
-			}
+			burst_pkt[num] = odp_pkt;
+			burst_qobj[num++] = tm_queue_obj;
 		} else if (tm_system->egress.egress_kind == ODP_TM_EGRESS_FN) {
+			if (tm_system->marking_enabled)
+				tm_egress_marking(tm_system, odp_pkt);
+
 			tm_system->egress.egress_fcn(odp_pkt);
 		} else {
-			return;
+			break;
 		}
 
 		tm_queue_obj->sent_pkt = tm_queue_obj->pkt;
@@ -2304,35 +2411,40 @@ static void tm_send_pkt(tm_system_t *tm_system, uint32_t max_sends)
 		tm_queue_obj->sent_pkt = ODP_PACKET_INVALID;
 		tm_queue_obj->sent_pkt_desc = EMPTY_PKT_DESC;
 		if (tm_system->egress_pkt_desc.queue_num == 0)
-			return;
+			break;
+
+		if (num == TM_EGRESS_BURST) {
+			tm_egress_pktout_burst(tm_system, burst_pkt, burst_qobj, num);
+			num = 0;
+		}
 	}
+
+	if (num)
+		tm_egress_pktout_burst(tm_system, burst_pkt, burst_qobj, num);
 }
 
 static int tm_process_input_work_queue(tm_system_t *tm_system,
 				       input_work_queue_t *input_work_queue,
 				       uint32_t pkts_to_process)
 {
-	input_work_item_t work_item;
+	input_work_item_t work_item[INPUT_WORK_BURST];
 	tm_queue_obj_t *tm_queue_obj;
 	tm_shaper_obj_t *shaper_obj;
 	odp_packet_t pkt;
 	pkt_desc_t *pkt_desc;
-	uint32_t cnt;
+	uint32_t i, num;
 	int rc;
 
-	for (cnt = 1; cnt <= pkts_to_process; cnt++) {
-		rc = input_work_queue_remove(input_work_queue, &work_item);
-		if (rc < 0) {
-			_ODP_DBG("%s input_work_queue_remove() failed\n", __func__);
-			return rc;
-		}
+	num = input_work_queue_remove(input_work_queue, work_item,
+				      _ODP_MIN(pkts_to_process, (uint32_t)INPUT_WORK_BURST));
 
+	for (i = 0; i < num; i++) {
 		tm_queue_obj =
-			tm_system->queue_num_tbl[work_item.queue_num - 1];
-		pkt = work_item.pkt;
+			tm_system->queue_num_tbl[work_item[i].queue_num - 1];
+		pkt = work_item[i].pkt;
 		if (!tm_queue_obj) {
 			odp_packet_free(pkt);
-			return 0;
+			continue;
 		}
 
 		tm_queue_obj->pkts_rcvd_cnt++;
@@ -2354,12 +2466,13 @@ static int tm_process_input_work_queue(tm_system_t *tm_system,
 			rc = tm_propagate_pkt_desc(tm_system, shaper_obj,
 						   pkt_desc,
 						   tm_queue_obj->priority);
+			/* Send through spigot */
 			if (0 < rc)
-				return 1;  /* Send through spigot */
+				tm_send_pkt(tm_system, TM_EGRESS_BURST);
 		}
 	}
 
-	return 0;
+	return num;
 }
 
 static int tm_process_expired_timers(tm_system_t *tm_system,
@@ -2407,7 +2520,7 @@ static int tm_process_expired_timers(tm_system_t *tm_system,
 				      pkt_desc, priority);
 		work_done++;
 		if (tm_system->egress_pkt_desc.queue_num != 0)
-			tm_send_pkt(tm_system, 2);
+			tm_send_pkt(tm_system, TM_EGRESS_BURST);
 	}
 
 	return work_done;
@@ -2524,16 +2637,16 @@ static void *tm_system_thread(void *arg)
 
 		current_ns = odp_time_to_ns(odp_time_local());
 		tm_system->current_time = current_ns;
-		work_queue_cnt =
-			odp_atomic_load_u64(&input_work_queue->queue_cnt);
+		work_queue_cnt = input_work_queue_len(input_work_queue);
 
 		if (work_queue_cnt != 0) {
 			tm_process_input_work_queue(tm_system,
-						    input_work_queue, 1);
+						    input_work_queue,
+						    INPUT_WORK_BURST);
 		}
 
 		if (tm_system->egress_pkt_desc.queue_num != 0)
-			tm_send_pkt(tm_system, 1);
+			tm_send_pkt(tm_system, TM_EGRESS_BURST);
 
 		current_ns = odp_time_to_ns(odp_time_local());
 		tm_system->current_time = current_ns;
@@ -3674,6 +3787,62 @@ void odp_tm_wred_params_init(odp_tm_wred_params_t *params)
 	memset(params, 0, sizeof(odp_tm_wred_params_t));
 }
 
+/* Drop probability of the WRED curve at the given queue fullness */
+static odp_tm_percent_t tm_wred_drop_prob(const odp_tm_wred_params_t *params,
+					  odp_tm_percent_t queue_fullness)
+{
+	odp_tm_percent_t min_threshold, med_threshold, first_threshold;
+	odp_tm_percent_t med_drop_prob, max_drop_prob;
+	uint32_t denom, numer;
+
+	min_threshold = params->min_threshold;
+	med_threshold = params->med_threshold;
+	first_threshold = (min_threshold != 0) ? min_threshold : med_threshold;
+	if (10000 <= queue_fullness)
+		return 10000;
+	else if (queue_fullness <= first_threshold)
+		return 0;
+
+       /* Determine if we have two active thresholds, min_threshold and
+	* med_threshold or just med_threshold. */
+	med_drop_prob = params->med_drop_prob;
+	max_drop_prob = params->max_drop_prob;
+	if (min_threshold == 0) {
+		denom = (uint32_t)(10000 - med_threshold);
+		numer = (uint32_t)max_drop_prob;
+		return (numer * (uint32_t)(queue_fullness - med_threshold)) /
+			denom;
+	} else if ((min_threshold < queue_fullness) &&
+		   (queue_fullness < med_threshold)) {
+		denom = (uint32_t)(med_threshold - min_threshold);
+		numer = (uint32_t)med_drop_prob;
+		return (numer * (uint32_t)(queue_fullness - min_threshold)) /
+			denom;
+	}
+
+	/* med_threshold <= queue_fullness. */
+	denom = (uint32_t)(10000 - med_threshold);
+	numer = (uint32_t)(max_drop_prob - med_drop_prob);
+	return max_drop_prob - ((numer * (10000 - queue_fullness)) / denom);
+}
+
+static void tm_wred_drop_tbl_init(const odp_tm_wred_params_t *params,
+				  tm_wred_params_t *wred_params)
+{
+	uint32_t i, fullness, drop_prob;
+
+	for (i = 0; i < TM_WRED_TBL_SIZE; i++) {
+		/* Fullness at the middle of the table entry */
+		fullness = ((2 * i + 1) * 10000) / (2 * TM_WRED_TBL_SIZE);
+		drop_prob = tm_wred_drop_prob(params, fullness);
+
+		if (10000 <= drop_prob)
+			wred_params->drop_thr[i] = UINT16_MAX;
+		else
+			wred_params->drop_thr[i] = (drop_prob << 16) / 10000;
+	}
+}
+
 static void tm_wred_params_cvt_to(const odp_tm_wred_params_t *params,
 				  tm_wred_params_t     *wred_params)
 {
@@ -3683,6 +3852,7 @@ static void tm_wred_params_cvt_to(const odp_tm_wred_params_t *params,
 	wred_params->max_drop_prob     = params->max_drop_prob;
 	wred_params->enable_wred       = params->enable_wred;
 	wred_params->use_byte_fullness = params->use_byte_fullness;
+	tm_wred_drop_tbl_init(params, wred_params);
 }
 
 static void tm_wred_params_cvt_from(tm_wred_params_t     *wred_params,
@@ -4555,7 +4725,10 @@ int odp_tm_enq_multi(odp_tm_queue_t tm_queue, const odp_packet_t packets[],
 {
 	tm_queue_obj_t *tm_queue_obj;
 	tm_system_t *tm_system;
-	int i, rc;
+	odp_packet_t enq_pkt[INPUT_WORK_BURST];
+	odp_bool_t drop[INPUT_WORK_BURST];
+	uint32_t num_enq, num_cnt, burst, j;
+	int i = 0;
 
 	tm_queue_obj = GET_TM_QUEUE_OBJ(tm_queue);
 	if (!tm_queue_obj)
@@ -4568,17 +4741,55 @@ int odp_tm_enq_multi(odp_tm_queue_t tm_queue, const odp_packet_t packets[],
 	if (odp_atomic_load_acq_u64(&tm_system->destroying))
 		return -1;
 
-	for (i = 0; i < num; i++) {
-		rc = tm_enqueue(tm_system, tm_queue_obj, packets[i]);
-		if (rc < 0 && rc != -2)
-			break;
-		/* For RED failure, just drop current pkt but
-		 * continue with next pkts.
-		 */
-		if (rc == -2) {
-			odp_packet_free(packets[i]);
-			odp_atomic_inc_u64(&tm_queue_obj->stats.discards);
+	if (num <= 0)
+		return 0;
+
+	tm_first_enq_wait(tm_system);
+
+	/* Pkts are processed in bursts of INPUT_WORK_BURST. Pkts passing WRED
+	 * are counted into the queue depths one by one, so that WRED of the
+	 * next pkt sees the pkts accepted before it. Accepted pkts of a burst
+	 * are appended into the input work queue in one operation. For WRED
+	 * failures, just drop current pkt but continue with next pkts. */
+	while (i < num) {
+		const odp_packet_t *pkt = &packets[i];
+
+		burst = _ODP_MIN((uint32_t)(num - i), (uint32_t)INPUT_WORK_BURST);
+		num_enq = 0;
+		num_cnt = 0;
+
+		for (j = 0; j < burst; j++) {
+			drop[j] = tm_enq_drop(tm_system, tm_queue_obj, pkt[j]);
+			if (!drop[j]) {
+				tm_enq_count(tm_system, tm_queue_obj, pkt[j]);
+				enq_pkt[num_cnt++] = pkt[j];
+			}
 		}
+
+		if (num_cnt)
+			num_enq = tm_enq_append(tm_system, tm_queue_obj, enq_pkt, num_cnt);
+
+		/* Uncount pkts that did not fit into the work queue */
+		for (j = num_enq; j < num_cnt; j++)
+			tm_enq_uncount(tm_system, tm_queue_obj, enq_pkt[j]);
+
+		/* Pkts up to the first one not fitting into the work queue have
+		 * been consumed */
+		for (j = 0; j < burst; j++) {
+			if (drop[j]) {
+				odp_packet_free(pkt[j]);
+				odp_atomic_inc_u64(&tm_queue_obj->stats.discards);
+			} else if (num_enq) {
+				num_enq--;
+			} else {
+				break;
+			}
+		}
+
+		i += j;
+
+		if (j < burst)
+			break;
 	}
 
 	return i;
@@ -4966,13 +5177,14 @@ void odp_tm_stats_print(odp_tm_t odp_tm)
 	_ODP_PRINT("\nTM stats\n");
 	_ODP_PRINT("--------\n");
 	_ODP_PRINT("  tm_system=0x%" PRIX64 " tm_idx=%u\n", odp_tm, tm_system->tm_idx);
-	_ODP_PRINT("    input_work_queue size=%u current cnt=%" PRIu64 " peak cnt=%" PRIu32 "\n",
-		   INPUT_WORK_RING_SIZE, odp_atomic_load_u64(&input_work_queue->queue_cnt),
+	_ODP_PRINT("    input_work_queue size=%u current cnt=%" PRIu32 " peak cnt=%" PRIu32 "\n",
+		   INPUT_WORK_RING_SIZE, input_work_queue_len(input_work_queue),
 		   input_work_queue->peak_cnt);
 	_ODP_PRINT("    input_work_queue enqueues=%" PRIu64 " dequeues=%" PRIu64
-		   " fail_cnt=%" PRIu64 "\n", input_work_queue->total_enqueues,
+		   " fail_cnt=%" PRIu64 "\n",
+		   input_work_queue->total_dequeues + input_work_queue_len(input_work_queue),
 		   input_work_queue->total_dequeues,
-		   input_work_queue->enqueue_fail_cnt);
+		   odp_atomic_load_u64(&input_work_queue->enqueue_fail_cnt));
 	_ODP_PRINT("    green_cnt=%" PRIu64 " yellow_cnt=%" PRIu64 " red_cnt=%" PRIu64 "\n",
 		   tm_system->shaper_green_cnt,
 		   tm_system->shaper_yellow_cnt,
@@ -6,7 +6,6 @@
 #include <odp/api/debug.h>
 #include <odp/api/deprecated.h>
 #include <odp/api/event.h>
-#include <odp/api/hash.h>
 #include <odp/api/hints.h>
 #include <odp/api/packet.h>
 #include <odp/api/packet_io.h>
@@ -22,6 +21,7 @@
 #include <odp_debug_internal.h>
 #include <odp_event_internal.h>
 #include <odp_global_data.h>
+#include <odp_ip_reass_internal.h>
 #include <odp_ipsec_internal.h>
 #include <odp_packet_internal.h>
 #include <odp_packet_io_internal.h>
@@ -33,6 +33,7 @@
 
 #include <inttypes.h>
 #include <limits.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
 
@@ -69,6 +70,8 @@ typedef struct ODP_ALIGNED_CACHE {
 typedef struct {
 	/* loopback entries for "loop" device */
 	loop_queue_t loopqs[MAX_QUEUES];
+	/* IP reassembly context, NULL when reassembly is disabled */
+	ip_reass_t *reass;
 	/* hash config */
 	odp_pktin_hash_proto_t hash;
 	/* config queue count */
@@ -167,6 +170,20 @@ static int loopback_start(pktio_entry_t *pktio_entry)
 	pkt_loop_t *pkt_loop = pkt_priv(pktio_entry);
 	odp_queue_param_t queue_param;
 	char queue_name[ODP_QUEUE_NAME_LEN];
+	const odp_reass_config_t *reass_config = &pktio_entry->config.reassembly;
+
+	/* Fragments stored before the previous stop are dropped */
+	if (pkt_loop->reass) {
+		_odp_ip_reass_destroy(pkt_loop->reass);
+		pkt_loop->reass = NULL;
+	}
+
+	if (reass_config->en_ipv4 || reass_config->en_ipv6) {
+		pkt_loop->reass = _odp_ip_reass_create(pktio_entry->handle, pktio_entry->pool,
+						       reass_config);
+		if (pkt_loop->reass == NULL)
+			return -1;
+	}
 
 	/* Re-create queue only when necessary */
 	if (!pkt_loop->queue_create)
@@ -240,33 +257,112 @@ static int loopback_close(pktio_entry_t *pktio_entry)
 {
 	pkt_loop_t *pkt_loop = pkt_priv(pktio_entry);
 
+	if (pkt_loop->reass) {
+		_odp_ip_reass_destroy(pkt_loop->reass);
+		pkt_loop->reass = NULL;
+	}
+
 	return loopback_queues_destroy(pkt_loop->loopqs, pkt_loop->num_qs);
 }
 
+/* Enqueue inline IPsec processed packets with one enqueue per destination queue */
+static void loopback_ipsec_enq(odp_packet_t pkt[], const uint32_t pkt_len[],
+			       odp_bool_t processed[], int num, stats_t *stats,
+			       uint32_t *octets, int *packets)
+{
+	odp_packet_t enq_tbl[QUEUE_MULTI_MAX];
+	uint32_t enq_len[QUEUE_MULTI_MAX];
+
+	for (int i = 0; i < num; i++) {
+		odp_queue_t queue;
+		int num_enq = 0;
+		int ret;
+
+		if (!processed[i])
+			continue;
+
+		queue = packet_hdr(pkt[i])->dst_queue;
+
+		/* Packets of the same destination, in receive order */
+		for (int j = i; j < num; j++) {
+			if (!processed[j] || packet_hdr(pkt[j])->dst_queue != queue)
+				continue;
+
+			enq_tbl[num_enq] = pkt[j];
+			enq_len[num_enq] = pkt_len[j];
+			num_enq++;
+			processed[j] = false;
+		}
+
+		ret = odp_queue_enq_multi(queue, (odp_event_t *)enq_tbl, num_enq);
+
+		if (odp_unlikely(ret < num_enq)) {
+			if (ret < 0)
+				ret = 0;
+
+			for (int j = ret; j < num_enq; j++) {
+				odp_atomic_inc_u64(&stats->in_discards);
+				if (!packet_hdr(enq_tbl[j])->p.flags.all.error) {
+					*octets -= enq_len[j];
+					(*packets)--;
+				}
+				odp_packet_free(enq_tbl[j]);
+			}
+		}
+	}
+}
+
 static int loopback_recv(pktio_entry_t *pktio_entry, int index, odp_packet_t pkts[], int num)
 {
-	int nbr, i;
-	loop_queue_t *entry = &pkt_priv(pktio_entry)->loopqs[index];
+	int nbr, i, j;
+	pkt_loop_t *pkt_loop = pkt_priv(pktio_entry);
+	loop_queue_t *entry = &pkt_loop->loopqs[index];
+	ip_reass_t *reass = pkt_loop->reass;
 	odp_queue_t queue = entry->queue;
 	stats_t *stats = &entry->stats;
 	_odp_event_hdr_t *hdr_tbl[QUEUE_MULTI_MAX];
+	odp_packet_t pkt_tbl[QUEUE_MULTI_MAX];
+	odp_packet_hdr_t *parse_hdr[QUEUE_MULTI_MAX];
+	const uint8_t *parse_data[QUEUE_MULTI_MAX];
+	uint32_t parse_len[QUEUE_MULTI_MAX];
+	int parse_ret[QUEUE_MULTI_MAX];
 	odp_packet_t cls_tbl[QUEUE_MULTI_MAX];
+	odp_packet_t ipsec_tbl[QUEUE_MULTI_MAX];
+	uint32_t ipsec_len[QUEUE_MULTI_MAX];
+	int ipsec_idx[QUEUE_MULTI_MAX];
+	uint32_t out_len[QUEUE_MULTI_MAX];
+	odp_bool_t ipsec_done[QUEUE_MULTI_MAX];
+	odp_bool_t processed[QUEUE_MULTI_MAX];
 	odp_packet_hdr_t *pkt_hdr;
 	odp_packet_t pkt;
 	odp_time_t ts_val;
 	odp_time_t *ts = NULL;
 	int num_rx = 0;
+	int num_pkt = 0;
+	int num_parse = 0;
 	int packets = 0;
 	int num_cls = 0;
+	int num_ipsec = 0;
+	int num_out = 0;
 	const int cls_enabled = pktio_cls_enabled(pktio_entry);
 	uint32_t octets = 0;
+	uint64_t now_ns = 0;
 	const odp_proto_layer_t layer = pktio_entry->parse_layer;
 	const odp_pktin_config_opt_t opt = pktio_entry->config.pktin;
 
 	if (odp_unlikely(num > QUEUE_MULTI_MAX))
 		num = QUEUE_MULTI_MAX;
 
-	nbr = odp_queue_deq_multi(queue, (odp_event_t *)hdr_tbl, num);
+	/* Timed out reassembly attempts are output before new packets */
+	if (odp_unlikely(reass != NULL)) {
+		now_ns = odp_time_global_ns();
+		num_rx = _odp_ip_reass_expire(reass, pkts, num, now_ns);
+
+		if (num_rx == num)
+			return num_rx;
+	}
+
+	nbr = odp_queue_deq_multi(queue, (odp_event_t *)hdr_tbl, num - num_rx);
 
 	if (opt.bit.ts_all || opt.bit.ts_ptp) {
 		ts_val = odp_time_global();
@@ -274,33 +370,82 @@ static int loopback_recv(pktio_entry_t *pktio_entry, int index, odp_packet_t pkt
 	}
 
 	for (i = 0; i < nbr; i++) {
-		uint32_t pkt_len;
-		int do_ipsec_enq = 0;
+		uint8_t reass_status = ODP_PACKET_REASS_NONE;
 
 		pkt = packet_from_event_hdr(hdr_tbl[i]);
+
+		/* Reassembly is done before other offloads. Statistics count packets
+		 * after reassembly. */
+		if (odp_unlikely(reass != NULL)) {
+			pkt = _odp_ip_reass_recv(reass, pkt, now_ns);
+
+			/* Fragment was stored */
+			if (pkt == ODP_PACKET_INVALID)
+				continue;
+
+			reass_status = odp_packet_reass_status(pkt);
+
+			/* Incomplete result does not contain packet data */
+			if (odp_unlikely(reass_status == ODP_PACKET_REASS_INCOMPLETE)) {
+				pkts[num_rx++] = pkt;
+				continue;
+			}
+		}
+
+		if (layer) {
+			pkt_hdr = packet_hdr(pkt);
+			packet_parse_reset(pkt_hdr, 1);
+			pkt_hdr->p.flags.reass = reass_status;
+
+			/* Single segment packets are parsed together below */
+			if (odp_likely(pkt_hdr->seg_count == 1)) {
+				parse_hdr[num_parse] = pkt_hdr;
+				parse_data[num_parse] = odp_packet_data(pkt);
+				parse_len[num_parse] = odp_packet_len(pkt);
+				num_parse++;
+			}
+		}
+
+		pkt_tbl[num_pkt++] = pkt;
+	}
+
+	if (num_parse)
+		_odp_packet_parse_multi(parse_hdr, parse_data, parse_len, num_parse, layer, opt,
+					parse_ret);
+
+	for (i = 0, j = 0; i < num_pkt; i++) {
+		uint32_t pkt_len;
+
+		pkt = pkt_tbl[i];
 		pkt_len = odp_packet_len(pkt);
 		pkt_hdr = packet_hdr(pkt);
 
 		if (layer) {
-			uint8_t *pkt_addr;
+			const uint8_t *pkt_addr;
 			uint8_t buf[PARSE_BYTES];
 			int ret;
-			uint32_t seg_len = odp_packet_seg_len(pkt);
-
-			/* Make sure there is enough data for the packet
-			 * parser in the case of a segmented packet. */
-			if (odp_unlikely(seg_len < PARSE_BYTES &&
-					 pkt_len > seg_len)) {
-				seg_len = _ODP_MIN(pkt_len, PARSE_BYTES);
-				odp_packet_copy_to_mem(pkt, 0, seg_len, buf);
-				pkt_addr = buf;
+
+			if (j < num_parse && parse_hdr[j] == pkt_hdr) {
+				pkt_addr = parse_data[j];
+				ret = parse_ret[j++];
 			} else {
-				pkt_addr = odp_packet_data(pkt);
+				uint32_t seg_len = odp_packet_seg_len(pkt);
+
+				/* Make sure there is enough data for the packet
+				 * parser in the case of a segmented packet. */
+				if (odp_unlikely(seg_len < PARSE_BYTES &&
+						 pkt_len > seg_len)) {
+					seg_len = _ODP_MIN(pkt_len, PARSE_BYTES);
+					odp_packet_copy_to_mem(pkt, 0, seg_len, buf);
+					pkt_addr = buf;
+				} else {
+					pkt_addr = odp_packet_data(pkt);
+				}
+
+				ret = _odp_packet_parse_common(pkt_hdr, pkt_addr, pkt_len,
+							       seg_len, layer, opt);
 			}
 
-			packet_parse_reset(pkt_hdr, 1);
-			ret = _odp_packet_parse_common(pkt_hdr, pkt_addr, pkt_len,
-						       seg_len, layer, opt);
 			if (ret)
 				odp_atomic_inc_u64(&stats->in_errors);
 
@@ -334,38 +479,61 @@ static int loopback_recv(pktio_entry_t *pktio_entry, int index, odp_packet_t pkt
 		packet_set_ts(pkt_hdr, ts);
 		pkt_hdr->input = pktio_entry->handle;
 
-		/* Try IPsec inline processing */
+		/* Collect packets for inline IPsec processing. Packets keep their
+		 * position in the burst, the output loop below skips the ones
+		 * that inline IPsec processed. */
 		if (pktio_entry->config.inbound_ipsec &&
 		    !pkt_hdr->p.flags.ip_err &&
 		    odp_packet_has_ipsec(pkt)) {
-			do_ipsec_enq = !_odp_ipsec_try_inline(&pkt);
-			pkt_hdr = packet_hdr(pkt);
+			ipsec_tbl[num_ipsec] = pkt;
+			ipsec_len[num_ipsec] = pkt_len;
+			ipsec_idx[num_ipsec] = num_out;
+			num_ipsec++;
+		}
+
+		/* Surviving packets are compacted to the start of pkt_tbl */
+		pkt_tbl[num_out] = pkt;
+		out_len[num_out] = pkt_len;
+		ipsec_done[num_out] = false;
+		num_out++;
+	}
+
+	/* Process IPsec packets of the burst together */
+	if (num_ipsec) {
+		_odp_ipsec_try_inline_multi(ipsec_tbl, processed, num_ipsec);
+
+		for (i = 0; i < num_ipsec; i++) {
+			pkt_tbl[ipsec_idx[i]] = ipsec_tbl[i];
+			ipsec_done[ipsec_idx[i]] = processed[i];
 		}
+	}
+
+	/* Output packets in receive order. IPsec packets without an SA
+	 * continue as normal packets. */
+	for (i = 0; i < num_out; i++) {
+		pkt = pkt_tbl[i];
 
-		if (!pkt_hdr->p.flags.all.error) {
-			octets += pkt_len;
+		if (!packet_hdr(pkt)->p.flags.all.error) {
+			octets += out_len[i];
 			packets++;
 		}
 
-		if (do_ipsec_enq) {
-			if (odp_unlikely(odp_queue_enq(pkt_hdr->dst_queue,
-						       odp_packet_to_event(pkt)))) {
-				odp_atomic_inc_u64(&stats->in_discards);
-				if (!pkt_hdr->p.flags.all.error) {
-					octets -= pkt_len;
-					packets--;
-				}
-				odp_packet_free(pkt);
-			}
-		} else if (cls_enabled) {
+		if (ipsec_done[i])
+			continue;
+
+		if (cls_enabled) {
 			/* Enqueue packets directly to classifier destination queue */
 			cls_tbl[num_cls++] = pkt;
-			num_cls = _odp_cls_enq(cls_tbl, num_cls, (i + 1 == nbr));
+			num_cls = _odp_cls_enq(cls_tbl, num_cls, (i + 1 == num_out));
 		} else {
 			pkts[num_rx++] = pkt;
 		}
 	}
 
+	if (num_ipsec)
+		loopback_ipsec_enq(ipsec_tbl, ipsec_len, processed, num_ipsec, stats, &octets,
+				   &packets);
+
 	/* Enqueue remaining classified packets */
 	if (odp_unlikely(num_cls))
 		_odp_cls_enq(cls_tbl, num_cls, true);
@@ -464,69 +632,85 @@ static inline void loopback_fix_checksums(odp_packet_t pkt,
 		_odp_packet_sctp_chksum_insert(pkt);
 }
 
-static inline uint8_t *add_data(uint8_t *data, void *src, uint32_t len)
+/* Fill in RSS hash tuple of a packet and return its length in bytes */
+static inline uint32_t hash_tuple(const odp_pktin_hash_proto_t *hash, odp_packet_t pkt,
+				  uint8_t *tuple)
 {
-	return (uint8_t *)memcpy(data, src, len) + len;
+	uint32_t l3_off = odp_packet_l3_offset(pkt);
+	uint32_t l4_off = odp_packet_l4_offset(pkt);
+	uint32_t addr_len, addr_off;
+	int udp = odp_packet_has_udp(pkt);
+	int tcp = odp_packet_has_tcp(pkt);
+	int ports;
+
+	if (l3_off == ODP_PACKET_OFFSET_INVALID)
+		return 0;
+
+	if (odp_packet_has_ipv4(pkt)) {
+		ports = (hash->proto.ipv4_udp && udp) || (hash->proto.ipv4_tcp && tcp);
+		if (!ports && !hash->proto.ipv4)
+			return 0;
+
+		addr_len = _ODP_IPV4ADDR_LEN;
+		addr_off = l3_off + offsetof(_odp_ipv4hdr_t, src_addr);
+	} else if (odp_packet_has_ipv6(pkt)) {
+		ports = (hash->proto.ipv6_udp && udp) || (hash->proto.ipv6_tcp && tcp);
+		if (!ports && !hash->proto.ipv6)
+			return 0;
+
+		addr_len = _ODP_IPV6ADDR_LEN;
+		addr_off = l3_off + offsetof(_odp_ipv6hdr_t, src_addr);
+	} else {
+		return 0;
+	}
+
+	/* Destination address follows source address */
+	if (odp_packet_copy_to_mem(pkt, addr_off, 2 * addr_len, tuple))
+		return 0;
+
+	/* TCP and UDP source and destination ports are at the same offsets */
+	if (ports && (l4_off == ODP_PACKET_OFFSET_INVALID ||
+		      odp_packet_copy_to_mem(pkt, l4_off, 2 * sizeof(uint16_t),
+					     tuple + 2 * addr_len)))
+		ports = 0;
+
+	_odp_cls_rss_tuple_sym(tuple, addr_len, ports);
+
+	return 2 * addr_len + (ports ? 2 * sizeof(uint16_t) : 0);
 }
 
-static inline odp_queue_t get_dest_queue(const pkt_loop_t *pkt_loop, odp_packet_t pkt, int index)
+/* Select destination queues of a packet burst by RSS hash */
+static inline void get_dest_queues(const pkt_loop_t *pkt_loop, const odp_packet_t pkt[],
+				   int index, odp_queue_t queue[], int num)
 {
-	const odp_pktin_hash_proto_t *hash = &pkt_loop->hash;
-	_odp_udphdr_t udp;
-	_odp_tcphdr_t tcp;
-	_odp_ipv4hdr_t ipv4;
-	_odp_ipv6hdr_t ipv6;
-	uint32_t off;
-	/* Space for UDP/TCP source and destination ports and IPv4/IPv6 source and destination
-	 * addresses. */
-	uint8_t data[2 * sizeof(uint16_t) + 2 * 4 * sizeof(uint32_t)];
-	uint8_t *head = data;
-
-	if (hash->all_bits == 0)
-		return pkt_loop->loopqs[index % pkt_loop->num_qs].queue;
-
-	memset(data, 0, sizeof(data));
-	off = odp_packet_l4_offset(pkt);
-
-	if (off != ODP_PACKET_OFFSET_INVALID) {
-		if ((hash->proto.ipv4_udp || hash->proto.ipv6_udp) && odp_packet_has_udp(pkt)) {
-			if (odp_packet_copy_to_mem(pkt, off, _ODP_UDPHDR_LEN, &udp) == 0) {
-				head = add_data(head, &udp.src_port, sizeof(udp.src_port));
-				head = add_data(head, &udp.dst_port, sizeof(udp.dst_port));
-			}
-		} else if ((hash->proto.ipv4_tcp || hash->proto.ipv6_tcp) &&
-			   odp_packet_has_tcp(pkt)) {
-			if (odp_packet_copy_to_mem(pkt, off, _ODP_TCPHDR_LEN, &tcp) == 0) {
-				head = add_data(head, &tcp.src_port, sizeof(tcp.src_port));
-				head = add_data(head, &tcp.dst_port, sizeof(tcp.dst_port));
-			}
-		}
-	}
+	uint8_t tuple[QUEUE_MULTI_MAX][THASH_TUPLE_MAX_LEN];
+	const uint8_t *tuple_ptr[QUEUE_MULTI_MAX];
+	uint32_t len[QUEUE_MULTI_MAX];
+	uint32_t hash[QUEUE_MULTI_MAX];
+	int i;
 
-	off = odp_packet_l3_offset(pkt);
+	if (pkt_loop->hash.all_bits == 0) {
+		for (i = 0; i < num; i++)
+			queue[i] = pkt_loop->loopqs[index % pkt_loop->num_qs].queue;
+		return;
+	}
 
-	if (off != ODP_PACKET_OFFSET_INVALID) {
-		if (hash->proto.ipv4 && odp_packet_has_ipv4(pkt)) {
-			if (odp_packet_copy_to_mem(pkt, off, _ODP_IPV4HDR_LEN, &ipv4) == 0) {
-				head = add_data(head, &ipv4.src_addr, sizeof(ipv4.src_addr));
-				head = add_data(head, &ipv4.dst_addr, sizeof(ipv4.dst_addr));
-			}
-		} else if (hash->proto.ipv6 && odp_packet_has_ipv6(pkt)) {
-			if (odp_packet_copy_to_mem(pkt, off, _ODP_IPV6HDR_LEN, &ipv6) == 0) {
-				head = add_data(head, &ipv6.src_addr, sizeof(ipv6.src_addr));
-				head = add_data(head, &ipv6.dst_addr, sizeof(ipv6.dst_addr));
-			}
-		}
+	for (i = 0; i < num; i++) {
+		len[i] = hash_tuple(&pkt_loop->hash, pkt[i], tuple[i]);
+		tuple_ptr[i] = tuple[i];
 	}
 
-	return pkt_loop->loopqs[odp_hash_crc32c(data, head - data, 0) % pkt_loop->num_qs].queue;
+	_odp_cls_rss_hash_multi(tuple_ptr, len, hash, num);
+
+	for (i = 0; i < num; i++)
+		queue[i] = pkt_loop->loopqs[hash[i] % pkt_loop->num_qs].queue;
 }
 
 static int loopback_send(pktio_entry_t *pktio_entry, int index, const odp_packet_t pkt_tbl[],
 			 int num)
 {
 	pkt_loop_t *pkt_loop = pkt_priv(pktio_entry);
-	odp_queue_t queue;
+	odp_queue_t queue[QUEUE_MULTI_MAX];
 	stats_t *stats;
 	int i;
 	int ret;
@@ -544,6 +728,8 @@ static int loopback_send(pktio_entry_t *pktio_entry, int index, const odp_packet
 	if (odp_unlikely(num > QUEUE_MULTI_MAX))
 		num = QUEUE_MULTI_MAX;
 
+	get_dest_queues(pkt_loop, pkt_tbl, index, queue, num);
+
 	for (i = 0; i < num; ++i) {
 		uint32_t pkt_len = odp_packet_len(pkt_tbl[i]);
 
@@ -560,12 +746,11 @@ static int loopback_send(pktio_entry_t *pktio_entry, int index, const odp_packet
 
 		packet_subtype_set(pkt_tbl[i], ODP_EVENT_PACKET_BASIC);
 		loopback_fix_checksums(pkt_tbl[i], pktout_cfg, pktout_capa);
-		queue = get_dest_queue(pkt_loop, pkt_tbl[i], index);
-		ret = odp_queue_enq(queue, odp_packet_to_event(pkt_tbl[i]));
+		ret = odp_queue_enq(queue[i], odp_packet_to_event(pkt_tbl[i]));
 
 		if (ret < 0) {
 			_ODP_DBG("queue enqueue failed %i to queue: %" PRIu64 "\n", ret,
-				 odp_queue_to_u64(queue));
+				 odp_queue_to_u64(queue[i]));
 			break;
 		}
 
@@ -685,6 +870,8 @@ static int loopback_init_capability(pktio_entry_t *pktio_entry)
 		capa->config.outbound_ipsec = 1;
 	}
 
+	_odp_ip_reass_capability(&capa->reassembly);
+
 	capa->config.pktout.bit.ipv4_chksum_ena =
 		capa->config.pktout.bit.ipv4_chksum;
 	capa->config.pktout.bit.udp_chksum_ena =
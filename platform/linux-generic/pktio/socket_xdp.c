@@ -765,7 +765,11 @@ static uint32_t process_received(pktio_entry_t *pktio_entry, xdp_sock_t *sock, p
 {
 	struct xsk_ring_cons *rx = &sock->rx;
 	uint8_t *base_addr = pool->base_addr;
-	pkt_data_t pkt_data;
+	pkt_data_t pkt_data[PARSE_MULTI_BURST];
+	odp_packet_hdr_t *pkt_hdr[PARSE_MULTI_BURST];
+	const uint8_t *data[PARSE_MULTI_BURST];
+	uint32_t len[PARSE_MULTI_BURST];
+	int parse_ret[PARSE_MULTI_BURST];
 	const odp_proto_layer_t layer = pktio_entry->parse_layer;
 	int ret;
 	const odp_pktin_config_opt_t opt = pktio_entry->config.pktin;
@@ -776,54 +780,68 @@ static uint32_t process_received(pktio_entry_t *pktio_entry, xdp_sock_t *sock, p
 	uint32_t num_pkts = 0U;
 	const int cls_enabled = pktio_cls_enabled(pktio_entry);
 
-	for (int i = 0; i < num; ++i) {
-		extract_data(xsk_ring_cons__rx_desc(rx, start_idx++), base_addr, &pkt_data);
-		pkt_data.pkt_hdr->ms_pktio_idx = 0U;
-		packet_init(pkt_data.pkt_hdr, pkt_data.len);
-		pkt_data.pkt_hdr->seg_data = pkt_data.data;
-		pkt_data.pkt_hdr->event_hdr.base_data = pkt_data.data;
+	for (int i = 0; i < num; i += PARSE_MULTI_BURST) {
+		const int burst = _ODP_MIN(num - i, PARSE_MULTI_BURST);
+
+		for (int j = 0; j < burst; ++j) {
+			extract_data(xsk_ring_cons__rx_desc(rx, start_idx++), base_addr,
+				     &pkt_data[j]);
+			pkt_data[j].pkt_hdr->ms_pktio_idx = 0U;
+			packet_init(pkt_data[j].pkt_hdr, pkt_data[j].len);
+			pkt_data[j].pkt_hdr->seg_data = pkt_data[j].data;
+			pkt_data[j].pkt_hdr->event_hdr.base_data = pkt_data[j].data;
+			pkt_hdr[j] = pkt_data[j].pkt_hdr;
+			data[j] = pkt_data[j].data;
+			len[j] = pkt_data[j].len;
+		}
 
-		if (layer) {
-			ret = _odp_packet_parse_common(pkt_data.pkt_hdr, pkt_data.data,
-						       pkt_data.len, pkt_data.len,
-						       layer, opt);
+		/* Parse the whole burst at once */
+		if (layer)
+			_odp_packet_parse_multi(pkt_hdr, data, len, burst, layer, opt, parse_ret);
 
-			if (ret)
-				++errors;
+		for (int j = 0; j < burst; ++j) {
+			pkt_data_t *pd = &pkt_data[j];
 
-			if (ret < 0) {
-				odp_packet_free(pkt_data.pkt);
-				continue;
-			}
+			if (layer) {
+				ret = parse_ret[j];
 
-			if (cls_enabled) {
-				odp_pool_t new_pool;
+				if (ret)
+					++errors;
 
-				ret = _odp_cls_classify_packet(pktio_entry, pkt_data.data,
-							       &new_pool, pkt_data.pkt_hdr);
-				if (ret) {
-					odp_packet_free(pkt_data.pkt);
+				if (ret < 0) {
+					odp_packet_free(pd->pkt);
 					continue;
 				}
 
-				if (odp_unlikely(_odp_pktio_packet_to_pool(
-					    &pkt_data.pkt, &pkt_data.pkt_hdr, new_pool))) {
-					odp_packet_free(pkt_data.pkt);
-					continue;
+				if (cls_enabled) {
+					odp_pool_t new_pool;
+
+					ret = _odp_cls_classify_packet(pktio_entry, pd->data,
+								       &new_pool, pd->pkt_hdr);
+					if (ret) {
+						odp_packet_free(pd->pkt);
+						continue;
+					}
+
+					if (odp_unlikely(_odp_pktio_packet_to_pool(
+						    &pd->pkt, &pd->pkt_hdr, new_pool))) {
+						odp_packet_free(pd->pkt);
+						continue;
+					}
 				}
 			}
-		}
 
-		pkt_data.pkt_hdr->input = pktio_hdl;
-		num_pkts++;
-		octets += pkt_data.len;
+			pd->pkt_hdr->input = pktio_hdl;
+			num_pkts++;
+			octets += pd->len;
 
-		if (cls_enabled) {
-			/* Enqueue packets directly to classifier destination queue */
-			packets[num_cls++] = pkt_data.pkt;
-			num_cls = _odp_cls_enq(packets, num_cls, (i + 1 == num));
-		} else {
-			packets[num_rx++] = pkt_data.pkt;
+			if (cls_enabled) {
+				/* Enqueue packets directly to classifier destination queue */
+				packets[num_cls++] = pd->pkt;
+				num_cls = _odp_cls_enq(packets, num_cls, (i + j + 1 == num));
+			} else {
+				packets[num_rx++] = pd->pkt;
+			}
 		}
 	}
 
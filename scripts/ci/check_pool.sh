@@ -0,0 +1,17 @@
+#!/bin/bash
+set -e
+
+echo 2048 | tee /proc/sys/vm/nr_hugepages
+mkdir -p /mnt/huge
+mount -t hugetlbfs nodev /mnt/huge
+
+"`dirname "$0"`"/build_${ARCH}.sh
+
+cd "$(dirname "$0")"/../..
+
+./test/validation/api/pool/pool_main
+./test/validation/api/buffer/buffer_main
+./test/validation/api/packet/packet_main
+./test/validation/api/timer/timer_main
+
+umount /mnt/huge
@@ -450,6 +450,40 @@ static const uint8_t test_packet_ipv4_udp_1500[] = {
 	0xAE, 0xAF, 0xB0, 0xB1
 };
 
+/* IPv4 UDP VXLAN tunnel, inner IPv4 TCP */
+static const uint8_t test_packet_ipv4_vxlan_ipv4_tcp[] = {
+	0x00, 0x00, 0x09, 0x00, 0x05, 0x00, 0x00, 0x00,
+	0x09, 0x00, 0x04, 0x00, 0x08, 0x00, 0x45, 0x00,
+	0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x40, 0x11,
+	0xF5, 0x39, 0xC0, 0xA8, 0x02, 0x01, 0xC0, 0xA8,
+	0x02, 0x02, 0x30, 0x39, 0x12, 0xB5, 0x00, 0x4C,
+	0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x12,
+	0x34, 0x00, 0x00, 0x00, 0x09, 0x00, 0x05, 0x00,
+	0x00, 0x00, 0x09, 0x00, 0x04, 0x00, 0x08, 0x00,
+	0x45, 0x00, 0x00, 0x2E, 0x00, 0x00, 0x00, 0x00,
+	0x40, 0x06, 0xF3, 0x76, 0xC0, 0xA8, 0x01, 0x02,
+	0xC4, 0xA8, 0x01, 0x01, 0x04, 0xD2, 0x10, 0xE1,
+	0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02,
+	0x50, 0x02, 0x00, 0x00, 0x0C, 0xCA, 0x00, 0x00,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05
+};
+
+/* IPv4 UDP GTP-U tunnel, inner IPv4 UDP */
+static const uint8_t test_packet_ipv4_gtpu_ipv4_udp[] = {
+	0x00, 0x00, 0x09, 0x00, 0x05, 0x00, 0x00, 0x00,
+	0x09, 0x00, 0x04, 0x00, 0x08, 0x00, 0x45, 0x00,
+	0x00, 0x52, 0x00, 0x00, 0x00, 0x00, 0x40, 0x11,
+	0xF5, 0x47, 0xC0, 0xA8, 0x02, 0x01, 0xC0, 0xA8,
+	0x02, 0x02, 0x30, 0x39, 0x08, 0x68, 0x00, 0x3E,
+	0x00, 0x00, 0x30, 0xFF, 0x00, 0x2E, 0x00, 0x00,
+	0x00, 0x01, 0x45, 0x00, 0x00, 0x2E, 0x00, 0x00,
+	0x00, 0x00, 0x40, 0x11, 0xF3, 0x6B, 0xC0, 0xA8,
+	0x01, 0x02, 0xC4, 0xA8, 0x01, 0x01, 0x00, 0x3F,
+	0x00, 0x3F, 0x00, 0x1A, 0x2F, 0x97, 0x00, 0x01,
+	0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+	0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11
+};
+
 #ifdef __cplusplus
 }
 #endif
@@ -63,7 +63,7 @@
 #define TEST_DEF_BURST 8
 
 /** Maximum number of results to be held */
-#define TEST_MAX_BENCH 100
+#define TEST_MAX_BENCH 110
 
 #define TEST_MAX_SIZES 7
 
@@ -319,6 +319,18 @@ static void alloc_parse_packets_ipv6_udp(void)
 	alloc_parse_packets(test_packet_ipv6_udp, sizeof(test_packet_ipv6_udp));
 }
 
+static void alloc_parse_packets_vxlan(void)
+{
+	alloc_parse_packets(test_packet_ipv4_vxlan_ipv4_tcp,
+			    sizeof(test_packet_ipv4_vxlan_ipv4_tcp));
+}
+
+static void alloc_parse_packets_gtpu(void)
+{
+	alloc_parse_packets(test_packet_ipv4_gtpu_ipv4_udp,
+			    sizeof(test_packet_ipv4_gtpu_ipv4_udp));
+}
+
 static void alloc_parse_packets_multi(const void *pkt_data, uint32_t len)
 {
 	int i;
@@ -357,6 +369,18 @@ static void alloc_parse_packets_multi_ipv6_udp(void)
 				  sizeof(test_packet_ipv6_udp));
 }
 
+static void alloc_parse_packets_multi_vxlan(void)
+{
+	alloc_parse_packets_multi(test_packet_ipv4_vxlan_ipv4_tcp,
+				  sizeof(test_packet_ipv4_vxlan_ipv4_tcp));
+}
+
+static void alloc_parse_packets_multi_gtpu(void)
+{
+	alloc_parse_packets_multi(test_packet_ipv4_gtpu_ipv4_udp,
+				  sizeof(test_packet_ipv4_gtpu_ipv4_udp));
+}
+
 static void create_packets(void)
 {
 	int i;
@@ -1731,6 +1755,10 @@ bench_info_t test_suite[] = {
 		   "packet_parse ipv6/tcp"),
 	BENCH_INFO(packet_parse, alloc_parse_packets_ipv6_udp, free_packets,
 		   "packet_parse ipv6/udp"),
+	BENCH_INFO(packet_parse, alloc_parse_packets_vxlan, free_packets,
+		   "packet_parse ipv4/vxlan/ipv4/tcp"),
+	BENCH_INFO(packet_parse, alloc_parse_packets_gtpu, free_packets,
+		   "packet_parse ipv4/gtpu/ipv4/udp"),
 	BENCH_INFO(packet_parse_multi, alloc_parse_packets_multi_ipv4_tcp, free_packets_multi,
 		   "packet_parse_multi ipv4/tcp"),
 	BENCH_INFO(packet_parse_multi, alloc_parse_packets_multi_ipv4_udp, free_packets_multi,
@@ -1739,6 +1767,10 @@ bench_info_t test_suite[] = {
 		   "packet_parse_multi ipv6/tcp"),
 	BENCH_INFO(packet_parse_multi, alloc_parse_packets_multi_ipv6_udp, free_packets_multi,
 		   "packet_parse_multi ipv6/udp"),
+	BENCH_INFO(packet_parse_multi, alloc_parse_packets_multi_vxlan, free_packets_multi,
+		   "packet_parse_multi ipv4/vxlan/ipv4/tcp"),
+	BENCH_INFO(packet_parse_multi, alloc_parse_packets_multi_gtpu, free_packets_multi,
+		   "packet_parse_multi ipv4/gtpu/ipv4/udp"),
 };
 
 ODP_STATIC_ASSERT(ODPH_ARRAY_SIZE(test_suite) < TEST_MAX_BENCH,
@@ -163,6 +163,19 @@ typedef struct {
 	 * Specified through -v or --vector argument.
 	 */
 	uint32_t vec_pkt_size;
+
+	/*
+	 * Anti-replay window size of the inbound SA. If non zero, outbound
+	 * processed packets are decapsulated with an inbound SA.
+	 * Specified through -i or --inbound argument.
+	 */
+	uint32_t inbound_ws;
+
+	/*
+	 * Number of worker threads processing packets through the same SA
+	 * in sync mode. Specified through -w or --workers argument.
+	 */
+	int num_workers;
 } ipsec_args_t;
 
 /*
@@ -213,6 +226,10 @@ static unsigned int global_payloads[] = {
 /** Number of payloads used in the test */
 static unsigned int global_num_payloads;
 
+/** ODP instance and CPU mask of sync mode worker threads */
+static odp_instance_t global_instance;
+static odp_cpumask_t global_cpumask;
+
 /**
  * Set of known algorithms to test
  */
@@ -542,6 +559,8 @@ print_result(ipsec_args_t *cargs,
 	       throughput);
 }
 
+#define TEST_SPI 0x100
+
 #define IPV4ADDR(a, b, c, d) odp_cpu_to_be_32((a << 24) | \
 					      (b << 16) | \
 					      (c << 8) | \
@@ -552,7 +571,8 @@ print_result(ipsec_args_t *cargs,
  */
 static odp_ipsec_sa_t
 create_sa_from_config(ipsec_alg_config_t *config,
-		      ipsec_args_t *cargs)
+		      ipsec_args_t *cargs,
+		      odp_ipsec_dir_t dir)
 {
 	odp_ipsec_sa_param_t param;
 	odp_queue_t out_queue;
@@ -562,9 +582,15 @@ create_sa_from_config(ipsec_alg_config_t *config,
 	       sizeof(odp_ipsec_crypto_param_t));
 
 	param.proto = ODP_IPSEC_ESP;
-	param.dir = ODP_IPSEC_DIR_OUTBOUND;
-
-	if (cargs->tunnel) {
+	param.dir = dir;
+	param.spi = TEST_SPI;
+
+	if (dir == ODP_IPSEC_DIR_INBOUND) {
+		param.mode = cargs->tunnel ? ODP_IPSEC_MODE_TUNNEL :
+					     ODP_IPSEC_MODE_TRANSPORT;
+		param.inbound.lookup_mode = ODP_IPSEC_LOOKUP_DISABLED;
+		param.inbound.antireplay_ws = cargs->inbound_ws;
+	} else if (cargs->tunnel) {
 		uint32_t src = IPV4ADDR(10, 0, 111, 2);
 		uint32_t dst = IPV4ADDR(10, 0, 222, 2);
 		odp_ipsec_tunnel_param_t tunnel;
@@ -657,6 +683,7 @@ static inline void check_ipsec_result(odp_packet_t ipsec_pkt)
 static int
 run_measure_one(ipsec_args_t *cargs,
 		odp_ipsec_sa_t sa,
+		odp_ipsec_sa_t in_sa,
 		unsigned int payload_length,
 		time_record_t *start,
 		time_record_t *end)
@@ -667,6 +694,7 @@ run_measure_one(ipsec_args_t *cargs,
 	const int packet_count = cargs->packet_count;
 	const int debug = cargs->debug_packets;
 	odp_ipsec_out_param_t param;
+	odp_ipsec_in_param_t in_param;
 	odp_pool_t pkt_pool;
 
 	pkt_pool = odp_pool_lookup("packet_pool");
@@ -687,6 +715,10 @@ run_measure_one(ipsec_args_t *cargs,
 	param.num_opt = 0;
 	param.sa = &sa;
 
+	memset(&in_param, 0, sizeof(in_param));
+	in_param.num_sa = 1;
+	in_param.sa = &in_sa;
+
 	fill_time_record(start);
 
 	while ((packets_sent < packet_count) ||
@@ -733,6 +765,35 @@ run_measure_one(ipsec_args_t *cargs,
 			packets_received += num_out;
 			debug_packets(debug, out_pkt, num_out);
 
+			if (in_sa != ODP_IPSEC_SA_INVALID && num_out > 0) {
+				odp_packet_t in_pkt[num_out];
+				int num_in = num_out;
+				int ret;
+
+				ret = odp_ipsec_in(out_pkt, num_out, in_pkt, &num_in, &in_param);
+				if (odp_unlikely(ret != num_out)) {
+					ODPH_ERR("Failed odp_ipsec_in: rc = %d\n", ret);
+					if (ret < 0) {
+						ret = 0;
+						num_in = 0;
+					}
+					odp_packet_free_sp(&out_pkt[ret], num_out - ret);
+					if (num_in > 0)
+						odp_packet_free_sp(in_pkt, num_in);
+					if (rc != num_pkts)
+						odp_packet_free_sp(&pkt[rc], num_pkts - rc);
+					rc = -1;
+					break;
+				}
+
+				for (i = 0; i < num_in; i++)
+					check_ipsec_result(in_pkt[i]);
+
+				debug_packets(debug, in_pkt, num_in);
+				memcpy(out_pkt, in_pkt, num_in * sizeof(odp_packet_t));
+				num_out = num_in;
+			}
+
 			if (odp_unlikely(rc != num_pkts))
 				odp_packet_free_sp(&pkt[rc], num_pkts - rc);
 			odp_packet_free_sp(out_pkt, num_out);
@@ -908,6 +969,80 @@ run_measure_one_async(ipsec_args_t *cargs,
 	return rc < 0 ? rc : 0;
 }
 
+typedef struct sync_arg {
+	ipsec_args_t *cargs;
+	odp_ipsec_sa_t sa;
+	odp_ipsec_sa_t in_sa;
+	unsigned int payload_length;
+	odp_barrier_t barrier;
+	odp_atomic_u32_t failed;
+} sync_arg_t;
+
+static int run_sync_thr_func(void *arg)
+{
+	sync_arg_t *sync_arg = (sync_arg_t *)arg;
+	time_record_t start, end;
+
+	odp_barrier_wait(&sync_arg->barrier);
+
+	if (run_measure_one(sync_arg->cargs, sync_arg->sa, sync_arg->in_sa,
+			    sync_arg->payload_length, &start, &end))
+		odp_atomic_inc_u32(&sync_arg->failed);
+
+	return 0;
+}
+
+/**
+ * Run sync mode measurement on multiple worker threads, which all process
+ * packets through the same SA (or SA pair).
+ */
+static int
+run_measure_workers(ipsec_args_t *cargs,
+		    odp_ipsec_sa_t sa,
+		    odp_ipsec_sa_t in_sa,
+		    unsigned int payload_length,
+		    time_record_t *start,
+		    time_record_t *end)
+{
+	const int num_workers = cargs->num_workers;
+	odph_thread_t thread_tbl[num_workers];
+	odph_thread_common_param_t thr_common;
+	odph_thread_param_t thr_param;
+	sync_arg_t sync_arg;
+
+	sync_arg.cargs = cargs;
+	sync_arg.sa = sa;
+	sync_arg.in_sa = in_sa;
+	sync_arg.payload_length = payload_length;
+	odp_barrier_init(&sync_arg.barrier, num_workers + 1);
+	odp_atomic_init_u32(&sync_arg.failed, 0);
+
+	odph_thread_common_param_init(&thr_common);
+	thr_common.instance = global_instance;
+	thr_common.cpumask = &global_cpumask;
+	thr_common.share_param = 1;
+
+	odph_thread_param_init(&thr_param);
+	thr_param.start = run_sync_thr_func;
+	thr_param.arg = &sync_arg;
+	thr_param.thr_type = ODP_THREAD_WORKER;
+
+	memset(thread_tbl, 0, sizeof(thread_tbl));
+	if (odph_thread_create(thread_tbl, &thr_common, &thr_param, num_workers) !=
+	    num_workers) {
+		ODPH_ERR("Worker thread create failed\n");
+		return -1;
+	}
+
+	odp_barrier_wait(&sync_arg.barrier);
+	fill_time_record(start);
+
+	odph_thread_join(thread_tbl, num_workers);
+	fill_time_record(end);
+
+	return odp_atomic_load_u32(&sync_arg.failed) ? -1 : 0;
+}
+
 /**
  * Process one algorithm. Note if paload size is specicified it is
  * only one run. Or iterate over set of predefined payloads.
@@ -919,6 +1054,7 @@ run_measure_one_config(ipsec_args_t *cargs,
 	unsigned int num_payloads = global_num_payloads;
 	unsigned int *payloads = global_payloads;
 	odp_ipsec_capability_t capa;
+	odp_ipsec_sa_t in_sa = ODP_IPSEC_SA_INVALID;
 	odp_ipsec_sa_t sa;
 	unsigned int i;
 	int rc = 0;
@@ -943,12 +1079,22 @@ run_measure_one_config(ipsec_args_t *cargs,
 		return 0;
 	}
 
-	sa = create_sa_from_config(config, cargs);
+	sa = create_sa_from_config(config, cargs, ODP_IPSEC_DIR_OUTBOUND);
 	if (sa == ODP_IPSEC_SA_INVALID) {
 		ODPH_ERR("IPsec SA create failed.\n");
 		return -1;
 	}
 
+	if (cargs->inbound_ws) {
+		in_sa = create_sa_from_config(config, cargs, ODP_IPSEC_DIR_INBOUND);
+		if (in_sa == ODP_IPSEC_SA_INVALID) {
+			ODPH_ERR("IPsec inbound SA create failed.\n");
+			odp_ipsec_sa_disable(sa);
+			odp_ipsec_sa_destroy(sa);
+			return -1;
+		}
+	}
+
 	print_result_header();
 	if (cargs->payload_length) {
 		num_payloads = 1;
@@ -957,6 +1103,7 @@ run_measure_one_config(ipsec_args_t *cargs,
 
 	for (i = 0; i < num_payloads; i++) {
 		double count;
+		double num_pkts = (double)cargs->packet_count * cargs->num_workers;
 		ipsec_run_result_t result;
 		time_record_t start, end;
 
@@ -964,21 +1111,25 @@ run_measure_one_config(ipsec_args_t *cargs,
 			rc = run_measure_one_async(cargs, sa,
 						   payloads[i],
 						   &start, &end);
+		else if (cargs->num_workers > 1)
+			rc = run_measure_workers(cargs, sa, in_sa,
+						 payloads[i],
+						 &start, &end);
 		else
-			rc = run_measure_one(cargs, sa,
+			rc = run_measure_one(cargs, sa, in_sa,
 					     payloads[i],
 					     &start, &end);
 		if (rc)
 			break;
 
 		count = get_elapsed_usec(&start, &end);
-		result.elapsed = count / cargs->packet_count;
+		result.elapsed = count / num_pkts;
 
 		count = get_rusage_self_diff(&start, &end);
-		result.rusage_self = count / cargs->packet_count;
+		result.rusage_self = count / num_pkts;
 
 		count = get_rusage_thread_diff(&start, &end);
-		result.rusage_thread = count / cargs->packet_count;
+		result.rusage_thread = count / num_pkts;
 
 		print_result(cargs, payloads[i],
 			     config, &result);
@@ -1007,6 +1158,11 @@ run_measure_one_config(ipsec_args_t *cargs,
 	}
 	odp_ipsec_sa_destroy(sa);
 
+	if (in_sa != ODP_IPSEC_SA_INVALID) {
+		odp_ipsec_sa_disable(in_sa);
+		odp_ipsec_sa_destroy(in_sa);
+	}
+
 	return rc;
 }
 
@@ -1050,6 +1206,10 @@ static void usage(char *progname)
 	       "  -p, --poll           Poll completion queue for completion events.\n"
 	       "  -t, --tunnel         Use tunnel-mode IPsec transformation.\n"
 	       "  -u, --ah             Use AH transformation instead of ESP.\n"
+	       "  -i, --inbound <ws>   Decapsulate outbound packets with an inbound SA that uses\n"
+	       "                       the given anti-replay window size (sync mode only).\n"
+	       "  -w, --workers <num>  Number of sync mode worker threads sharing the same SA(s).\n"
+	       "                       Each worker processes 'count' packets (default 1).\n"
 	       "  -h, --help	       Display help and exit.\n"
 	       "\n");
 }
@@ -1071,10 +1231,12 @@ static void parse_args(int argc, char *argv[], ipsec_args_t *cargs)
 		{"schedule", no_argument, NULL, 's'},
 		{"tunnel", no_argument, NULL, 't'},
 		{"ah", no_argument, NULL, 'u'},
+		{"inbound", required_argument, NULL, 'i'},
+		{"workers", required_argument, NULL, 'w'},
 		{NULL, 0, NULL, 0}
 	};
 
-	static const char *shortopts = "+a:b:c:df:hm:nl:sptuv:";
+	static const char *shortopts = "+a:b:c:df:hi:m:nl:sptuv:w:";
 
 	cargs->in_flight = 1;
 	cargs->debug_packets = 0;
@@ -1085,6 +1247,8 @@ static void parse_args(int argc, char *argv[], ipsec_args_t *cargs)
 	cargs->alg_config = NULL;
 	cargs->schedule = 0;
 	cargs->ah = 0;
+	cargs->inbound_ws = 0;
+	cargs->num_workers = 1;
 
 	while (1) {
 		opt = getopt_long(argc, argv, shortopts, longopts, NULL);
@@ -1146,6 +1310,12 @@ static void parse_args(int argc, char *argv[], ipsec_args_t *cargs)
 		case 'u':
 			cargs->ah = 1;
 			break;
+		case 'i':
+			cargs->inbound_ws = atoi(optarg);
+			break;
+		case 'w':
+			cargs->num_workers = atoi(optarg);
+			break;
 		default:
 			break;
 		}
@@ -1163,6 +1333,18 @@ static void parse_args(int argc, char *argv[], ipsec_args_t *cargs)
 		usage(argv[0]);
 		exit(-1);
 	}
+
+	if ((cargs->inbound_ws || cargs->num_workers > 1) &&
+	    (cargs->schedule || cargs->poll)) {
+		printf("-i (inbound) and -w (workers) options are supported only in sync mode\n");
+		usage(argv[0]);
+		exit(-1);
+	}
+
+	if (cargs->num_workers < 1) {
+		printf("Invalid number of workers: %d\n", cargs->num_workers);
+		exit(-1);
+	}
 }
 
 int main(int argc, char *argv[])
@@ -1358,6 +1540,16 @@ int main(int argc, char *argv[])
 		printf("Run in async poll mode\n");
 	} else {
 		printf("Run in sync mode\n");
+
+		if (cargs.num_workers > 1) {
+			global_instance = instance;
+			cargs.num_workers = odp_cpumask_default_worker(&global_cpumask,
+								       cargs.num_workers);
+			(void)odp_cpumask_to_str(&global_cpumask, cpumaskstr,
+						 sizeof(cpumaskstr));
+			printf("num worker threads:  %i\n", cargs.num_workers);
+			printf("cpu mask:	     %s\n", cpumaskstr);
+		}
 	}
 
 	if (cargs.alg_config) {
@@ -87,14 +87,13 @@ typedef struct pktio_s {
 } pktio_t;
 
 typedef struct {
-	uint32_t prefix;
-	uint32_t mask;
 	odph_ethaddr_t dst_mac;
 	const pktio_t *pktio;
 } fwd_entry_t;
 
 typedef struct {
 	fwd_entry_t entries[MAX_FWDS];
+	odph_lpm_t lpm;
 	uint32_t num;
 } lookup_table_t;
 
@@ -228,6 +227,7 @@ static void init_config(prog_config_t *config)
 	odp_ipsec_sa_param_init(&config->default_cfg.sa_param);
 	config->compl_q = ODP_QUEUE_INVALID;
 	config->pktio_pool = ODP_POOL_INVALID;
+	config->fwd_tbl.lpm = ODPH_LPM_INVALID;
 	config->num_input_qs = 1;
 	config->num_sa_qs = 1;
 	config->num_output_qs = 1;
@@ -521,38 +521,12 @@ static inline int process_ipsec_out_enq(odp_packet_t pkts[], const odp_ipsec_sa_
 	return sent;
 }
 
-static inline const fwd_entry_t *get_fwd_entry(lookup_table_t *table, uint32_t ip)
-{
-	fwd_entry_t *entry;
-
-	for (uint32_t i = 0U; i < table->num; ++i) {
-		entry = &table->entries[i];
-
-		if ((ip & entry->mask) == entry->prefix)
-			return entry;
-	}
-
-	return NULL;
-}
-
-static inline const pktio_t *lookup_and_apply(odp_packet_t pkt, lookup_table_t *fwd_tbl,
-					      uint8_t *q_idx)
+static inline const pktio_t *apply_fwd(odp_packet_t pkt, const fwd_entry_t *fwd, uint32_t hash,
+				       uint8_t *q_idx)
 {
 	const uint32_t l3_off = odp_packet_l3_offset(pkt);
-	odph_ipv4hdr_t ipv4;
-	uint32_t dst_ip, src_ip;
-	const fwd_entry_t *fwd;
 	odph_ethhdr_t eth;
 
-	if (odp_packet_copy_to_mem(pkt, l3_off, ODPH_IPV4HDR_LEN, &ipv4) < 0)
-		return NULL;
-
-	dst_ip = odp_be_to_cpu_32(ipv4.dst_addr);
-	fwd = get_fwd_entry(fwd_tbl, dst_ip);
-
-	if (fwd == NULL)
-		return NULL;
-
 	if (l3_off != ODPH_ETHHDR_LEN) {
 		if (l3_off > ODPH_ETHHDR_LEN) {
 			if (odp_packet_pull_head(pkt, l3_off - ODPH_ETHHDR_LEN) == NULL)
@@ -570,10 +544,8 @@ static inline const pktio_t *lookup_and_apply(odp_packet_t pkt, lookup_table_t *
 	if (odp_packet_copy_from_mem(pkt, 0U, ODPH_ETHHDR_LEN, &eth) < 0)
 		return NULL;
 
-	if (q_idx != NULL) {
-		src_ip = odp_be_to_cpu_32(ipv4.src_addr);
-		*q_idx = (src_ip ^ dst_ip) % fwd->pktio->num_tx_qs;
-	}
+	if (q_idx != NULL)
+		*q_idx = hash % fwd->pktio->num_tx_qs;
 
 	return fwd->pktio;
 }
@@ -588,10 +560,35 @@ static inline uint32_t forward_packets(odp_packet_t pkts[], int num, lookup_tabl
 	pkt_out_t *out;
 	pkt_vec_t *vec;
 	uint32_t num_procd = 0U, ret;
+	odp_packet_t pkts_lkp[MAX_BURST];
+	uint32_t dst_ips[MAX_BURST], hashes[MAX_BURST], fwd_idxs[MAX_BURST];
+	odph_ipv4hdr_t ipv4;
+	int num_lkp = 0;
 
 	for (int i = 0; i < num; ++i) {
 		pkt = pkts[i];
-		pktio = lookup_and_apply(pkt, fwd_tbl, q_idx_ptr);
+
+		if (odp_packet_copy_to_mem(pkt, odp_packet_l3_offset(pkt), ODPH_IPV4HDR_LEN,
+					   &ipv4) < 0) {
+			odp_packet_free(pkt);
+			continue;
+		}
+
+		dst_ips[num_lkp] = odp_be_to_cpu_32(ipv4.dst_addr);
+		hashes[num_lkp] = odp_be_to_cpu_32(ipv4.src_addr) ^ dst_ips[num_lkp];
+		pkts_lkp[num_lkp++] = pkt;
+	}
+
+	/* Look up all destinations at once to overlap route table cache misses */
+	(void)odph_lpm_ipv4_find_multi(fwd_tbl->lpm, dst_ips, fwd_idxs, num_lkp);
+
+	for (int i = 0; i < num_lkp; ++i) {
+		pkt = pkts_lkp[i];
+		pktio = NULL;
+
+		if (fwd_idxs[i] != ODPH_LPM_NEXT_HOP_INVALID)
+			pktio = apply_fwd(pkt, &fwd_tbl->entries[fwd_idxs[i]], hashes[i],
+					  q_idx_ptr);
 
 		if (pktio == NULL) {
 			odp_packet_free(pkt);
@@ -1380,10 +1377,12 @@ static void create_fwd_table_entry(config_setting_t *cfg, prog_config_t *config)
 		return;
 	}
 
-	mask = mask > 0U ? 0xFFFFFFFF << (IP_ADDR_LEN - mask) : 0U;
+	if (odph_lpm_ipv4_add(config->fwd_tbl.lpm, dst_ip, mask, config->fwd_tbl.num) < 0) {
+		ODPH_ERR("Error adding forwarding entry to lookup table\n");
+		return;
+	}
+
 	entry = &config->fwd_tbl.entries[config->fwd_tbl.num];
-	entry->prefix = dst_ip & mask;
-	entry->mask = mask;
 	entry->dst_mac = dst_mac;
 	entry->pktio = pktio;
 	++config->fwd_tbl.num;
@@ -1392,6 +1391,7 @@ static void create_fwd_table_entry(config_setting_t *cfg, prog_config_t *config)
 static void parse_fwd_table(config_t *cfg, prog_config_t *config)
 {
 	config_setting_t *cs;
+	odph_lpm_param_t lpm_param;
 	int count;
 
 	cs = config_lookup(cfg, "fwd");
@@ -1399,6 +1399,16 @@ static void parse_fwd_table(config_t *cfg, prog_config_t *config)
 	if (cs == NULL)
 		return;
 
+	odph_lpm_param_init(&lpm_param);
+	lpm_param.max_routes = MAX_FWDS;
+	lpm_param.num_groups = MAX_FWDS;
+	config->fwd_tbl.lpm = odph_lpm_create(PROG_NAME "_fwd", &lpm_param);
+
+	if (config->fwd_tbl.lpm == ODPH_LPM_INVALID) {
+		ODPH_ERR("Error creating forwarding lookup table\n");
+		return;
+	}
+
 	count = config_setting_length(cs);
 
 	for (int i = 0; i < count; i++) {
@@ -1970,6 +1980,9 @@ static void teardown_test(const prog_config_t *config)
 	if (config->compl_q != ODP_QUEUE_INVALID)
 		(void)odp_queue_destroy(config->compl_q);
 
+	if (config->fwd_tbl.lpm != ODPH_LPM_INVALID)
+		(void)odph_lpm_destroy(config->fwd_tbl.lpm);
+
 	free(config->conf_file);
 }
 
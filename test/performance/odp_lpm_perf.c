@@ -0,0 +1,613 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+/**
+ * @example odp_lpm_perf.c
+ *
+ * Performance test application for helper LPM tables. Creates a table of
+ * random routes and measures route insert and lookup rates. Optionally, the
+ * main thread updates routes while workers do lookups.
+ *
+ * @cond _ODP_HIDE_FROM_DOXYGEN_
+ */
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <odp_api.h>
+#include <odp/helper/odph_api.h>
+
+#define MAX_BURST 256
+
+typedef struct test_options_t {
+	uint32_t num_cpu;
+	uint32_t ipv6;
+	uint32_t num_route;
+	uint32_t num_group;
+	uint32_t num_addr;
+	uint32_t num_round;
+	uint32_t burst_size;
+	uint32_t update;
+
+} test_options_t;
+
+typedef struct test_route_t {
+	uint8_t addr[ODPH_IPV6ADDR_LEN];
+	uint32_t next_hop;
+	uint8_t depth;
+
+} test_route_t;
+
+typedef struct test_stat_t {
+	uint64_t lookups;
+	uint64_t found;
+	uint64_t nsec;
+	uint64_t cycles;
+
+} test_stat_t;
+
+typedef struct test_global_t {
+	test_options_t test_options;
+	odp_barrier_t barrier;
+	odp_atomic_u32_t workers_done;
+	odp_cpumask_t cpumask;
+	odph_thread_t thread_tbl[ODP_THREAD_COUNT_MAX];
+	test_stat_t stat[ODP_THREAD_COUNT_MAX];
+	odph_lpm_t lpm;
+	odp_shm_t route_shm;
+	odp_shm_t addr_shm;
+	test_route_t *route;
+	uint8_t *addr;
+	uint64_t insert_nsec;
+	uint64_t updates;
+
+} test_global_t;
+
+static void print_usage(void)
+{
+	printf("\n"
+	       "LPM table performance test\n"
+	       "\n"
+	       "Usage: odp_lpm_perf [options]\n"
+	       "\n"
+	       "  -c, --num_cpu      Number of worker threads (default 1)\n"
+	       "  -6, --ipv6         Test IPv6 table (default IPv4)\n"
+	       "  -r, --num_route    Number of routes (default 1000000)\n"
+	       "  -g, --num_group    Number of table groups. Default is num_route / 16 for\n"
+	       "                     IPv4 and num_route * 4 for IPv6.\n"
+	       "  -a, --num_addr     Number of lookup addresses per thread (default 1000000)\n"
+	       "  -R, --num_round    Number of rounds over lookup addresses (default 10)\n"
+	       "  -b, --burst        Lookup burst size (default 32, max %u).\n"
+	       "                     1: single address lookup functions\n"
+	       "  -u, --update       Delete and add routes in the main thread during lookups\n"
+	       "  -h, --help         This help\n"
+	       "\n", MAX_BURST);
+}
+
+static int parse_options(int argc, char *argv[], test_options_t *test_options)
+{
+	int opt;
+	int ret = 0;
+
+	static const struct option longopts[] = {
+		{"num_cpu",   required_argument, NULL, 'c'},
+		{"ipv6",      no_argument,       NULL, '6'},
+		{"num_route", required_argument, NULL, 'r'},
+		{"num_group", required_argument, NULL, 'g'},
+		{"num_addr",  required_argument, NULL, 'a'},
+		{"num_round", required_argument, NULL, 'R'},
+		{"burst",     required_argument, NULL, 'b'},
+		{"update",    no_argument,       NULL, 'u'},
+		{"help",      no_argument,       NULL, 'h'},
+		{NULL, 0, NULL, 0}
+	};
+
+	static const char *shortopts = "+c:6r:g:a:R:b:uh";
+
+	memset(test_options, 0, sizeof(test_options_t));
+	test_options->num_cpu    = 1;
+	test_options->num_route  = 1000000;
+	test_options->num_addr   = 1000000;
+	test_options->num_round  = 10;
+	test_options->burst_size = 32;
+
+	while (1) {
+		opt = getopt_long(argc, argv, shortopts, longopts, NULL);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'c':
+			test_options->num_cpu = atoi(optarg);
+			break;
+		case '6':
+			test_options->ipv6 = 1;
+			break;
+		case 'r':
+			test_options->num_route = atoi(optarg);
+			break;
+		case 'g':
+			test_options->num_group = atoi(optarg);
+			break;
+		case 'a':
+			test_options->num_addr = atoi(optarg);
+			break;
+		case 'R':
+			test_options->num_round = atoi(optarg);
+			break;
+		case 'b':
+			test_options->burst_size = atoi(optarg);
+			break;
+		case 'u':
+			test_options->update = 1;
+			break;
+		case 'h':
+			/* fall through */
+		default:
+			print_usage();
+			ret = -1;
+			break;
+		}
+	}
+
+	if (test_options->num_route == 0 || test_options->num_addr == 0) {
+		ODPH_ERR("Number of routes and addresses must be non-zero\n");
+		return -1;
+	}
+
+	if (test_options->burst_size == 0 || test_options->burst_size > MAX_BURST) {
+		ODPH_ERR("Bad burst size: %u\n", test_options->burst_size);
+		return -1;
+	}
+
+	if (test_options->num_group == 0)
+		test_options->num_group = test_options->ipv6 ? test_options->num_route * 4 :
+					  test_options->num_route / 16;
+
+	return ret;
+}
+
+static int set_num_cpu(test_global_t *global)
+{
+	int ret;
+	test_options_t *test_options = &global->test_options;
+	int num_cpu = test_options->num_cpu;
+
+	/* One thread used for the main thread */
+	if (num_cpu > ODP_THREAD_COUNT_MAX - 1) {
+		ODPH_ERR("Too many workers. Maximum is %i.\n", ODP_THREAD_COUNT_MAX - 1);
+		return -1;
+	}
+
+	ret = odp_cpumask_default_worker(&global->cpumask, num_cpu);
+
+	if (num_cpu && ret != num_cpu) {
+		ODPH_ERR("Too many workers. Max supported %i.\n", ret);
+		return -1;
+	}
+
+	/* Zero: all available workers */
+	if (num_cpu == 0) {
+		num_cpu = ret;
+		test_options->num_cpu = num_cpu;
+	}
+
+	odp_barrier_init(&global->barrier, num_cpu);
+
+	return 0;
+}
+
+/* Simple PRNG, so that the same routes and addresses are generated on every run */
+static inline uint64_t test_rand(uint64_t *state)
+{
+	uint64_t x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 7;
+	x ^= x << 17;
+	*state = x;
+
+	return x;
+}
+
+/* Prefix length distributions resemble those of Internet routing tables */
+static uint8_t route_depth(int ipv6, uint64_t *state)
+{
+	uint32_t r = test_rand(state) % 100;
+
+	if (ipv6) {
+		if (r < 30)
+			return 32 + test_rand(state) % 16;
+		if (r < 70)
+			return 48;
+		if (r < 95)
+			return 49 + test_rand(state) % 16;
+
+		return 65 + test_rand(state) % 64;
+	}
+
+	if (r < 5)
+		return 8 + test_rand(state) % 8;
+	if (r < 40)
+		return 16 + test_rand(state) % 8;
+	if (r < 95)
+		return 24;
+
+	return 25 + test_rand(state) % 8;
+}
+
+static uint32_t ipv4_from_addr(const uint8_t addr[])
+{
+	return ((uint32_t)addr[0] << 24) | ((uint32_t)addr[1] << 16) |
+	       ((uint32_t)addr[2] << 8) | addr[3];
+}
+
+static int route_add(test_global_t *global, const test_route_t *route)
+{
+	if (global->test_options.ipv6)
+		return odph_lpm_ipv6_add(global->lpm, route->addr, route->depth, route->next_hop);
+
+	return odph_lpm_ipv4_add(global->lpm, ipv4_from_addr(route->addr), route->depth,
+				 route->next_hop);
+}
+
+static int route_del(test_global_t *global, const test_route_t *route)
+{
+	if (global->test_options.ipv6)
+		return odph_lpm_ipv6_del(global->lpm, route->addr, route->depth);
+
+	return odph_lpm_ipv4_del(global->lpm, ipv4_from_addr(route->addr), route->depth);
+}
+
+static int create_table(test_global_t *global)
+{
+	test_options_t *test_options = &global->test_options;
+	uint32_t num_route = test_options->num_route;
+	uint32_t addr_len = test_options->ipv6 ? ODPH_IPV6ADDR_LEN : ODPH_IPV4ADDR_LEN;
+	uint64_t addr_size = (uint64_t)test_options->num_addr * addr_len;
+	odph_lpm_param_t param;
+	odp_time_t t1, t2;
+	uint64_t state = 0x9e3779b97f4a7c15;
+	uint32_t num_added = 0;
+
+	global->route_shm = odp_shm_reserve("lpm_perf_route", num_route * sizeof(test_route_t),
+					    ODP_CACHE_LINE_SIZE, 0);
+	global->addr_shm = odp_shm_reserve("lpm_perf_addr", addr_size, ODP_CACHE_LINE_SIZE, 0);
+
+	if (global->route_shm == ODP_SHM_INVALID || global->addr_shm == ODP_SHM_INVALID) {
+		ODPH_ERR("Shm reserve failed\n");
+		return -1;
+	}
+
+	global->route = odp_shm_addr(global->route_shm);
+	global->addr = odp_shm_addr(global->addr_shm);
+
+	for (uint32_t i = 0; i < num_route; i++) {
+		test_route_t *route = &global->route[i];
+
+		memset(route->addr, 0, ODPH_IPV6ADDR_LEN);
+
+		for (uint32_t j = 0; j < addr_len; j++)
+			route->addr[j] = test_rand(&state);
+
+		/* Global unicast */
+		if (test_options->ipv6)
+			route->addr[0] = 0x20 | (route->addr[0] & 0x1);
+
+		route->depth = route_depth(test_options->ipv6, &state);
+		route->next_hop = test_rand(&state) % 1024;
+	}
+
+	/* Lookup addresses are either within a route prefix or random */
+	for (uint32_t i = 0; i < test_options->num_addr; i++) {
+		uint8_t addr[ODPH_IPV6ADDR_LEN];
+
+		for (uint32_t j = 0; j < addr_len; j++)
+			addr[j] = test_rand(&state);
+
+		if (test_rand(&state) % 4) {
+			const test_route_t *route = &global->route[test_rand(&state) % num_route];
+
+			memcpy(addr, route->addr, route->depth / 8);
+		}
+
+		/* IPv4 addresses are stored in CPU byte order */
+		if (test_options->ipv6)
+			memcpy(&global->addr[(uint64_t)i * addr_len], addr, addr_len);
+		else
+			((uint32_t *)(uintptr_t)global->addr)[i] = ipv4_from_addr(addr);
+	}
+
+	odph_lpm_param_init(&param);
+	param.type = test_options->ipv6 ? ODPH_LPM_IPV6 : ODPH_LPM_IPV4;
+	param.max_routes = num_route;
+	param.num_groups = test_options->num_group;
+
+	global->lpm = odph_lpm_create("lpm_perf_table", &param);
+	if (global->lpm == ODPH_LPM_INVALID) {
+		ODPH_ERR("LPM table create failed\n");
+		return -1;
+	}
+
+	t1 = odp_time_local_strict();
+
+	for (uint32_t i = 0; i < num_route; i++)
+		if (route_add(global, &global->route[i]) == 0)
+			num_added++;
+
+	t2 = odp_time_local_strict();
+	global->insert_nsec = odp_time_diff_ns(t2, t1);
+
+	if (num_added != num_route)
+		printf("Note: %u routes did not fit into the table (out of groups)\n",
+		       num_route - num_added);
+
+	odph_lpm_print(global->lpm);
+
+	return 0;
+}
+
+static int test_lookup(void *arg)
+{
+	test_global_t *global = arg;
+	test_options_t *test_options = &global->test_options;
+	odph_lpm_t lpm = global->lpm;
+	uint32_t num_addr = test_options->num_addr;
+	uint32_t burst_size = test_options->burst_size;
+	int ipv6 = test_options->ipv6;
+	uint32_t next_hop[MAX_BURST];
+	uint64_t found = 0;
+	uint64_t lookups = 0;
+	uint64_t c1, c2, nsec;
+	odp_time_t t1, t2;
+	int thr = odp_thread_id();
+
+	odp_barrier_wait(&global->barrier);
+
+	t1 = odp_time_local_strict();
+	c1 = odp_cpu_cycles();
+
+	for (uint32_t round = 0; round < test_options->num_round; round++) {
+		for (uint32_t i = 0; i < num_addr; i += burst_size) {
+			uint32_t num = ODPH_MIN(burst_size, num_addr - i);
+
+			if (ipv6) {
+				const uint8_t (*addr)[ODPH_IPV6ADDR_LEN] =
+					(const uint8_t (*)[ODPH_IPV6ADDR_LEN])global->addr;
+
+				if (num == 1)
+					found += odph_lpm_ipv6_find(lpm, addr[i], next_hop) == 0;
+				else
+					found += odph_lpm_ipv6_find_multi(lpm, &addr[i], next_hop,
+									  num);
+			} else {
+				const uint32_t *addr = (const uint32_t *)(uintptr_t)global->addr;
+
+				if (num == 1)
+					found += odph_lpm_ipv4_find(lpm, addr[i], next_hop) == 0;
+				else
+					found += odph_lpm_ipv4_find_multi(lpm, &addr[i], next_hop,
+									  num);
+			}
+
+			lookups += num;
+		}
+	}
+
+	c2 = odp_cpu_cycles();
+	t2 = odp_time_local_strict();
+	nsec = odp_time_diff_ns(t2, t1);
+
+	global->stat[thr].lookups = lookups;
+	global->stat[thr].found = found;
+	global->stat[thr].nsec = nsec;
+	global->stat[thr].cycles = odp_cpu_cycles_diff(c2, c1);
+
+	odp_atomic_inc_u32(&global->workers_done);
+
+	return 0;
+}
+
+/* Delete and re-add routes until all workers are done */
+static void update_routes(test_global_t *global)
+{
+	test_options_t *test_options = &global->test_options;
+	uint64_t updates = 0;
+	uint32_t i = 0;
+
+	while (odp_atomic_load_u32(&global->workers_done) < test_options->num_cpu) {
+		const test_route_t *route = &global->route[i];
+
+		if (route_del(global, route) == 0 && route_add(global, route) == 0)
+			updates++;
+
+		if (++i == test_options->num_route)
+			i = 0;
+	}
+
+	global->updates = updates;
+}
+
+static int start_workers(test_global_t *global, odp_instance_t instance)
+{
+	odph_thread_common_param_t thr_common;
+	odph_thread_param_t thr_param;
+	int num_cpu = global->test_options.num_cpu;
+
+	odph_thread_common_param_init(&thr_common);
+	thr_common.instance = instance;
+	thr_common.cpumask = &global->cpumask;
+	thr_common.share_param = 1;
+
+	odph_thread_param_init(&thr_param);
+	thr_param.start = test_lookup;
+	thr_param.arg = global;
+	thr_param.thr_type = ODP_THREAD_WORKER;
+
+	if (odph_thread_create(global->thread_tbl, &thr_common, &thr_param,
+			       num_cpu) != num_cpu)
+		return -1;
+
+	return 0;
+}
+
+static void print_results(test_global_t *global)
+{
+	test_options_t *test_options = &global->test_options;
+	uint64_t lookups = 0, found = 0, nsec = 0, cycles = 0;
+	uint32_t num_cpu = test_options->num_cpu;
+	double nsec_ave, cycles_ave;
+
+	for (int i = 0; i < ODP_THREAD_COUNT_MAX; i++) {
+		lookups += global->stat[i].lookups;
+		found += global->stat[i].found;
+		nsec += global->stat[i].nsec;
+		cycles += global->stat[i].cycles;
+	}
+
+	nsec_ave = (double)nsec / num_cpu;
+	cycles_ave = (double)cycles / num_cpu;
+
+	printf("\nLPM table performance test\n");
+	printf("  table type           %s\n", test_options->ipv6 ? "IPv6" : "IPv4");
+	printf("  num routes           %u\n", test_options->num_route);
+	printf("  num groups           %u\n", test_options->num_group);
+	printf("  num workers          %u\n", num_cpu);
+	printf("  lookup burst size    %u\n", test_options->burst_size);
+	printf("  route updates        %s\n\n", test_options->update ? "yes" : "no");
+
+	printf("RESULTS\n");
+	printf("  route insert:        %.1f nsec/route\n",
+	       (double)global->insert_nsec / test_options->num_route);
+
+	if (test_options->update)
+		printf("  concurrent updates:  %" PRIu64 "\n", global->updates);
+
+	if (lookups == 0)
+		return;
+
+	printf("  lookups:             %" PRIu64 " (%.1f%% found)\n", lookups,
+	       100.0 * found / lookups);
+	printf("  lookup time:         %.2f nsec, %.2f cycles (per thread average)\n",
+	       nsec_ave * num_cpu / lookups, cycles_ave * num_cpu / lookups);
+	printf("  lookup rate:         %.2f M/s per thread, %.2f M/s total\n\n",
+	       (double)lookups / num_cpu * 1000.0 / nsec_ave,
+	       (double)lookups * 1000.0 / nsec_ave);
+}
+
+int main(int argc, char **argv)
+{
+	odph_helper_options_t helper_options;
+	odp_instance_t instance;
+	odp_init_t init;
+	odp_shm_t shm;
+	test_global_t *global;
+	int ret = 0;
+
+	/* Let helper collect its own arguments (e.g. --odph_proc) */
+	argc = odph_parse_options(argc, argv);
+	if (odph_options(&helper_options)) {
+		ODPH_ERR("Reading ODP helper options failed\n");
+		exit(EXIT_FAILURE);
+	}
+
+	/* List features not to be used */
+	odp_init_param_init(&init);
+	init.not_used.feat.cls      = 1;
+	init.not_used.feat.compress = 1;
+	init.not_used.feat.crypto   = 1;
+	init.not_used.feat.ipsec    = 1;
+	init.not_used.feat.schedule = 1;
+	init.not_used.feat.stash    = 1;
+	init.not_used.feat.timer    = 1;
+	init.not_used.feat.tm       = 1;
+
+	init.mem_model = helper_options.mem_model;
+
+	if (odp_init_global(&instance, &init, NULL)) {
+		ODPH_ERR("Global init failed\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_init_local(instance, ODP_THREAD_CONTROL)) {
+		ODPH_ERR("Local init failed\n");
+		exit(EXIT_FAILURE);
+	}
+
+	shm = odp_shm_reserve("lpm_perf_global", sizeof(test_global_t), ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID) {
+		ODPH_ERR("Shared mem reserve failed\n");
+		exit(EXIT_FAILURE);
+	}
+
+	global = odp_shm_addr(shm);
+	if (global == NULL) {
+		ODPH_ERR("Shared mem alloc failed\n");
+		exit(EXIT_FAILURE);
+	}
+
+	memset(global, 0, sizeof(test_global_t));
+	global->lpm = ODPH_LPM_INVALID;
+	global->route_shm = ODP_SHM_INVALID;
+	global->addr_shm = ODP_SHM_INVALID;
+	odp_atomic_init_u32(&global->workers_done, 0);
+
+	if (parse_options(argc, argv, &global->test_options)) {
+		ret = -1;
+		goto term;
+	}
+
+	odp_sys_info_print();
+
+	if (set_num_cpu(global) || create_table(global)) {
+		ret = -1;
+		goto free;
+	}
+
+	if (start_workers(global, instance)) {
+		ODPH_ERR("Worker start failed\n");
+		ret = -1;
+		goto free;
+	}
+
+	if (global->test_options.update)
+		update_routes(global);
+
+	odph_thread_join(global->thread_tbl, global->test_options.num_cpu);
+
+	print_results(global);
+
+free:
+	if (global->lpm != ODPH_LPM_INVALID && odph_lpm_destroy(global->lpm))
+		ret = -1;
+
+	if (global->addr_shm != ODP_SHM_INVALID && odp_shm_free(global->addr_shm))
+		ret = -1;
+
+	if (global->route_shm != ODP_SHM_INVALID && odp_shm_free(global->route_shm))
+		ret = -1;
+
+term:
+	if (odp_shm_free(shm)) {
+		ODPH_ERR("Shared mem free failed\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_local()) {
+		ODPH_ERR("Local term failed\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_global(instance)) {
+		ODPH_ERR("Global term failed\n");
+		exit(EXIT_FAILURE);
+	}
+
+	return ret ? EXIT_FAILURE : EXIT_SUCCESS;
+}
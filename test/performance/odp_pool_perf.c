@@ -40,6 +40,7 @@ typedef struct test_options_t {
 	uint32_t cache_size;
 	uint32_t stats_mode;
 	int      pool_type;
+	int      pipeline;
 
 } test_options_t;
 
@@ -57,6 +58,9 @@ typedef struct test_global_t {
 
 	odp_barrier_t barrier;
 	odp_pool_t pool;
+	odp_queue_t queue[ODP_THREAD_COUNT_MAX / 2];
+	odp_atomic_u32_t worker_idx;
+	odp_atomic_u32_t producers_done;
 	odp_cpumask_t cpumask;
 	odph_thread_t thread_tbl[ODP_THREAD_COUNT_MAX];
 	test_stat_t stat[ODP_THREAD_COUNT_MAX];
@@ -88,6 +92,12 @@ static void print_usage(void)
 	       "  -t, --pool_type        0: Buffer pool (default)\n"
 	       "                         1: Packet pool\n"
 	       "  -C, --cache_size       Pool cache size (per thread)\n"
+	       "  -p, --pipeline         Producer/consumer pipeline. Workers are paired, one worker\n"
+	       "                         allocates events and passes those through a plain queue to\n"
+	       "                         the other worker, which frees them. Requires an even number\n"
+	       "                         of workers. Results are reported for producers.\n"
+	       "                         0: Each worker allocates and frees (default)\n"
+	       "                         1: Pipeline\n"
 	       "  -h, --help             This help\n"
 	       "\n");
 }
@@ -107,11 +117,12 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		{"stats_mode", required_argument, NULL, 'S'},
 		{"pool_type",  required_argument, NULL, 't'},
 		{"cache_size", required_argument, NULL, 'C'},
+		{"pipeline",   required_argument, NULL, 'p'},
 		{"help",       no_argument,       NULL, 'h'},
 		{NULL, 0, NULL, 0}
 	};
 
-	static const char *shortopts = "+c:e:r:b:n:s:S:t:C:h";
+	static const char *shortopts = "+c:e:r:b:n:s:S:t:C:p:h";
 
 	test_options->num_cpu    = 1;
 	test_options->num_event  = 1000;
@@ -122,6 +133,7 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 	test_options->stats_mode = 0;
 	test_options->pool_type  = 0;
 	test_options->cache_size = UINT32_MAX;
+	test_options->pipeline   = 0;
 
 	while (1) {
 		opt = getopt_long(argc, argv, shortopts, longopts, NULL);
@@ -157,6 +169,9 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		case 'C':
 			test_options->cache_size = atoi(optarg);
 			break;
+		case 'p':
+			test_options->pipeline = atoi(optarg);
+			break;
 		case 'h':
 			/* fall through */
 		default:
@@ -204,6 +219,11 @@ static int set_num_cpu(test_global_t *global)
 		test_options->num_cpu = num_cpu;
 	}
 
+	if (test_options->pipeline && (num_cpu < 2 || num_cpu % 2)) {
+		printf("Error: Pipeline requires an even number of workers.\n");
+		return -1;
+	}
+
 	odp_barrier_init(&global->barrier, num_cpu);
 
 	return 0;
@@ -257,7 +277,8 @@ static int create_pool(test_global_t *global)
 	printf("  data size  %u\n", data_size);
 	printf("  cache size %u\n", cache_size);
 	printf("  stats mode 0x%x\n", stats_mode);
-	printf("  pool type  %s\n\n", packet_pool ? "packet" : "buffer");
+	printf("  pool type  %s\n", packet_pool ? "packet" : "buffer");
+	printf("  pipeline   %s\n\n", test_options->pipeline ? "yes" : "no");
 
 	if (odp_pool_capability(&pool_capa)) {
 		printf("Error: Pool capa failed.\n");
@@ -332,6 +353,64 @@ static int create_pool(test_global_t *global)
 	return 0;
 }
 
+static int create_queues(test_global_t *global)
+{
+	odp_queue_capability_t queue_capa;
+	odp_queue_param_t queue_param;
+	test_options_t *test_options = &global->test_options;
+	uint32_t num_queue = test_options->num_cpu / 2;
+	uint32_t queue_size = test_options->num_event;
+
+	if (odp_queue_capability(&queue_capa)) {
+		printf("Error: Queue capa failed.\n");
+		return -1;
+	}
+
+	if (num_queue > queue_capa.plain.max_num) {
+		printf("Error: max plain queues supported %u\n", queue_capa.plain.max_num);
+		return -1;
+	}
+
+	/* All events must fit into a queue, so that producers never block */
+	if (queue_capa.plain.max_size && queue_size > queue_capa.plain.max_size) {
+		printf("Error: max plain queue size supported %u\n", queue_capa.plain.max_size);
+		return -1;
+	}
+
+	odp_queue_param_init(&queue_param);
+	queue_param.type = ODP_QUEUE_TYPE_PLAIN;
+	queue_param.size = queue_size;
+
+	for (uint32_t i = 0; i < num_queue; i++) {
+		global->queue[i] = odp_queue_create("pool perf", &queue_param);
+
+		if (global->queue[i] == ODP_QUEUE_INVALID) {
+			printf("Error: Queue create failed.\n");
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static int destroy_queues(test_global_t *global)
+{
+	uint32_t num_queue = global->test_options.num_cpu / 2;
+	int ret = 0;
+
+	for (uint32_t i = 0; i < num_queue; i++) {
+		if (global->queue[i] == ODP_QUEUE_INVALID)
+			continue;
+
+		if (odp_queue_destroy(global->queue[i])) {
+			printf("Error: Queue destroy failed.\n");
+			ret = -1;
+		}
+	}
+
+	return ret;
+}
+
 static int test_buffer_pool(void *arg)
 {
 	int ret, thr;
@@ -498,6 +577,153 @@ static int test_packet_pool(void *arg)
 	return 0;
 }
 
+static int alloc_events(odp_pool_t pool, int packet_pool, uint32_t data_size, odp_event_t ev[],
+			int num)
+{
+	int ret;
+
+	if (packet_pool) {
+		odp_packet_t pkt[num];
+
+		ret = odp_packet_alloc_multi(pool, data_size, pkt, num);
+		if (ret > 0)
+			odp_packet_to_event_multi(pkt, ev, ret);
+	} else {
+		odp_buffer_t buf[num];
+
+		ret = odp_buffer_alloc_multi(pool, buf, num);
+		if (ret > 0)
+			odp_buffer_to_event_multi(buf, ev, ret);
+	}
+
+	return ret;
+}
+
+/* Producer allocates events and passes those to its consumer pair through a
+ * plain queue. Event pool ends up being accessed asymmetrically: producers only
+ * allocate and consumers only free. */
+static int test_producer(test_global_t *global, odp_queue_t queue)
+{
+	int ret, thr;
+	uint32_t num, num_enq, i, rounds;
+	uint64_t c1, c2, cycles, nsec;
+	uint64_t events, enqs;
+	odp_time_t t1, t2;
+	test_options_t *test_options = &global->test_options;
+	uint32_t num_round = test_options->num_round;
+	uint32_t max_burst = test_options->max_burst;
+	uint32_t num_burst = test_options->num_burst;
+	uint32_t max_num = num_burst * max_burst;
+	uint32_t data_size = test_options->data_size;
+	int packet_pool = test_options->pool_type;
+	odp_pool_t pool = global->pool;
+	odp_event_t ev[max_num];
+
+	thr = odp_thread_id();
+	events = 0;
+	enqs = 0;
+
+	/* Start all workers at the same time */
+	odp_barrier_wait(&global->barrier);
+
+	t1 = odp_time_local();
+	c1 = odp_cpu_cycles();
+
+	for (rounds = 0; rounds < num_round; rounds++) {
+		num = 0;
+
+		for (i = 0; i < num_burst; i++) {
+			ret = alloc_events(pool, packet_pool, data_size, &ev[num], max_burst);
+			if (odp_unlikely(ret < 0)) {
+				printf("Error: Alloc failed. Round %u\n", rounds);
+				if (num)
+					odp_event_free_multi(ev, num);
+
+				odp_atomic_inc_u32(&global->producers_done);
+				return -1;
+			}
+
+			num += ret;
+		}
+
+		if (odp_unlikely(num == 0))
+			continue;
+
+		events += num;
+		num_enq = 0;
+
+		/* Queue has room for all events of the pool */
+		while (num_enq < num) {
+			ret = odp_queue_enq_multi(queue, &ev[num_enq], num - num_enq);
+
+			if (odp_likely(ret > 0))
+				num_enq += ret;
+		}
+
+		enqs++;
+	}
+
+	c2 = odp_cpu_cycles();
+	t2 = odp_time_local();
+
+	odp_atomic_inc_u32(&global->producers_done);
+
+	nsec   = odp_time_diff_ns(t2, t1);
+	cycles = odp_cpu_cycles_diff(c2, c1);
+
+	/* Update stats*/
+	global->stat[thr].rounds = rounds;
+	global->stat[thr].frees  = enqs;
+	global->stat[thr].events = events;
+	global->stat[thr].nsec   = nsec;
+	global->stat[thr].cycles = cycles;
+
+	return 0;
+}
+
+static int test_consumer(test_global_t *global, odp_queue_t queue)
+{
+	int num;
+	test_options_t *test_options = &global->test_options;
+	uint32_t num_producer = test_options->num_cpu / 2;
+	int max_num = test_options->num_burst * test_options->max_burst;
+	odp_event_t ev[max_num];
+
+	/* Start all workers at the same time */
+	odp_barrier_wait(&global->barrier);
+
+	while (1) {
+		num = odp_queue_deq_multi(queue, ev, max_num);
+
+		if (num > 0) {
+			odp_event_free_multi(ev, num);
+			continue;
+		}
+
+		/* Producers enqueue all events before signaling done */
+		if (odp_atomic_load_u32(&global->producers_done) == num_producer) {
+			while ((num = odp_queue_deq_multi(queue, ev, max_num)) > 0)
+				odp_event_free_multi(ev, num);
+
+			break;
+		}
+	}
+
+	return 0;
+}
+
+static int test_pipeline(void *arg)
+{
+	test_global_t *global = arg;
+	uint32_t idx = odp_atomic_fetch_inc_u32(&global->worker_idx);
+	odp_queue_t queue = global->queue[idx / 2];
+
+	if (idx % 2)
+		return test_consumer(global, queue);
+
+	return test_producer(global, queue);
+}
+
 static int start_workers(test_global_t *global, odp_instance_t instance)
 {
 	odph_thread_common_param_t thr_common;
@@ -515,7 +741,9 @@ static int start_workers(test_global_t *global, odp_instance_t instance)
 	thr_param.arg = global;
 	thr_param.thr_type = ODP_THREAD_WORKER;
 
-	if (packet_pool)
+	if (test_options->pipeline)
+		thr_param.start = test_pipeline;
+	else if (packet_pool)
 		thr_param.start = test_packet_pool;
 	else
 		thr_param.start = test_buffer_pool;
@@ -605,6 +833,10 @@ static int output_results(test_global_t *global)
 		return 0;
 	}
 
+	/* Only producers record results in pipeline mode */
+	if (test_options->pipeline)
+		num_cpu = num_cpu / 2;
+
 	rounds_ave = rounds_sum / num_cpu;
 	allocs_ave = (num_burst * rounds_sum) / num_cpu;
 	frees_ave  = frees_sum / num_cpu;
@@ -740,6 +972,11 @@ int main(int argc, char **argv)
 
 	memset(global, 0, sizeof(test_global_t));
 	global->pool = ODP_POOL_INVALID;
+	odp_atomic_init_u32(&global->worker_idx, 0);
+	odp_atomic_init_u32(&global->producers_done, 0);
+
+	for (int i = 0; i < ODP_THREAD_COUNT_MAX / 2; i++)
+		global->queue[i] = ODP_QUEUE_INVALID;
 
 	global->common_options = common_options;
 
@@ -754,6 +991,9 @@ int main(int argc, char **argv)
 	if (create_pool(global))
 		return -1;
 
+	if (global->test_options.pipeline && create_queues(global))
+		return -1;
+
 	/* Start workers */
 	start_workers(global, instance);
 
@@ -766,6 +1006,9 @@ int main(int argc, char **argv)
 	if (output_results(global))
 		return -1;
 
+	if (destroy_queues(global))
+		return -1;
+
 	if (odp_pool_destroy(global->pool)) {
 		printf("Error: Pool destroy failed.\n");
 		return -1;
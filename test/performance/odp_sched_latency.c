@@ -106,6 +106,9 @@ typedef struct {
 
 	odp_schedule_group_t group[NUM_PRIOS][MAX_GROUPS];
 
+	/** Scheduler statistics are collected */
+	int sched_stats;
+
 } test_globals_t;
 
 /**
@@ -250,6 +253,46 @@ static int enqueue_events(int prio, int num_queues, int num_events,
 	return 0;
 }
 
+/**
+ * Reset scheduler statistics, if supported by the implementation
+ */
+static void reset_sched_stats(test_globals_t *globals)
+{
+	odp_schedule_capability_t capa;
+
+	globals->sched_stats = 0;
+
+	if (odp_schedule_capability(&capa) || capa.stats != ODP_SUPPORT_YES)
+		return;
+
+	if (odp_schedule_stats_reset() == 0)
+		globals->sched_stats = 1;
+}
+
+/**
+ * Print scheduler burst size and queue delay statistics of all threads
+ */
+static void print_sched_stats(test_globals_t *globals)
+{
+	odp_schedule_stats_t stats;
+	const odp_schedule_stats_hist_t *hist;
+
+	if (!globals->sched_stats || odp_schedule_stats(-1, &stats))
+		return;
+
+	printf("Scheduler statistics\n"
+	       "          Avg        Min        Max        Samples\n"
+	       "-----------------------------------------------------------------------\n");
+
+	hist = &stats.burst;
+	printf("Burst     %-10" PRIu64 " %-10" PRIu64 " %-10" PRIu64 " %-10" PRIu64 "\n",
+	       hist->num ? hist->sum / hist->num : 0, hist->min, hist->max, hist->num);
+
+	hist = &stats.queue_delay;
+	printf("Delay[ns] %-10" PRIu64 " %-10" PRIu64 " %-10" PRIu64 " %-10" PRIu64 "\n\n",
+	       hist->num ? hist->sum / hist->num : 0, hist->min, hist->max, hist->num);
+}
+
 /**
  * Print latency measurement results
  *
@@ -354,6 +397,8 @@ static int output_results(test_globals_t *globals)
 		}
 	}
 
+	print_sched_stats(globals);
+
 	if (globals->common_options.is_export)
 		test_common_write_term();
 
@@ -1095,6 +1140,8 @@ int main(int argc, char *argv[])
 
 	odp_barrier_init(&globals->barrier, num_workers);
 
+	reset_sched_stats(globals);
+
 	/* Create and launch worker threads */
 	memset(thread_tbl, 0, sizeof(thread_tbl));
 
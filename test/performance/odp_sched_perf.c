@@ -109,6 +109,8 @@ typedef struct test_global_t {
 	odp_atomic_u32_t num_worker;
 	odp_atomic_u32_t exit_threads;
 	test_common_options_t common_options;
+	odp_schedule_stats_t sched_stats;
+	int sched_stats_valid;
 
 } test_global_t;
 
@@ -1266,6 +1268,13 @@ static int test_sched(void *arg)
 			odp_schedule_print();
 		}
 
+		if (global->sched_stats_valid) {
+			if (odp_schedule_stats(-1, &global->sched_stats))
+				global->sched_stats_valid = 0;
+			else if (test_options->verbose)
+				odp_schedule_stats_print();
+		}
+
 		while ((event = odp_schedule(NULL, sched_wait)) != ODP_EVENT_INVALID)
 			odp_event_free(event);
 	}
@@ -1369,6 +1378,41 @@ static double measure_wait_time_cycles(uint64_t wait_ns)
 	return wait_cycles;
 }
 
+static void reset_sched_stats(test_global_t *global)
+{
+	odp_schedule_capability_t capa;
+
+	if (odp_schedule_capability(&capa) || capa.stats != ODP_SUPPORT_YES)
+		return;
+
+	if (odp_schedule_stats_reset() == 0)
+		global->sched_stats_valid = 1;
+}
+
+static double hist_ave(const odp_schedule_stats_hist_t *hist)
+{
+	return hist->num ? (double)hist->sum / hist->num : 0.0;
+}
+
+static void print_sched_stats(test_global_t *global)
+{
+	odp_schedule_stats_t *stats = &global->sched_stats;
+
+	if (!global->sched_stats_valid)
+		return;
+
+	printf("SCHEDULER statistics - all threads:\n");
+	printf("-----------------------------------\n");
+	printf("  schedule rounds:          %" PRIu64 "\n", stats->rounds);
+	printf("  empty rounds:             %" PRIu64 "\n", stats->empty_rounds);
+	printf("  ave burst size:           %.3f\n", hist_ave(&stats->burst));
+	printf("  max burst size:           %" PRIu64 "\n", stats->burst.max);
+	printf("  ave schedule latency:     %.3f nsec\n", hist_ave(&stats->latency));
+	printf("  max schedule latency:     %" PRIu64 " nsec\n", stats->latency.max);
+	printf("  ave queue delay:          %.3f nsec\n", hist_ave(&stats->queue_delay));
+	printf("  max queue delay:          %" PRIu64 " nsec\n\n", stats->queue_delay.max);
+}
+
 static int output_results(test_global_t *global)
 {
 	int i, num;
@@ -1466,6 +1510,8 @@ static int output_results(test_global_t *global)
 	printf("TOTAL events per sec:       %.3f M\n\n",
 	       (1000.0 * events_sum) / nsec_ave);
 
+	print_sched_stats(global);
+
 	if (global->common_options.is_export) {
 		if (test_common_write("schedule calls,enqueue calls,duration (msec),"
 				      "num cycles (M),cycles per round,cycles per event,"
@@ -1602,6 +1648,8 @@ int main(int argc, char **argv)
 
 	print_options(&global->test_options);
 
+	reset_sched_stats(global);
+
 	/* Start workers */
 	start_workers(global, instance);
 
@@ -0,0 +1,1483 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 Nokia
+ */
+
+/**
+ * @example odp_tm_perf.c
+ *
+ * Performance test application for traffic manager APIs. Producer threads
+ * enqueue packets into TM queues of a configurable TM node hierarchy. Test
+ * reports enqueue and egress throughput, packet latency through the
+ * hierarchy and shaping accuracy.
+ *
+ * @cond _ODP_HIDE_FROM_DOXYGEN_
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <getopt.h>
+
+#include <odp_api.h>
+#include <odp/helper/odph_api.h>
+
+#include <export_results.h>
+
+#define MAX_NODES      4096
+#define MAX_QUEUES     4096
+#define MAX_BURST      64
+#define MAX_WEIGHTS    16
+#define DRAIN_TMO_SEC  10
+
+/* Test packet ethertype (IEEE local experimental) */
+#define TEST_ETHTYPE   0x88b5
+
+/* Enqueue timestamp is stored right after the Ethernet header */
+#define TS_OFFSET      ODPH_ETHHDR_LEN
+#define MIN_PKT_LEN    (TS_OFFSET + sizeof(uint64_t))
+
+enum {
+	EGRESS_NULL = 0,
+	EGRESS_LOOP,
+	EGRESS_FN
+};
+
+typedef struct test_options_t {
+	uint32_t num_cpu;
+	uint32_t num_level;
+	uint32_t fanout;
+	uint32_t queues_per_leaf;
+	uint32_t burst;
+	uint32_t pkt_len;
+	uint32_t num_pkt;
+	uint32_t egress;
+	uint64_t shaper_rate;
+	uint64_t queue_shaper_rate;
+	uint32_t shaper_burst;
+	uint32_t num_prio;
+	uint32_t max_weight;
+	int wrr;
+	uint32_t threshold;
+	uint32_t wred_drop;
+	uint32_t duration;
+	uint64_t interval_ns;
+
+	/* Derived from the options above */
+	uint32_t num_node;
+	uint32_t num_queue;
+	uint32_t level_nodes[ODP_TM_MAX_LEVELS];
+	uint32_t level_first[ODP_TM_MAX_LEVELS];
+
+} test_options_t;
+
+typedef struct test_stat_t {
+	uint64_t enq_pkts;
+	uint64_t enq_calls;
+	uint64_t enq_drops;
+	uint64_t alloc_fails;
+	uint64_t enq_cycles;
+	uint64_t nsec;
+
+} test_stat_t;
+
+typedef struct egress_stat_t {
+	uint64_t num_lat;
+	uint64_t lat_sum;
+	uint64_t lat_min;
+	uint64_t lat_max;
+
+} egress_stat_t;
+
+typedef struct test_global_t {
+	odp_barrier_t barrier;
+	odp_atomic_u32_t exit_test;
+	test_options_t options;
+	odp_instance_t instance;
+	odp_shm_t shm;
+	odp_pool_t pool;
+	odp_pktio_t pktio;
+	odp_pktin_queue_t pktin;
+	odp_tm_t tm;
+	odp_tm_shaper_t shaper;
+	odp_tm_shaper_t queue_shaper;
+	odp_tm_threshold_t threshold;
+	odp_tm_wred_t wred;
+	odp_tm_sched_t sched[MAX_WEIGHTS];
+	odp_tm_node_t node[MAX_NODES];
+	odp_tm_queue_t queue[MAX_QUEUES];
+	uint8_t hdr[ODPH_ETHHDR_LEN];
+
+	/* Written by the egress thread (TM or main thread) */
+	egress_stat_t egress;
+
+	/* TM queue statistics at the end of the measurement period */
+	odp_tm_queue_stats_t queue_stats;
+	uint64_t nsec;
+
+	odph_thread_t thread_tbl[ODP_THREAD_COUNT_MAX];
+	test_stat_t stat[ODP_THREAD_COUNT_MAX];
+	test_common_options_t common_options;
+
+} test_global_t;
+
+/* Egress function has no context argument */
+static test_global_t *test_global;
+
+static void print_usage(void)
+{
+	printf("\n"
+	       "Traffic manager performance test\n"
+	       "\n"
+	       "Usage: odp_tm_perf [options]\n"
+	       "\n"
+	       "  -c, --num_cpu <num>      Number of producer threads. 0: all available workers.\n"
+	       "                           Default: 1\n"
+	       "  -l, --num_level <num>    Number of TM node levels. Default: 2\n"
+	       "  -f, --fanout <num>       Number of child nodes per TM node on non-leaf levels.\n"
+	       "                           Default: 4\n"
+	       "  -q, --num_queue <num>    Number of TM queues per leaf TM node. Default: 4\n"
+	       "  -b, --burst <num>        Max number of packets per enqueue call. Default: 8\n"
+	       "  -L, --pkt_len <bytes>    Packet length. Default: 64\n"
+	       "  -n, --num_pkt <num>      Number of packets in the pool. Default: 8192\n"
+	       "  -e, --egress <mode>      TM egress\n"
+	       "                             0: null pktio (default)\n"
+	       "                             1: loop pktio, packets are received back for\n"
+	       "                                latency measurement\n"
+	       "                             2: egress function\n"
+	       "  -s, --shaper <bps>       Root TM node shaper rate in bits per sec.\n"
+	       "                           0: no shaper. Default: 0\n"
+	       "  -S, --queue_shaper <bps> TM queue shaper rate in bits per sec. 0: no shaper.\n"
+	       "                           Default: 0\n"
+	       "  -B, --shaper_burst <bits> Shaper commit burst. Default: 80000\n"
+	       "  -p, --num_prio <num>     Number of strict priorities used by TM queues. Queues\n"
+	       "                           are assigned priorities in round robin. Default: 1\n"
+	       "  -w, --max_weight <num>   Max scheduler weight. Fan-in weights are assigned\n"
+	       "                           from range 1..max in round robin. Max %u. Default: 1\n"
+	       "  -r, --wrr                Frame based weights (WRR). Default: byte based (WFQ)\n"
+	       "  -T, --threshold <num>    TM queue max packet count threshold. 0: no threshold.\n"
+	       "                           Default: 0\n"
+	       "  -W, --wred <percent>     Enable single slope WRED on TM queues with this max\n"
+	       "                           drop probability. Requires threshold. 0: no WRED.\n"
+	       "                           Default: 0\n"
+	       "  -t, --time <sec>         Test duration in seconds. Default: 1\n"
+	       "  -i, --interval <nsec>    Delay between enqueue bursts of a producer. Default: 0\n"
+	       "  -h, --help               This help\n"
+	       "\n", MAX_WEIGHTS);
+}
+
+static int parse_options(int argc, char *argv[], test_options_t *test_options)
+{
+	int opt;
+	uint32_t i, nodes;
+	int ret = 0;
+
+	static const struct option longopts[] = {
+		{ "num_cpu", required_argument, NULL, 'c' },
+		{ "num_level", required_argument, NULL, 'l' },
+		{ "fanout", required_argument, NULL, 'f' },
+		{ "num_queue", required_argument, NULL, 'q' },
+		{ "burst", required_argument, NULL, 'b' },
+		{ "pkt_len", required_argument, NULL, 'L' },
+		{ "num_pkt", required_argument, NULL, 'n' },
+		{ "egress", required_argument, NULL, 'e' },
+		{ "shaper", required_argument, NULL, 's' },
+		{ "queue_shaper", required_argument, NULL, 'S' },
+		{ "shaper_burst", required_argument, NULL, 'B' },
+		{ "num_prio", required_argument, NULL, 'p' },
+		{ "max_weight", required_argument, NULL, 'w' },
+		{ "wrr", no_argument, NULL, 'r' },
+		{ "threshold", required_argument, NULL, 'T' },
+		{ "wred", required_argument, NULL, 'W' },
+		{ "time", required_argument, NULL, 't' },
+		{ "interval", required_argument, NULL, 'i' },
+		{ "help", no_argument, NULL, 'h' },
+		{ NULL, 0, NULL, 0 }
+	};
+
+	static const char *shortopts = "+c:l:f:q:b:L:n:e:s:S:B:p:w:rT:W:t:i:h";
+
+	test_options->num_cpu = 1;
+	test_options->num_level = 2;
+	test_options->fanout = 4;
+	test_options->queues_per_leaf = 4;
+	test_options->burst = 8;
+	test_options->pkt_len = 64;
+	test_options->num_pkt = 8192;
+	test_options->egress = EGRESS_NULL;
+	test_options->shaper_rate = 0;
+	test_options->queue_shaper_rate = 0;
+	test_options->shaper_burst = 80000;
+	test_options->num_prio = 1;
+	test_options->max_weight = 1;
+	test_options->wrr = 0;
+	test_options->threshold = 0;
+	test_options->wred_drop = 0;
+	test_options->duration = 1;
+	test_options->interval_ns = 0;
+
+	while (1) {
+		opt = getopt_long(argc, argv, shortopts, longopts, NULL);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'c':
+			test_options->num_cpu = atoi(optarg);
+			break;
+		case 'l':
+			test_options->num_level = atoi(optarg);
+			break;
+		case 'f':
+			test_options->fanout = atoi(optarg);
+			break;
+		case 'q':
+			test_options->queues_per_leaf = atoi(optarg);
+			break;
+		case 'b':
+			test_options->burst = atoi(optarg);
+			break;
+		case 'L':
+			test_options->pkt_len = atoi(optarg);
+			break;
+		case 'n':
+			test_options->num_pkt = atoi(optarg);
+			break;
+		case 'e':
+			test_options->egress = atoi(optarg);
+			break;
+		case 's':
+			test_options->shaper_rate = strtoull(optarg, NULL, 0);
+			break;
+		case 'S':
+			test_options->queue_shaper_rate = strtoull(optarg, NULL, 0);
+			break;
+		case 'B':
+			test_options->shaper_burst = atoi(optarg);
+			break;
+		case 'p':
+			test_options->num_prio = atoi(optarg);
+			break;
+		case 'w':
+			test_options->max_weight = atoi(optarg);
+			break;
+		case 'r':
+			test_options->wrr = 1;
+			break;
+		case 'T':
+			test_options->threshold = atoi(optarg);
+			break;
+		case 'W':
+			test_options->wred_drop = atoi(optarg);
+			break;
+		case 't':
+			test_options->duration = atoi(optarg);
+			break;
+		case 'i':
+			test_options->interval_ns = strtoull(optarg, NULL, 0);
+			break;
+		case 'h':
+			/* fall through */
+		default:
+			print_usage();
+			ret = -1;
+			break;
+		}
+	}
+
+	if (ret)
+		return ret;
+
+	if (test_options->num_level == 0 || test_options->num_level > ODP_TM_MAX_LEVELS) {
+		ODPH_ERR("Bad number of levels %u. Max %u.\n", test_options->num_level,
+			 ODP_TM_MAX_LEVELS);
+		return -1;
+	}
+
+	if (test_options->fanout == 0 || test_options->queues_per_leaf == 0) {
+		ODPH_ERR("Fan-out and number of queues must be at least 1\n");
+		return -1;
+	}
+
+	if (test_options->burst == 0 || test_options->burst > MAX_BURST) {
+		ODPH_ERR("Bad burst size %u. Max %u.\n", test_options->burst, MAX_BURST);
+		return -1;
+	}
+
+	if (test_options->pkt_len < MIN_PKT_LEN) {
+		ODPH_ERR("Too short packet length %u. Min %u.\n", test_options->pkt_len,
+			 (uint32_t)MIN_PKT_LEN);
+		return -1;
+	}
+
+	if (test_options->egress > EGRESS_FN) {
+		ODPH_ERR("Bad egress mode %u\n", test_options->egress);
+		return -1;
+	}
+
+	if (test_options->num_prio == 0 || test_options->num_prio > ODP_TM_MAX_PRIORITIES) {
+		ODPH_ERR("Bad number of priorities %u. Max %u.\n", test_options->num_prio,
+			 ODP_TM_MAX_PRIORITIES);
+		return -1;
+	}
+
+	if (test_options->max_weight == 0 || test_options->max_weight > MAX_WEIGHTS) {
+		ODPH_ERR("Bad max weight %u. Max %u.\n", test_options->max_weight, MAX_WEIGHTS);
+		return -1;
+	}
+
+	if (test_options->wred_drop > 100) {
+		ODPH_ERR("Bad WRED drop probability %u%%\n", test_options->wred_drop);
+		return -1;
+	}
+
+	if (test_options->wred_drop && test_options->threshold == 0) {
+		ODPH_ERR("WRED requires queue threshold (-T)\n");
+		return -1;
+	}
+
+	if (test_options->duration == 0) {
+		ODPH_ERR("Test duration must be at least 1 second\n");
+		return -1;
+	}
+
+	/* Level 0 has the root node, each level below multiplies node count by fan-out */
+	nodes = 1;
+	test_options->num_node = 0;
+
+	for (i = 0; i < test_options->num_level; i++) {
+		test_options->level_first[i] = test_options->num_node;
+		test_options->level_nodes[i] = nodes;
+		test_options->num_node += nodes;
+
+		if (test_options->num_node > MAX_NODES) {
+			ODPH_ERR("Too many TM nodes. Max %u.\n", MAX_NODES);
+			return -1;
+		}
+
+		nodes *= test_options->fanout;
+	}
+
+	test_options->num_queue = test_options->level_nodes[test_options->num_level - 1] *
+				  test_options->queues_per_leaf;
+
+	if (test_options->num_queue > MAX_QUEUES) {
+		ODPH_ERR("Too many TM queues %u. Max %u.\n", test_options->num_queue, MAX_QUEUES);
+		return -1;
+	}
+
+	return 0;
+}
+
+static void record_latency(test_global_t *global, odp_packet_t pkt, uint64_t now)
+{
+	egress_stat_t *egress = &global->egress;
+	uint64_t ts, lat;
+
+	/* Only the measurement period is taken into account */
+	if (odp_atomic_load_u32(&global->exit_test))
+		return;
+
+	if (odp_packet_copy_to_mem(pkt, TS_OFFSET, sizeof(ts), &ts))
+		return;
+
+	lat = now > ts ? now - ts : 0;
+
+	egress->num_lat++;
+	egress->lat_sum += lat;
+
+	if (lat < egress->lat_min)
+		egress->lat_min = lat;
+
+	if (lat > egress->lat_max)
+		egress->lat_max = lat;
+}
+
+static void egress_fn(odp_packet_t pkt)
+{
+	record_latency(test_global, pkt, odp_time_global_strict_ns());
+	odp_packet_free(pkt);
+}
+
+static int open_egress(test_global_t *global)
+{
+	odp_pool_capability_t pool_capa;
+	odp_pool_param_t pool_param;
+	odp_pktio_param_t pktio_param;
+	test_options_t *test_options = &global->options;
+	const char *dev;
+
+	if (odp_pool_capability(&pool_capa)) {
+		ODPH_ERR("Pool capability failed\n");
+		return -1;
+	}
+
+	if (pool_capa.pkt.max_num && test_options->num_pkt > pool_capa.pkt.max_num) {
+		ODPH_ERR("Too many packets %u. Max %u.\n", test_options->num_pkt,
+			 pool_capa.pkt.max_num);
+		return -1;
+	}
+
+	if (pool_capa.pkt.max_len && test_options->pkt_len > pool_capa.pkt.max_len) {
+		ODPH_ERR("Too long packets %u. Max %u.\n", test_options->pkt_len,
+			 pool_capa.pkt.max_len);
+		return -1;
+	}
+
+	odp_pool_param_init(&pool_param);
+	pool_param.type = ODP_POOL_PACKET;
+	pool_param.pkt.num = test_options->num_pkt;
+	pool_param.pkt.len = test_options->pkt_len;
+	pool_param.pkt.max_len = test_options->pkt_len;
+
+	global->pool = odp_pool_create("tm_perf_pool", &pool_param);
+	if (global->pool == ODP_POOL_INVALID) {
+		ODPH_ERR("Pool create failed\n");
+		return -1;
+	}
+
+	if (test_options->egress == EGRESS_FN)
+		return 0;
+
+	dev = test_options->egress == EGRESS_LOOP ? "loop" : "null:0";
+
+	odp_pktio_param_init(&pktio_param);
+	pktio_param.in_mode = test_options->egress == EGRESS_LOOP ? ODP_PKTIN_MODE_DIRECT :
+								    ODP_PKTIN_MODE_DISABLED;
+	pktio_param.out_mode = ODP_PKTOUT_MODE_TM;
+
+	global->pktio = odp_pktio_open(dev, global->pool, &pktio_param);
+	if (global->pktio == ODP_PKTIO_INVALID) {
+		ODPH_ERR("Pktio open failed: %s\n", dev);
+		return -1;
+	}
+
+	if (test_options->egress == EGRESS_LOOP) {
+		if (odp_pktin_queue_config(global->pktio, NULL)) {
+			ODPH_ERR("Pktin queue config failed\n");
+			return -1;
+		}
+
+		if (odp_pktin_queue(global->pktio, &global->pktin, 1) != 1) {
+			ODPH_ERR("Pktin queue query failed\n");
+			return -1;
+		}
+	}
+
+	if (odp_pktio_start(global->pktio)) {
+		ODPH_ERR("Pktio start failed\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int check_capability(test_global_t *global, const odp_tm_capabilities_t *capa)
+{
+	test_options_t *test_options = &global->options;
+	uint32_t i, fanin;
+
+	if (capa->max_tm_queues == 0) {
+		ODPH_ERR("TM not supported by the egress\n");
+		return -1;
+	}
+
+	if (test_options->egress == EGRESS_FN && !capa->egress_fcn_supported) {
+		ODPH_ERR("TM egress function not supported\n");
+		return -1;
+	}
+
+	if (test_options->num_level > capa->max_levels) {
+		ODPH_ERR("Too many levels %u. Max %u.\n", test_options->num_level,
+			 capa->max_levels);
+		return -1;
+	}
+
+	if (test_options->num_queue > capa->max_tm_queues) {
+		ODPH_ERR("Too many TM queues %u. Max %u.\n", test_options->num_queue,
+			 capa->max_tm_queues);
+		return -1;
+	}
+
+	if (!capa->queue_stats.counter.packets) {
+		ODPH_ERR("TM queue packet statistics not supported\n");
+		return -1;
+	}
+
+	if (test_options->queue_shaper_rate && !capa->tm_queue_shaper_supported) {
+		ODPH_ERR("TM queue shaper not supported\n");
+		return -1;
+	}
+
+	if (test_options->threshold && !capa->tm_queue_threshold.packet) {
+		ODPH_ERR("TM queue packet threshold not supported\n");
+		return -1;
+	}
+
+	if (test_options->wred_drop && !capa->tm_queue_wred_supported) {
+		ODPH_ERR("TM queue WRED not supported\n");
+		return -1;
+	}
+
+	for (i = 0; i < test_options->num_level; i++) {
+		const odp_tm_level_capabilities_t *level = &capa->per_level[i];
+
+		fanin = i == test_options->num_level - 1 ? test_options->queues_per_leaf :
+							   test_options->fanout;
+
+		if (test_options->level_nodes[i] > level->max_num_tm_nodes) {
+			ODPH_ERR("Too many TM nodes on level %u. Max %u.\n", i,
+				 level->max_num_tm_nodes);
+			return -1;
+		}
+
+		if (fanin > level->max_fanin_per_node) {
+			ODPH_ERR("Too large fan-in on level %u. Max %u.\n", i,
+				 level->max_fanin_per_node);
+			return -1;
+		}
+
+		if (test_options->num_prio - 1 > level->max_priority) {
+			ODPH_ERR("Too many priorities on level %u. Max %u.\n", i,
+				 level->max_priority + 1);
+			return -1;
+		}
+
+		if (test_options->max_weight > 1 &&
+		    (!level->weights_supported || test_options->max_weight > level->max_weight)) {
+			ODPH_ERR("Weights up to %u not supported on level %u\n",
+				 test_options->max_weight, i);
+			return -1;
+		}
+	}
+
+	if (test_options->shaper_rate && !capa->per_level[0].tm_node_shaper_supported) {
+		ODPH_ERR("TM node shaper not supported\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int create_profiles(test_global_t *global)
+{
+	odp_tm_shaper_params_t shaper_param;
+	odp_tm_sched_params_t sched_param;
+	odp_tm_threshold_params_t threshold_param;
+	odp_tm_wred_params_t wred_param;
+	odp_tm_sched_mode_t sched_mode;
+	test_options_t *test_options = &global->options;
+	uint32_t i, j;
+
+	if (test_options->shaper_rate || test_options->queue_shaper_rate) {
+		odp_tm_shaper_params_init(&shaper_param);
+		shaper_param.commit_burst = test_options->shaper_burst;
+
+		if (test_options->shaper_rate) {
+			shaper_param.commit_rate = test_options->shaper_rate;
+			global->shaper = odp_tm_shaper_create(NULL, &shaper_param);
+			if (global->shaper == ODP_TM_INVALID) {
+				ODPH_ERR("Shaper profile create failed\n");
+				return -1;
+			}
+		}
+
+		if (test_options->queue_shaper_rate) {
+			shaper_param.commit_rate = test_options->queue_shaper_rate;
+			global->queue_shaper = odp_tm_shaper_create(NULL, &shaper_param);
+			if (global->queue_shaper == ODP_TM_INVALID) {
+				ODPH_ERR("Queue shaper profile create failed\n");
+				return -1;
+			}
+		}
+	}
+
+	sched_mode = test_options->wrr ? ODP_TM_FRAME_BASED_WEIGHTS : ODP_TM_BYTE_BASED_WEIGHTS;
+
+	for (i = 0; i < test_options->max_weight; i++) {
+		odp_tm_sched_params_init(&sched_param);
+
+		for (j = 0; j < ODP_TM_MAX_PRIORITIES; j++) {
+			sched_param.sched_modes[j] = sched_mode;
+			sched_param.sched_weights[j] = i + 1;
+		}
+
+		global->sched[i] = odp_tm_sched_create(NULL, &sched_param);
+		if (global->sched[i] == ODP_TM_INVALID) {
+			ODPH_ERR("Scheduler profile create failed\n");
+			return -1;
+		}
+	}
+
+	if (test_options->threshold) {
+		odp_tm_threshold_params_init(&threshold_param);
+		threshold_param.max_pkts = test_options->threshold;
+		threshold_param.enable_max_pkts = true;
+
+		global->threshold = odp_tm_threshold_create(NULL, &threshold_param);
+		if (global->threshold == ODP_TM_INVALID) {
+			ODPH_ERR("Threshold profile create failed\n");
+			return -1;
+		}
+	}
+
+	if (test_options->wred_drop) {
+		/* Drop probability increases from zero at 50% fullness */
+		odp_tm_wred_params_init(&wred_param);
+		wred_param.min_threshold = 0;
+		wred_param.med_threshold = 5000;
+		wred_param.max_drop_prob = test_options->wred_drop * 100;
+		wred_param.enable_wred = true;
+
+		global->wred = odp_tm_wred_create(NULL, &wred_param);
+		if (global->wred == ODP_TM_INVALID) {
+			ODPH_ERR("WRED profile create failed\n");
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static int create_tm(test_global_t *global)
+{
+	odp_tm_requirements_t req;
+	odp_tm_egress_t egress;
+	odp_tm_capabilities_t capa;
+	odp_tm_node_params_t node_param;
+	odp_tm_queue_params_t queue_param;
+	odp_tm_sched_t sched;
+	test_options_t *test_options = &global->options;
+	uint32_t num_level = test_options->num_level;
+	uint32_t leaf_level = num_level - 1;
+	uint32_t fanout = test_options->fanout;
+	uint32_t qpl = test_options->queues_per_leaf;
+	uint32_t i, j, idx, parent, color;
+
+	printf("\nTM configuration\n");
+	printf("  num levels           %u\n", num_level);
+	printf("  fan-out              %u\n", fanout);
+	printf("  queues per leaf node %u\n", qpl);
+	printf("  num TM nodes         %u\n", test_options->num_node);
+	printf("  num TM queues        %u\n", test_options->num_queue);
+	printf("  num priorities       %u\n", test_options->num_prio);
+	printf("  max weight           %u (%s)\n", test_options->max_weight,
+	       test_options->wrr ? "WRR" : "WFQ");
+	printf("  root shaper          %" PRIu64 " bps\n", test_options->shaper_rate);
+	printf("  queue shaper         %" PRIu64 " bps\n", test_options->queue_shaper_rate);
+	printf("  shaper burst         %u bits\n", test_options->shaper_burst);
+	printf("  queue threshold      %u pkts\n", test_options->threshold);
+	printf("  WRED max drop        %u %%\n", test_options->wred_drop);
+	printf("  egress               %s\n", test_options->egress == EGRESS_NULL ? "null pktio" :
+	       test_options->egress == EGRESS_LOOP ? "loop pktio" : "function");
+	printf("  packet length        %u bytes\n", test_options->pkt_len);
+	printf("  num packets          %u\n", test_options->num_pkt);
+	printf("  burst size           %u\n", test_options->burst);
+	printf("  enqueue interval     %" PRIu64 " nsec\n", test_options->interval_ns);
+	printf("  duration             %u sec\n", test_options->duration);
+
+	odp_tm_egress_init(&egress);
+
+	if (test_options->egress == EGRESS_FN) {
+		egress.egress_kind = ODP_TM_EGRESS_FN;
+		egress.egress_fcn = egress_fn;
+	} else {
+		egress.egress_kind = ODP_TM_EGRESS_PKT_IO;
+		egress.pktio = global->pktio;
+	}
+
+	if (odp_tm_egress_capabilities(&capa, &egress)) {
+		ODPH_ERR("TM egress capability failed\n");
+		return -1;
+	}
+
+	if (check_capability(global, &capa))
+		return -1;
+
+	odp_tm_requirements_init(&req);
+	req.max_tm_queues = test_options->num_queue;
+	req.num_levels = num_level;
+	req.tm_queue_shaper_needed = test_options->queue_shaper_rate ? true : false;
+	req.tm_queue_threshold_needed = test_options->threshold ? true : false;
+	req.tm_queue_wred_needed = test_options->wred_drop ? true : false;
+
+	for (i = 0; i < num_level; i++) {
+		odp_tm_level_requirements_t *level = &req.per_level[i];
+
+		level->max_num_tm_nodes = test_options->level_nodes[i];
+		level->max_fanin_per_node = i == leaf_level ? qpl : fanout;
+		level->max_priority = test_options->num_prio - 1;
+		level->min_weight = 1;
+		level->max_weight = test_options->max_weight;
+		level->tm_node_shaper_needed = (i == 0 && test_options->shaper_rate) ? true : false;
+		level->fair_queuing_needed = true;
+		level->weights_needed = test_options->max_weight > 1 ? true : false;
+	}
+
+	global->tm = odp_tm_create("tm_perf", &req, &egress);
+	if (global->tm == ODP_TM_INVALID) {
+		ODPH_ERR("TM create failed\n");
+		return -1;
+	}
+
+	if (create_profiles(global))
+		return -1;
+
+	/* Nodes are stored level by level, root node first */
+	for (i = 0; i < num_level; i++) {
+		for (j = 0; j < test_options->level_nodes[i]; j++) {
+			idx = test_options->level_first[i] + j;
+
+			odp_tm_node_params_init(&node_param);
+			node_param.max_fanin = i == leaf_level ? qpl : fanout;
+			node_param.level = i;
+
+			if (i == 0 && test_options->shaper_rate)
+				node_param.shaper_profile = global->shaper;
+
+			global->node[idx] = odp_tm_node_create(global->tm, NULL, &node_param);
+			if (global->node[idx] == ODP_TM_INVALID) {
+				ODPH_ERR("TM node create failed (level %u, node %u)\n", i, j);
+				return -1;
+			}
+
+			if (i == 0) {
+				if (odp_tm_node_connect(global->node[idx], ODP_TM_ROOT)) {
+					ODPH_ERR("TM root node connect failed\n");
+					return -1;
+				}
+				continue;
+			}
+
+			parent = test_options->level_first[i - 1] + j / fanout;
+
+			if (odp_tm_node_connect(global->node[idx], global->node[parent])) {
+				ODPH_ERR("TM node connect failed (level %u, node %u)\n", i, j);
+				return -1;
+			}
+
+			sched = global->sched[(j % fanout) % test_options->max_weight];
+
+			if (odp_tm_node_sched_config(global->node[parent], global->node[idx],
+						     sched)) {
+				ODPH_ERR("TM node scheduler config failed\n");
+				return -1;
+			}
+		}
+	}
+
+	for (i = 0; i < test_options->num_queue; i++) {
+		parent = test_options->level_first[leaf_level] + i / qpl;
+
+		odp_tm_queue_params_init(&queue_param);
+		queue_param.priority = i % test_options->num_prio;
+		queue_param.ordered_enqueue = false;
+
+		if (test_options->queue_shaper_rate)
+			queue_param.shaper_profile = global->queue_shaper;
+
+		if (test_options->threshold)
+			queue_param.threshold_profile = global->threshold;
+
+		if (test_options->wred_drop) {
+			for (color = 0; color < ODP_NUM_PACKET_COLORS; color++)
+				queue_param.wred_profile[color] = global->wred;
+		}
+
+		global->queue[i] = odp_tm_queue_create(global->tm, &queue_param);
+		if (global->queue[i] == ODP_TM_INVALID) {
+			ODPH_ERR("TM queue create failed (%u)\n", i);
+			return -1;
+		}
+
+		if (odp_tm_queue_connect(global->queue[i], global->node[parent])) {
+			ODPH_ERR("TM queue connect failed (%u)\n", i);
+			return -1;
+		}
+
+		sched = global->sched[(i % qpl) % test_options->max_weight];
+
+		if (odp_tm_queue_sched_config(global->node[parent], global->queue[i], sched)) {
+			ODPH_ERR("TM queue scheduler config failed\n");
+			return -1;
+		}
+	}
+
+	if (odp_tm_start(global->tm)) {
+		ODPH_ERR("TM start failed\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static void remove_shapers(test_global_t *global)
+{
+	test_options_t *test_options = &global->options;
+	uint32_t i;
+
+	if (test_options->shaper_rate)
+		(void)odp_tm_node_shaper_config(global->node[0], ODP_TM_INVALID);
+
+	if (test_options->queue_shaper_rate) {
+		for (i = 0; i < test_options->num_queue; i++)
+			(void)odp_tm_queue_shaper_config(global->queue[i], ODP_TM_INVALID);
+	}
+}
+
+static int read_queue_stats(test_global_t *global, odp_tm_queue_stats_t *sum)
+{
+	odp_tm_queue_stats_t stats;
+	uint32_t i;
+
+	memset(sum, 0, sizeof(odp_tm_queue_stats_t));
+
+	for (i = 0; i < global->options.num_queue; i++) {
+		if (odp_tm_queue_stats(global->queue[i], &stats)) {
+			ODPH_ERR("TM queue stats read failed (%u)\n", i);
+			return -1;
+		}
+
+		sum->packets += stats.packets;
+		sum->discards += stats.discards;
+		sum->errors += stats.errors;
+	}
+
+	return 0;
+}
+
+static void receive_packets(test_global_t *global)
+{
+	odp_packet_t pkt[MAX_BURST];
+	uint64_t now;
+	int i, num;
+
+	num = odp_pktin_recv(global->pktin, pkt, MAX_BURST);
+	if (num <= 0)
+		return;
+
+	now = odp_time_global_strict_ns();
+
+	for (i = 0; i < num; i++)
+		record_latency(global, pkt[i], now);
+
+	odp_packet_free_multi(pkt, num);
+}
+
+/* Wait until all enqueued packets have left the TM system */
+static void drain_tm(test_global_t *global)
+{
+	test_options_t *test_options = &global->options;
+	odp_tm_queue_stats_t stats;
+	odp_time_t end;
+	uint64_t enq_pkts = 0;
+	int i;
+
+	for (i = 0; i < ODP_THREAD_COUNT_MAX; i++)
+		enq_pkts += global->stat[i].enq_pkts;
+
+	/* Let the backlog out at full speed */
+	remove_shapers(global);
+
+	end = odp_time_sum(odp_time_local(),
+			   odp_time_local_from_ns(DRAIN_TMO_SEC * ODP_TIME_SEC_IN_NS));
+
+	while (1) {
+		if (test_options->egress == EGRESS_LOOP)
+			receive_packets(global);
+		else
+			odp_time_wait_ns(ODP_TIME_MSEC_IN_NS);
+
+		if (read_queue_stats(global, &stats))
+			break;
+
+		if (stats.packets + stats.discards + stats.errors >= enq_pkts)
+			break;
+
+		if (odp_time_cmp(odp_time_local(), end) > 0) {
+			ODPH_ERR("TM drain timeout: %" PRIu64 " packets remain\n",
+				 enq_pkts - stats.packets - stats.discards - stats.errors);
+			break;
+		}
+	}
+
+	/* Packets may still be in the loop interface */
+	if (test_options->egress == EGRESS_LOOP) {
+		for (i = 0; i < 100; i++) {
+			receive_packets(global);
+			odp_time_wait_ns(ODP_TIME_USEC_IN_NS);
+		}
+	}
+}
+
+static int destroy_tm(test_global_t *global)
+{
+	test_options_t *test_options = &global->options;
+	uint32_t i, j, idx, parent, color;
+	uint32_t leaf_level = test_options->num_level - 1;
+	int ret = 0;
+
+	if (global->tm == ODP_TM_INVALID)
+		return 0;
+
+	if (odp_tm_stop(global->tm)) {
+		ODPH_ERR("TM stop failed\n");
+		ret = -1;
+	}
+
+	for (i = 0; i < test_options->num_queue; i++) {
+		if (global->queue[i] == ODP_TM_INVALID)
+			continue;
+
+		parent = test_options->level_first[leaf_level] + i / test_options->queues_per_leaf;
+
+		(void)odp_tm_queue_sched_config(global->node[parent], global->queue[i],
+						ODP_TM_INVALID);
+		(void)odp_tm_queue_disconnect(global->queue[i]);
+		(void)odp_tm_queue_shaper_config(global->queue[i], ODP_TM_INVALID);
+		(void)odp_tm_queue_threshold_config(global->queue[i], ODP_TM_INVALID);
+
+		for (color = 0; color < ODP_NUM_PACKET_COLORS; color++)
+			(void)odp_tm_queue_wred_config(global->queue[i], color, ODP_TM_INVALID);
+
+		if (odp_tm_queue_destroy(global->queue[i])) {
+			ODPH_ERR("TM queue destroy failed (%u)\n", i);
+			ret = -1;
+		}
+	}
+
+	/* Leaf level first */
+	for (i = test_options->num_level; i > 0; i--) {
+		for (j = 0; j < test_options->level_nodes[i - 1]; j++) {
+			idx = test_options->level_first[i - 1] + j;
+
+			if (global->node[idx] == ODP_TM_INVALID)
+				continue;
+
+			if (i > 1) {
+				parent = test_options->level_first[i - 2] +
+					 j / test_options->fanout;
+				(void)odp_tm_node_sched_config(global->node[parent],
+							       global->node[idx], ODP_TM_INVALID);
+			}
+
+			(void)odp_tm_node_disconnect(global->node[idx]);
+			(void)odp_tm_node_shaper_config(global->node[idx], ODP_TM_INVALID);
+
+			if (odp_tm_node_destroy(global->node[idx])) {
+				ODPH_ERR("TM node destroy failed (level %u, node %u)\n", i - 1, j);
+				ret = -1;
+			}
+		}
+	}
+
+	if (global->shaper != ODP_TM_INVALID && odp_tm_shaper_destroy(global->shaper)) {
+		ODPH_ERR("Shaper profile destroy failed\n");
+		ret = -1;
+	}
+
+	if (global->queue_shaper != ODP_TM_INVALID &&
+	    odp_tm_shaper_destroy(global->queue_shaper)) {
+		ODPH_ERR("Queue shaper profile destroy failed\n");
+		ret = -1;
+	}
+
+	for (i = 0; i < MAX_WEIGHTS; i++) {
+		if (global->sched[i] != ODP_TM_INVALID && odp_tm_sched_destroy(global->sched[i])) {
+			ODPH_ERR("Scheduler profile destroy failed\n");
+			ret = -1;
+		}
+	}
+
+	if (global->threshold != ODP_TM_INVALID && odp_tm_threshold_destroy(global->threshold)) {
+		ODPH_ERR("Threshold profile destroy failed\n");
+		ret = -1;
+	}
+
+	if (global->wred != ODP_TM_INVALID && odp_tm_wred_destroy(global->wred)) {
+		ODPH_ERR("WRED profile destroy failed\n");
+		ret = -1;
+	}
+
+	if (odp_tm_destroy(global->tm)) {
+		ODPH_ERR("TM destroy failed\n");
+		ret = -1;
+	}
+
+	return ret;
+}
+
+static int close_egress(test_global_t *global)
+{
+	int ret = 0;
+
+	if (global->pktio != ODP_PKTIO_INVALID) {
+		if (odp_pktio_stop(global->pktio)) {
+			ODPH_ERR("Pktio stop failed\n");
+			ret = -1;
+		}
+
+		if (odp_pktio_close(global->pktio)) {
+			ODPH_ERR("Pktio close failed\n");
+			ret = -1;
+		}
+	}
+
+	if (global->pool != ODP_POOL_INVALID && odp_pool_destroy(global->pool)) {
+		ODPH_ERR("Pool destroy failed\n");
+		ret = -1;
+	}
+
+	return ret;
+}
+
+static int run_test(void *arg)
+{
+	uint64_t c1, c2, ts;
+	odp_time_t t1, t2;
+	test_global_t *global = arg;
+	test_options_t *test_options = &global->options;
+	odp_pool_t pool = global->pool;
+	odp_packet_t pkt[MAX_BURST];
+	uint32_t pkt_len = test_options->pkt_len;
+	uint32_t num_queue = test_options->num_queue;
+	uint32_t burst = test_options->burst;
+	uint64_t interval_ns = test_options->interval_ns;
+	uint64_t enq_pkts = 0;
+	uint64_t enq_calls = 0;
+	uint64_t enq_drops = 0;
+	uint64_t alloc_fails = 0;
+	uint64_t enq_cycles = 0;
+	int thr = odp_thread_id();
+	test_stat_t *stat = &global->stat[thr];
+	uint32_t i, q;
+	int num, ret;
+
+	/* Producers start from different queues */
+	q = (thr * num_queue) / ODP_THREAD_COUNT_MAX;
+
+	/* Start all workers at the same time */
+	odp_barrier_wait(&global->barrier);
+
+	t1 = odp_time_local();
+
+	while (!odp_atomic_load_u32(&global->exit_test)) {
+		num = odp_packet_alloc_multi(pool, pkt_len, pkt, burst);
+
+		if (odp_unlikely(num <= 0)) {
+			alloc_fails++;
+			continue;
+		}
+
+		ts = odp_time_global_strict_ns();
+
+		for (i = 0; i < (uint32_t)num; i++) {
+			uint8_t *data = odp_packet_data(pkt[i]);
+
+			memcpy(data, global->hdr, ODPH_ETHHDR_LEN);
+			memcpy(data + TS_OFFSET, &ts, sizeof(ts));
+		}
+
+		c1 = odp_cpu_cycles();
+		ret = odp_tm_enq_multi(global->queue[q], pkt, num);
+		c2 = odp_cpu_cycles();
+
+		enq_cycles += odp_cpu_cycles_diff(c2, c1);
+		enq_calls++;
+
+		if (odp_unlikely(ret < 0))
+			ret = 0;
+
+		if (odp_unlikely(ret < num)) {
+			odp_packet_free_multi(&pkt[ret], num - ret);
+			enq_drops += num - ret;
+		}
+
+		enq_pkts += ret;
+
+		q++;
+		if (q == num_queue)
+			q = 0;
+
+		if (interval_ns)
+			odp_time_wait_ns(interval_ns);
+	}
+
+	t2 = odp_time_local();
+
+	stat->enq_pkts = enq_pkts;
+	stat->enq_calls = enq_calls;
+	stat->enq_drops = enq_drops;
+	stat->alloc_fails = alloc_fails;
+	stat->enq_cycles = enq_cycles;
+	stat->nsec = odp_time_diff_ns(t2, t1);
+
+	return 0;
+}
+
+static int start_workers(test_global_t *global)
+{
+	odph_thread_common_param_t thr_common;
+	odph_thread_param_t thr_param;
+	odp_cpumask_t cpumask;
+	int ret;
+	test_options_t *test_options = &global->options;
+	int num_cpu = test_options->num_cpu;
+
+	ret = odp_cpumask_default_worker(&cpumask, num_cpu);
+
+	if (num_cpu && ret != num_cpu) {
+		ODPH_ERR("Error: Too many workers. Max supported %i\n.", ret);
+		return -1;
+	}
+
+	/* Zero: all available workers */
+	if (num_cpu == 0) {
+		num_cpu = ret;
+		test_options->num_cpu = num_cpu;
+	}
+
+	printf("  num producers        %u\n\n", num_cpu);
+
+	/* Workers and the main thread */
+	odp_barrier_init(&global->barrier, num_cpu + 1);
+
+	odph_thread_common_param_init(&thr_common);
+	thr_common.instance = global->instance;
+	thr_common.cpumask = &cpumask;
+	thr_common.share_param = 1;
+
+	odph_thread_param_init(&thr_param);
+	thr_param.start = run_test;
+	thr_param.arg = global;
+	thr_param.thr_type = ODP_THREAD_WORKER;
+
+	if (odph_thread_create(global->thread_tbl, &thr_common, &thr_param,
+			       num_cpu) != num_cpu)
+		return -1;
+
+	return 0;
+}
+
+/* Main thread receives loop pktio packets or just waits while workers produce */
+static int run_main(test_global_t *global)
+{
+	test_options_t *test_options = &global->options;
+	odp_time_t t1, end;
+	int ret;
+
+	odp_barrier_wait(&global->barrier);
+
+	t1 = odp_time_local();
+	end = odp_time_sum(t1, odp_time_local_from_ns(test_options->duration *
+						      ODP_TIME_SEC_IN_NS));
+
+	while (odp_time_cmp(odp_time_local(), end) < 0) {
+		if (test_options->egress == EGRESS_LOOP)
+			receive_packets(global);
+		else
+			odp_time_wait_ns(ODP_TIME_MSEC_IN_NS);
+	}
+
+	ret = read_queue_stats(global, &global->queue_stats);
+	global->nsec = odp_time_diff_ns(odp_time_local(), t1);
+
+	odp_atomic_store_u32(&global->exit_test, 1);
+
+	return ret;
+}
+
+static int output_results(test_global_t *global)
+{
+	int i, num;
+	test_options_t *test_options = &global->options;
+	egress_stat_t *egress = &global->egress;
+	odp_tm_queue_stats_t *qs = &global->queue_stats;
+	int num_cpu = test_options->num_cpu;
+	uint64_t enq_pkts = 0;
+	uint64_t enq_calls = 0;
+	uint64_t enq_drops = 0;
+	uint64_t alloc_fails = 0;
+	uint64_t enq_cycles = 0;
+	uint64_t nsec_sum = 0;
+	double nsec_ave, enq_mpps, cycles_per_pkt, pkts_per_enq;
+	double egress_nsec, egress_mpps, egress_mbps;
+	double lat_ave = 0.0;
+	double expected_bps = 0.0, accuracy = 0.0;
+
+	for (i = 0; i < ODP_THREAD_COUNT_MAX; i++) {
+		enq_pkts += global->stat[i].enq_pkts;
+		enq_calls += global->stat[i].enq_calls;
+		enq_drops += global->stat[i].enq_drops;
+		alloc_fails += global->stat[i].alloc_fails;
+		enq_cycles += global->stat[i].enq_cycles;
+		nsec_sum += global->stat[i].nsec;
+	}
+
+	if (enq_calls == 0 || nsec_sum == 0) {
+		printf("No results.\n");
+		return 0;
+	}
+
+	nsec_ave = (double)nsec_sum / num_cpu;
+	enq_mpps = (1000.0 * enq_pkts) / nsec_ave;
+	cycles_per_pkt = enq_pkts ? (double)enq_cycles / enq_pkts : 0.0;
+	pkts_per_enq = (double)(enq_pkts + enq_drops) / enq_calls;
+
+	egress_nsec = (double)global->nsec;
+	egress_mpps = (1000.0 * qs->packets) / egress_nsec;
+	/* All packets are of the same length */
+	egress_mbps = (8000.0 * qs->packets * test_options->pkt_len) / egress_nsec;
+
+	if (egress->num_lat)
+		lat_ave = (double)egress->lat_sum / egress->num_lat;
+
+	/* The lowest configured shaper rate limits the egress rate */
+	if (test_options->queue_shaper_rate)
+		expected_bps = (double)test_options->queue_shaper_rate * test_options->num_queue;
+
+	if (test_options->shaper_rate &&
+	    (expected_bps == 0.0 || (double)test_options->shaper_rate < expected_bps))
+		expected_bps = (double)test_options->shaper_rate;
+
+	if (expected_bps > 0.0)
+		accuracy = (100.0 * 1000000.0 * egress_mbps) / expected_bps;
+
+	num = 0;
+
+	printf("RESULTS - per producer enqueue rate (Million pkts per sec):\n");
+	printf("-----------------------------------------------------------\n");
+	printf("        1      2      3      4      5      6      7      8      9     10");
+
+	for (i = 0; i < ODP_THREAD_COUNT_MAX; i++) {
+		if (global->stat[i].enq_calls) {
+			if ((num % 10) == 0)
+				printf("\n   ");
+
+			printf("%6.2f ", (1000.0 * global->stat[i].enq_pkts) /
+					 global->stat[i].nsec);
+			num++;
+		}
+	}
+	printf("\n\n");
+
+	printf("RESULTS - enqueue (%i producers):\n", num_cpu);
+	printf("------------------------------------\n");
+	printf("  duration:                 %.3f msec\n", nsec_ave / 1000000);
+	printf("  enqueued packets:         %" PRIu64 "\n", enq_pkts);
+	printf("  dropped on enqueue:       %" PRIu64 "\n", enq_drops);
+	printf("  packet alloc failures:    %" PRIu64 "\n", alloc_fails);
+	printf("  packets per enq call:     %.3f\n", pkts_per_enq);
+	printf("  cycles per enq packet:    %.3f\n", cycles_per_pkt);
+	printf("  TOTAL enqueue rate:       %.3f Mpps\n\n", enq_mpps);
+
+	printf("RESULTS - egress:\n");
+	printf("-----------------\n");
+	printf("  duration:                 %.3f msec\n", egress_nsec / 1000000);
+	printf("  packets:                  %" PRIu64 "\n", qs->packets);
+	printf("  discards:                 %" PRIu64 "\n", qs->discards);
+	printf("  errors:                   %" PRIu64 "\n", qs->errors);
+	printf("  egress rate:              %.3f Mpps\n", egress_mpps);
+	printf("  egress rate:              %.3f Mbps\n", egress_mbps);
+
+	if (egress->num_lat) {
+		printf("  latency samples:          %" PRIu64 "\n", egress->num_lat);
+		printf("  latency min:              %" PRIu64 " nsec\n", egress->lat_min);
+		printf("  latency ave:              %.1f nsec\n", lat_ave);
+		printf("  latency max:              %" PRIu64 " nsec\n", egress->lat_max);
+	}
+
+	if (expected_bps > 0.0) {
+		printf("  shaper rate:              %.3f Mbps\n", expected_bps / 1000000.0);
+		printf("  shaping accuracy:         %.2f %%\n", accuracy);
+	}
+
+	printf("\n");
+
+	if (global->common_options.is_export) {
+		if (test_common_write("num levels,num queues,num producers,enqueue rate (Mpps),"
+				      "cycles per enq packet,dropped on enqueue,egress rate (Mpps),"
+				      "egress rate (Mbps),latency min (nsec),latency ave (nsec),"
+				      "latency max (nsec),"
+				      "shaper rate (Mbps),shaping accuracy (%%)\n")) {
+			ODPH_ERR("Export failed\n");
+			test_common_write_term();
+			return -1;
+		}
+
+		if (test_common_write("%u,%u,%i,%f,%f,%" PRIu64 ",%f,%f,%" PRIu64 ",%f,%" PRIu64
+				      ",%f,%f\n",
+				      test_options->num_level, test_options->num_queue, num_cpu,
+				      enq_mpps, cycles_per_pkt, enq_drops, egress_mpps, egress_mbps,
+				      egress->num_lat ? egress->lat_min : 0, lat_ave,
+				      egress->lat_max, expected_bps / 1000000.0,
+				      accuracy)) {
+			ODPH_ERR("Export failed\n");
+			test_common_write_term();
+			return -1;
+		}
+
+		test_common_write_term();
+	}
+
+	return 0;
+}
+
+static void init_global(test_global_t *global)
+{
+	odph_ethhdr_t *eth = (odph_ethhdr_t *)global->hdr;
+	uint32_t i;
+
+	memset(global, 0, sizeof(test_global_t));
+
+	odp_atomic_init_u32(&global->exit_test, 0);
+	global->pool = ODP_POOL_INVALID;
+	global->pktio = ODP_PKTIO_INVALID;
+	global->tm = ODP_TM_INVALID;
+	global->shaper = ODP_TM_INVALID;
+	global->queue_shaper = ODP_TM_INVALID;
+	global->threshold = ODP_TM_INVALID;
+	global->wred = ODP_TM_INVALID;
+
+	for (i = 0; i < MAX_WEIGHTS; i++)
+		global->sched[i] = ODP_TM_INVALID;
+
+	for (i = 0; i < MAX_NODES; i++)
+		global->node[i] = ODP_TM_INVALID;
+
+	for (i = 0; i < MAX_QUEUES; i++)
+		global->queue[i] = ODP_TM_INVALID;
+
+	eth->type = odp_cpu_to_be_16(TEST_ETHTYPE);
+	global->egress.lat_min = UINT64_MAX;
+}
+
+int main(int argc, char **argv)
+{
+	odph_helper_options_t helper_options;
+	odp_instance_t instance;
+	odp_init_t init;
+	odp_shm_t shm;
+	test_global_t *global;
+	test_common_options_t common_options;
+	int ret = 0;
+
+	/* Let helper collect its own arguments (e.g. --odph_proc) */
+	argc = odph_parse_options(argc, argv);
+	if (odph_options(&helper_options)) {
+		ODPH_ERR("Error: Reading ODP helper options failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	argc = test_common_parse_options(argc, argv);
+	if (test_common_options(&common_options)) {
+		ODPH_ERR("Error: Reading test options failed\n");
+		exit(EXIT_FAILURE);
+	}
+
+	/* List features not to be used */
+	odp_init_param_init(&init);
+	init.not_used.feat.cls = 1;
+	init.not_used.feat.compress = 1;
+	init.not_used.feat.crypto = 1;
+	init.not_used.feat.ipsec = 1;
+	init.not_used.feat.timer = 1;
+
+	init.mem_model = helper_options.mem_model;
+
+	/* Init ODP before calling anything else */
+	if (odp_init_global(&instance, &init, NULL)) {
+		ODPH_ERR("Error: Global init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	/* Init this thread */
+	if (odp_init_local(instance, ODP_THREAD_CONTROL)) {
+		ODPH_ERR("Error: Local init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	shm = odp_shm_reserve("tm_perf_global", sizeof(test_global_t),
+			      ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID) {
+		ODPH_ERR("Error: Shared mem reserve failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	global = odp_shm_addr(shm);
+	if (global == NULL) {
+		ODPH_ERR("Error: Shared mem alloc failed\n");
+		exit(EXIT_FAILURE);
+	}
+
+	init_global(global);
+	test_global = global;
+
+	global->common_options = common_options;
+
+	if (parse_options(argc, argv, &global->options))
+		exit(EXIT_FAILURE);
+
+	odp_sys_info_print();
+
+	global->instance = instance;
+
+	if (open_egress(global)) {
+		ODPH_ERR("Error: Open egress failed.\n");
+		ret = -1;
+		goto destroy;
+	}
+
+	if (create_tm(global)) {
+		ODPH_ERR("Error: Create TM failed.\n");
+		ret = -1;
+		goto destroy;
+	}
+
+	if (start_workers(global)) {
+		ODPH_ERR("Error: Test start failed.\n");
+		ret = -1;
+		goto destroy;
+	}
+
+	if (run_main(global))
+		ret = -1;
+
+	/* Wait workers to exit */
+	odph_thread_join(global->thread_tbl, global->options.num_cpu);
+
+	drain_tm(global);
+
+	if (output_results(global))
+		ret = -1;
+
+destroy:
+	if (destroy_tm(global)) {
+		ODPH_ERR("Error: Destroy TM failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (close_egress(global)) {
+		ODPH_ERR("Error: Close egress failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_shm_free(shm)) {
+		ODPH_ERR("Error: Shared mem free failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_local()) {
+		ODPH_ERR("Error: term local failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_global(instance)) {
+		ODPH_ERR("Error: term global failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	return ret;
+}
@@ -0,0 +1,42 @@
+#!/bin/sh
+#
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright (c) 2026 Nokia
+#
+
+TEST_DIR="${TEST_DIR:-$(dirname $0)}"
+
+echo odp_tm_perf: null pktio egress
+echo ===============================================
+
+$TEST_DIR/odp_tm_perf${EXEEXT} -e 0 -c 1 -l 3 -f 4 -q 4
+
+RET_VAL=$?
+if [ $RET_VAL -ne 0 ]; then
+	echo odp_tm_perf -e 0: FAILED
+	exit $RET_VAL
+fi
+
+echo odp_tm_perf: loop pktio egress
+echo ===============================================
+
+$TEST_DIR/odp_tm_perf${EXEEXT} -e 1 -c 1 -l 2 -p 2 -w 4 -T 64 -W 50
+
+RET_VAL=$?
+if [ $RET_VAL -ne 0 ]; then
+	echo odp_tm_perf -e 1: FAILED
+	exit $RET_VAL
+fi
+
+echo odp_tm_perf: shaped egress function
+echo ===============================================
+
+$TEST_DIR/odp_tm_perf${EXEEXT} -e 2 -c 1 -l 2 -s 100000000
+
+RET_VAL=$?
+if [ $RET_VAL -ne 0 ]; then
+	echo odp_tm_perf -e 2: FAILED
+	exit $RET_VAL
+fi
+
+exit 0
@@ -6,14 +6,21 @@
 #include "odp_classification_testsuites.h"
 #include "classification.h"
 #include <odp_cunit_common.h>
+#include <test_packet_ipv4.h>
 #include <odp/helper/odph_api.h>
 
+#include <stdlib.h>
+
 #define MAX_NUM_UDP 4
 #define MARK_IP     1
 #define MARK_UDP    2
 #define TEST_IPV4   false
 #define TEST_IPV6   true
 
+/* Outer UDP and inner TCP destination ports of the VXLAN test packet */
+#define VXLAN_OUTER_DPORT 4789
+#define VXLAN_INNER_DPORT 4321
+
 static odp_pool_t pkt_pool;
 /** sequence number of IP packets */
 static odp_atomic_u32_t seq;
@@ -1828,6 +1835,47 @@ static void cls_pmr_term_gtpu_teid(void)
 	test_pmr(&pmr_param, pkt, NO_MATCH);
 }
 
+static odp_packet_t create_vxlan_packet(void)
+{
+	odp_packet_t pkt;
+
+	pkt = odp_packet_alloc(pkt_pool, sizeof(test_packet_ipv4_vxlan_ipv4_tcp));
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+	CU_ASSERT_FATAL(odp_packet_copy_from_mem(pkt, 0, sizeof(test_packet_ipv4_vxlan_ipv4_tcp),
+						 test_packet_ipv4_vxlan_ipv4_tcp) == 0);
+
+	odp_packet_l2_offset_set(pkt, 0);
+	odp_packet_l3_offset_set(pkt, ODPH_ETHHDR_LEN);
+	odp_packet_has_ipv4_set(pkt, 1);
+
+	/* Sequence number overwrites the end of the inner TCP segment */
+	CU_ASSERT_FATAL(cls_pkt_set_seq(pkt) == 0);
+
+	return pkt;
+}
+
+static void test_pmr_tunnel_port(odp_cls_pmr_term_t term, uint16_t port, int match)
+{
+	uint16_t val = odp_cpu_to_be_16(port);
+	uint16_t mask = odp_cpu_to_be_16(0xffff);
+	odp_pmr_param_t pmr_param;
+
+	odp_cls_pmr_param_init(&pmr_param);
+	pmr_param.term = term;
+	pmr_param.match.value = &val;
+	pmr_param.match.mask = &mask;
+	pmr_param.val_sz = sizeof(val);
+
+	test_pmr(&pmr_param, create_vxlan_packet(), match ? MATCH : NO_MATCH);
+}
+
+/* Port terms match the inner TCP header of a VXLAN packet, not the outer UDP header */
+static void cls_pmr_term_tunnel_port(void)
+{
+	test_pmr_tunnel_port(ODP_PMR_TCP_DPORT, VXLAN_INNER_DPORT, 1);
+	test_pmr_tunnel_port(ODP_PMR_UDP_DPORT, VXLAN_OUTER_DPORT, 0);
+}
+
 static void cls_pmr_term_igmp_grpaddr(void)
 {
 	odp_packet_t pkt;
@@ -2081,6 +2129,16 @@ static int check_capa_ipsec_spi(void)
 	return cls_capa.supported_terms.bit.ipsec_spi;
 }
 
+static int check_capa_tunnel_port(void)
+{
+	/* Matching inner headers of tunneled packets is an implementation
+	 * specific configuration */
+	if (!getenv("ODP_CLS_TEST_INNER_PMR"))
+		return ODP_TEST_INACTIVE;
+
+	return cls_capa.supported_terms.bit.tcp_dport && cls_capa.supported_terms.bit.udp_dport;
+}
+
 static int check_capa_pmr_series(void)
 {
 	uint64_t support;
@@ -2146,6 +2204,7 @@ odp_testinfo_t classification_suite_pmr[] = {
 	ODP_TEST_INFO_CONDITIONAL(cls_pmr_term_udp_dport, check_capa_udp_dport),
 	ODP_TEST_INFO_CONDITIONAL(cls_pmr_term_udp_sport, check_capa_udp_sport),
 	ODP_TEST_INFO_CONDITIONAL(cls_pmr_term_gtpu_teid, check_capa_gtpu_teid),
+	ODP_TEST_INFO_CONDITIONAL(cls_pmr_term_tunnel_port, check_capa_tunnel_port),
 	ODP_TEST_INFO_CONDITIONAL(cls_pmr_term_igmp_grpaddr, check_capa_igmp_grpaddr),
 	ODP_TEST_INFO_CONDITIONAL(cls_pmr_term_sctp_sport, check_capa_sctp_sport),
 	ODP_TEST_INFO_CONDITIONAL(cls_pmr_term_sctp_dport, check_capa_sctp_dport),
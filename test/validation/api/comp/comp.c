@@ -11,6 +11,8 @@
 #define TEST_NUM_PKT  64
 #define TEST_PKT_LEN  (8 * 1024)
 
+#define TEST_BURST    8
+
 #define SEGMENTED_TEST_PKT_LEN  (16 * 1024)
 #define SEGMENTED_TEST_PATTERN  0xAA
 
@@ -415,6 +417,88 @@ static void comp_test_comp_decomp_alg_zlib_none(void)
 			     plaintext, PLAIN_TEXT_SIZE);
 }
 
+/* Compress a burst of packets with one call and decompress each one of those */
+static void comp_test_comp_decomp_burst_deflate_none(void)
+{
+	odp_comp_session_param_t ses_params;
+	odp_comp_packet_op_param_t op_params[TEST_BURST];
+	odp_comp_packet_result_t result;
+	odp_packet_t inpkt[TEST_BURST];
+	odp_packet_t outpkt[TEST_BURST];
+	odp_packet_t decomp_outpkt;
+	odp_comp_session_t session;
+	int i, num;
+
+	odp_comp_session_param_init(&ses_params);
+	ses_params.op = ODP_COMP_OP_COMPRESS;
+	ses_params.comp_algo = ODP_COMP_ALG_DEFLATE;
+	ses_params.hash_algo = ODP_COMP_HASH_ALG_NONE;
+	ses_params.compl_queue = suite_context.queue;
+	ses_params.mode = suite_context.op_mode;
+
+	session = odp_comp_session_create(&ses_params);
+	CU_ASSERT_FATAL(session != ODP_COMP_SESSION_INVALID);
+
+	for (i = 0; i < TEST_BURST; i++) {
+		inpkt[i] = odp_packet_alloc(suite_context.pool, PLAIN_TEXT_SIZE);
+		CU_ASSERT_FATAL(inpkt[i] != ODP_PACKET_INVALID);
+		CU_ASSERT_FATAL(!odp_packet_copy_from_mem(inpkt[i], 0, PLAIN_TEXT_SIZE,
+							  plaintext));
+
+		outpkt[i] = odp_packet_alloc(suite_context.pool, PLAIN_TEXT_SIZE);
+		CU_ASSERT_FATAL(outpkt[i] != ODP_PACKET_INVALID);
+
+		op_params[i].session = session;
+		op_params[i].in_data_range.offset = 0;
+		op_params[i].in_data_range.length = PLAIN_TEXT_SIZE;
+		op_params[i].out_data_range.offset = 0;
+		op_params[i].out_data_range.length = PLAIN_TEXT_SIZE;
+	}
+
+	if (suite_context.op_mode == ODP_COMP_OP_MODE_SYNC) {
+		num = odp_comp_op(inpkt, outpkt, TEST_BURST, op_params);
+		CU_ASSERT(num == TEST_BURST);
+	} else {
+		num = odp_comp_op_enq(inpkt, outpkt, TEST_BURST, op_params);
+		CU_ASSERT(num == TEST_BURST);
+
+		/* Completions may be in any order */
+		for (i = 0; i < num; i++) {
+			odp_event_t event;
+
+			do {
+				event = odp_queue_deq(suite_context.queue);
+			} while (event == ODP_EVENT_INVALID);
+
+			CU_ASSERT(odp_event_subtype(event) == ODP_EVENT_PACKET_COMP);
+		}
+	}
+
+	for (i = 0; i < TEST_BURST; i++) {
+		if (i < num) {
+			CU_ASSERT(!odp_comp_result(&result, outpkt[i]));
+			CU_ASSERT(result.status == ODP_COMP_STATUS_SUCCESS);
+			CU_ASSERT(result.pkt_in == inpkt[i]);
+
+			odp_packet_trunc_tail(&outpkt[i], odp_packet_len(outpkt[i]) -
+					      result.output_data_range.length, NULL, NULL);
+
+			decomp_outpkt = run_comp_op(ODP_COMP_OP_DECOMPRESS, ODP_COMP_ALG_DEFLATE,
+						    ODP_COMP_HASH_ALG_NONE, outpkt[i],
+						    PLAIN_TEXT_SIZE);
+			if (decomp_outpkt != ODP_PACKET_INVALID) {
+				packet_cmp(decomp_outpkt, plaintext, PLAIN_TEXT_SIZE);
+				odp_packet_free(decomp_outpkt);
+			}
+		}
+
+		odp_packet_free(outpkt[i]);
+		odp_packet_free(inpkt[i]);
+	}
+
+	CU_ASSERT(!odp_comp_session_destroy(session));
+}
+
 static int comp_suite_sync_init(void)
 {
 	suite_context.pool = odp_pool_lookup(COMP_PACKET_POOL);
@@ -452,6 +536,8 @@ static odp_testinfo_t comp_suite[] = {
 				  comp_check_deflate_none),
 	ODP_TEST_INFO_CONDITIONAL(comp_test_comp_decomp_alg_zlib_none,
 				  comp_check_zlib_none),
+	ODP_TEST_INFO_CONDITIONAL(comp_test_comp_decomp_burst_deflate_none,
+				  comp_check_deflate_none),
 	ODP_TEST_INFO_NULL,
 };
 
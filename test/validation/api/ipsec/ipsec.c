@@ -1010,7 +1010,7 @@ static int ipsec_send_out_one(const ipsec_test_part *part,
 	return num_out;
 }
 
-int ipsec_test_sa_update_seq_num(odp_ipsec_sa_t sa, uint32_t seq_num)
+int ipsec_test_sa_update_seq_num(odp_ipsec_sa_t sa, uint64_t seq_num)
 {
 	odp_ipsec_test_sa_operation_t sa_op;
 	odp_ipsec_test_sa_param_t sa_param;
@@ -128,7 +128,7 @@ int ipsec_check_out(const ipsec_test_part *part,
 		    odp_ipsec_sa_t sa,
 		    odp_packet_t *pkto);
 void ipsec_check_out_one(const ipsec_test_part *part, odp_ipsec_sa_t sa);
-int ipsec_test_sa_update_seq_num(odp_ipsec_sa_t sa, uint32_t seq_num);
+int ipsec_test_sa_update_seq_num(odp_ipsec_sa_t sa, uint64_t seq_num);
 void ipsec_test_packet_from_pkt(ipsec_test_packet *test_pkt, odp_packet_t *pkt);
 int ipsec_check(odp_bool_t ah,
 		odp_cipher_alg_t cipher,
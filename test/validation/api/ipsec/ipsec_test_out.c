@@ -1609,6 +1609,113 @@ static void test_test_sa_update_seq_num(void)
 	printf("\n  ");
 }
 
+static void out_in_seq_num(odp_ipsec_sa_t sa_out, odp_ipsec_sa_t sa_in,
+			   uint64_t seq_num, odp_bool_t replay)
+{
+	ipsec_test_part test_out = {
+		.pkt_in = &pkt_ipv4_icmp_0,
+		.num_pkt = 1,
+		.out = {
+			{ .status.warn.all = 0,
+			  .status.error.all = 0,
+			  .l3_type = ODP_PROTO_L3_TYPE_IPV4,
+			  .l4_type = ODP_PROTO_L4_TYPE_ESP,
+			},
+		},
+	};
+	ipsec_test_part test_in = {
+		.num_pkt = 1,
+		.out = {
+			{ .status.warn.all = 0,
+			  .status.error.all = 0,
+			  .l3_type = ODP_PROTO_L3_TYPE_IPV4,
+			  .l4_type = ODP_PROTO_L4_TYPE_ICMPV4,
+			  .pkt_res = &pkt_ipv4_icmp_0 },
+		},
+	};
+
+	if (replay) {
+		memset(&test_in.out[0], 0, sizeof(test_in.out[0]));
+		test_in.out[0].status.error.antireplay = 1;
+	}
+
+	CU_ASSERT_FATAL(ipsec_test_sa_update_seq_num(sa_out, seq_num) == 0);
+	ipsec_check_out_in_one(&test_out, &test_in, sa_out, sa_in, NULL);
+}
+
+/*
+ * Check the anti-replay window with extended sequence numbers above 2^36,
+ * where the lower 32 bits of the window bucket number no longer fit in a
+ * signed 32-bit distance from the initial bucket state.
+ */
+static void test_out_in_antireplay_esn_large_seq(void)
+{
+	odp_ipsec_sa_param_t param;
+	odp_ipsec_sa_info_t info;
+	odp_ipsec_sa_t sa_out;
+	odp_ipsec_sa_t sa_in;
+	uint64_t seq, top;
+	uint32_t ws;
+
+	ipsec_sa_param_fill(&param,
+			    ODP_IPSEC_DIR_OUTBOUND, ODP_IPSEC_ESP, 123, NULL,
+			    ODP_CIPHER_ALG_NULL, NULL,
+			    ODP_AUTH_ALG_SHA256_HMAC, &key_5a_256,
+			    NULL, NULL);
+	param.opt.esn = 1;
+	sa_out = odp_ipsec_sa_create(&param);
+	CU_ASSERT_FATAL(sa_out != ODP_IPSEC_SA_INVALID);
+
+	ipsec_sa_param_fill(&param,
+			    ODP_IPSEC_DIR_INBOUND, ODP_IPSEC_ESP, 123, NULL,
+			    ODP_CIPHER_ALG_NULL, NULL,
+			    ODP_AUTH_ALG_SHA256_HMAC, &key_5a_256,
+			    NULL, NULL);
+	param.opt.esn = 1;
+	ws = param.inbound.antireplay_ws;
+	sa_in = odp_ipsec_sa_create(&param);
+	CU_ASSERT_FATAL(sa_in != ODP_IPSEC_SA_INVALID);
+
+	/*
+	 * The receiver infers the upper 32 bits of the sequence number from
+	 * the window, so move the window over each 32-bit wrap in turn.
+	 */
+	for (seq = 0; seq < (1ull << 36); seq += 1ull << 32) {
+		out_in_seq_num(sa_out, sa_in, seq + 0x80000000, false);
+		out_in_seq_num(sa_out, sa_in, seq + (1ull << 32) + 1, false);
+	}
+
+	/* Touch every window bucket at least once past 2^36 */
+	top = seq + 1;
+	for (seq = top + 1; seq <= top + ws + 64; seq += 31)
+		out_in_seq_num(sa_out, sa_in, seq, false);
+	top = seq - 31;
+
+	memset(&info, 0, sizeof(info));
+	CU_ASSERT_FATAL(odp_ipsec_sa_info(sa_in, &info) == 0);
+	CU_ASSERT(info.inbound.antireplay_window_top == top);
+
+	/* Duplicates are dropped */
+	out_in_seq_num(sa_out, sa_in, top, true);
+	out_in_seq_num(sa_out, sa_in, top - 31, true);
+
+	/* Unseen sequence numbers inside the window are accepted */
+	out_in_seq_num(sa_out, sa_in, top - 1, false);
+	out_in_seq_num(sa_out, sa_in, top - ws + 1, false);
+	out_in_seq_num(sa_out, sa_in, top - 1, true);
+
+	ipsec_sa_destroy(sa_out);
+	ipsec_sa_destroy(sa_in);
+}
+
+static int ipsec_check_antireplay_esn_large_seq(void)
+{
+	if (ipsec_check_test_sa_update_seq_num() == ODP_TEST_INACTIVE)
+		return ODP_TEST_INACTIVE;
+
+	return ipsec_check_esp_null_sha256();
+}
+
 #define SOFT_LIMIT_PKT_CNT 1024
 #define HARD_LIMIT_PKT_CNT 2048
 #define DELTA_PKT_CNT 320
@@ -2054,6 +2161,8 @@ odp_testinfo_t ipsec_out_suite[] = {
 				  ipsec_check_esp_aes_cbc_128_sha1),
 	ODP_TEST_INFO_CONDITIONAL(test_test_sa_update_seq_num,
 				  ipsec_check_test_sa_update_seq_num),
+	ODP_TEST_INFO_CONDITIONAL(test_out_in_antireplay_esn_large_seq,
+				  ipsec_check_antireplay_esn_large_seq),
 	ODP_TEST_INFO(test_esp_out_in_all_basic),
 	ODP_TEST_INFO_CONDITIONAL(test_inline_hdr_in_packet,
 				  is_out_mode_inline),
@@ -27,6 +27,7 @@
 #define LSO_TEST_IPV4_FLAG_MF 0x2000 /* More fragments flag within the frag_offset field */
 #define LSO_TEST_IPV4_FLAG_DF 0x4000 /* Don't fragment flag within the frag_offset field */
 #define LSO_TEST_IPV4_FRAG_OFFS_MASK 0x1fff /* Fragment offset bits in the frag_offset field */
+#define LSO_TEST_IPV6_PKT_LEN (ODPH_ETHHDR_LEN + 1500) /* Length of TCP over IPv6 test packets */
 /* Segment number field value in the original packet. Nonzero to verify that the LSO operation
  * adds to the value instead of simply overwriting it. We use binary 10101010 bit pattern in the
  * most significant byte for testing overlapping write bits operations */
@@ -252,7 +253,7 @@ static odp_packet_t create_packet_for_pktio(const uint8_t *data, uint32_t len,
 
 static int send_packet(odp_lso_profile_t lso_profile, pktio_info_t *pktio,
 		       odp_packet_t pkt, uint32_t hdr_len, uint32_t max_payload,
-		       uint32_t l3_offset, int use_opt)
+		       uint32_t l3_offset, uint32_t l4_offset, int use_opt)
 {
 	int ret;
 	odp_packet_lso_opt_t lso_opt;
@@ -279,6 +280,9 @@ static int send_packet(odp_lso_profile_t lso_profile, pktio_info_t *pktio,
 	if (l3_offset)
 		odp_packet_l3_offset_set(pkt, l3_offset);
 
+	if (l4_offset)
+		odp_packet_l4_offset_set(pkt, l4_offset);
+
 	while (retries) {
 		ret = odp_pktout_send_lso(pktio->pktout, &pkt, 1, opt_ptr);
 
@@ -601,6 +605,60 @@ static int check_lso_ipv4_segs_3(void)
 	return check_lso_ipv4_segs(3);
 }
 
+static int check_lso_tcp_ipv4(void)
+{
+	if (pktio_a->capa.lso.max_profiles == 0 || pktio_a->capa.lso.max_profiles_per_pktio == 0)
+		return ODP_TEST_INACTIVE;
+
+	if (pktio_a->capa.lso.proto.tcp_ipv4 == 0)
+		return ODP_TEST_INACTIVE;
+
+	return ODP_TEST_ACTIVE;
+}
+
+static int check_lso_tcp_ipv4_segs_3(void)
+{
+	if (check_lso_tcp_ipv4() == ODP_TEST_INACTIVE)
+		return ODP_TEST_INACTIVE;
+
+	if (pktio_a->capa.lso.max_segments < 3)
+		return ODP_TEST_INACTIVE;
+
+	if (disable_restart && num_starts > 0)
+		return ODP_TEST_INACTIVE;
+
+	num_starts++;
+
+	return ODP_TEST_ACTIVE;
+}
+
+static int check_lso_tcp_ipv6(void)
+{
+	if (pktio_a->capa.lso.max_profiles == 0 || pktio_a->capa.lso.max_profiles_per_pktio == 0)
+		return ODP_TEST_INACTIVE;
+
+	if (pktio_a->capa.lso.proto.tcp_ipv6 == 0)
+		return ODP_TEST_INACTIVE;
+
+	return ODP_TEST_ACTIVE;
+}
+
+static int check_lso_tcp_ipv6_segs_3(void)
+{
+	if (check_lso_tcp_ipv6() == ODP_TEST_INACTIVE)
+		return ODP_TEST_INACTIVE;
+
+	if (pktio_a->capa.lso.max_segments < 3)
+		return ODP_TEST_INACTIVE;
+
+	if (disable_restart && num_starts > 0)
+		return ODP_TEST_INACTIVE;
+
+	num_starts++;
+
+	return ODP_TEST_ACTIVE;
+}
+
 static void lso_capability(void)
 {
 	/* LSO not supported when max_profiles is zero */
@@ -643,6 +701,34 @@ static void lso_create_ipv4_profile(void)
 	CU_ASSERT_FATAL(odp_lso_profile_destroy(profile) == 0);
 }
 
+static void lso_create_tcp_ipv4_profile(void)
+{
+	odp_lso_profile_param_t param;
+	odp_lso_profile_t profile;
+
+	odp_lso_profile_param_init(&param);
+	param.lso_proto = ODP_LSO_PROTO_TCP_IPV4;
+
+	profile = odp_lso_profile_create(pktio_a->hdl, &param);
+	CU_ASSERT_FATAL(profile != ODP_LSO_PROFILE_INVALID);
+
+	CU_ASSERT_FATAL(odp_lso_profile_destroy(profile) == 0);
+}
+
+static void lso_create_tcp_ipv6_profile(void)
+{
+	odp_lso_profile_param_t param;
+	odp_lso_profile_t profile;
+
+	odp_lso_profile_param_init(&param);
+	param.lso_proto = ODP_LSO_PROTO_TCP_IPV6;
+
+	profile = odp_lso_profile_create(pktio_a->hdl, &param);
+	CU_ASSERT_FATAL(profile != ODP_LSO_PROFILE_INVALID);
+
+	CU_ASSERT_FATAL(odp_lso_profile_destroy(profile) == 0);
+}
+
 static void lso_create_custom_profile(void)
 {
 	odp_lso_profile_param_t param_0, param_1;
@@ -754,7 +840,7 @@ static int send_marker(pktio_info_t *src, pktio_info_t *dst)
 
 static void lso_test(odp_lso_profile_param_t param, uint32_t max_payload,
 		     const uint8_t *test_packet, uint32_t pkt_len,
-		     uint32_t hdr_len, uint32_t l3_offset,
+		     uint32_t hdr_len, uint32_t l3_offset, uint32_t l4_offset,
 		     int use_opt,
 		     int (*is_test_pkt)(odp_packet_t),
 		     void (*update_hdr)(uint8_t *hdr, uint32_t hdr_len, odp_packet_t pkt,
@@ -785,7 +871,8 @@ static void lso_test(odp_lso_profile_param_t param, uint32_t max_payload,
 
 	CU_ASSERT(odp_packet_copy_to_mem(pkt, 0, hdr_len, orig_hdr) == 0);
 
-	ret = send_packet(profile, pktio_a, pkt, hdr_len, max_payload, l3_offset, use_opt);
+	ret = send_packet(profile, pktio_a, pkt, hdr_len, max_payload, l3_offset, l4_offset,
+			  use_opt);
 	CU_ASSERT_FATAL(ret == 0);
 	ret = send_marker(pktio_a, pktio_b);
 	CU_ASSERT_FATAL(ret == 0);
@@ -928,7 +1015,7 @@ static void lso_send_custom_eth(const uint8_t *test_packet, uint32_t pkt_len, ui
 		odp_lso_profile_param_init(&param);
 		param.lso_proto = ODP_LSO_PROTO_CUSTOM;
 		add_profile_param_custom_segnum(&param);
-		lso_test(param, max_payload, test_packet, pkt_len, hdr_len, l3_offset, use_opt,
+		lso_test(param, max_payload, test_packet, pkt_len, hdr_len, l3_offset, 0, use_opt,
 			 is_custom_eth_test_pkt,
 			 update_custom_hdr_segnum);
 	}
@@ -936,7 +1023,7 @@ static void lso_send_custom_eth(const uint8_t *test_packet, uint32_t pkt_len, ui
 		odp_lso_profile_param_init(&param);
 		param.lso_proto = ODP_LSO_PROTO_CUSTOM;
 		add_profile_param_custom_write_bits(&param);
-		lso_test(param, max_payload, test_packet, pkt_len, hdr_len, l3_offset, use_opt,
+		lso_test(param, max_payload, test_packet, pkt_len, hdr_len, l3_offset, 0, use_opt,
 			 is_custom_eth_test_pkt,
 			 update_custom_hdr_bits);
 	}
@@ -948,7 +1035,7 @@ static void lso_send_custom_eth(const uint8_t *test_packet, uint32_t pkt_len, ui
 		param.lso_proto = ODP_LSO_PROTO_CUSTOM;
 		add_profile_param_custom_segnum(&param);
 		add_profile_param_custom_write_bits(&param);
-		lso_test(param, max_payload, test_packet, pkt_len, hdr_len, l3_offset, use_opt,
+		lso_test(param, max_payload, test_packet, pkt_len, hdr_len, l3_offset, 0, use_opt,
 			 is_custom_eth_test_pkt,
 			 update_custom_hdr_segnum_bits);
 	}
@@ -1069,14 +1156,14 @@ static void lso_send_ipv4(const uint8_t *test_packet, uint32_t pkt_len, uint32_t
 	odp_lso_profile_param_init(&param);
 	param.lso_proto = ODP_LSO_PROTO_IPV4;
 
-	lso_test(param, max_payload, test_packet, pkt_len, hdr_len, l3_offset, use_opt,
+	lso_test(param, max_payload, test_packet, pkt_len, hdr_len, l3_offset, 0, use_opt,
 		 is_ipv4_test_pkt,
 		 update_ipv4_hdr);
 
 	/* Same test with DF set */
 	memcpy(pkt2, test_packet, pkt_len);
 	change_ipv4_frag_offset(&pkt2[l3_offset], LSO_TEST_IPV4_FLAG_DF, LSO_TEST_IPV4_FLAG_DF);
-	lso_test(param, max_payload, pkt2, pkt_len, hdr_len, l3_offset, use_opt,
+	lso_test(param, max_payload, pkt2, pkt_len, hdr_len, l3_offset, 0, use_opt,
 		 is_ipv4_test_pkt,
 		 update_ipv4_hdr);
 }
@@ -1134,9 +1221,246 @@ static void lso_send_ipv4_1500_700_opt(void)
 	lso_send_ipv4_udp_1500(700, 1);
 }
 
+static void update_tcp_ipv4_hdr(uint8_t *hdr, uint32_t hdr_len, odp_packet_t pkt,
+				uint16_t seg_num, uint16_t seg_offset, uint16_t num_segs)
+{
+	const uint32_t l3_offset = ODPH_ETHHDR_LEN;
+	const uint32_t l4_offset = l3_offset + ODPH_IPV4HDR_LEN;
+	uint32_t tcp_len = odp_packet_len(pkt) - l4_offset;
+	uint8_t buf[12 + tcp_len];
+	odph_ipv4hdr_t ip;
+	odph_tcphdr_t tcp;
+
+	CU_ASSERT(odp_packet_has_error(pkt) == 0);
+
+	memcpy(&ip, &hdr[l3_offset], sizeof(ip));
+	ip.tot_len = odp_cpu_to_be_16(odp_packet_len(pkt) - l3_offset);
+	ip.id = odp_cpu_to_be_16(odp_be_to_cpu_16(ip.id) + seg_num);
+	ip.chksum = 0;
+	ip.chksum = ~odp_chksum_ones_comp16(&ip, sizeof(ip));
+	memcpy(&hdr[l3_offset], &ip, sizeof(ip));
+
+	memcpy(&tcp, &hdr[l4_offset], sizeof(tcp));
+	tcp.seq_no = odp_cpu_to_be_32(odp_be_to_cpu_32(tcp.seq_no) + seg_offset);
+	if (seg_num < num_segs - 1) {
+		tcp.fin = 0;
+		tcp.psh = 0;
+	}
+	if (seg_num > 0)
+		tcp.cwr = 0;
+	tcp.cksm = 0;
+
+	/* Pseudo header, TCP header and payload */
+	memcpy(buf, &ip.src_addr, 8);
+	buf[8] = 0;
+	buf[9] = ODPH_IPPROTO_TCP;
+	buf[10] = tcp_len >> 8;
+	buf[11] = tcp_len & 0xff;
+	memcpy(&buf[12], &tcp, sizeof(tcp));
+	CU_ASSERT(odp_packet_copy_to_mem(pkt, hdr_len, tcp_len - sizeof(tcp),
+					 &buf[12 + sizeof(tcp)]) == 0);
+	tcp.cksm = ~odp_chksum_ones_comp16(buf, sizeof(buf));
+	memcpy(&hdr[l4_offset], &tcp, sizeof(tcp));
+}
+
+static void lso_send_tcp_ipv4(uint32_t max_payload, int use_opt)
+{
+	odp_lso_profile_param_t param;
+	const uint32_t pkt_len = sizeof(test_packet_ipv4_udp_1500);
+	const uint32_t l3_offset = ODPH_ETHHDR_LEN;
+	const uint32_t l4_offset = l3_offset + ODPH_IPV4HDR_LEN;
+	const uint32_t hdr_len = l4_offset + ODPH_TCPHDR_LEN;
+	uint8_t pkt[pkt_len];
+	odph_ipv4hdr_t ip;
+	odph_tcphdr_t tcp;
+
+	if (max_payload > pktio_a->capa.lso.max_payload_len)
+		max_payload = pktio_a->capa.lso.max_payload_len;
+
+	/* Convert the UDP test packet into a TCP packet of the same length */
+	memcpy(pkt, test_packet_ipv4_udp_1500, pkt_len);
+	memcpy(&ip, &pkt[l3_offset], sizeof(ip));
+	ip.proto = ODPH_IPPROTO_TCP;
+	ip.chksum = 0;
+	ip.chksum = ~odp_chksum_ones_comp16(&ip, sizeof(ip));
+	memcpy(&pkt[l3_offset], &ip, sizeof(ip));
+
+	memset(&tcp, 0, sizeof(tcp));
+	tcp.src_port = odp_cpu_to_be_16(0x3f);
+	tcp.dst_port = odp_cpu_to_be_16(0x3f);
+	tcp.seq_no = odp_cpu_to_be_32(0xfffffc00);
+	tcp.hl = ODPH_TCPHDR_LEN / 4;
+	tcp.ack = 1;
+	tcp.psh = 1;
+	tcp.fin = 1;
+	tcp.cwr = 1;
+	tcp.window = odp_cpu_to_be_16(0xffff);
+	memcpy(&pkt[l4_offset], &tcp, sizeof(tcp));
+
+	odp_lso_profile_param_init(&param);
+	param.lso_proto = ODP_LSO_PROTO_TCP_IPV4;
+
+	lso_test(param, max_payload, pkt, pkt_len, hdr_len, l3_offset, l4_offset, use_opt,
+		 is_ipv4_test_pkt,
+		 update_tcp_ipv4_hdr);
+}
+
+/* At least 3 segments: packet size 1500 bytes, LSO segment payload 700 bytes. Sequence number
+ * wraps around. */
+static void lso_send_tcp_ipv4_1500_700_pkt_meta(void)
+{
+	lso_send_tcp_ipv4(700, 0);
+}
+
+static void lso_send_tcp_ipv4_1500_700_opt(void)
+{
+	lso_send_tcp_ipv4(700, 1);
+}
+
+static const uint8_t tcp_ipv6_src_addr[ODPH_IPV6ADDR_LEN] = {
+	0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02
+};
+
+static const uint8_t tcp_ipv6_dst_addr[ODPH_IPV6ADDR_LEN] = {
+	0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01
+};
+
+/* Create a TCP over IPv6 test packet of LSO_TEST_IPV6_PKT_LEN bytes */
+static void create_tcp_ipv6_pkt(uint8_t *pkt)
+{
+	const uint32_t l3_offset = ODPH_ETHHDR_LEN;
+	const uint32_t l4_offset = l3_offset + ODPH_IPV6HDR_LEN;
+	odph_ethhdr_t eth;
+	odph_ipv6hdr_t ip;
+	odph_tcphdr_t tcp;
+
+	memset(&eth, 0, sizeof(eth));
+	eth.type = odp_cpu_to_be_16(ODPH_ETHTYPE_IPV6);
+	memcpy(pkt, &eth, sizeof(eth));
+
+	memset(&ip, 0, sizeof(ip));
+	ip.ver_tc_flow = odp_cpu_to_be_32(ODPH_IPV6 << ODPH_IPV6HDR_VERSION_SHIFT);
+	ip.payload_len = odp_cpu_to_be_16(LSO_TEST_IPV6_PKT_LEN - l3_offset - ODPH_IPV6HDR_LEN);
+	ip.next_hdr = ODPH_IPPROTO_TCP;
+	ip.hop_limit = 64;
+	memcpy(ip.src_addr, tcp_ipv6_src_addr, ODPH_IPV6ADDR_LEN);
+	memcpy(ip.dst_addr, tcp_ipv6_dst_addr, ODPH_IPV6ADDR_LEN);
+	memcpy(&pkt[l3_offset], &ip, sizeof(ip));
+
+	memset(&tcp, 0, sizeof(tcp));
+	tcp.src_port = odp_cpu_to_be_16(0x3f);
+	tcp.dst_port = odp_cpu_to_be_16(0x3f);
+	tcp.seq_no = odp_cpu_to_be_32(0xfffffc00);
+	tcp.hl = ODPH_TCPHDR_LEN / 4;
+	tcp.ack = 1;
+	tcp.psh = 1;
+	tcp.fin = 1;
+	tcp.cwr = 1;
+	tcp.window = odp_cpu_to_be_16(0xffff);
+	memcpy(&pkt[l4_offset], &tcp, sizeof(tcp));
+
+	for (uint32_t i = l4_offset + ODPH_TCPHDR_LEN; i < LSO_TEST_IPV6_PKT_LEN; i++)
+		pkt[i] = i;
+}
+
+static int is_ipv6_test_pkt(odp_packet_t pkt)
+{
+	uint32_t len;
+	odph_ipv6hdr_t *ip;
+
+	if (!odp_packet_has_ipv6(pkt))
+		return 0;
+
+	ip = odp_packet_l3_ptr(pkt, &len);
+
+	if (len < sizeof(*ip) ||
+	    memcmp(ip->src_addr, tcp_ipv6_src_addr, ODPH_IPV6ADDR_LEN) ||
+	    memcmp(ip->dst_addr, tcp_ipv6_dst_addr, ODPH_IPV6ADDR_LEN))
+		return 0;
+
+	return 1;
+}
+
+static void update_tcp_ipv6_hdr(uint8_t *hdr, uint32_t hdr_len, odp_packet_t pkt,
+				uint16_t seg_num, uint16_t seg_offset, uint16_t num_segs)
+{
+	const uint32_t l3_offset = ODPH_ETHHDR_LEN;
+	const uint32_t l4_offset = l3_offset + ODPH_IPV6HDR_LEN;
+	uint32_t tcp_len = odp_packet_len(pkt) - l4_offset;
+	uint8_t buf[40 + tcp_len];
+	odph_ipv6hdr_t ip;
+	odph_tcphdr_t tcp;
+
+	CU_ASSERT(odp_packet_has_error(pkt) == 0);
+
+	memcpy(&ip, &hdr[l3_offset], sizeof(ip));
+	ip.payload_len = odp_cpu_to_be_16(tcp_len);
+	memcpy(&hdr[l3_offset], &ip, sizeof(ip));
+
+	memcpy(&tcp, &hdr[l4_offset], sizeof(tcp));
+	tcp.seq_no = odp_cpu_to_be_32(odp_be_to_cpu_32(tcp.seq_no) + seg_offset);
+	if (seg_num < num_segs - 1) {
+		tcp.fin = 0;
+		tcp.psh = 0;
+	}
+	if (seg_num > 0)
+		tcp.cwr = 0;
+	tcp.cksm = 0;
+
+	/* Pseudo header, TCP header and payload */
+	memcpy(buf, ip.src_addr, 2 * ODPH_IPV6ADDR_LEN);
+	buf[32] = tcp_len >> 24;
+	buf[33] = (tcp_len >> 16) & 0xff;
+	buf[34] = (tcp_len >> 8) & 0xff;
+	buf[35] = tcp_len & 0xff;
+	buf[36] = 0;
+	buf[37] = 0;
+	buf[38] = 0;
+	buf[39] = ODPH_IPPROTO_TCP;
+	memcpy(&buf[40], &tcp, sizeof(tcp));
+	CU_ASSERT(odp_packet_copy_to_mem(pkt, hdr_len, tcp_len - sizeof(tcp),
+					 &buf[40 + sizeof(tcp)]) == 0);
+	tcp.cksm = ~odp_chksum_ones_comp16(buf, sizeof(buf));
+	memcpy(&hdr[l4_offset], &tcp, sizeof(tcp));
+}
+
+static void lso_send_tcp_ipv6(uint32_t max_payload, int use_opt)
+{
+	odp_lso_profile_param_t param;
+	const uint32_t l3_offset = ODPH_ETHHDR_LEN;
+	const uint32_t l4_offset = l3_offset + ODPH_IPV6HDR_LEN;
+	const uint32_t hdr_len = l4_offset + ODPH_TCPHDR_LEN;
+	uint8_t pkt[LSO_TEST_IPV6_PKT_LEN];
+
+	if (max_payload > pktio_a->capa.lso.max_payload_len)
+		max_payload = pktio_a->capa.lso.max_payload_len;
+
+	create_tcp_ipv6_pkt(pkt);
+
+	odp_lso_profile_param_init(&param);
+	param.lso_proto = ODP_LSO_PROTO_TCP_IPV6;
+
+	lso_test(param, max_payload, pkt, LSO_TEST_IPV6_PKT_LEN, hdr_len, l3_offset, l4_offset,
+		 use_opt, is_ipv6_test_pkt, update_tcp_ipv6_hdr);
+}
+
+/* At least 3 segments: packet size 1500 bytes, LSO segment payload 700 bytes. Sequence number
+ * wraps around. */
+static void lso_send_tcp_ipv6_1500_700_pkt_meta(void)
+{
+	lso_send_tcp_ipv6(700, 0);
+}
+
+static void lso_send_tcp_ipv6_1500_700_opt(void)
+{
+	lso_send_tcp_ipv6(700, 1);
+}
+
 odp_testinfo_t lso_suite[] = {
 	ODP_TEST_INFO(lso_capability),
 	ODP_TEST_INFO_CONDITIONAL(lso_create_ipv4_profile, check_lso_ipv4),
+	ODP_TEST_INFO_CONDITIONAL(lso_create_tcp_ipv4_profile, check_lso_tcp_ipv4),
+	ODP_TEST_INFO_CONDITIONAL(lso_create_tcp_ipv6_profile, check_lso_tcp_ipv6),
 	ODP_TEST_INFO_CONDITIONAL(lso_create_custom_profile, check_lso_custom_segnum),
 	ODP_TEST_INFO_CONDITIONAL(lso_send_ipv4_325_700_pkt_meta, check_lso_ipv4_segs_1),
 	ODP_TEST_INFO_CONDITIONAL(lso_send_ipv4_325_700_opt, check_lso_ipv4_segs_1),
@@ -1144,6 +1468,10 @@ odp_testinfo_t lso_suite[] = {
 	ODP_TEST_INFO_CONDITIONAL(lso_send_ipv4_1500_1000_opt, check_lso_ipv4_segs_2),
 	ODP_TEST_INFO_CONDITIONAL(lso_send_ipv4_1500_700_pkt_meta, check_lso_ipv4_segs_3),
 	ODP_TEST_INFO_CONDITIONAL(lso_send_ipv4_1500_700_opt, check_lso_ipv4_segs_3),
+	ODP_TEST_INFO_CONDITIONAL(lso_send_tcp_ipv4_1500_700_pkt_meta, check_lso_tcp_ipv4_segs_3),
+	ODP_TEST_INFO_CONDITIONAL(lso_send_tcp_ipv4_1500_700_opt, check_lso_tcp_ipv4_segs_3),
+	ODP_TEST_INFO_CONDITIONAL(lso_send_tcp_ipv6_1500_700_pkt_meta, check_lso_tcp_ipv6_segs_3),
+	ODP_TEST_INFO_CONDITIONAL(lso_send_tcp_ipv6_1500_700_opt, check_lso_tcp_ipv6_segs_3),
 	ODP_TEST_INFO_CONDITIONAL(lso_send_custom_eth_723_800_pkt_meta, check_lso_custom_segs_1),
 	ODP_TEST_INFO_CONDITIONAL(lso_send_custom_eth_723_800_opt, check_lso_custom_segs_1),
 	ODP_TEST_INFO_CONDITIONAL(lso_send_custom_eth_723_500_pkt_meta, check_lso_custom_segs_2),
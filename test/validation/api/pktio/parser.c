@@ -487,6 +487,417 @@ static void parser_test_ipv6_sctp(void)
 	odp_packet_free(pkt);
 }
 
+/* TCP segments of the burst test */
+#define TCP_BURST_NUM      10
+#define TCP_BURST_PAYLOAD  100
+#define TCP_BURST_HDR_LEN  (ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN + ODPH_TCPHDR_LEN)
+#define TCP_BURST_SEQ      0xfffffe00
+#define TCP_BURST_PORT     2000
+
+/* Flow and payload offset of burst segments. Flow 0 segments are in order up to the PSH
+ * segment. After that, one flow 0 segment is missing and flow 1 segments are in between. */
+static const struct {
+	uint8_t flow;
+	uint8_t psh;
+	uint32_t offset;
+} tcp_burst[TCP_BURST_NUM] = {
+	{0, 0, 0}, {0, 0, 100}, {0, 0, 200}, {0, 0, 300}, {0, 1, 400},
+	{0, 0, 500}, {0, 0, 700}, {1, 0, 0}, {1, 0, 100}, {0, 0, 800}
+};
+
+static uint8_t tcp_burst_data(uint32_t flow, uint32_t offset)
+{
+	return offset * 3 + flow * 101;
+}
+
+/* Partial checksum of IPv4 pseudo header, TCP header and payload */
+static uint16_t tcp_burst_chksum(odp_packet_t pkt)
+{
+	uint32_t tcp_len = odp_packet_len(pkt) - ODPH_ETHHDR_LEN - ODPH_IPV4HDR_LEN;
+	uint8_t buf[12 + tcp_len];
+	odph_ipv4hdr_t ip;
+
+	CU_ASSERT(odp_packet_copy_to_mem(pkt, ODPH_ETHHDR_LEN, sizeof(ip), &ip) == 0);
+	memcpy(buf, &ip.src_addr, 8);
+	buf[8] = 0;
+	buf[9] = ODPH_IPPROTO_TCP;
+	buf[10] = tcp_len >> 8;
+	buf[11] = tcp_len & 0xff;
+	CU_ASSERT(odp_packet_copy_to_mem(pkt, ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN, tcp_len,
+					 &buf[12]) == 0);
+
+	return odp_chksum_ones_comp16(buf, sizeof(buf));
+}
+
+static odp_packet_t tcp_burst_packet(int idx)
+{
+	uint8_t data[TCP_BURST_HDR_LEN + TCP_BURST_PAYLOAD];
+	odph_ethhdr_t eth;
+	odph_ipv4hdr_t ip;
+	odph_tcphdr_t tcp;
+	odp_packet_t pkt;
+
+	memset(&eth, 0, sizeof(eth));
+	eth.type = odp_cpu_to_be_16(ODPH_ETHTYPE_IPV4);
+	memcpy(data, &eth, sizeof(eth));
+
+	memset(&ip, 0, sizeof(ip));
+	ip.ver_ihl = (ODPH_IPV4 << 4) | (ODPH_IPV4HDR_LEN / 4);
+	ip.tot_len = odp_cpu_to_be_16(sizeof(data) - ODPH_ETHHDR_LEN);
+	ip.id = odp_cpu_to_be_16(idx);
+	ip.ttl = 64;
+	ip.proto = ODPH_IPPROTO_TCP;
+	ip.src_addr = odp_cpu_to_be_32(0xc0a80102);
+	ip.dst_addr = odp_cpu_to_be_32(0xc0a80101);
+	ip.chksum = ~odp_chksum_ones_comp16(&ip, sizeof(ip));
+	memcpy(&data[ODPH_ETHHDR_LEN], &ip, sizeof(ip));
+
+	memset(&tcp, 0, sizeof(tcp));
+	tcp.src_port = odp_cpu_to_be_16(1000 + tcp_burst[idx].flow);
+	tcp.dst_port = odp_cpu_to_be_16(TCP_BURST_PORT);
+	tcp.seq_no = odp_cpu_to_be_32(TCP_BURST_SEQ + tcp_burst[idx].offset);
+	tcp.ack_no = odp_cpu_to_be_32(1);
+	tcp.hl = ODPH_TCPHDR_LEN / 4;
+	tcp.ack = 1;
+	tcp.psh = tcp_burst[idx].psh;
+	tcp.window = odp_cpu_to_be_16(1000 + idx);
+	memcpy(&data[ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN], &tcp, sizeof(tcp));
+
+	for (uint32_t i = 0; i < TCP_BURST_PAYLOAD; i++)
+		data[TCP_BURST_HDR_LEN + i] = tcp_burst_data(tcp_burst[idx].flow,
+							     tcp_burst[idx].offset + i);
+
+	pkt = create_packet(data, sizeof(data));
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+
+	pktio_pkt_set_macs(pkt, pktio_a->hdl, pktio_b->hdl);
+
+	tcp.cksm = ~tcp_burst_chksum(pkt);
+	CU_ASSERT(odp_packet_copy_from_mem(pkt, ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN,
+					   sizeof(tcp), &tcp) == 0);
+
+	return pkt;
+}
+
+/* Index of the burst segment that starts at the offset */
+static int tcp_burst_index(uint32_t flow, uint32_t offset)
+{
+	for (int i = 0; i < TCP_BURST_NUM; i++) {
+		if (tcp_burst[i].flow == flow && tcp_burst[i].offset == offset)
+			return i;
+	}
+
+	return -1;
+}
+
+/* Check a received packet, which may contain multiple coalesced burst segments. Returns the
+ * number of segments, or 0 when the packet is not a burst test packet. */
+static int tcp_burst_check(odp_packet_t pkt, int received[])
+{
+	uint32_t len = odp_packet_len(pkt);
+	uint8_t payload[len];
+	odph_ipv4hdr_t ip;
+	odph_tcphdr_t tcp;
+	uint32_t flow, offset, payload_len;
+	int num, idx = -1;
+
+	if (!odp_packet_has_tcp(pkt) || len <= TCP_BURST_HDR_LEN)
+		return 0;
+
+	CU_ASSERT_FATAL(odp_packet_copy_to_mem(pkt, ODPH_ETHHDR_LEN, sizeof(ip), &ip) == 0);
+	CU_ASSERT_FATAL(odp_packet_copy_to_mem(pkt, ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN,
+					       sizeof(tcp), &tcp) == 0);
+
+	if (odp_be_to_cpu_16(tcp.dst_port) != TCP_BURST_PORT)
+		return 0;
+
+	CU_ASSERT(odp_packet_has_error(pkt) == 0);
+	CU_ASSERT(odp_be_to_cpu_16(ip.tot_len) == len - ODPH_ETHHDR_LEN);
+	CU_ASSERT(odp_chksum_ones_comp16(&ip, sizeof(ip)) == 0xffff);
+	CU_ASSERT(tcp_burst_chksum(pkt) == 0xffff);
+
+	flow = odp_be_to_cpu_16(tcp.src_port) - 1000;
+	offset = odp_be_to_cpu_32(tcp.seq_no) - TCP_BURST_SEQ;
+	payload_len = len - TCP_BURST_HDR_LEN;
+	CU_ASSERT_FATAL(flow < 2);
+	CU_ASSERT_FATAL(payload_len % TCP_BURST_PAYLOAD == 0);
+
+	/* Payload of consecutive segments of the same flow */
+	CU_ASSERT(odp_packet_copy_to_mem(pkt, TCP_BURST_HDR_LEN, payload_len, payload) == 0);
+	for (uint32_t i = 0; i < payload_len; i++)
+		CU_ASSERT(payload[i] == tcp_burst_data(flow, offset + i));
+
+	num = payload_len / TCP_BURST_PAYLOAD;
+	for (int i = 0; i < num; i++) {
+		int prev = idx;
+
+		idx = tcp_burst_index(flow, offset + i * TCP_BURST_PAYLOAD);
+		CU_ASSERT_FATAL(idx >= 0);
+		CU_ASSERT(idx > prev);
+		CU_ASSERT(received[idx] == 0);
+		received[idx] = 1;
+
+		/* Only the last segment may have the PSH flag */
+		if (i < num - 1)
+			CU_ASSERT(tcp_burst[idx].psh == 0);
+	}
+
+	/* Flags and window of the last segment */
+	CU_ASSERT(tcp.ack == 1);
+	CU_ASSERT(tcp.psh == tcp_burst[idx].psh);
+	CU_ASSERT(tcp.fin == 0 && tcp.syn == 0 && tcp.rst == 0);
+	CU_ASSERT(odp_be_to_cpu_16(tcp.window) == 1000 + idx);
+
+	return num;
+}
+
+/*
+ * Send a burst of TCP segments and check that all segments are received. An
+ * implementation may coalesce consecutive segments of a flow (e.g. software
+ * GRO), but not segments of different flows, segments that are out of order
+ * or segments that follow a PSH segment.
+ */
+static void parser_test_ipv4_tcp_burst(void)
+{
+	odp_packet_t pkt[TCP_BURST_NUM];
+	int received[TCP_BURST_NUM] = {0};
+	int num_pkt = 0, num_seg = 0, sent = 0;
+	odp_time_t end;
+
+	for (int i = 0; i < TCP_BURST_NUM; i++)
+		pkt[i] = tcp_burst_packet(i);
+
+	while (sent < TCP_BURST_NUM) {
+		int ret = odp_pktout_send(pktio_a->pktout, &pkt[sent], TCP_BURST_NUM - sent);
+
+		if (ret < 0) {
+			CU_FAIL("failed to send test packets");
+			odp_packet_free_multi(&pkt[sent], TCP_BURST_NUM - sent);
+			return;
+		}
+		sent += ret;
+	}
+
+	end = odp_time_sum(odp_time_local(), odp_time_local_from_ns(ODP_TIME_SEC_IN_NS));
+
+	while (num_seg < TCP_BURST_NUM && odp_time_cmp(end, odp_time_local()) > 0) {
+		int ret = odp_pktin_recv(pktio_b->pktin, pkt, TCP_BURST_NUM);
+
+		CU_ASSERT_FATAL(ret >= 0);
+
+		for (int i = 0; i < ret; i++) {
+			int num = tcp_burst_check(pkt[i], received);
+
+			if (num) {
+				num_pkt++;
+				num_seg += num;
+			}
+		}
+
+		if (ret > 0)
+			odp_packet_free_multi(pkt, ret);
+	}
+
+	CU_ASSERT(num_seg == TCP_BURST_NUM);
+
+	/* When segments are coalesced, the PSH segment and the missing segment
+	 * split flow 0 into three packets. Flow 1 results one packet. */
+	if (num_pkt < TCP_BURST_NUM)
+		CU_ASSERT(num_pkt == 4);
+}
+
+/* Frames of the mixed burst test */
+#define MIXED_BURST_PAD    4
+#define MIXED_BURST_MAX_LEN 256
+
+/* UDP checksum of a mixed burst frame */
+enum {
+	MIXED_CHKSUM_SET = 0,
+	MIXED_CHKSUM_ZERO
+};
+
+static const struct {
+	const uint8_t *data;
+	uint32_t len;
+	uint32_t pad;
+	uint8_t chksum;
+	uint8_t eth_mcast;
+	uint8_t l4_err;
+} mixed_burst[] = {
+	{ test_packet_ipv4_udp, sizeof(test_packet_ipv4_udp), 0, MIXED_CHKSUM_SET, 0, 0 },
+	/* Ethernet padding after the IP packet */
+	{ test_packet_ipv4_udp, sizeof(test_packet_ipv4_udp), MIXED_BURST_PAD, MIXED_CHKSUM_SET,
+	  0, 0 },
+	{ test_packet_ipv4_tcp, sizeof(test_packet_ipv4_tcp), 0, MIXED_CHKSUM_SET, 0, 0 },
+	{ test_packet_mcast_eth_ipv4_udp, sizeof(test_packet_mcast_eth_ipv4_udp), 0,
+	  MIXED_CHKSUM_SET, 1, 0 },
+	{ test_packet_ipv6_tcp, sizeof(test_packet_ipv6_tcp), 0, MIXED_CHKSUM_SET, 0, 0 },
+	{ test_packet_mcast_eth_ipv6_udp, sizeof(test_packet_mcast_eth_ipv6_udp), 0,
+	  MIXED_CHKSUM_SET, 1, 0 },
+	/* Zero UDP checksum is an error with IPv6 */
+	{ test_packet_ipv6_udp, sizeof(test_packet_ipv6_udp), 0, MIXED_CHKSUM_ZERO, 0, 1 },
+	/* VXLAN destination port, zero UDP checksum is valid with IPv4 */
+	{ test_packet_ipv4_vxlan_ipv4_tcp, sizeof(test_packet_ipv4_vxlan_ipv4_tcp), 0,
+	  MIXED_CHKSUM_ZERO, 0, 0 },
+	{ test_packet_ipv6_udp, sizeof(test_packet_ipv6_udp), 0, MIXED_CHKSUM_SET, 0, 0 },
+	{ test_packet_ipv4_udp, sizeof(test_packet_ipv4_udp), 0, MIXED_CHKSUM_SET, 0, 0 }
+};
+
+#define MIXED_BURST_NUM ODPH_ARRAY_SIZE(mixed_burst)
+
+static odp_packet_t mixed_burst_packet(int idx)
+{
+	uint8_t data[MIXED_BURST_MAX_LEN] = {0};
+	uint32_t len = mixed_burst[idx].len + mixed_burst[idx].pad;
+	odp_packet_parse_param_t param;
+	odp_packet_t pkt;
+
+	memcpy(data, mixed_burst[idx].data, mixed_burst[idx].len);
+	pkt = create_packet(data, len);
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+
+	memset(&param, 0, sizeof(param));
+	param.proto = ODP_PROTO_ETH;
+	param.last_layer = ODP_PROTO_LAYER_L4;
+	CU_ASSERT_FATAL(odp_packet_parse(pkt, 0, &param) == 0);
+
+	if (odp_packet_has_ipv4(pkt))
+		CU_ASSERT(odph_ipv4_csum_update(pkt) == 0);
+
+	if (mixed_burst[idx].chksum == MIXED_CHKSUM_ZERO) {
+		odph_udphdr_t *udp = odp_packet_l4_ptr(pkt, NULL);
+
+		udp->chksum = 0;
+	} else if (odp_packet_has_tcp(pkt)) {
+		CU_ASSERT(odph_tcp_chksum_set(pkt) == 0);
+	} else {
+		CU_ASSERT(odph_udp_chksum_set(pkt) == 0);
+	}
+
+	return pkt;
+}
+
+/* Compare input parse results to odp_packet_parse() results of the same data */
+static void mixed_burst_check(odp_packet_t pkt, odp_packet_t ref, int idx)
+{
+	odp_packet_parse_param_t param;
+
+	CU_ASSERT_FATAL(odp_packet_len(pkt) == odp_packet_len(ref));
+	CU_ASSERT(memcmp(odp_packet_data(pkt), odp_packet_data(ref), odp_packet_len(pkt)) == 0);
+
+	memset(&param, 0, sizeof(param));
+	param.proto = ODP_PROTO_ETH;
+	param.last_layer = ODP_PROTO_LAYER_ALL;
+	param.chksums.chksum.ipv4 = 1;
+	param.chksums.chksum.udp = 1;
+	param.chksums.chksum.tcp = 1;
+	/* Parsing may fail due to the checksum error, flags are set anyway */
+	if (odp_packet_parse(ref, 0, &param))
+		CU_ASSERT(mixed_burst[idx].l4_err);
+
+	CU_ASSERT(odp_packet_has_error(pkt) == odp_packet_has_error(ref));
+	CU_ASSERT(odp_packet_has_l3_error(pkt) == odp_packet_has_l3_error(ref));
+	CU_ASSERT(odp_packet_has_l4_error(pkt) == odp_packet_has_l4_error(ref));
+	CU_ASSERT(odp_packet_has_eth(pkt) == odp_packet_has_eth(ref));
+	CU_ASSERT(odp_packet_has_eth_mcast(pkt) == odp_packet_has_eth_mcast(ref));
+	CU_ASSERT(odp_packet_has_jumbo(pkt) == odp_packet_has_jumbo(ref));
+	CU_ASSERT(odp_packet_has_ipv4(pkt) == odp_packet_has_ipv4(ref));
+	CU_ASSERT(odp_packet_has_ipv6(pkt) == odp_packet_has_ipv6(ref));
+	CU_ASSERT(odp_packet_has_ip_mcast(pkt) == odp_packet_has_ip_mcast(ref));
+	CU_ASSERT(odp_packet_has_ipsec(pkt) == odp_packet_has_ipsec(ref));
+	CU_ASSERT(odp_packet_has_udp(pkt) == odp_packet_has_udp(ref));
+	CU_ASSERT(odp_packet_has_tcp(pkt) == odp_packet_has_tcp(ref));
+	CU_ASSERT(odp_packet_l2_offset(pkt) == odp_packet_l2_offset(ref));
+	CU_ASSERT(odp_packet_l3_offset(pkt) == odp_packet_l3_offset(ref));
+	CU_ASSERT(odp_packet_l4_offset(pkt) == odp_packet_l4_offset(ref));
+	CU_ASSERT(odp_packet_l3_chksum_status(pkt) == odp_packet_l3_chksum_status(ref));
+	CU_ASSERT(odp_packet_l4_chksum_status(pkt) == odp_packet_l4_chksum_status(ref));
+
+	CU_ASSERT(odp_packet_has_eth_mcast(pkt) == mixed_burst[idx].eth_mcast);
+	CU_ASSERT(!odp_packet_has_l3_error(pkt));
+	CU_ASSERT(odp_packet_has_l4_error(pkt) == mixed_burst[idx].l4_err);
+	CU_ASSERT(odp_packet_has_udp(pkt) || odp_packet_has_tcp(pkt));
+}
+
+/**
+ * Send a burst of different IPv4 and IPv6 frames and check that packet input
+ * parses each frame like odp_packet_parse() does. Input checksum checks are
+ * enabled. The burst mixes frames that the 'loop' interface parses in a fast
+ * burst parser with frames that it leaves to the full parser: Ethernet
+ * multicast, IPv6 UDP with zero checksum and VXLAN tunnel.
+ */
+static void parser_test_mixed_burst(void)
+{
+	odp_packet_t pkt[MIXED_BURST_NUM];
+	odp_packet_t ref[MIXED_BURST_NUM];
+	odp_pktio_param_t pktio_param;
+	odp_pktio_config_t config;
+	odp_pktin_queue_t pktin;
+	odp_pktout_queue_t pktout;
+	odp_pktio_t pktio;
+	odp_time_t end;
+	int num_rx = 0, sent = 0;
+
+	odp_pktio_param_init(&pktio_param);
+	pktio_param.in_mode = ODP_PKTIN_MODE_DIRECT;
+	pktio_param.out_mode = ODP_PKTOUT_MODE_DIRECT;
+
+	pktio = odp_pktio_open("loop1", parser_pool, &pktio_param);
+	CU_ASSERT_FATAL(pktio != ODP_PKTIO_INVALID);
+
+	odp_pktio_config_init(&config);
+	config.parser.layer = ODP_PROTO_LAYER_ALL;
+	config.pktin.bit.ipv4_chksum = 1;
+	config.pktin.bit.udp_chksum = 1;
+	config.pktin.bit.tcp_chksum = 1;
+	CU_ASSERT_FATAL(odp_pktio_config(pktio, &config) == 0);
+	CU_ASSERT_FATAL(odp_pktin_queue_config(pktio, NULL) == 0);
+	CU_ASSERT_FATAL(odp_pktout_queue_config(pktio, NULL) == 0);
+	CU_ASSERT_FATAL(odp_pktin_queue(pktio, &pktin, 1) == 1);
+	CU_ASSERT_FATAL(odp_pktout_queue(pktio, &pktout, 1) == 1);
+	CU_ASSERT_FATAL(odp_pktio_start(pktio) == 0);
+
+	for (uint32_t i = 0; i < MIXED_BURST_NUM; i++) {
+		pkt[i] = mixed_burst_packet(i);
+		ref[i] = odp_packet_copy(pkt[i], parser_pool);
+		CU_ASSERT_FATAL(ref[i] != ODP_PACKET_INVALID);
+	}
+
+	while (sent < (int)MIXED_BURST_NUM) {
+		int ret = odp_pktout_send(pktout, &pkt[sent], MIXED_BURST_NUM - sent);
+
+		if (ret < 0) {
+			CU_FAIL("failed to send test packets");
+			odp_packet_free_multi(&pkt[sent], MIXED_BURST_NUM - sent);
+			break;
+		}
+		sent += ret;
+	}
+
+	end = odp_time_sum(odp_time_local(), odp_time_local_from_ns(ODP_TIME_SEC_IN_NS));
+
+	while (num_rx < sent && odp_time_cmp(end, odp_time_local()) > 0) {
+		int ret = odp_pktin_recv(pktin, &pkt[num_rx], sent - num_rx);
+
+		CU_ASSERT_FATAL(ret >= 0);
+		num_rx += ret;
+	}
+
+	CU_ASSERT(num_rx == (int)MIXED_BURST_NUM);
+
+	/* Loopback interface keeps the packet order */
+	for (int i = 0; i < num_rx; i++) {
+		CU_ASSERT(odp_packet_input(pkt[i]) == pktio);
+		mixed_burst_check(pkt[i], ref[i], i);
+	}
+
+	odp_packet_free_multi(pkt, num_rx);
+	odp_packet_free_multi(ref, MIXED_BURST_NUM);
+
+	CU_ASSERT(odp_pktio_stop(pktio) == 0);
+	CU_ASSERT(odp_pktio_close(pktio) == 0);
+}
+
 int parser_suite_init(void)
 {
 	int i;
@@ -595,6 +1006,8 @@ odp_testinfo_t parser_suite[] = {
 	ODP_TEST_INFO(parser_test_ipv4_icmp),
 	ODP_TEST_INFO(parser_test_ipv4_tcp),
 	ODP_TEST_INFO(parser_test_ipv4_udp),
+	ODP_TEST_INFO_CONDITIONAL(parser_test_ipv4_tcp_burst, loop_pktio),
+	ODP_TEST_INFO_CONDITIONAL(parser_test_mixed_burst, loop_pktio),
 	ODP_TEST_INFO_CONDITIONAL(parser_test_vlan_ipv4_udp, loop_pktio),
 	ODP_TEST_INFO_CONDITIONAL(parser_test_vlan_qinq_ipv4_udp, loop_pktio),
 	ODP_TEST_INFO(parser_test_ipv4_sctp),
@@ -28,6 +28,8 @@
 #define TEST_SEQ_INVALID       ((uint32_t)~0)
 #define TEST_SEQ_MAGIC         0x92749451
 #define TX_BATCH_LEN           4
+#define RSS_SYM_FLOWS          16
+#define RSS_SYM_QUEUES         8
 #define PKTV_TX_BATCH_LEN      32
 #define PKTV_DEFAULT_SIZE      8
 #define MAX_QUEUES             128
@@ -1259,6 +1261,156 @@ static void pktio_test_recv_queue(void)
 	}
 }
 
+static int pktio_check_pktin_hash_sym(void)
+{
+	odp_pktio_t pktio;
+	odp_pktio_capability_t capa;
+	odp_pktio_param_t pktio_param;
+	int ret;
+
+	/* Symmetric RSS hash is an implementation specific configuration */
+	if (!getenv("ODP_PKTIO_TEST_RSS_SYMMETRIC"))
+		return ODP_TEST_INACTIVE;
+
+	odp_pktio_param_init(&pktio_param);
+	pktio_param.in_mode = ODP_PKTIN_MODE_DIRECT;
+
+	pktio = odp_pktio_open(iface_name[0], pool[0], &pktio_param);
+	if (pktio == ODP_PKTIO_INVALID)
+		return ODP_TEST_INACTIVE;
+
+	ret = odp_pktio_capability(pktio, &capa);
+	(void)odp_pktio_close(pktio);
+
+	if (ret < 0 || capa.max_input_queues < 2)
+		return ODP_TEST_INACTIVE;
+
+	return ODP_TEST_ACTIVE;
+}
+
+/* Set addresses and ports of a test packet, 'rev' selects the reverse direction of the flow */
+static void pktio_pkt_set_flow(odp_packet_t pkt, int flow, int rev)
+{
+	odph_ipv4hdr_t *ip = odp_packet_l3_ptr(pkt, NULL);
+	odph_udphdr_t *udp = odp_packet_l4_ptr(pkt, NULL);
+	uint32_t addr[2] = {0x0a000001 + flow, 0x0a000064};
+	uint16_t port[2] = {1024 + flow, 2048};
+	odp_packet_parse_param_t param;
+
+	ip->src_addr = odp_cpu_to_be_32(addr[rev]);
+	ip->dst_addr = odp_cpu_to_be_32(addr[!rev]);
+	udp->src_port = odp_cpu_to_be_16(port[rev]);
+	udp->dst_port = odp_cpu_to_be_16(port[!rev]);
+	CU_ASSERT(pktio_fixup_checksums(pkt) == 0);
+
+	memset(&param, 0, sizeof(param));
+	param.proto = ODP_PROTO_ETH;
+	param.last_layer = ODP_PROTO_LAYER_L4;
+	CU_ASSERT(odp_packet_parse(pkt, 0, &param) == 0);
+}
+
+/**
+ * Send packets of both directions of multiple UDP flows and check that both
+ * directions of a flow are received from the same input queue. Run when the
+ * implementation is configured for symmetric RSS hash.
+ */
+static void pktio_test_pktin_hash_sym(void)
+{
+	odp_pktio_t pktio_tx, pktio_rx;
+	odp_pktio_t pktio[MAX_NUM_IFACES] = {0};
+	odp_pktio_capability_t capa;
+	odp_pktin_queue_param_t in_queue_param;
+	odp_pktout_queue_t pktout_queue;
+	odp_pktin_queue_t pktin_queue[RSS_SYM_QUEUES];
+	odp_packet_t pkt_tbl[2 * RSS_SYM_FLOWS];
+	uint32_t pkt_seq[2 * RSS_SYM_FLOWS];
+	int rx_queue[2 * RSS_SYM_FLOWS];
+	uint32_t queue_mask = 0;
+	odp_time_t end;
+	int num_rx = 0;
+	int num_q, ret, i;
+
+	CU_ASSERT_FATAL(num_ifaces >= 1);
+
+	for (i = 0; i < num_ifaces; ++i) {
+		pktio[i] = create_pktio(i, ODP_PKTIN_MODE_DIRECT,
+					ODP_PKTOUT_MODE_DIRECT);
+		CU_ASSERT_FATAL(pktio[i] != ODP_PKTIO_INVALID);
+
+		CU_ASSERT_FATAL(odp_pktio_capability(pktio[i], &capa) == 0);
+
+		odp_pktin_queue_param_init(&in_queue_param);
+		in_queue_param.num_queues = ODPH_MIN(capa.max_input_queues, (uint32_t)RSS_SYM_QUEUES);
+		in_queue_param.hash_enable = 1;
+		in_queue_param.hash_proto.proto.ipv4_udp = 1;
+
+		CU_ASSERT_FATAL(odp_pktin_queue_config(pktio[i], &in_queue_param) == 0);
+		CU_ASSERT_FATAL(odp_pktio_start(pktio[i]) == 0);
+	}
+
+	for (i = 0; i < num_ifaces; ++i)
+		_pktio_wait_linkup(pktio[i]);
+
+	pktio_tx = pktio[0];
+	pktio_rx = (num_ifaces > 1) ? pktio[1] : pktio_tx;
+
+	ret = create_packets(pkt_tbl, pkt_seq, 2 * RSS_SYM_FLOWS, pktio_tx, pktio_rx);
+	CU_ASSERT_FATAL(ret == 2 * RSS_SYM_FLOWS);
+
+	for (i = 0; i < 2 * RSS_SYM_FLOWS; i++) {
+		pktio_pkt_set_flow(pkt_tbl[i], i / 2, i % 2);
+		rx_queue[i] = -1;
+	}
+
+	CU_ASSERT_FATAL(odp_pktout_queue(pktio_tx, &pktout_queue, 1) == 1);
+	ret = odp_pktout_send(pktout_queue, pkt_tbl, 2 * RSS_SYM_FLOWS);
+	CU_ASSERT_FATAL(ret == 2 * RSS_SYM_FLOWS);
+
+	num_q = odp_pktin_queue(pktio_rx, pktin_queue, RSS_SYM_QUEUES);
+	CU_ASSERT_FATAL(num_q > 1);
+	if (num_q > RSS_SYM_QUEUES)
+		num_q = RSS_SYM_QUEUES;
+
+	end = odp_time_sum(odp_time_local(), odp_time_local_from_ns(ODP_TIME_SEC_IN_NS));
+
+	while (num_rx < 2 * RSS_SYM_FLOWS && odp_time_cmp(end, odp_time_local()) > 0) {
+		for (int q = 0; q < num_q; q++) {
+			odp_packet_t pkt;
+			uint32_t seq;
+
+			ret = odp_pktin_recv(pktin_queue[q], &pkt, 1);
+			CU_ASSERT_FATAL(ret >= 0);
+			if (ret == 0)
+				continue;
+
+			seq = pktio_pkt_seq(pkt);
+			odp_packet_free(pkt);
+
+			for (i = 0; i < 2 * RSS_SYM_FLOWS; i++) {
+				if (pkt_seq[i] == seq && rx_queue[i] < 0) {
+					rx_queue[i] = q;
+					queue_mask |= 1u << q;
+					num_rx++;
+					break;
+				}
+			}
+		}
+	}
+
+	CU_ASSERT(num_rx == 2 * RSS_SYM_FLOWS);
+
+	for (i = 0; i < RSS_SYM_FLOWS; i++)
+		CU_ASSERT(rx_queue[2 * i] == rx_queue[2 * i + 1]);
+
+	/* Flows are spread over multiple queues */
+	CU_ASSERT(queue_mask & (queue_mask - 1));
+
+	for (i = 0; i < num_ifaces; i++) {
+		CU_ASSERT_FATAL(odp_pktio_stop(pktio[i]) == 0);
+		CU_ASSERT_FATAL(odp_pktio_close(pktio[i]) == 0);
+	}
+}
+
 static void test_recv_tmo(recv_tmo_mode_e mode)
 {
 	odp_pktio_t pktio_tx, pktio_rx;
@@ -4031,6 +4183,307 @@ static int pktio_check_pktout_dont_free(void)
 	return ODP_TEST_INACTIVE;
 }
 
+static int pktio_check_reass(odp_bool_t ipv6)
+{
+	odp_pktio_param_t pktio_param;
+	odp_pktio_capability_t capa;
+	odp_pktio_t pktio;
+	int idx = (num_ifaces > 1) ? 1 : 0;
+	int ret;
+
+	odp_pktio_param_init(&pktio_param);
+	pktio_param.in_mode = ODP_PKTIN_MODE_DIRECT;
+
+	pktio = odp_pktio_open(iface_name[idx], pool[idx], &pktio_param);
+	if (pktio == ODP_PKTIO_INVALID)
+		return ODP_TEST_INACTIVE;
+
+	ret = odp_pktio_capability(pktio, &capa);
+	(void)odp_pktio_close(pktio);
+
+	if (ret == 0 && ((ipv6 ? capa.reassembly.ipv6 : capa.reassembly.ipv4) ||
+			 capa.reassembly.ip))
+		return ODP_TEST_ACTIVE;
+
+	return ODP_TEST_INACTIVE;
+}
+
+static int pktio_check_reass_ipv4(void)
+{
+	return pktio_check_reass(false);
+}
+
+static int pktio_check_reass_ipv6(void)
+{
+	return pktio_check_reass(true);
+}
+
+/* Split an IPv4 packet into two fragments. First fragment carries 'len' bytes of
+ * the IP payload. */
+static int ipv4_fragment(odp_packet_t pkt, uint32_t len, odp_packet_t frag[2])
+{
+	const uint32_t hdr_len = ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN;
+	const uint32_t pkt_len = odp_packet_len(pkt);
+	odph_ipv4hdr_t *ip;
+
+	frag[0] = odp_packet_copy(pkt, odp_packet_pool(pkt));
+	frag[1] = odp_packet_copy(pkt, odp_packet_pool(pkt));
+
+	if (frag[0] == ODP_PACKET_INVALID || frag[1] == ODP_PACKET_INVALID ||
+	    odp_packet_trunc_tail(&frag[0], pkt_len - hdr_len - len, NULL, NULL) < 0 ||
+	    odp_packet_rem_data(&frag[1], hdr_len, len) < 0)
+		return -1;
+
+	/* More fragments flag */
+	ip = odp_packet_l3_ptr(frag[0], NULL);
+	ip->tot_len = odp_cpu_to_be_16(ODPH_IPV4HDR_LEN + len);
+	ip->frag_offset = odp_cpu_to_be_16(0x2000);
+	odph_ipv4_csum_update(frag[0]);
+
+	ip = odp_packet_l3_ptr(frag[1], NULL);
+	ip->tot_len = odp_cpu_to_be_16(pkt_len - ODPH_ETHHDR_LEN - len);
+	ip->frag_offset = odp_cpu_to_be_16(len / 8);
+	odph_ipv4_csum_update(frag[1]);
+
+	return 0;
+}
+
+static odp_pktio_t reass_pktio_open(odp_pktio_t pktio[], uint64_t max_wait_time,
+				    odp_bool_t ipv6)
+{
+	odp_pktio_config_t config;
+	odp_pktio_t pktio_rx;
+	int i;
+
+	for (i = 0; i < num_ifaces; ++i) {
+		pktio[i] = create_pktio(i, ODP_PKTIN_MODE_DIRECT, ODP_PKTOUT_MODE_DIRECT);
+		CU_ASSERT_FATAL(pktio[i] != ODP_PKTIO_INVALID);
+	}
+
+	pktio_rx = (num_ifaces > 1) ? pktio[1] : pktio[0];
+
+	odp_pktio_config_init(&config);
+	config.reassembly.en_ipv4 = !ipv6;
+	config.reassembly.en_ipv6 = ipv6;
+	config.reassembly.max_wait_time = max_wait_time;
+	CU_ASSERT_FATAL(odp_pktio_config(pktio_rx, &config) == 0);
+
+	for (i = 0; i < num_ifaces; ++i) {
+		CU_ASSERT_FATAL(odp_pktio_start(pktio[i]) == 0);
+		_pktio_wait_linkup(pktio[i]);
+	}
+
+	return pktio_rx;
+}
+
+static void reass_pktio_close(odp_pktio_t pktio[])
+{
+	for (int i = 0; i < num_ifaces; i++) {
+		CU_ASSERT_FATAL(odp_pktio_stop(pktio[i]) == 0);
+		CU_ASSERT_FATAL(odp_pktio_close(pktio[i]) == 0);
+	}
+}
+
+static void pktio_test_reass_ipv4(void)
+{
+	odp_pktio_t pktio[MAX_NUM_IFACES] = {ODP_PKTIO_INVALID};
+	odp_pktio_t pktio_rx;
+	odp_pktout_queue_t pktout;
+	pktio_info_t pktio_rx_info;
+	odp_packet_reass_info_t info;
+	odp_packet_t pkt, rx_pkt;
+	odp_packet_t frag[2];
+	uint32_t pkt_seq;
+	const uint32_t len = 1000;
+	uint8_t orig[len], data[len];
+
+	packet_len = len;
+	pktio_rx = reass_pktio_open(pktio, 0, false);
+
+	pktio_rx_info.id = pktio_rx;
+	pktio_rx_info.inq = ODP_QUEUE_INVALID;
+	pktio_rx_info.in_mode = ODP_PKTIN_MODE_DIRECT;
+
+	CU_ASSERT_FATAL(create_packets(&pkt, &pkt_seq, 1, pktio[0], pktio_rx) == 1);
+	CU_ASSERT_FATAL(odp_packet_copy_to_mem(pkt, 0, len, orig) == 0);
+	CU_ASSERT_FATAL(ipv4_fragment(pkt, 400, frag) == 0);
+	odp_packet_free(pkt);
+
+	CU_ASSERT_FATAL(odp_pktout_queue(pktio[0], &pktout, 1) == 1);
+
+	/* Last fragment first */
+	CU_ASSERT_FATAL(odp_pktout_send(pktout, &frag[1], 1) == 1);
+	CU_ASSERT_FATAL(odp_pktout_send(pktout, &frag[0], 1) == 1);
+
+	CU_ASSERT(wait_for_packets(&pktio_rx_info, &rx_pkt, &pkt_seq, 1, TXRX_MODE_SINGLE,
+				   ODP_TIME_SEC_IN_NS, false) == 1);
+
+	if (rx_pkt != ODP_PACKET_INVALID) {
+		CU_ASSERT(odp_packet_reass_status(rx_pkt) == ODP_PACKET_REASS_COMPLETE);
+		CU_ASSERT(odp_packet_reass_info(rx_pkt, &info) == 0);
+		CU_ASSERT(info.num_frags == 2);
+		CU_ASSERT(odp_packet_len(rx_pkt) == len);
+		CU_ASSERT(odp_packet_copy_to_mem(rx_pkt, 0, len, data) == 0);
+		CU_ASSERT(memcmp(orig, data, len) == 0);
+		odp_packet_free(rx_pkt);
+	}
+
+	packet_len = PKT_LEN_NORMAL;
+	reass_pktio_close(pktio);
+}
+
+static void pktio_test_reass_ipv4_incomplete(void)
+{
+	odp_pktio_t pktio[MAX_NUM_IFACES] = {ODP_PKTIO_INVALID};
+	odp_pktio_t pktio_rx;
+	odp_pktout_queue_t pktout;
+	odp_pktin_queue_t pktin;
+	odp_packet_reass_partial_state_t res;
+	odp_packet_t pkt, rx_pkt;
+	odp_packet_t frag[2], part[2];
+	odp_time_t end;
+	uint32_t pkt_seq, frag_len;
+	const uint64_t max_wait = 10 * ODP_TIME_MSEC_IN_NS;
+	int num_incomplete = 0;
+
+	packet_len = 1000;
+	pktio_rx = reass_pktio_open(pktio, max_wait, false);
+
+	CU_ASSERT_FATAL(create_packets(&pkt, &pkt_seq, 1, pktio[0], pktio_rx) == 1);
+	CU_ASSERT_FATAL(ipv4_fragment(pkt, 400, frag) == 0);
+	odp_packet_free(pkt);
+	odp_packet_free(frag[1]);
+	frag_len = odp_packet_len(frag[0]);
+
+	CU_ASSERT_FATAL(odp_pktout_queue(pktio[0], &pktout, 1) == 1);
+	CU_ASSERT_FATAL(odp_pktin_queue(pktio_rx, &pktin, 1) == 1);
+	CU_ASSERT_FATAL(odp_pktout_send(pktout, &frag[0], 1) == 1);
+
+	end = odp_time_sum(odp_time_local(), odp_time_local_from_ns(ODP_TIME_SEC_IN_NS));
+
+	/* Fragment is output with incomplete status after the wait time */
+	while (num_incomplete == 0 && odp_time_cmp(end, odp_time_local()) > 0) {
+		if (odp_pktin_recv(pktin, &rx_pkt, 1) != 1)
+			continue;
+
+		if (odp_packet_reass_status(rx_pkt) != ODP_PACKET_REASS_INCOMPLETE) {
+			odp_packet_free(rx_pkt);
+			continue;
+		}
+
+		num_incomplete++;
+		CU_ASSERT_FATAL(odp_packet_reass_partial_state(rx_pkt, part, &res) == 0);
+		CU_ASSERT_FATAL(res.num_frags == 1);
+		CU_ASSERT(res.elapsed_time >= max_wait);
+		CU_ASSERT(odp_packet_len(part[0]) == frag_len);
+		odp_packet_free(part[0]);
+	}
+
+	CU_ASSERT(num_incomplete == 1);
+
+	packet_len = PKT_LEN_NORMAL;
+	reass_pktio_close(pktio);
+}
+
+/* Number of VLAN tags in front of the IPv6 header of reassembly test fragments */
+#define REASS_VLAN_TAGS 9
+
+/* Create an IPv6 fragment with REASS_VLAN_TAGS VLAN tags. 'len' bytes of data
+ * start at datagram offset 'offset'. */
+static odp_packet_t ipv6_vlan_fragment(odp_pool_t pkt_pool, uint32_t offset, uint32_t len,
+				       int more)
+{
+	const uint32_t l3_offset = ODPH_ETHHDR_LEN + REASS_VLAN_TAGS * ODPH_VLANHDR_LEN;
+	const uint32_t hdr_len = l3_offset + ODPH_IPV6HDR_LEN + 8;
+	uint8_t src_mac[ODPH_ETHADDR_LEN] = PKTIO_SRC_MAC;
+	uint8_t dst_mac[ODPH_ETHADDR_LEN] = PKTIO_DST_MAC;
+	uint8_t buf[hdr_len + len];
+	odph_ipv6hdr_t *ip = (odph_ipv6hdr_t *)(uintptr_t)(buf + l3_offset);
+	uint8_t *frag_hdr = buf + l3_offset + ODPH_IPV6HDR_LEN;
+	odp_packet_t pkt;
+	uint32_t i;
+
+	memset(buf, 0, hdr_len);
+	memcpy(buf, dst_mac, ODPH_ETHADDR_LEN);
+	memcpy(buf + ODPH_ETHADDR_LEN, src_mac, ODPH_ETHADDR_LEN);
+
+	for (i = 0; i < REASS_VLAN_TAGS; i++) {
+		uint8_t *tag = buf + 2 * ODPH_ETHADDR_LEN + i * ODPH_VLANHDR_LEN;
+
+		tag[0] = ODPH_ETHTYPE_VLAN >> 8;
+		tag[1] = ODPH_ETHTYPE_VLAN & 0xff;
+		tag[3] = i + 1;
+	}
+
+	buf[l3_offset - 2] = ODPH_ETHTYPE_IPV6 >> 8;
+	buf[l3_offset - 1] = ODPH_ETHTYPE_IPV6 & 0xff;
+
+	ip->ver_tc_flow = odp_cpu_to_be_32(ODPH_IPV6 << ODPH_IPV6HDR_VERSION_SHIFT);
+	ip->payload_len = odp_cpu_to_be_16(8 + len);
+	ip->next_hdr = ODPH_IPPROTO_FRAG;
+	ip->hop_limit = 64;
+	ip->src_addr[15] = 1;
+	ip->dst_addr[15] = 2;
+
+	/* Fragment header: next header, offset and more fragments flag, id */
+	frag_hdr[0] = ODPH_IPPROTO_UDP;
+	frag_hdr[2] = offset >> 8;
+	frag_hdr[3] = (offset & 0xf8) | !!more;
+	frag_hdr[7] = 0x5a;
+
+	for (i = 0; i < len; i++)
+		buf[hdr_len + i] = offset + i;
+
+	pkt = odp_packet_alloc(pkt_pool, hdr_len + len);
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+	CU_ASSERT_FATAL(odp_packet_copy_from_mem(pkt, 0, hdr_len + len, buf) == 0);
+
+	return pkt;
+}
+
+/* Fragments with more VLAN tags than the reassembly engine parses are
+ * received as normal packets */
+static void pktio_test_reass_ipv6_vlan(void)
+{
+	odp_pktio_t pktio[MAX_NUM_IFACES] = {ODP_PKTIO_INVALID};
+	odp_pktio_t pktio_rx;
+	odp_pktout_queue_t pktout;
+	odp_pktin_queue_t pktin;
+	odp_packet_t frag[2], rx_pkt;
+	uint32_t frag_len[2];
+	odp_time_t end;
+	int num_rx = 0;
+
+	pktio_rx = reass_pktio_open(pktio, 0, true);
+
+	frag[0] = ipv6_vlan_fragment(pool[0], 0, 64, 1);
+	frag[1] = ipv6_vlan_fragment(pool[0], 64, 32, 0);
+	frag_len[0] = odp_packet_len(frag[0]);
+	frag_len[1] = odp_packet_len(frag[1]);
+
+	CU_ASSERT_FATAL(odp_pktout_queue(pktio[0], &pktout, 1) == 1);
+	CU_ASSERT_FATAL(odp_pktin_queue(pktio_rx, &pktin, 1) == 1);
+	CU_ASSERT_FATAL(odp_pktout_send(pktout, frag, 2) == 2);
+
+	end = odp_time_sum(odp_time_local(), odp_time_local_from_ns(ODP_TIME_SEC_IN_NS));
+
+	while (num_rx < 2 && odp_time_cmp(end, odp_time_local()) > 0) {
+		if (odp_pktin_recv(pktin, &rx_pkt, 1) != 1)
+			continue;
+
+		if (odp_packet_len(rx_pkt) == frag_len[num_rx]) {
+			CU_ASSERT(odp_packet_reass_status(rx_pkt) == ODP_PACKET_REASS_NONE);
+			num_rx++;
+		}
+
+		odp_packet_free(rx_pkt);
+	}
+
+	CU_ASSERT(num_rx == 2);
+
+	reass_pktio_close(pktio);
+}
+
 static void pktio_test_chksum(void (*config_fn)(odp_pktio_t, odp_pktio_t),
 			      void (*prep_fn)(odp_packet_t pkt),
 			      void (*test_fn)(odp_packet_t pkt))
@@ -5408,6 +5861,8 @@ odp_testinfo_t pktio_suite_unsegmented[] = {
 	ODP_TEST_INFO(pktio_test_recv),
 	ODP_TEST_INFO(pktio_test_recv_multi),
 	ODP_TEST_INFO(pktio_test_recv_queue),
+	ODP_TEST_INFO_CONDITIONAL(pktio_test_pktin_hash_sym,
+				  pktio_check_pktin_hash_sym),
 	ODP_TEST_INFO(pktio_test_recv_tmo),
 	ODP_TEST_INFO(pktio_test_recv_mq_tmo),
 	ODP_TEST_INFO(pktio_test_recv_mtu),
@@ -5474,6 +5929,9 @@ odp_testinfo_t pktio_suite_unsegmented[] = {
 				  pktio_check_pktout_compl_event_sched_queue),
 	ODP_TEST_INFO_CONDITIONAL(pktio_test_pktout_compl_poll, pktio_check_pktout_compl_poll),
 	ODP_TEST_INFO_CONDITIONAL(pktio_test_pktout_dont_free, pktio_check_pktout_dont_free),
+	ODP_TEST_INFO_CONDITIONAL(pktio_test_reass_ipv4, pktio_check_reass_ipv4),
+	ODP_TEST_INFO_CONDITIONAL(pktio_test_reass_ipv4_incomplete, pktio_check_reass_ipv4),
+	ODP_TEST_INFO_CONDITIONAL(pktio_test_reass_ipv6_vlan, pktio_check_reass_ipv6),
 	ODP_TEST_INFO_CONDITIONAL(pktio_test_enable_pause_rx, pktio_check_pause_rx),
 	ODP_TEST_INFO_CONDITIONAL(pktio_test_enable_pause_tx, pktio_check_pause_tx),
 	ODP_TEST_INFO_CONDITIONAL(pktio_test_enable_pause_both, pktio_check_pause_both),
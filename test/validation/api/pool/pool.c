@@ -1513,6 +1513,63 @@ static void pool_test_create_max_pkt_pools(void)
 		CU_ASSERT(odp_shm_free(shm[i]) == 0);
 }
 
+static void pool_test_cache_trim(void)
+{
+	odp_pool_param_t param;
+	odp_pool_stats_t stats;
+	odp_pool_t pool;
+	odp_buffer_t buf[BUF_NUM];
+	uint32_t cache_size = CACHE_SIZE;
+	int num;
+	int thr = odp_thread_id();
+
+	if (cache_size > global_pool_capa.buf.max_cache_size)
+		cache_size = global_pool_capa.buf.max_cache_size;
+
+	odp_pool_param_init(&param);
+	param.type = ODP_POOL_BUFFER;
+	param.buf.size = BUF_SIZE;
+	param.buf.num = BUF_NUM;
+	param.buf.cache_size = cache_size;
+	param.stats.all = global_pool_capa.buf.stats.all;
+
+	pool = odp_pool_create(NULL, &param);
+	CU_ASSERT_FATAL(pool != ODP_POOL_INVALID);
+
+	/* Nothing cached yet */
+	CU_ASSERT(odp_pool_cache_trim(pool) == 0);
+
+	num = odp_buffer_alloc_multi(pool, buf, BUF_NUM);
+	CU_ASSERT(num > 0);
+
+	/* Free one by one to fill the cache of this thread */
+	for (int i = 0; i < num; i++)
+		odp_buffer_free(buf[i]);
+
+	/* Events in the cache of this thread are returned into the pool during the call */
+	CU_ASSERT(odp_pool_cache_trim(pool) == 0);
+
+	memset(&stats, 0, sizeof(odp_pool_stats_t));
+	stats.thread.first = thr;
+	stats.thread.last = thr;
+	CU_ASSERT_FATAL(odp_pool_stats(pool, &stats) == 0);
+
+	if (param.stats.bit.thread_cache_available)
+		CU_ASSERT(stats.thread.cache_available[0] == 0);
+	if (param.stats.bit.available && param.stats.bit.cache_available)
+		CU_ASSERT(stats.available + stats.cache_available == BUF_NUM);
+	if (param.stats.bit.cache_flushed && num > 0 && cache_size)
+		CU_ASSERT(stats.cache_flushed > 0);
+
+	/* Pool remains fully functional */
+	num = odp_buffer_alloc_multi(pool, buf, BUF_NUM);
+	CU_ASSERT(num > 0);
+	if (num > 0)
+		odp_buffer_free_multi(buf, num);
+
+	CU_ASSERT(odp_pool_destroy(pool) == 0);
+}
+
 static int pool_check_buffer_pool_statistics(void)
 {
 	if (global_pool_capa.buf.stats.all == 0)
@@ -1693,6 +1750,12 @@ static void pool_test_pool_statistics(odp_pool_type_t pool_type)
 		CU_ASSERT(stats.cache_free_ops == 0);
 		if (supported.bit.cache_free_ops)
 			CU_ASSERT(selected.cache_free_ops == 0);
+		CU_ASSERT(stats.cache_flush_reqs == 0);
+		if (supported.bit.cache_flush_reqs)
+			CU_ASSERT(selected.cache_flush_reqs == 0);
+		CU_ASSERT(stats.cache_flushed == 0);
+		if (supported.bit.cache_flushed)
+			CU_ASSERT(selected.cache_flushed == 0);
 
 		CU_ASSERT(stats.thread.first == first);
 		CU_ASSERT(stats.thread.last == last);
@@ -1889,6 +1952,12 @@ static void pool_test_pool_statistics(odp_pool_type_t pool_type)
 		CU_ASSERT(stats.cache_free_ops == 0);
 		if (supported.bit.cache_free_ops)
 			CU_ASSERT(selected.cache_free_ops == 0);
+		CU_ASSERT(stats.cache_flush_reqs == 0);
+		if (supported.bit.cache_flush_reqs)
+			CU_ASSERT(selected.cache_flush_reqs == 0);
+		CU_ASSERT(stats.cache_flushed == 0);
+		if (supported.bit.cache_flushed)
+			CU_ASSERT(selected.cache_flushed == 0);
 
 		CU_ASSERT(odp_pool_destroy(pool[i]) == 0);
 	}
@@ -2641,6 +2710,7 @@ odp_testinfo_t pool_suite[] = {
 	ODP_TEST_INFO(pool_test_create_after_fork),
 	ODP_TEST_INFO(pool_test_pool_index),
 	ODP_TEST_INFO(pool_test_create_max_pkt_pools),
+	ODP_TEST_INFO(pool_test_cache_trim),
 	ODP_TEST_INFO_CONDITIONAL(pool_test_buffer_pool_statistics,
 				  pool_check_buffer_pool_statistics),
 	ODP_TEST_INFO_CONDITIONAL(pool_test_packet_pool_statistics,
@@ -893,6 +893,105 @@ static void scheduler_test_order_ignore(void)
 	CU_ASSERT_FATAL(odp_pool_destroy(pool) == 0);
 }
 
+static void scheduler_test_stats(void)
+{
+	odp_schedule_capability_t capa;
+	odp_schedule_stats_t stats;
+	odp_pool_t pool;
+	odp_pool_param_t pool_param;
+	odp_queue_param_t queue_param;
+	odp_queue_t queue;
+	odp_event_t ev;
+	odp_buffer_t buf;
+	uint32_t i, num;
+	int thr = odp_thread_id();
+
+	CU_ASSERT_FATAL(odp_schedule_capability(&capa) == 0);
+
+	if (capa.stats == ODP_SUPPORT_NO) {
+		CU_ASSERT(odp_schedule_stats(thr, &stats) < 0);
+		CU_ASSERT(odp_schedule_stats_reset() < 0);
+		odp_schedule_stats_print();
+		return;
+	}
+
+	odp_pool_param_init(&pool_param);
+	pool_param.buf.size = 100;
+	pool_param.buf.num  = DEFAULT_NUM_EV;
+	pool_param.type     = ODP_POOL_BUFFER;
+
+	pool = odp_pool_create("test_stats", &pool_param);
+	CU_ASSERT_FATAL(pool != ODP_POOL_INVALID);
+
+	sched_queue_param_init(&queue_param);
+	queue = odp_queue_create("test_stats", &queue_param);
+	CU_ASSERT_FATAL(queue != ODP_QUEUE_INVALID);
+
+	CU_ASSERT(drain_queues() == 0);
+	CU_ASSERT_FATAL(odp_schedule_stats_reset() == 0);
+
+	CU_ASSERT_FATAL(odp_schedule_stats(thr, &stats) == 0);
+	CU_ASSERT(stats.rounds == 0);
+	CU_ASSERT(stats.events == 0);
+	CU_ASSERT(stats.queue_delay.num == 0);
+
+	for (i = 0; i < DEFAULT_NUM_EV; i++) {
+		buf = odp_buffer_alloc(pool);
+		CU_ASSERT_FATAL(buf != ODP_BUFFER_INVALID);
+
+		ev = odp_buffer_to_event(buf);
+		CU_ASSERT_FATAL(odp_queue_enq(queue, ev) == 0);
+	}
+
+	num = 0;
+	for (i = 0; i < 100 * DEFAULT_NUM_EV && num < DEFAULT_NUM_EV; i++) {
+		ev = odp_schedule(NULL, ODP_SCHED_NO_WAIT);
+
+		if (ev == ODP_EVENT_INVALID)
+			continue;
+
+		odp_event_free(ev);
+		num++;
+	}
+
+	CU_ASSERT(num == DEFAULT_NUM_EV);
+
+	/* One empty round */
+	CU_ASSERT(odp_schedule(NULL, ODP_SCHED_NO_WAIT) == ODP_EVENT_INVALID);
+
+	CU_ASSERT_FATAL(odp_schedule_stats(thr, &stats) == 0);
+	CU_ASSERT(stats.events == DEFAULT_NUM_EV);
+	CU_ASSERT(stats.rounds > stats.empty_rounds);
+	CU_ASSERT(stats.empty_rounds >= 1);
+	CU_ASSERT(stats.queue_delay.num == DEFAULT_NUM_EV);
+	CU_ASSERT(stats.queue_delay.min <= stats.queue_delay.max);
+	CU_ASSERT(stats.latency.num == stats.rounds - stats.empty_rounds);
+	CU_ASSERT(stats.burst.num == stats.latency.num);
+	CU_ASSERT(stats.burst.sum == DEFAULT_NUM_EV);
+	CU_ASSERT(stats.burst.min >= 1);
+
+	num = 0;
+	for (i = 0; i < ODP_SCHED_STATS_HIST_BINS; i++)
+		num += stats.queue_delay.bin[i];
+
+	CU_ASSERT(num == DEFAULT_NUM_EV);
+
+	/* Combined statistics include the statistics of this thread */
+	CU_ASSERT_FATAL(odp_schedule_stats(-1, &stats) == 0);
+	CU_ASSERT(stats.events >= DEFAULT_NUM_EV);
+	CU_ASSERT(stats.queue_delay.num >= DEFAULT_NUM_EV);
+
+	odp_schedule_stats_print();
+
+	CU_ASSERT_FATAL(odp_schedule_stats_reset() == 0);
+	CU_ASSERT_FATAL(odp_schedule_stats(thr, &stats) == 0);
+	CU_ASSERT(stats.events == 0);
+	CU_ASSERT(stats.latency.num == 0);
+
+	CU_ASSERT_FATAL(odp_queue_destroy(queue) == 0);
+	CU_ASSERT_FATAL(odp_pool_destroy(pool) == 0);
+}
+
 static void scheduler_test_group_info_predef(void)
 {
 	odp_schedule_group_info_t info;
@@ -3755,6 +3854,7 @@ odp_testinfo_t scheduler_basic_suite[] = {
 	ODP_TEST_INFO(scheduler_test_max_queues_a),
 	ODP_TEST_INFO(scheduler_test_max_queues_o),
 	ODP_TEST_INFO(scheduler_test_order_ignore),
+	ODP_TEST_INFO(scheduler_test_stats),
 	ODP_TEST_INFO(scheduler_test_group_info_predef),
 	ODP_TEST_INFO(scheduler_test_create_group),
 	ODP_TEST_INFO(scheduler_test_group_param_init),